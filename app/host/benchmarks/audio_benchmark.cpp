@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <benchmark/benchmark.h>
+#include <audio/resampler.h>
+#include <audio/adpcm_decoder.h>
+#include <audio/dsp.h>
+
+namespace skyline::audio {
+    constexpr size_t BufferSamples{0x1000}; //!< The amount of samples per channel in a benchmarked buffer
+    constexpr u8 ChannelCount{2};
+
+    static std::vector<i16> RandomSamples(size_t count) {
+        std::vector<i16> samples(count);
+        std::mt19937 generator{};
+        std::uniform_int_distribution<i16> distribution{};
+        std::generate(samples.begin(), samples.end(), [&] { return distribution(generator); });
+        return samples;
+    }
+
+    /**
+     * @brief Benchmarks resampling a stereo buffer by a ratio of the argument in thousandths
+     */
+    static void BM_Resample(benchmark::State &state) {
+        double ratio{static_cast<double>(state.range(0)) / 1000.0};
+        auto input{RandomSamples(BufferSamples * ChannelCount)};
+        std::vector<i16> output(Resampler::GetMaxOutputSize(input.size(), ratio, ChannelCount));
+        Resampler resampler;
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(resampler.Process(input, output, ratio, ChannelCount));
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * BufferSamples));
+    }
+    BENCHMARK(BM_Resample)->Arg(1000)->Arg(1005)->Arg(1500)->Arg(2000);
+
+    static void BM_DecodeAdpcm(benchmark::State &state) {
+        constexpr size_t FrameSize{8}, FrameSamples{14};
+        std::vector<std::array<i16, 2>> coefficients(8, {0x800, -0x400});
+        std::vector<u8> adpcm(BufferSamples / FrameSamples * FrameSize);
+        std::mt19937 generator{};
+        std::generate(adpcm.begin(), adpcm.end(), [&] { return static_cast<u8>(generator()); });
+        for (size_t offset{}; offset < adpcm.size(); offset += FrameSize)
+            adpcm[offset] &= 0x7F; // The coefficient index must be in range of the supplied coefficients
+
+        for (auto _ : state) {
+            AdpcmDecoder decoder{coefficients};
+            benchmark::DoNotOptimize(decoder.Decode(adpcm));
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * (adpcm.size() / FrameSize) * FrameSamples));
+    }
+    BENCHMARK(BM_DecodeAdpcm);
+
+    static void BM_MixWithVolumeRamp(benchmark::State &state) {
+        auto source{RandomSamples(BufferSamples * ChannelCount)};
+        std::vector<i32> mix(source.size());
+
+        for (auto _ : state) {
+            dsp::MixWithVolumeRamp(mix, source, ChannelCount, 0.5f, 0.0001f);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * BufferSamples));
+    }
+    BENCHMARK(BM_MixWithVolumeRamp);
+
+    static void BM_SaturateMix(benchmark::State &state) {
+        std::vector<i32> mix(BufferSamples * ChannelCount);
+        std::mt19937 generator{};
+        std::generate(mix.begin(), mix.end(), [&] { return static_cast<i32>(generator()) >> 14; });
+        std::vector<i16> output(mix.size());
+
+        for (auto _ : state) {
+            dsp::SaturateMix(output, mix);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * BufferSamples));
+    }
+    BENCHMARK(BM_SaturateMix);
+
+    static void BM_ApplyBiquadFilter(benchmark::State &state) {
+        auto samples{RandomSamples(BufferSamples * ChannelCount)};
+        dsp::BiquadCoefficients coefficients{{0x0D4D, 0x1A9A, 0x0D4D}, {-0x3A49, 0x1B03}}; // A Q14 low-pass filter
+        std::array<dsp::BiquadState, ChannelCount> states{};
+
+        for (auto _ : state) {
+            dsp::ApplyBiquadFilter(samples, coefficients, states);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * BufferSamples));
+    }
+    BENCHMARK(BM_ApplyBiquadFilter);
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <benchmark/benchmark.h>
+#include <kernel/memory.h>
+
+namespace skyline::kernel {
+    constexpr u64 AddressSpaceSize{1ULL << 39};
+    constexpr u64 BaseAddress{1ULL << 35}; //!< The base of the application address space, this matches the placement by MemoryManager::InitializeVmm
+    constexpr u64 BaseSize{0x2200000000};
+    constexpr u64 HeapOffset{0x100000000}; //!< The offset of the heap region from the base
+    constexpr u64 AliasOffset{0x1000000000}; //!< The offset of the region that stacks and transfer memory are mapped into from the base
+
+    /**
+     * @brief A memory SVC in a trace, it's applied to the chunks as the kernel would
+     */
+    struct SvcCall {
+        enum class Type {
+            Insert, //!< Any SVC which changes the state, permission or attributes of a range (svcMapMemory, svcSetHeapSize, svcMapTransferMemory, svcSetMemoryPermission, ...)
+            Query, //!< svcQueryMemory
+        } type;
+        ChunkDescriptor chunk; //!< (Insert) The chunk inserted by the SVC, (Query) the address being queried is the chunk's pointer
+    };
+
+    static u8 *ToPointer(u64 address) {
+        return reinterpret_cast<u8 *>(address);
+    }
+
+    static SvcCall Insert(u64 address, u64 size, memory::MemoryState state, memory::Permission permission, memory::MemoryAttribute attributes = {}) {
+        return SvcCall{SvcCall::Type::Insert, ChunkDescriptor{.ptr = ToPointer(address), .size = size, .permission = permission, .state = state, .attributes = attributes}};
+    }
+
+    static SvcCall Query(u64 address) {
+        return SvcCall{SvcCall::Type::Query, ChunkDescriptor{.ptr = ToPointer(address)}};
+    }
+
+    /**
+     * @brief A synthetic trace of the memory SVCs made by a title, modelled on the patterns seen while booting titles and during gameplay
+     * @note Skyline has no facility for capturing SVC traces so the traces are generated deterministically, the steady state trace restores every chunk it changes so it can be replayed repeatedly
+     */
+    struct SvcTrace {
+        std::vector<SvcCall> boot; //!< Loading the executables, growing the heap and creating the supplied amount of long-lived stack and TLS mappings
+        std::vector<SvcCall> steady; //!< Transfer memory churn, permission changes on the heap and svcQueryMemory walks
+
+        SvcTrace(size_t liveMappings) {
+            std::mt19937_64 random{0x5C7A1E};
+            constexpr memory::Permission R{true, false, false}, RW{true, true, false}, RX{true, false, true}, None{};
+
+            // rtld and every NSO are mapped as a text, rodata and data segment
+            u64 address{BaseAddress};
+            for (size_t module{}; module < 12; module++) {
+                u64 textSize{util::AlignUp(random() % 0x2000000 + constant::PageSize, constant::PageSize)}, rodataSize{util::AlignUp(random() % 0x800000 + constant::PageSize, constant::PageSize)}, dataSize{util::AlignUp(random() % 0x400000 + constant::PageSize, constant::PageSize)};
+                boot.push_back(Insert(address, textSize, memory::states::CodeStatic, RX));
+                boot.push_back(Insert(address + textSize, rodataSize, memory::states::CodeStatic, R));
+                boot.push_back(Insert(address + textSize + rodataSize, dataSize, memory::states::CodeMutable, RW));
+                address += textSize + rodataSize + dataSize;
+            }
+
+            // The heap is grown in steps by svcSetHeapSize, every step is merged with the prior heap chunk
+            for (u64 heapSize{0x2000000}; heapSize <= 0x40000000; heapSize *= 2)
+                boot.push_back(Insert(BaseAddress + HeapOffset, heapSize, memory::states::Heap, RW));
+
+            // Thread stacks are separated by guard pages and each thread has a TLS page, these never merge with their neighbours
+            std::vector<u64> aliasSlots;
+            for (size_t index{}; index < liveMappings; index++) {
+                u64 slot{BaseAddress + AliasOffset + index * 0x40000};
+                boot.push_back(Insert(slot, 0x20000, memory::states::Stack, RW));
+                boot.push_back(Insert(slot + 0x30000, constant::PageSize, memory::states::ThreadLocal, RW));
+            }
+
+            for (size_t iteration{}; iteration < 256; iteration++) {
+                switch (random() % 4) {
+                    case 0: {
+                        // Transfer memory is mapped into a free slot and unmapped after being used by a service
+                        u64 slot{BaseAddress + AliasOffset + (liveMappings + random() % 64) * 0x40000}, size{util::AlignUp(random() % 0x20000 + 1, constant::PageSize)};
+                        steady.push_back(Insert(slot, size, memory::states::TransferMemory, RW));
+                        steady.push_back(Query(slot));
+                        steady.push_back(Insert(slot, size, memory::states::Unmapped, None));
+                        break;
+                    }
+
+                    case 1: {
+                        // svcSetMemoryPermission and svcSetMemoryAttribute on a part of the heap split its chunk before being reverted
+                        u64 offset{(random() % 0x3F000) * constant::PageSize}, size{(random() % 0x10 + 1) * constant::PageSize};
+                        memory::MemoryAttribute attributes{};
+                        attributes.isUncached = true;
+                        steady.push_back(Insert(BaseAddress + HeapOffset + offset, size, memory::states::Heap, R));
+                        steady.push_back(Insert(BaseAddress + HeapOffset + offset, size, memory::states::Heap, RW, attributes));
+                        steady.push_back(Insert(BaseAddress + HeapOffset + offset, size, memory::states::Heap, RW));
+                        break;
+                    }
+
+                    case 2: {
+                        // Querying the memory around stacks is done by the guest's allocator and debuggers
+                        u64 slot{BaseAddress + AliasOffset + (random() % liveMappings) * 0x40000};
+                        steady.push_back(Query(slot));
+                        steady.push_back(Query(slot + 0x20000));
+                        steady.push_back(Query(slot + 0x30000));
+                        break;
+                    }
+
+                    case 3: {
+                        // Queries at random addresses across the address space
+                        for (size_t query{}; query < 4; query++)
+                            steady.push_back(Query(random() % AddressSpaceSize));
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    static void InitializeChunks(ChunkMap &chunks) {
+        chunks.Reset({
+            ChunkDescriptor{.ptr = ToPointer(0), .size = BaseAddress, .state = memory::states::Reserved},
+            ChunkDescriptor{.ptr = ToPointer(BaseAddress), .size = BaseSize, .state = memory::states::Unmapped},
+            ChunkDescriptor{.ptr = ToPointer(BaseAddress + BaseSize), .size = AddressSpaceSize - BaseAddress - BaseSize, .state = memory::states::Reserved},
+        });
+    }
+
+    static void Replay(ChunkMap &chunks, const std::vector<SvcCall> &calls) {
+        for (const auto &call : calls) {
+            if (call.type == SvcCall::Type::Insert)
+                chunks.Insert(call.chunk);
+            else
+                benchmark::DoNotOptimize(chunks.Get(call.chunk.ptr));
+        }
+    }
+
+    /**
+     * @brief Benchmarks replaying the steady state of an SVC trace with the argument's amount of long-lived stack mappings
+     */
+    static void BM_ChunkMapReplay(benchmark::State &state) {
+        SvcTrace trace{static_cast<size_t>(state.range(0))};
+        ChunkMap chunks;
+        InitializeChunks(chunks);
+        Replay(chunks, trace.boot);
+
+        for (auto _ : state)
+            Replay(chunks, trace.steady);
+
+        state.counters["chunks"] = static_cast<double>(chunks.Size());
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * trace.steady.size()));
+    }
+    BENCHMARK(BM_ChunkMapReplay)->Arg(16)->Arg(256)->Arg(4096);
+
+    /**
+     * @brief Benchmarks replaying the boot of an SVC trace with the argument's amount of long-lived stack mappings into an empty address space
+     */
+    static void BM_ChunkMapBoot(benchmark::State &state) {
+        SvcTrace trace{static_cast<size_t>(state.range(0))};
+        ChunkMap chunks;
+
+        for (auto _ : state) {
+            InitializeChunks(chunks);
+            Replay(chunks, trace.boot);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * trace.boot.size()));
+    }
+    BENCHMARK(BM_ChunkMapBoot)->Arg(16)->Arg(256)->Arg(4096);
+
+    /**
+     * @brief Benchmarks walking the entire address space with svcQueryMemory as rtld and homebrew do, every query starts at the end of the previous chunk
+     */
+    static void BM_ChunkMapQueryWalk(benchmark::State &state) {
+        SvcTrace trace{static_cast<size_t>(state.range(0))};
+        ChunkMap chunks;
+        InitializeChunks(chunks);
+        Replay(chunks, trace.boot);
+
+        for (auto _ : state) {
+            u8 *address{};
+            while (auto chunk{chunks.Get(address)})
+                address = chunk->ptr + chunk->size;
+            benchmark::DoNotOptimize(address);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * chunks.Size()));
+    }
+    BENCHMARK(BM_ChunkMapQueryWalk)->Arg(16)->Arg(256)->Arg(4096);
+}
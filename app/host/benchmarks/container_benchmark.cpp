@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <benchmark/benchmark.h>
+#include <common/circular_buffer.h>
+#include <common/interval_map.h>
+#include <common/linear_allocator.h>
+
+namespace skyline {
+    /**
+     * @brief Benchmarks appending and reading back chunks of the argument's size through a circular buffer, the chunks wrap around the end of the buffer
+     */
+    static void BM_CircularBuffer(benchmark::State &state) {
+        static CircularBuffer<i16, 0x4000> buffer;
+        std::vector<i16> input(static_cast<size_t>(state.range(0)));
+        std::vector<i16> output(input.size());
+
+        for (auto _ : state) {
+            buffer.Append(input);
+            auto outputIt{output.begin()};
+            buffer.Read(output.size(), [&](span<i16> data) {
+                outputIt = std::copy(data.begin(), data.end(), outputIt);
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * input.size()));
+    }
+    BENCHMARK(BM_CircularBuffer)->Arg(0x100)->Arg(0x1000)->Arg(0x3000);
+
+    /**
+     * @brief Benchmarks looking up addresses in an interval map of the argument's amount of disjoint page-sized intervals
+     */
+    static void BM_IntervalMapGet(benchmark::State &state) {
+        constexpr u64 IntervalSize{0x1000};
+        auto count{static_cast<u64>(state.range(0))};
+        IntervalMap<u64, u64> map;
+        for (u64 index{}; index < count; index++)
+            map.Insert(index * IntervalSize * 2, index * IntervalSize * 2 + IntervalSize, index);
+
+        u64 address{};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(map.Get(address));
+            address = (address + IntervalSize * 7 + 0x10) % (count * IntervalSize * 2);
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()));
+    }
+    BENCHMARK(BM_IntervalMapGet)->Arg(0x10)->Arg(0x100)->Arg(0x1000);
+
+    static void BM_LinearAllocator(benchmark::State &state) {
+        LinearAllocatorState<> allocator;
+        auto count{static_cast<size_t>(state.range(0))};
+
+        for (auto _ : state) {
+            for (size_t index{}; index < count; index++)
+                benchmark::DoNotOptimize(allocator.EmplaceUntracked<std::array<u64, 4>>());
+            allocator.Reset();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * count));
+    }
+    BENCHMARK(BM_LinearAllocator)->Arg(0x100)->Arg(0x10000);
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <benchmark/benchmark.h>
+#include <crypto/aes_cipher.h>
+
+namespace skyline::crypto {
+    constexpr size_t SectorSize{0x200}; //!< The sector size used for XTS, this matches NCA headers
+
+    static void BM_AesCtrDecrypt(benchmark::State &state) {
+        std::array<u8, 0x10> key{0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+        AesCipher cipher{key, MBEDTLS_CIPHER_AES_128_CTR};
+        std::vector<u8> data(static_cast<size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            cipher.SetIV({});
+            cipher.Decrypt(data);
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<i64>(state.iterations() * data.size()));
+    }
+    BENCHMARK(BM_AesCtrDecrypt)->Arg(0x200)->Arg(0x4000)->Arg(0x100000);
+
+    static void BM_AesXtsDecrypt(benchmark::State &state) {
+        std::array<u8, 0x20> key{0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+        AesCipher cipher{key, MBEDTLS_CIPHER_AES_128_XTS};
+        std::vector<u8> data(static_cast<size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            cipher.XtsDecrypt(data, 0, SectorSize);
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<i64>(state.iterations() * data.size()));
+    }
+    BENCHMARK(BM_AesXtsDecrypt)->Arg(0x200)->Arg(0x4000)->Arg(0x100000);
+}
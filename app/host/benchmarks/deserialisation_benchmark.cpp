@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <benchmark/benchmark.h>
+#include <services/nvdrv/devices/deserialisation/deserialisation.h>
+
+namespace skyline::service::nvdrv::deserialisation {
+    /**
+     * @brief Benchmarks decoding a fixed-size IOCTL with inline input, output and padding arguments
+     */
+    static void BM_DecodeFixedArguments(benchmark::State &state) {
+        using Desc = MetaIoctlDescriptor<true, true, 0x10, 'N', 0x1>;
+        std::array<u8, Desc::Size> buffer{};
+
+        for (auto _ : state) {
+            auto arguments{DecodeArguments<Desc, In<u32>, InOut<u32>, Pad<u32>, Out<u32>>(buffer)};
+            std::get<1>(arguments) += std::get<0>(arguments);
+            std::get<2>(arguments) = std::get<1>(arguments);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()));
+    }
+    BENCHMARK(BM_DecodeFixedArguments);
+
+    /**
+     * @brief Benchmarks decoding an IOCTL with a span sized by a preceding count, this mirrors the layout of host1x channel IOCTLs
+     */
+    static void BM_DecodeSlotSizeSpan(benchmark::State &state) {
+        constexpr u32 SpanSize{8};
+        using Desc = MetaIoctlDescriptor<true, true, sizeof(u32) * 2 + sizeof(u64) * SpanSize, 'H', 0x9>;
+        std::array<u8, Desc::Size> buffer{};
+        *reinterpret_cast<u32 *>(buffer.data()) = SpanSize;
+
+        for (auto _ : state) {
+            auto arguments{DecodeArguments<Desc, Save<u32, 0>, Pad<u32>, SlotSizeSpan<u64, 0>>(buffer)};
+            for (auto &value : std::get<0>(arguments))
+                value++;
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()));
+    }
+    BENCHMARK(BM_DecodeSlotSizeSpan);
+}
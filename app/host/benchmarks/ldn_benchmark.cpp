@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <benchmark/benchmark.h>
+#include <services/ldn/ldn_types.h>
+#include <services/ldn/lan_transport.h>
+
+namespace skyline::service::ldn {
+    /**
+     * @brief A counter of received packets which the benchmark thread waits on, packets are received on the transport threads
+     */
+    class PacketCounter {
+      private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t count{};
+
+      public:
+        void Increment() {
+            {
+                std::scoped_lock lock{mutex};
+                count++;
+            }
+            condition.notify_all();
+        }
+
+        /**
+         * @brief Waits until the supplied amount of packets were received since the last wait and consumes them
+         * @return If the packets were received prior to the timeout
+         */
+        bool Wait(size_t target) {
+            std::unique_lock lock{mutex};
+            if (!condition.wait_for(lock, std::chrono::seconds{1}, [&] { return count >= target; }))
+                return false;
+            count -= target;
+            return true;
+        }
+    };
+
+    /**
+     * @brief An access point which responds to packets in the same way as LanDiscovery, it's reduced to the parts which are exchanged over the transport
+     */
+    class AccessPoint {
+      private:
+        std::mutex mutex;
+        NetworkInfo networkInfo{};
+        std::array<std::optional<Transport::Endpoint>, NodeCountMax> stationEndpoints{};
+        PacketCounter &disconnects;
+        std::unique_ptr<Transport> transport;
+
+        void SyncNetwork() {
+            std::array<Transport::Endpoint, NodeCountMax> endpoints;
+            size_t count{};
+            for (const auto &endpoint : stationEndpoints)
+                if (endpoint)
+                    endpoints[count++] = *endpoint;
+            transport->Send(span(endpoints).first(count), PacketType::SyncNetwork, span(networkInfo).cast<u8>());
+        }
+
+        void OnPacket(const Transport::Endpoint &source, PacketType type, span<u8> payload) {
+            std::scoped_lock lock{mutex};
+            auto &ldn{networkInfo.ldn};
+            switch (type) {
+                case PacketType::Scan:
+                    transport->Send(span<const Transport::Endpoint>{source}, PacketType::ScanResponse, span(networkInfo).cast<u8>());
+                    break;
+
+                case PacketType::Connect: {
+                    if (payload.size() != sizeof(NodeInfo) || ldn.nodeCount >= ldn.nodeCountMax)
+                        break;
+
+                    size_t nodeId{1};
+                    for (; nodeId < NodeCountMax && ldn.nodes[nodeId].isConnected; nodeId++);
+                    ldn.nodes[nodeId] = payload.as<NodeInfo>();
+                    ldn.nodes[nodeId].nodeId = static_cast<i8>(nodeId);
+                    ldn.nodes[nodeId].isConnected = true;
+                    ldn.nodeCount++;
+                    stationEndpoints[nodeId] = source;
+                    SyncNetwork();
+                    break;
+                }
+
+                case PacketType::Disconnect: {
+                    auto it{std::find(stationEndpoints.begin(), stationEndpoints.end(), source)};
+                    if (it == stationEndpoints.end())
+                        break;
+
+                    auto nodeId{static_cast<size_t>(std::distance(stationEndpoints.begin(), it))};
+                    it->reset();
+                    ldn.nodes[nodeId] = {};
+                    ldn.nodeCount--;
+                    SyncNetwork();
+                    disconnects.Increment();
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+      public:
+        AccessPoint(const std::shared_ptr<InProcessNetwork> &network, PacketCounter &disconnects) : disconnects{disconnects}, transport{std::make_unique<InProcessTransport>(network, [this](const Transport::Endpoint &source, PacketType type, span<u8> payload) { OnPacket(source, type, payload); })} {}
+
+        void CreateNetwork(u8 nodeCountMax) {
+            std::scoped_lock lock{mutex};
+            networkInfo = {};
+            networkInfo.common.channel = 6;
+            networkInfo.ldn.nodeCountMax = nodeCountMax;
+            networkInfo.ldn.nodeCount = 1;
+            networkInfo.ldn.nodes[0] = NodeInfo{.ipv4Address = transport->GetLocalAddress(), .isConnected = true};
+            stationEndpoints = {};
+        }
+
+        u8 GetNodeCount() {
+            std::scoped_lock lock{mutex};
+            return networkInfo.ldn.nodeCount;
+        }
+    };
+
+    /**
+     * @brief A station which scans for, connects to and disconnects from an access point in the same way as LanDiscovery
+     */
+    class Station {
+      private:
+        PacketCounter &scanResponses;
+        PacketCounter &connections;
+        std::atomic<bool> connecting{};
+        std::optional<Transport::Endpoint> accessPointEndpoint; //!< The endpoint of the access point that responded to the last scan, it's only written prior to scanResponses being incremented
+        std::unique_ptr<Transport> transport;
+
+        void OnPacket(const Transport::Endpoint &source, PacketType type, span<u8> payload) {
+            if (payload.size() != sizeof(NetworkInfo))
+                return;
+
+            if (type == PacketType::ScanResponse) {
+                accessPointEndpoint = source;
+                scanResponses.Increment();
+            } else if (type == PacketType::SyncNetwork && source == accessPointEndpoint && connecting.exchange(false)) {
+                connections.Increment();
+            }
+        }
+
+      public:
+        Station(const std::shared_ptr<InProcessNetwork> &network, PacketCounter &scanResponses, PacketCounter &connections) : scanResponses{scanResponses}, connections{connections}, transport{std::make_unique<InProcessTransport>(network, [this](const Transport::Endpoint &source, PacketType type, span<u8> payload) { OnPacket(source, type, payload); })} {}
+
+        void Scan() {
+            transport->Broadcast(PacketType::Scan, {});
+        }
+
+        void Connect() {
+            NodeInfo node{.ipv4Address = transport->GetLocalAddress()};
+            connecting = true;
+            transport->Send(span<const Transport::Endpoint>{*accessPointEndpoint}, PacketType::Connect, span(node).cast<u8>());
+        }
+
+        void Disconnect() {
+            transport->Send(span<const Transport::Endpoint>{*accessPointEndpoint}, PacketType::Disconnect, {});
+        }
+    };
+
+    /**
+     * @brief Benchmarks an entire LDN session over InProcessTransport with the argument's amount of stations, the access point creates a network which every station scans for, connects to and then disconnects from
+     * @note This doubles as a loopback test of the transport, the benchmark fails if any packet isn't delivered or the access point's view of the network is inconsistent
+     */
+    static void BM_InProcessSession(benchmark::State &state) {
+        auto stationCount{static_cast<size_t>(state.range(0))};
+        auto network{std::make_shared<InProcessNetwork>()};
+        PacketCounter scanResponses, connections, disconnects;
+        AccessPoint accessPoint{network, disconnects};
+        std::vector<std::unique_ptr<Station>> stations;
+        for (size_t index{}; index < stationCount; index++)
+            stations.emplace_back(std::make_unique<Station>(network, scanResponses, connections));
+
+        for (auto _ : state) {
+            accessPoint.CreateNetwork(static_cast<u8>(NodeCountMax));
+
+            for (auto &station : stations)
+                station->Scan();
+            if (!scanResponses.Wait(stationCount)) {
+                state.SkipWithError("Scan responses weren't received");
+                break;
+            }
+
+            for (auto &station : stations)
+                station->Connect();
+            if (!connections.Wait(stationCount) || accessPoint.GetNodeCount() != stationCount + 1) {
+                state.SkipWithError("Stations weren't connected");
+                break;
+            }
+
+            for (auto &station : stations)
+                station->Disconnect();
+            if (!disconnects.Wait(stationCount) || accessPoint.GetNodeCount() != 1) {
+                state.SkipWithError("Stations weren't disconnected");
+                break;
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * stationCount));
+    }
+    BENCHMARK(BM_InProcessSession)->Arg(1)->Arg(NodeCountMax - 1)->UseRealTime();
+
+    /**
+     * @brief Benchmarks the delivery of state synchronization packets from an access point to the argument's amount of stations, this is the most frequent packet during a session
+     */
+    static void BM_InProcessSyncNetwork(benchmark::State &state) {
+        auto stationCount{static_cast<size_t>(state.range(0))};
+        auto network{std::make_shared<InProcessNetwork>()};
+        PacketCounter received;
+        std::vector<std::unique_ptr<InProcessTransport>> stations;
+        std::vector<Transport::Endpoint> endpoints;
+        for (size_t index{}; index < stationCount; index++) {
+            auto &station{stations.emplace_back(std::make_unique<InProcessTransport>(network, [&](const Transport::Endpoint &, PacketType, span<u8>) { received.Increment(); }))};
+            endpoints.push_back({station->GetLocalAddress(), 0});
+        }
+        InProcessTransport accessPoint{network, [](const Transport::Endpoint &, PacketType, span<u8>) {}};
+
+        NetworkInfo info{};
+        for (auto _ : state) {
+            accessPoint.Send(endpoints, PacketType::SyncNetwork, span(info).cast<u8>());
+            if (!received.Wait(stationCount)) {
+                state.SkipWithError("Network state wasn't received");
+                break;
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * stationCount));
+        state.SetBytesProcessed(static_cast<i64>(state.iterations() * stationCount * sizeof(NetworkInfo)));
+    }
+    BENCHMARK(BM_InProcessSyncNetwork)->Arg(1)->Arg(NodeCountMax - 1)->UseRealTime();
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <benchmark/benchmark.h>
+#include <soc/gm20b/engines/engine.h>
+
+namespace skyline::soc::gm20b::engine {
+    /**
+     * @brief An engine which discards all method calls from macros, this isolates the cost of the interpreter
+     */
+    class NullEngine : public MacroEngineBase {
+      public:
+        u32 lastArgument{}; //!< The argument of the last method call, it's stored to keep calls from being optimised out
+
+        NullEngine(MacroState &macroState) : MacroEngineBase{macroState} {}
+
+        void CallMethodFromMacro(u32 method, u32 argument) override {
+            lastArgument = argument;
+        }
+
+        u32 ReadMethodFromMacro(u32 method) override {
+            return 0;
+        }
+
+        void FlushGpuWork() override {}
+    };
+
+    /**
+     * @brief Encodes an AddImmediate MME instruction
+     */
+    constexpr u32 AddImmediate(u8 assignment, u8 dest, u8 srcA, i32 immediate, bool exit = false) {
+        return 1 | (assignment << 4) | (static_cast<u32>(exit) << 7) | (dest << 8) | (srcA << 11) | ((static_cast<u32>(immediate) & 0x3FFFF) << 14);
+    }
+
+    /**
+     * @brief Encodes a Branch MME instruction that branches without a delay slot when the source register is non-zero
+     */
+    constexpr u32 BranchNonZero(u8 srcA, i32 offset) {
+        return 7 | (1 << 4) | (1 << 5) | (srcA << 11) | ((static_cast<u32>(offset) & 0x3FFFF) << 14);
+    }
+
+    constexpr u8 Move{1}, MoveAndSetMethod{2}, MoveAndSend{4}; //!< The assignment operations used by the benchmarked macro
+
+    /**
+     * @brief Benchmarks a macro that sends a decrementing counter to a method, the argument is the initial value of the counter
+     */
+    static void BM_MacroInterpreterLoop(benchmark::State &state) {
+        MacroState macroState;
+        constexpr std::array<u32, 6> macro{
+            AddImmediate(MoveAndSetMethod, 3, 0, 0x100), // r3 = method = 0x100
+            AddImmediate(Move, 1, 1, -1), // r1 = r1 - 1
+            AddImmediate(MoveAndSend, 4, 1, 0), // Send(r1)
+            BranchNonZero(1, -2), // Loop while r1 != 0
+            AddImmediate(Move, 0, 0, 0, true), // Exit
+            AddImmediate(Move, 0, 0, 0), // Exit delay slot
+        };
+        std::copy(macro.begin(), macro.end(), macroState.macroCode.begin());
+
+        NullEngine engine{macroState};
+        std::array<u32, 1> arguments{static_cast<u32>(state.range(0))};
+        for (auto _ : state) {
+            macroState.macroInterpreter.Execute(0, arguments, &engine);
+            benchmark::DoNotOptimize(engine.lastArgument);
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * state.range(0) * 3)); // Each loop iteration executes three instructions
+    }
+    BENCHMARK(BM_MacroInterpreterLoop)->Arg(0x10)->Arg(0x1000);
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <random>
+#include <benchmark/benchmark.h>
+#include <gpu/texture/layout.h>
+#include <gpu/texture/bc_decoder.h>
+
+namespace skyline::gpu::texture {
+    constexpr size_t GobBlockHeight{16}; //!< The GOB block height used by most render targets
+    constexpr size_t FormatBpb{4}; //!< The bytes per block of an R8G8B8A8 surface
+
+    static std::vector<u8> RandomBytes(size_t size) {
+        std::vector<u8> bytes(size);
+        std::mt19937 generator{};
+        std::generate(bytes.begin(), bytes.end(), [&] { return static_cast<u8>(generator()); });
+        return bytes;
+    }
+
+    static void BM_CopyBlockLinearToLinear(benchmark::State &state) {
+        Dimensions dimensions{static_cast<u32>(state.range(0)), static_cast<u32>(state.range(0))};
+        auto blockLinear{RandomBytes(GetBlockLinearLayerSize(dimensions, 1, 1, FormatBpb, GobBlockHeight, 1))};
+        std::vector<u8> linear(dimensions.width * dimensions.height * FormatBpb);
+
+        for (auto _ : state) {
+            CopyBlockLinearToLinear(dimensions, 1, 1, FormatBpb, GobBlockHeight, 1, blockLinear.data(), linear.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<i64>(state.iterations() * linear.size()));
+    }
+    BENCHMARK(BM_CopyBlockLinearToLinear)->Arg(256)->Arg(1280)->Arg(1920);
+
+    static void BM_CopyLinearToBlockLinear(benchmark::State &state) {
+        Dimensions dimensions{static_cast<u32>(state.range(0)), static_cast<u32>(state.range(0))};
+        std::vector<u8> blockLinear(GetBlockLinearLayerSize(dimensions, 1, 1, FormatBpb, GobBlockHeight, 1));
+        auto linear{RandomBytes(dimensions.width * dimensions.height * FormatBpb)};
+
+        for (auto _ : state) {
+            CopyLinearToBlockLinear(dimensions, 1, 1, FormatBpb, GobBlockHeight, 1, linear.data(), blockLinear.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<i64>(state.iterations() * linear.size()));
+    }
+    BENCHMARK(BM_CopyLinearToBlockLinear)->Arg(256)->Arg(1280)->Arg(1920);
+
+    static void BM_CopyBlockLinearToPitch(benchmark::State &state) {
+        Dimensions dimensions{static_cast<u32>(state.range(0)), static_cast<u32>(state.range(0))};
+        u32 pitch{util::AlignUp(dimensions.width * static_cast<u32>(FormatBpb), 64)};
+        auto blockLinear{RandomBytes(GetBlockLinearLayerSize(dimensions, 1, 1, FormatBpb, GobBlockHeight, 1))};
+        std::vector<u8> pitchBuffer(static_cast<size_t>(pitch) * dimensions.height);
+
+        for (auto _ : state) {
+            CopyBlockLinearToPitch(dimensions, 1, 1, FormatBpb, pitch, GobBlockHeight, 1, blockLinear.data(), pitchBuffer.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<i64>(state.iterations() * dimensions.width * dimensions.height * FormatBpb));
+    }
+    BENCHMARK(BM_CopyBlockLinearToPitch)->Arg(256)->Arg(1280)->Arg(1920);
+
+    /**
+     * @brief Benchmarks decoding a BCn texture of random blocks into R8G8B8A8
+     * @note Random blocks exercise every mode of the formats with multiple modes, real textures are generally dominated by a few of them
+     */
+    template<size_t BytesPerBlock, typename Decode>
+    static void BenchmarkBcDecode(benchmark::State &state, Decode decode) {
+        auto size{static_cast<size_t>(state.range(0))};
+        auto blocks{RandomBytes((size / 4) * (size / 4) * BytesPerBlock)};
+        std::vector<u8> decoded(size * size * 4);
+
+        for (auto _ : state) {
+            decode(blocks.data(), decoded.data(), size, size);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * size * size));
+    }
+
+    static void BM_DecodeBc1(benchmark::State &state) {
+        BenchmarkBcDecode<8>(state, [](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc1(src, dst, width, height, true); });
+    }
+    BENCHMARK(BM_DecodeBc1)->Arg(256)->Arg(1024);
+
+    static void BM_DecodeBc3(benchmark::State &state) {
+        BenchmarkBcDecode<16>(state, [](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc3(src, dst, width, height); });
+    }
+    BENCHMARK(BM_DecodeBc3)->Arg(256)->Arg(1024);
+
+    static void BM_DecodeBc7(benchmark::State &state) {
+        BenchmarkBcDecode<16>(state, [](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc7(src, dst, width, height); });
+    }
+    BENCHMARK(BM_DecodeBc7)->Arg(256)->Arg(1024);
+}
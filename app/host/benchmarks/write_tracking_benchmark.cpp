@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <csignal>
+#include <sys/mman.h>
+#include <benchmark/benchmark.h>
+#include <nce/write_tracker.h>
+
+namespace skyline {
+    /**
+     * @brief An anonymous mapping of the argument's amount of pages that a benchmark writes to
+     */
+    struct TrackedRegion {
+        span<u8> region;
+
+        TrackedRegion(size_t pageCount) {
+            auto size{pageCount * constant::PageSize};
+            auto data{static_cast<u8 *>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0))};
+            if (data == MAP_FAILED)
+                throw exception("Failed to map the tracked region: {}", strerror(errno));
+            region = span<u8>{data, size};
+            std::memset(data, 0, size); // All pages are populated in advance so page faults from the first touch aren't measured
+        }
+
+        ~TrackedRegion() {
+            munmap(region.data(), region.size());
+        }
+
+        /**
+         * @brief Writes to every page in the region as the guest would when updating a buffer in-place
+         */
+        void Write(u8 value) {
+            for (size_t offset{}; offset < region.size(); offset += constant::PageSize)
+                *reinterpret_cast<volatile u8 *>(region.data() + offset) = value;
+        }
+    };
+
+    static span<u8> trappedRegion; //!< The region that the SIGSEGV handler of BM_TrapWrites removes the protection from
+    static bool trappedRegionWritten;
+
+    /**
+     * @brief Benchmarks write-only mprotect traps as NCE uses them, the first write faults into a signal handler which unprotects the entire region and it's reprotected after collecting
+     * @note The first argument is the amount of pages in the region and the second is if they're written to
+     */
+    static void BM_TrapWrites(benchmark::State &state) {
+        TrackedRegion tracked{static_cast<size_t>(state.range(0))};
+        bool write{state.range(1) != 0};
+
+        trappedRegion = tracked.region;
+        struct sigaction action{}, oldAction{};
+        action.sa_flags = SA_SIGINFO;
+        action.sa_sigaction = [](int, siginfo_t *info, void *) {
+            auto address{static_cast<u8 *>(info->si_addr)};
+            if (address < trappedRegion.data() || address >= trappedRegion.end().base())
+                std::abort();
+            mprotect(trappedRegion.data(), trappedRegion.size(), PROT_READ | PROT_WRITE);
+            trappedRegionWritten = true;
+        };
+        sigaction(SIGSEGV, &action, &oldAction);
+
+        for (auto _ : state) {
+            trappedRegionWritten = false;
+            mprotect(tracked.region.data(), tracked.region.size(), PROT_READ);
+            if (write)
+                tracked.Write(1);
+            benchmark::DoNotOptimize(trappedRegionWritten);
+            if (!trappedRegionWritten)
+                mprotect(tracked.region.data(), tracked.region.size(), PROT_READ | PROT_WRITE);
+        }
+
+        sigaction(SIGSEGV, &oldAction, nullptr);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()));
+    }
+    BENCHMARK(BM_TrapWrites)->Args({1, 0})->Args({1, 1})->Args({16, 1})->Args({256, 0})->Args({256, 1});
+
+    /**
+     * @brief Benchmarks arming a region, writing to it and collecting the writes with the supplied write tracker backend
+     * @note The first argument is the amount of pages in the region and the second is if they're written to
+     */
+    static void BenchmarkWriteTracker(benchmark::State &state, nce::WriteTracker::Backend backend) {
+        auto tracker{nce::WriteTracker::Create(backend)};
+        if (!tracker) {
+            state.SkipWithError("The backend isn't supported by the host kernel");
+            return;
+        }
+
+        TrackedRegion tracked{static_cast<size_t>(state.range(0))};
+        bool write{state.range(1) != 0};
+
+        for (auto _ : state) {
+            if (!tracker->Arm(tracked.region)) {
+                state.SkipWithError("The region couldn't be armed");
+                break;
+            }
+            if (write)
+                tracked.Write(1);
+            benchmark::DoNotOptimize(tracker->IsWritten(tracked.region));
+            if (tracker->IsResetRequired())
+                tracker->Reset();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()));
+    }
+
+    static void BM_UffdWriteTracking(benchmark::State &state) {
+        BenchmarkWriteTracker(state, nce::WriteTracker::Backend::UffdWriteProtect);
+    }
+    BENCHMARK(BM_UffdWriteTracking)->Args({1, 0})->Args({1, 1})->Args({16, 1})->Args({256, 0})->Args({256, 1});
+
+    static void BM_SoftDirtyWriteTracking(benchmark::State &state) {
+        BenchmarkWriteTracker(state, nce::WriteTracker::Backend::SoftDirty);
+    }
+    BENCHMARK(BM_SoftDirtyWriteTracking)->Args({1, 0})->Args({1, 1})->Args({16, 1})->Args({256, 0})->Args({256, 1});
+}
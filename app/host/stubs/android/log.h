@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+/**
+ * @brief A stub of the Android logging API for host builds, all messages are written to stderr
+ */
+
+enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT,
+};
+
+inline int __android_log_write(int priority, const char *tag, const char *text) {
+    return std::fprintf(stderr, "%d %s: %s\n", priority, tag, text);
+}
+
+inline int __android_log_print(int priority, const char *tag, const char *format, ...) {
+    std::fprintf(stderr, "%d %s: ", priority, tag);
+    va_list arguments;
+    va_start(arguments, format);
+    int result{std::vfprintf(stderr, format, arguments)};
+    va_end(arguments);
+    std::fputc('\n', stderr);
+    return result;
+}
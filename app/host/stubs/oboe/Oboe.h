@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief A stub of the Oboe types used by the platform-independent audio code for host builds, there's no audio output on the host
+ */
+namespace oboe {
+    enum class AudioFormat : int32_t {
+        Invalid = -1,
+        Unspecified = 0,
+        I16 = 1,
+        Float = 2,
+        I24 = 3,
+        I32 = 4,
+    };
+}
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+/**
+ * @brief A stub of the Android system property API for host builds, no properties are ever set
+ */
+
+#define PROP_VALUE_MAX 92
+
+inline int __system_property_get(const char *, char *value) {
+    value[0] = '\0';
+    return 0;
+}
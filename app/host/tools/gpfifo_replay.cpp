@@ -0,0 +1,447 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cstdio>
+#include <soc/gm20b/gpfifo_capture.h>
+#include <soc/gm20b/engines/engine.h>
+
+/**
+ * @brief Replays a GPFIFO trace captured with the 'gpfifoCapture' setting, the pushbuffers are decoded and executed with the same macro interpreter and HLE macros as the emulator while guest memory is reconstructed from the captured pages
+ * @note Engines aren't emulated, every method call that would reach them (including those from macros) is listed alongside the draws performed by HLE macros
+ */
+namespace skyline::soc::gm20b::replay {
+    constexpr std::array<std::string_view, 8> SubchannelNames{"3D", "Compute", "I2M", "2D", "Copy", "SW0", "SW1", "SW2"};
+    constexpr u32 GpfifoRegisterCount{0x40}; //!< The number of GPFIFO registers, methods below this aren't sent to the subchannel's engine
+    constexpr u32 MmeInstructionRamPointer{0x45}, MmeInstructionRamLoad{0x46}, MmeStartAddressRamPointer{0x47}, MmeStartAddressRamLoad{0x48}; //!< The Maxwell 3D methods used to upload macros
+
+    /**
+     * @brief Reads the decompressed contents of an LZ4 frame compressed trace sequentially
+     */
+    class TraceReader {
+      private:
+        std::ifstream stream;
+        LZ4F_dctx *context{};
+        std::vector<u8> compressed; //!< Compressed data read from the file that hasn't been consumed yet
+        size_t compressedOffset{};
+
+      public:
+        TraceReader(const std::string &path) : stream{path, std::ios::binary}, compressed(0x10000) {
+            if (!stream)
+                throw exception("Failed to open GPFIFO trace: {}", path);
+
+            if (auto result{LZ4F_createDecompressionContext(&context, LZ4F_VERSION)}; LZ4F_isError(result))
+                throw exception("Failed to create LZ4 decompression context: {}", LZ4F_getErrorName(result));
+            compressedOffset = compressed.size();
+        }
+
+        ~TraceReader() {
+            LZ4F_freeDecompressionContext(context);
+        }
+
+        /**
+         * @brief Fills the supplied buffer with decompressed data
+         * @return If the buffer could be filled, false is only returned if the end of the trace was reached prior to any data being read
+         */
+        bool Read(span<u8> buffer) {
+            size_t read{};
+            while (read < buffer.size()) {
+                if (compressedOffset == compressed.size()) {
+                    compressed.resize(compressed.capacity());
+                    stream.read(reinterpret_cast<char *>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+                    compressed.resize(static_cast<size_t>(stream.gcount()));
+                    compressedOffset = 0;
+
+                    if (compressed.empty()) {
+                        if (read)
+                            throw exception("GPFIFO trace is truncated");
+                        return false;
+                    }
+                }
+
+                size_t dstSize{buffer.size() - read}, srcSize{compressed.size() - compressedOffset};
+                auto result{LZ4F_decompress(context, buffer.data() + read, &dstSize, compressed.data() + compressedOffset, &srcSize, nullptr)};
+                if (LZ4F_isError(result))
+                    throw exception("Failed to decompress GPFIFO trace: {}", LZ4F_getErrorName(result));
+
+                read += dstSize;
+                compressedOffset += srcSize;
+            }
+            return true;
+        }
+
+        template<typename T>
+        T Read() {
+            T object{};
+            if (!Read(span<T>{object}.template cast<u8>()))
+                throw exception("GPFIFO trace is truncated");
+            return object;
+        }
+    };
+
+    /**
+     * @brief A sparse reconstruction of the GPU address space from the memory captured in a trace, pages that were never captured read as zero
+     */
+    class GuestMemory {
+      private:
+        using Page = std::array<u8, GpfifoCapture::PageSize>;
+        std::unordered_map<u64, std::unique_ptr<Page>> pages; //!< A map from the GPU address of every captured page to its contents
+
+      public:
+        void Write(u64 address, span<const u8> data) {
+            while (!data.empty()) {
+                u64 pageAddress{util::AlignDown(address, GpfifoCapture::PageSize)}, offset{address - pageAddress};
+                size_t size{std::min(data.size(), GpfifoCapture::PageSize - offset)};
+
+                auto &page{pages[pageAddress]};
+                if (!page)
+                    page = std::make_unique<Page>();
+                std::memcpy(page->data() + offset, data.data(), size);
+
+                address += size;
+                data = data.subspan(size);
+            }
+        }
+
+        void Read(u64 address, span<u8> data) const {
+            while (!data.empty()) {
+                u64 pageAddress{util::AlignDown(address, GpfifoCapture::PageSize)}, offset{address - pageAddress};
+                size_t size{std::min(data.size(), GpfifoCapture::PageSize - offset)};
+
+                if (auto page{pages.find(pageAddress)}; page != pages.end())
+                    std::memcpy(data.data(), page->second->data() + offset, size);
+                else
+                    std::memset(data.data(), 0, size);
+
+                address += size;
+                data = data.subspan(size);
+            }
+        }
+
+        size_t Size() const {
+            return pages.size() * GpfifoCapture::PageSize;
+        }
+    };
+
+    /**
+     * @brief Counters for everything that was replayed, these are printed at the end of the replay
+     */
+    struct Statistics {
+        size_t pushBuffers{};
+        size_t methods{};
+        size_t macroMethods{}; //!< Method calls that were made by macros rather than the pushbuffer
+        size_t macroExecutions{};
+        size_t draws{};
+        size_t memoryRecords{};
+        size_t memoryBytes{};
+    };
+
+    /**
+     * @brief Stands in for the engine bound to a subchannel, method calls are stored into a register file and listed
+     */
+    class ReplayEngine : public engine::MacroEngineBase {
+      private:
+        std::string_view name;
+        Statistics &statistics;
+        bool verbose;
+
+      public:
+        std::array<u32, engine::EngineMethodsEnd> registers{};
+
+        ReplayEngine(MacroState &macroState, std::string_view name, Statistics &statistics, bool verbose) : MacroEngineBase{macroState}, name{name}, statistics{statistics}, verbose{verbose} {}
+
+        void CallMethod(u32 method, u32 argument, bool fromMacro = false) {
+            if (verbose)
+                fmt::print("    {:<7} 0x{:04X} = 0x{:08X}{}\n", name, method * sizeof(u32), argument, fromMacro ? " (Macro)" : "");
+
+            statistics.methods++;
+            if (fromMacro)
+                statistics.macroMethods++;
+
+            if (method >= registers.size()) {
+                fmt::print("    {:<7} Method 0x{:X} is out of bounds\n", name, method);
+                return;
+            }
+            registers[method] = argument;
+
+            // Only the 3D engine can upload macros but they're shared with every other engine on the channel
+            if (name != SubchannelNames[0])
+                return;
+
+            if (method == MmeInstructionRamLoad) {
+                u32 &pointer{registers[MmeInstructionRamPointer]};
+                macroState.macroCode[pointer++ % macroState.macroCode.size()] = argument;
+                pointer %= macroState.macroCode.size();
+                macroState.Invalidate();
+            } else if (method == MmeStartAddressRamLoad) {
+                u32 &pointer{registers[MmeStartAddressRamPointer]};
+                macroState.macroPositions[pointer++ % macroState.macroPositions.size()] = argument;
+                macroState.Invalidate();
+            }
+        }
+
+        void CallMethodFromMacro(u32 method, u32 argument) override {
+            CallMethod(method, argument, true);
+        }
+
+        u32 ReadMethodFromMacro(u32 method) override {
+            return method < registers.size() ? registers[method] : 0;
+        }
+
+        void DrawInstanced(bool setRegs, u32 drawTopology, u32 vertexArrayCount, u32 instanceCount, u32 vertexArrayStart, u32 globalBaseInstanceIndex) override {
+            statistics.draws++;
+            if (verbose)
+                fmt::print("    {:<7} Draw (Topology: {}, Vertices: {} @ {}, Instances: {} @ {})\n", name, drawTopology, vertexArrayCount, vertexArrayStart, instanceCount, globalBaseInstanceIndex);
+        }
+
+        void DrawIndexedInstanced(bool setRegs, u32 drawTopology, u32 indexBufferCount, u32 instanceCount, u32 globalBaseVertexIndex, u32 indexBufferFirst, u32 globalBaseInstanceIndex) override {
+            statistics.draws++;
+            if (verbose)
+                fmt::print("    {:<7} Indexed Draw (Topology: {}, Indices: {} @ {}, Base Vertex: {}, Instances: {} @ {})\n", name, drawTopology, indexBufferCount, indexBufferFirst, globalBaseVertexIndex, instanceCount, globalBaseInstanceIndex);
+        }
+
+        bool DrawIndirect(u32 drawTopology, bool indexed, u64 indirectAddress, u32 drawCount, u32 stride, u64 countAddress) override {
+            return false; // Arguments are never GPU dirty in a replay so this is never reached, the interpreter is used if it is
+        }
+
+        void FlushGpuWork() override {}
+    };
+
+    /**
+     * @brief Decodes pushbuffers in the same manner as ChannelGpfifo::Process, including methods that are split across multiple pushbuffers
+     */
+    class Replayer {
+      private:
+        MacroState macroState;
+        Statistics statistics;
+        bool verbose;
+        std::array<std::unique_ptr<ReplayEngine>, 8> engines;
+        std::array<u32, GpfifoRegisterCount> gpfifoRegisters{};
+
+        enum class SecOp : u8 {
+            Grp0UseTert = 0,
+            IncMethod = 1,
+            NonIncMethod = 3,
+            ImmdDataMethod = 4,
+            OneInc = 5,
+            EndPbSegment = 7,
+        };
+
+        /**
+         * @brief The state of a method that's split across multiple pushbuffers
+         */
+        struct {
+            u32 remaining{};
+            u32 address{};
+            u8 subchannel{};
+            SecOp secOp{};
+        } resumeState;
+
+        void Send(u32 method, u32 argument, u8 subchannel, bool lastCall) {
+            if (method < GpfifoRegisterCount) {
+                if (verbose)
+                    fmt::print("    GPFIFO  0x{:04X} = 0x{:08X}\n", method * sizeof(u32), argument);
+                gpfifoRegisters[method] = argument;
+                statistics.methods++;
+            } else if (method < engine::EngineMethodsEnd) {
+                engines[subchannel]->CallMethod(method, argument);
+            } else {
+                auto &engine{*engines[subchannel]};
+                bool starting{!((method - engine::EngineMethodsEnd) & 1)};
+                if (verbose)
+                    fmt::print("    {:<7} Macro 0x{:X} {} 0x{:08X}\n", SubchannelNames[subchannel], (method - engine::EngineMethodsEnd) / 2, starting ? "<-" : "+=", argument);
+
+                // A pending macro is executed when another is started and once all arguments of the method call were sent
+                bool pending{engine.macroInvocation.Valid()};
+                statistics.macroExecutions += (starting && pending) + (lastCall && (starting || pending));
+                engine.HandleMacroCall(method - engine::EngineMethodsEnd, MacroArgument{.raw = argument}, lastCall);
+            }
+        }
+
+        /**
+         * @brief Continues the split method in resumeState with arguments from the supplied iterator
+         */
+        void Resume(span<u32>::iterator &entry, span<u32>::iterator end) {
+            for (; entry != end && resumeState.remaining; entry++) {
+                Send(resumeState.address, *entry, resumeState.subchannel, --resumeState.remaining == 0);
+
+                if (resumeState.secOp == SecOp::IncMethod)
+                    resumeState.address++;
+                else if (resumeState.secOp == SecOp::OneInc)
+                    resumeState = {resumeState.remaining, resumeState.address + 1, resumeState.subchannel, SecOp::NonIncMethod};
+            }
+        }
+
+      public:
+        GuestMemory memory;
+
+        Replayer(bool verbose) : verbose{verbose} {
+            for (size_t index{}; index < engines.size(); index++)
+                engines[index] = std::make_unique<ReplayEngine>(macroState, SubchannelNames[index], statistics, verbose);
+        }
+
+        void ReplayPushBuffer(span<u32> pushBuffer) {
+            statistics.pushBuffers++;
+
+            auto entry{pushBuffer.begin()};
+            if (resumeState.remaining)
+                Resume(entry, pushBuffer.end());
+
+            while (entry != pushBuffer.end()) {
+                u32 header{*entry++};
+                if (!header)
+                    continue; // A NOP
+
+                u32 address{header & 0xFFF};
+                u8 subchannel{static_cast<u8>((header >> 13) & 0x7)};
+                u32 count{(header >> 16) & 0x1FFF};
+                auto secOp{static_cast<SecOp>(header >> 29)};
+
+                switch (secOp) {
+                    case SecOp::IncMethod:
+                    case SecOp::NonIncMethod:
+                    case SecOp::OneInc:
+                        resumeState = {count, address, subchannel, secOp};
+                        Resume(entry, pushBuffer.end());
+                        break;
+
+                    case SecOp::ImmdDataMethod:
+                        Send(address, count, subchannel, true);
+                        break;
+
+                    case SecOp::EndPbSegment:
+                        return;
+
+                    case SecOp::Grp0UseTert:
+                        if (((header >> 16) & 0x7) == 1)
+                            break; // Grp0SetSubDevMask is ignored by the emulator as well
+                        [[fallthrough]];
+
+                    default:
+                        throw exception("Unsupported pushbuffer method header: 0x{:08X}", header);
+                }
+            }
+        }
+
+        const Statistics &GetStatistics() {
+            statistics.memoryBytes = memory.Size();
+            return statistics;
+        }
+
+        void RecordMemory(u64 address, span<const u8> data) {
+            memory.Write(address, data);
+            statistics.memoryRecords++;
+        }
+    };
+
+    /**
+     * @brief A range of reconstructed guest memory to be written to a file after the trace has been replayed
+     */
+    struct MemoryDump {
+        u64 address;
+        u64 size;
+        std::string path;
+    };
+
+    static int Replay(const std::string &tracePath, bool verbose, const std::vector<MemoryDump> &dumps) {
+        TraceReader trace{tracePath};
+
+        auto header{trace.Read<GpfifoCapture::Header>()};
+        if (header.magic != GpfifoCapture::Magic)
+            throw exception("Not a GPFIFO trace: {}", tracePath);
+        if (header.version != GpfifoCapture::Version)
+            throw exception("Unsupported GPFIFO trace version: {} (Expected {})", header.version, GpfifoCapture::Version);
+
+        Replayer replayer{verbose};
+        std::vector<u8> payload;
+        GpfifoCapture::RecordHeader recordHeader{};
+        while (trace.Read(span<GpfifoCapture::RecordHeader>{recordHeader}.cast<u8>())) {
+            payload.resize(recordHeader.size);
+            if (!trace.Read(payload))
+                throw exception("GPFIFO trace is truncated");
+
+            double timestamp{static_cast<double>(recordHeader.timestamp) / constant::NsInMillisecond};
+            switch (recordHeader.type) {
+                case GpfifoCapture::RecordType::PushBuffer: {
+                    auto record{span(payload).as<GpfifoCapture::PushBufferRecord>()};
+                    if (verbose)
+                        fmt::print("[{:.3f}ms] Pushbuffer @ 0x{:X} ({} words)\n", timestamp, record.gpuAddress, record.size);
+                    replayer.ReplayPushBuffer(span(payload).subspan(sizeof(record), record.size * sizeof(u32)).cast<u32>());
+                    break;
+                }
+
+                case GpfifoCapture::RecordType::GmmuMappings: {
+                    auto record{span(payload).as<GpfifoCapture::GmmuMappingsRecord>()};
+                    if (verbose) {
+                        fmt::print("[{:.3f}ms] GMMU Mappings ({})\n", timestamp, record.count);
+                        for (const auto &mapping : span(payload).subspan(sizeof(record), record.count * sizeof(GpfifoCapture::GmmuMapping)).cast<GpfifoCapture::GmmuMapping>())
+                            fmt::print("    0x{:010X} - 0x{:010X}{}\n", mapping.gpuAddress, mapping.gpuAddress + mapping.size, mapping.sparse ? " (Sparse)" : "");
+                    }
+                    break;
+                }
+
+                case GpfifoCapture::RecordType::Memory: {
+                    auto record{span(payload).as<GpfifoCapture::MemoryRecord>()};
+                    if (verbose)
+                        fmt::print("[{:.3f}ms] Memory @ 0x{:010X} - 0x{:010X}\n", timestamp, record.gpuAddress, record.gpuAddress + record.size);
+                    replayer.RecordMemory(record.gpuAddress, span(payload).subspan(sizeof(record), record.size));
+                    break;
+                }
+
+                default:
+                    throw exception("Unknown GPFIFO trace record type: {}", static_cast<u32>(recordHeader.type));
+            }
+        }
+
+        for (const auto &dump : dumps) {
+            std::vector<u8> contents(dump.size);
+            replayer.memory.Read(dump.address, contents);
+
+            std::ofstream file{dump.path, std::ios::binary | std::ios::trunc};
+            if (!file)
+                throw exception("Failed to open memory dump file: {}", dump.path);
+            file.write(reinterpret_cast<const char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+        }
+
+        const auto &statistics{replayer.GetStatistics()};
+        fmt::print("Replayed {} pushbuffers with {} method calls ({} from {} macro executions) and {} HLE draws, {} memory records reconstructed {} KiB of guest memory\n", statistics.pushBuffers, statistics.methods, statistics.macroMethods, statistics.macroExecutions, statistics.draws, statistics.memoryRecords, statistics.memoryBytes / 1024);
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    using namespace skyline::soc::gm20b::replay;
+
+    std::string tracePath;
+    bool verbose{true};
+    std::vector<MemoryDump> dumps;
+    for (int index{1}; index < argc; index++) {
+        std::string_view argument{argv[index]};
+        if (argument == "-q" || argument == "--quiet") {
+            verbose = false;
+        } else if (argument == "--dump-memory" && index + 3 < argc) {
+            dumps.push_back(MemoryDump{
+                .address = std::stoull(argv[index + 1], nullptr, 0),
+                .size = std::stoull(argv[index + 2], nullptr, 0),
+                .path = argv[index + 3],
+            });
+            index += 3;
+        } else if (tracePath.empty() && !argument.starts_with('-')) {
+            tracePath = argument;
+        } else {
+            tracePath.clear();
+            break;
+        }
+    }
+
+    if (tracePath.empty()) {
+        fmt::print(stderr, "Usage: {} [--quiet] [--dump-memory <address> <size> <file>]... <trace.gpct>\n", argv[0]);
+        return 1;
+    }
+
+    try {
+        return Replay(tracePath, verbose, dumps);
+    } catch (const std::exception &e) {
+        fmt::print(stderr, "{}\n", e.what());
+        return 1;
+    }
+}
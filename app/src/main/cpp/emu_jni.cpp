@@ -10,6 +10,7 @@
 #include "skyline/common/signal.h"
 #include "skyline/common/android_settings.h"
 #include "skyline/common/trace.h"
+#include "skyline/common/perf_counters.h"
 #include "skyline/loader/loader.h"
 #include "skyline/vfs/android_asset_filesystem.h"
 #include "skyline/os.h"
@@ -80,6 +81,7 @@ extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_executeApplication(
     skyline::signal::ScopedStackBlocker stackBlocker; // We do not want anything to unwind past JNI code as there are invalid stack frames which can lead to a segmentation fault
     Fps = 0;
     AverageFrametimeMs = AverageFrametimeDeviationMs = 0.0f;
+    skyline::perf::Reset();
 
     pthread_setname_np(pthread_self(), "EmuMain");
 
@@ -189,6 +191,22 @@ extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_updatePerformanceSt
     env->SetFloatField(thiz, averageFrametimeDeviationField, AverageFrametimeDeviationMs);
 }
 
+extern "C" JNIEXPORT jlongArray Java_emu_skyline_EmulationActivity_getPerformanceCounters(JNIEnv *env, jobject) {
+    std::array<skyline::u64, skyline::perf::SnapshotSize> snapshot;
+    skyline::perf::Snapshot(snapshot);
+
+    jlongArray result{env->NewLongArray(static_cast<jsize>(snapshot.size()))};
+    env->SetLongArrayRegion(result, 0, static_cast<jsize>(snapshot.size()), reinterpret_cast<const jlong *>(snapshot.data()));
+    return result;
+}
+
+extern "C" JNIEXPORT jobjectArray Java_emu_skyline_EmulationActivity_getPerformanceCounterNames(JNIEnv *env, jobject) {
+    jobjectArray result{env->NewObjectArray(static_cast<jsize>(skyline::perf::CounterCount), env->FindClass("java/lang/String"), nullptr)};
+    for (size_t i{}; i < skyline::perf::CounterCount; i++)
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), env->NewStringUTF(skyline::perf::GetName(static_cast<skyline::perf::Counter>(i))));
+    return result;
+}
+
 extern "C" JNIEXPORT void JNICALL Java_emu_skyline_input_InputHandler_00024Companion_setController(JNIEnv *, jobject, jint index, jint type, jint partnerIndex) {
     auto input{InputWeak.lock()};
     std::lock_guard guard(input->npad.mutex);
@@ -1,11 +1,18 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <common/trace.h>
 #include "audio.h"
 
 namespace skyline::audio {
-    Audio::Audio(const DeviceState &state) : oboe::AudioStreamCallback() {
+    Audio::Audio(const DeviceState &state)
+        : oboe::AudioStreamCallback(),
+          audioTracks{std::make_unique<TrackList>()},
+          activeTracks{audioTracks.get()} {
         settings = std::shared_ptr<Settings>{state.settings};
+        outputDisabled = *settings->isAudioOutputDisabled;
+
+        releaseThread = std::thread(&Audio::ReleaseThread, this);
 
         builder.setChannelCount(constant::StereoChannelCount);
         builder.setSampleRate(constant::SampleRate);
@@ -21,13 +28,67 @@ namespace skyline::audio {
 
     Audio::~Audio() {
         outputStream->requestStop();
+
+        releaseThreadExit = true;
+        releaseSequence++;
+        releaseSequence.notify_one();
+        releaseThread.join();
+    }
+
+    void Audio::PublishTracks(std::unique_ptr<TrackList> tracks) {
+        activeTracks.store(tracks.get());
+
+        // If the callback is currently running then it might be using the previous list, we need to wait for it to exit before freeing it
+        auto epoch{callbackEpoch.load()};
+        if (epoch & 1)
+            while (callbackEpoch.load() == epoch)
+                std::this_thread::yield();
+
+        audioTracks = std::move(tracks);
+    }
+
+    void Audio::ReleaseThread() {
+        if (int result{pthread_setname_np(pthread_self(), "Sky-AudioRel")})
+            Logger::Warn("Failed to set the thread name: {}", strerror(result));
+
+        u32 sequence{};
+        u64 underrunCount{}, overrunCount{};
+        while (true) {
+            releaseSequence.wait(sequence);
+            sequence = releaseSequence.load();
+            if (releaseThreadExit)
+                return;
+
+            outputDisabled = *settings->isAudioOutputDisabled; // Settings can't be read from the callback as they're protected by a mutex
+
+            std::scoped_lock trackGuard{trackLock};
+
+            u64 newUnderrunCount{}, newOverrunCount{};
+            for (auto &track : *audioTracks) {
+                track->CheckReleasedBuffers();
+                newUnderrunCount += track->underrunCount.load(std::memory_order_relaxed);
+                newOverrunCount += track->overrunCount.load(std::memory_order_relaxed);
+            }
+
+            if (newUnderrunCount != underrunCount) {
+                underrunCount = newUnderrunCount;
+                TRACE_COUNTER("audio", perfetto::CounterTrack("Audio Underruns"), underrunCount);
+            }
+
+            if (newOverrunCount != overrunCount) {
+                overrunCount = newOverrunCount;
+                TRACE_COUNTER("audio", perfetto::CounterTrack("Audio Overruns"), overrunCount);
+            }
+        }
     }
 
     std::shared_ptr<AudioTrack> Audio::OpenTrack(u8 channelCount, u32 sampleRate, const std::function<void()> &releaseCallback) {
         std::scoped_lock trackGuard{trackLock};
 
         auto track{std::make_shared<AudioTrack>(channelCount, sampleRate, releaseCallback)};
-        audioTracks.push_back(track);
+        auto tracks{std::make_unique<TrackList>(*audioTracks)};
+        tracks->push_back(track);
+        PublishTracks(std::move(tracks));
 
         return track;
     }
@@ -35,38 +96,62 @@ namespace skyline::audio {
     void Audio::CloseTrack(std::shared_ptr<AudioTrack> &track) {
         std::scoped_lock trackGuard{trackLock};
 
-        audioTracks.erase(std::remove(audioTracks.begin(), audioTracks.end(), track), audioTracks.end());
+        auto tracks{std::make_unique<TrackList>(*audioTracks)};
+        tracks->erase(std::remove(tracks->begin(), tracks->end(), track), tracks->end());
+        PublishTracks(std::move(tracks));
     }
 
     oboe::DataCallbackResult Audio::onAudioReady(oboe::AudioStream *audioStream, void *audioData, int32_t numFrames) {
         auto destBuffer{static_cast<i16 *>(audioData)};
         auto streamSamples{static_cast<size_t>(numFrames) * static_cast<size_t>(audioStream->getChannelCount())};
         size_t writtenSamples{};
+        bool consumedSamples{};
 
-        {
-            std::scoped_lock trackGuard{trackLock};
+        callbackEpoch.fetch_add(1); // Enter the track list read-side critical section
+        bool disabled{outputDisabled.load(std::memory_order_relaxed)};
 
-            for (auto &track : audioTracks) {
-                if (track->playbackState == AudioOutState::Stopped)
-                    continue;
+        for (auto &track : *activeTracks.load()) {
+            if (track->playbackState == AudioOutState::Stopped)
+                continue;
 
-                std::scoped_lock bufferGuard{track->bufferLock};
+            track->consumerReadSize.store(streamSamples, std::memory_order_relaxed);
 
-                if (!*settings->isAudioOutputDisabled) {
-                    auto trackSamples{track->samples.Read(span(destBuffer, streamSamples), [](i16 *source, i16 *destination) {
-                        *destination = Saturate<i16, i32>(static_cast<u32>(*destination) + static_cast<u32>(*source));
-                    }, static_cast<ssize_t>(writtenSamples))};
+            size_t trackSamples{};
+            if (!disabled) {
+                trackSamples = track->samples.Read(streamSamples, [&](span<i16> samples) {
+                    // The first track is copied directly into the output buffer while any subsequent ones are mixed into it
+                    auto destination{destBuffer + trackSamples};
+                    size_t copySize{trackSamples < writtenSamples ? std::min(samples.size(), writtenSamples - trackSamples) : 0};
 
-                    writtenSamples = std::max(trackSamples, writtenSamples);
+                    for (size_t index{}; index < copySize; index++)
+                        destination[index] = Saturate<i16, i32>(static_cast<i32>(destination[index]) + static_cast<i32>(samples[index]));
+                    std::memcpy(destination + copySize, samples.data() + copySize, (samples.size() - copySize) * sizeof(i16));
 
-                    track->sampleCounter += trackSamples;
-                } else {
-                    track->sampleCounter += streamSamples;
-                }
-                track->CheckReleasedBuffers();
+                    trackSamples += samples.size();
+                });
+
+                writtenSamples = std::max(trackSamples, writtenSamples);
+            } else {
+                // Samples still need to be consumed while output is disabled to allow buffers to be released
+                trackSamples = track->samples.Read(streamSamples, [](span<i16>) {});
+            }
+
+            if (trackSamples < streamSamples && track->playbackState == AudioOutState::Started)
+                track->underrunCount.fetch_add(1, std::memory_order_relaxed);
+
+            if (trackSamples) {
+                track->sampleCounter.fetch_add(trackSamples, std::memory_order_release);
+                consumedSamples = true;
             }
         }
 
+        callbackEpoch.fetch_add(1); // Exit the read-side critical section
+
+        if (consumedSamples) {
+            releaseSequence.fetch_add(1, std::memory_order_release);
+            releaseSequence.notify_one();
+        }
+
         if (streamSamples > writtenSamples)
             memset(destBuffer + writtenSamples, 0, (streamSamples - writtenSamples) * sizeof(i16));
 
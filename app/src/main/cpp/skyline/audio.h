@@ -12,12 +12,32 @@ namespace skyline::audio {
      */
     class Audio : public oboe::AudioStreamCallback {
       private:
+        using TrackList = std::vector<std::shared_ptr<AudioTrack>>;
+
         oboe::AudioStreamBuilder builder;
         oboe::ManagedStream outputStream;
-        std::vector<std::shared_ptr<AudioTrack>> audioTracks;
-        std::mutex trackLock; //!< Synchronizes modifications to the audio tracks
+        std::unique_ptr<TrackList> audioTracks; //!< The current list of tracks, this is replaced rather than modified so the audio callback can read it without locking
+        std::atomic<TrackList *> activeTracks; //!< A pointer to the track list that the audio callback should use
+        std::atomic<u32> callbackEpoch{}; //!< Incremented on entry and exit of the audio callback, an odd value denotes that the callback may be reading a track list
+        std::mutex trackLock; //!< Synchronizes modifications to the audio tracks, this is never locked by the audio callback
+        std::atomic<bool> outputDisabled; //!< A copy of the audio output disabled setting that can be read without locking, this is refreshed by the release thread
         std::shared_ptr<Settings> settings;
 
+        std::atomic<u32> releaseSequence{}; //!< Incremented by the audio callback after consuming samples to wake the release thread
+        std::atomic<bool> releaseThreadExit{};
+        std::thread releaseThread; //!< A thread that checks for released buffers and signals them, this keeps any blocking work off the real-time audio callback
+
+        /**
+         * @brief Publishes a new track list to the audio callback and frees the previous list once the callback is guaranteed to no longer be using it
+         * @note trackLock MUST be locked when calling this
+         */
+        void PublishTracks(std::unique_ptr<TrackList> tracks);
+
+        /**
+         * @brief The entry point of the release thread, it checks all tracks for released buffers whenever the audio callback has consumed samples
+         */
+        void ReleaseThread();
+
       public:
         Audio(const DeviceState &state);
 
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "common.h"
+#include "dsp.h"
+
+namespace skyline::audio::dsp {
+    constexpr float BiquadFixedPointScale{1.0f / (1 << 14)}; //!< The scale of the Q2.14 biquad coefficients
+
+    /**
+     * @brief Runs a single sample through a transposed direct form II biquad filter
+     */
+    static float ProcessBiquadSample(float input, const std::array<float, 5> &coefficients, BiquadState &state) {
+        float output{input * coefficients[0] + state.s0};
+        state.s0 = input * coefficients[1] + output * coefficients[3] + state.s1;
+        state.s1 = input * coefficients[2] + output * coefficients[4];
+        return output;
+    }
+
+    static std::array<float, 5> ConvertBiquadCoefficients(const BiquadCoefficients &coefficients) {
+        return {
+            coefficients.b[0] * BiquadFixedPointScale,
+            coefficients.b[1] * BiquadFixedPointScale,
+            coefficients.b[2] * BiquadFixedPointScale,
+            coefficients.a[0] * BiquadFixedPointScale,
+            coefficients.a[1] * BiquadFixedPointScale,
+        };
+    }
+
+    void ApplyBiquadFilter(span<i16> samples, const BiquadCoefficients &coefficients, span<BiquadState> states) {
+        auto floatCoefficients{ConvertBiquadCoefficients(coefficients)};
+        size_t channelCount{states.size()};
+
+        for (size_t index{}; index < samples.size(); index++)
+            samples[index] = Saturate<i16, float>(ProcessBiquadSample(samples[index], floatCoefficients, states[index % channelCount]));
+    }
+
+    void ApplyBiquadFilter(span<i32> samples, u8 channelCount, u8 inputChannel, u8 outputChannel, const BiquadCoefficients &coefficients, BiquadState &state) {
+        auto floatCoefficients{ConvertBiquadCoefficients(coefficients)};
+
+        for (size_t frame{}; frame + channelCount <= samples.size(); frame += channelCount)
+            samples[frame + outputChannel] = static_cast<i32>(ProcessBiquadSample(static_cast<float>(samples[frame + inputChannel]), floatCoefficients, state));
+    }
+
+    void MixWithVolumeRamp(span<i32> destination, span<i16> source, u8 channelCount, float volume, float volumeStep) {
+        size_t sampleCount{std::min(destination.size(), source.size())};
+        size_t index{};
+
+        #if defined(__ARM_NEON) || defined(__SSE2__)
+        if (channelCount == constant::StereoChannelCount) {
+            // Each vector covers two stereo frames, the volume of the second frame is one step ahead of the first
+            #if defined(__ARM_NEON)
+            float32x4_t volumes{volume, volume, volume + volumeStep, volume + volumeStep};
+            float32x4_t volumeIncrement{vdupq_n_f32(volumeStep * 2)};
+
+            for (; index + 4 <= sampleCount; index += 4) {
+                float32x4_t input{vcvtq_f32_s32(vmovl_s16(vld1_s16(source.data() + index)))};
+                int32x4_t mixed{vaddq_s32(vld1q_s32(destination.data() + index), vcvtq_s32_f32(vmulq_f32(input, volumes)))};
+                vst1q_s32(destination.data() + index, mixed);
+                volumes = vaddq_f32(volumes, volumeIncrement);
+            }
+            #else
+            __m128 volumes{_mm_setr_ps(volume, volume, volume + volumeStep, volume + volumeStep)};
+            __m128 volumeIncrement{_mm_set1_ps(volumeStep * 2)};
+
+            for (; index + 4 <= sampleCount; index += 4) {
+                __m128i input16{_mm_loadl_epi64(reinterpret_cast<const __m128i *>(source.data() + index))};
+                __m128 input{_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(input16, input16), 16))};
+                auto destinationPointer{reinterpret_cast<__m128i *>(destination.data() + index)};
+                _mm_storeu_si128(destinationPointer, _mm_add_epi32(_mm_loadu_si128(destinationPointer), _mm_cvttps_epi32(_mm_mul_ps(input, volumes))));
+                volumes = _mm_add_ps(volumes, volumeIncrement);
+            }
+            #endif
+
+            volume += volumeStep * static_cast<float>(index / channelCount);
+        }
+        #endif
+
+        // Handles any trailing frames along with channel layouts that don't have a vectorized path
+        for (; index < sampleCount; index++) {
+            destination[index] += static_cast<i32>(source[index] * volume);
+            if ((index + 1) % channelCount == 0)
+                volume += volumeStep;
+        }
+    }
+
+    void MixChannel(span<i32> samples, u8 channelCount, u8 inputChannel, u8 outputChannel, float volume) {
+        for (size_t frame{}; frame + channelCount <= samples.size(); frame += channelCount)
+            samples[frame + outputChannel] += static_cast<i32>(static_cast<float>(samples[frame + inputChannel]) * volume);
+    }
+
+    void SaturateMix(span<i16> destination, span<i32> source) {
+        size_t sampleCount{std::min(destination.size(), source.size())};
+        size_t index{};
+
+        #if defined(__ARM_NEON)
+        for (; index + 8 <= sampleCount; index += 8) {
+            int16x8_t narrowed{vcombine_s16(vqmovn_s32(vld1q_s32(source.data() + index)), vqmovn_s32(vld1q_s32(source.data() + index + 4)))};
+            vst1q_s16(destination.data() + index, narrowed);
+        }
+        #elif defined(__SSE2__)
+        for (; index + 8 <= sampleCount; index += 8) {
+            __m128i low{_mm_loadu_si128(reinterpret_cast<const __m128i *>(source.data() + index))};
+            __m128i high{_mm_loadu_si128(reinterpret_cast<const __m128i *>(source.data() + index + 4))};
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination.data() + index), _mm_packs_epi32(low, high));
+        }
+        #endif
+
+        for (; index < sampleCount; index++)
+            destination[index] = Saturate<i16, i32>(source[index]);
+    }
+}
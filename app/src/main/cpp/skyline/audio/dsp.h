@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::audio::dsp {
+    /**
+     * @brief The coefficients of a biquad filter in the Q2.14 fixed point format used by audren
+     */
+    struct BiquadCoefficients {
+        std::array<i16, 3> b; //!< The feed-forward coefficients
+        std::array<i16, 2> a; //!< The feedback coefficients
+    };
+
+    /**
+     * @brief The delay line state of a single channel of a transposed direct form II biquad filter
+     */
+    struct BiquadState {
+        float s0{};
+        float s1{};
+    };
+
+    /**
+     * @brief Applies a biquad filter to all channels of an interleaved buffer of I16 PCM samples
+     * @param states The filter state for each channel of the buffer, this is carried over between calls
+     */
+    void ApplyBiquadFilter(span<i16> samples, const BiquadCoefficients &coefficients, span<BiquadState> states);
+
+    /**
+     * @brief Filters a single channel of an interleaved 32-bit mix buffer into another channel, which may be the same as the input
+     */
+    void ApplyBiquadFilter(span<i32> samples, u8 channelCount, u8 inputChannel, u8 outputChannel, const BiquadCoefficients &coefficients, BiquadState &state);
+
+    /**
+     * @brief Accumulates interleaved I16 PCM samples into a 32-bit mix buffer while linearly ramping the volume
+     * @param channelCount The amount of channels in both buffers, the volume is stepped once per frame
+     * @param volume The volume applied to the first frame
+     * @param volumeStep The amount the volume changes by with every frame
+     */
+    void MixWithVolumeRamp(span<i32> destination, span<i16> source, u8 channelCount, float volume, float volumeStep);
+
+    /**
+     * @brief Scales a single channel of an interleaved 32-bit mix buffer and accumulates it into another channel
+     */
+    void MixChannel(span<i32> samples, u8 channelCount, u8 inputChannel, u8 outputChannel, float volume);
+
+    /**
+     * @brief Narrows a 32-bit mix buffer down to I16 PCM with saturation
+     */
+    void SaturateMix(span<i16> destination, span<i32> source);
+}
@@ -1,18 +1,24 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "common.h"
 #include "resampler.h"
 
 namespace skyline::audio {
     /**
      * @brief The coefficients for each index of a single output frame
+     * @note These are stored as I16 so an entry can be directly loaded as a vector of all four taps
      */
     struct LutEntry {
-        i32 a;
-        i32 b;
-        i32 c;
-        i32 d;
+        i16 a;
+        i16 b;
+        i16 c;
+        i16 d;
     };
 
     // @fmt:off
@@ -119,11 +125,64 @@ namespace skyline::audio {
         {-42, 3751, 26253, 2811},   {-38, 3608, 26270, 2936},   {-34, 3467, 26281, 3064},   {-32, 3329, 26287, 3195}}};
     // @fmt:on
 
-    std::vector<i16> Resampler::ResampleBuffer(span<i16> inputBuffer, double ratio, u8 channelCount) {
-        auto step{static_cast<u32>(ratio * 0x8000)};
-        auto outputSize{static_cast<size_t>(inputBuffer.size() / ratio)};
-        std::vector<i16> outputBuffer(outputSize);
+    /**
+     * @brief Filters a single output frame from the four consecutive interleaved input frames starting at `input`
+     */
+    static void ResampleFrame(const i16 *input, i16 *output, const LutEntry &lut, u8 channelCount) {
+        #if defined(__aarch64__)
+        if (channelCount == constant::StereoChannelCount) {
+            int16x4x2_t frames{vld2_s16(input)}; // Deinterleaves the four frames into left and right vectors
+            int16x4_t taps{vld1_s16(&lut.a)};
+            output[0] = Saturate<i16, i32>(vaddvq_s32(vmull_s16(frames.val[0], taps)) >> 15);
+            output[1] = Saturate<i16, i32>(vaddvq_s32(vmull_s16(frames.val[1], taps)) >> 15);
+            return;
+        }
+        #elif defined(__SSE2__)
+        if (channelCount == constant::StereoChannelCount) {
+            // Reorder L0 R0 L1 R1 L2 R2 L3 R3 into L0 L1 L2 L3 R0 R1 R2 R3 so each channel can be multiplied against the taps in one step
+            __m128i frames{_mm_loadu_si128(reinterpret_cast<const __m128i *>(input))};
+            frames = _mm_shufflehi_epi16(_mm_shufflelo_epi16(frames, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+            frames = _mm_shuffle_epi32(frames, _MM_SHUFFLE(3, 1, 2, 0));
+
+            __m128i products{_mm_madd_epi16(frames, _mm_setr_epi16(lut.a, lut.b, lut.c, lut.d, lut.a, lut.b, lut.c, lut.d))};
+            __m128i sums{_mm_add_epi32(products, _mm_shuffle_epi32(products, _MM_SHUFFLE(2, 3, 0, 1)))};
+            output[0] = Saturate<i16, i32>(_mm_cvtsi128_si32(sums) >> 15);
+            output[1] = Saturate<i16, i32>(_mm_cvtsi128_si32(_mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 2, 2, 2))) >> 15);
+            return;
+        }
+        #endif
+
+        for (u8 channel{}; channel < channelCount; channel++) {
+            i32 data{input[0 * channelCount + channel] * lut.a +
+                     input[1 * channelCount + channel] * lut.b +
+                     input[2 * channelCount + channel] * lut.c +
+                     input[3 * channelCount + channel] * lut.d};
+            output[channel] = Saturate<i16, i32>(data >> 15);
+        }
+    }
 
+    void Resampler::RetainHistory(span<i16> input, u8 channelCount) {
+        size_t inputFrames{input.size() / channelCount};
+        std::array<i16, HistoryFrames * constant::SurroundChannelCount> newHistory{};
+        for (size_t frame{}; frame < HistoryFrames; frame++) {
+            size_t streamFrame{inputFrames + frame};
+            const i16 *source{streamFrame < HistoryFrames ? &history[streamFrame * channelCount] : &input[(streamFrame - HistoryFrames) * channelCount]};
+            std::copy_n(source, channelCount, &newHistory[frame * channelCount]);
+        }
+        history = newHistory;
+    }
+
+    size_t Resampler::GetMaxOutputSize(size_t inputSize, double ratio, u8 channelCount) {
+        auto step{std::max(static_cast<u32>(ratio * 0x8000), 1U)};
+        size_t inputFrames{inputSize / channelCount};
+        return (((inputFrames + HistoryFrames) * 0x8000) / step + 1) * channelCount;
+    }
+
+    size_t Resampler::Process(span<i16> input, span<i16> output, double ratio, u8 channelCount) {
+        if (channelCount > constant::SurroundChannelCount)
+            throw exception("Unsupported resampler channel count: {}", channelCount);
+
+        auto step{std::max(static_cast<u32>(ratio * 0x8000), 1U)};
         const std::array<LutEntry, 128> &lut = [step] {
             if (step > 0xAAAA)
                 return CurveLut0;
@@ -133,26 +192,57 @@ namespace skyline::audio {
                 return CurveLut2;
         }();
 
-        for (size_t outIndex{}, inIndex{}; outIndex < outputSize; outIndex += channelCount) {
-            u32 lutIndex{fraction >> 8};
-
-            for (u8 channel{}; channel < channelCount; channel++) {
-                if (((inIndex + 3) * channelCount + channel) >= inputBuffer.size())
-                    continue;
+        size_t inputFrames{input.size() / channelCount};
+        size_t streamFrames{HistoryFrames + inputFrames}; //!< The amount of frames in the history followed by the input
+        size_t outIndex{};
 
-                i32 data{inputBuffer[(inIndex + 0) * channelCount + channel] * lut[lutIndex].a +
-                         inputBuffer[(inIndex + 1) * channelCount + channel] * lut[lutIndex].b +
-                         inputBuffer[(inIndex + 2) * channelCount + channel] * lut[lutIndex].c +
-                         inputBuffer[(inIndex + 3) * channelCount + channel] * lut[lutIndex].d};
+        auto advance{[&]() {
+            u32 newOffset{fraction + step};
+            frameOffset += newOffset >> 15;
+            fraction = newOffset & 0x7FFF;
+            outIndex += channelCount;
+        }};
 
-                outputBuffer[outIndex + channel] = Saturate<i16, i32>(data >> 15);
+        // Output frames with taps that overlap the history need to be gathered into a contiguous buffer first
+        std::array<i16, (HistoryFrames + 1) * constant::SurroundChannelCount> straddlingFrames;
+        while (frameOffset < HistoryFrames && frameOffset + HistoryFrames < streamFrames && outIndex + channelCount <= output.size()) {
+            for (size_t frame{}; frame <= HistoryFrames; frame++) {
+                size_t streamFrame{frameOffset + frame};
+                const i16 *source{streamFrame < HistoryFrames ? &history[streamFrame * channelCount] : &input[(streamFrame - HistoryFrames) * channelCount]};
+                std::copy_n(source, channelCount, &straddlingFrames[frame * channelCount]);
             }
 
-            u32 newOffset{fraction + step};
-            inIndex += newOffset >> 15;
-            fraction = newOffset & 0x7FFF;
+            ResampleFrame(straddlingFrames.data(), &output[outIndex], lut[fraction >> 8], channelCount);
+            advance();
         }
 
-        return outputBuffer;
+        while (frameOffset + HistoryFrames < streamFrames && outIndex + channelCount <= output.size()) {
+            ResampleFrame(&input[(frameOffset - HistoryFrames) * channelCount], &output[outIndex], lut[fraction >> 8], channelCount);
+            advance();
+        }
+
+        RetainHistory(input, channelCount);
+
+        // If the output buffer was too small then the remaining output is dropped to ensure all input is consumed
+        frameOffset = std::max(frameOffset, inputFrames) - inputFrames;
+
+        return outIndex;
+    }
+
+    void Resampler::Passthrough(span<i16> input, u8 channelCount) {
+        if (channelCount > constant::SurroundChannelCount)
+            throw exception("Unsupported resampler channel count: {}", channelCount);
+
+        RetainHistory(input, channelCount);
+
+        // An output frame at a fraction of zero is centred on the second of its four taps, the next one is positioned so that it lands on the first frame of the next input
+        fraction = 0;
+        frameOffset = HistoryFrames - 1;
+    }
+
+    void Resampler::Reset() {
+        fraction = 0;
+        frameOffset = 0;
+        history = {};
     }
 }
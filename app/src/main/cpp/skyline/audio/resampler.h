@@ -4,22 +4,49 @@
 #pragma once
 
 #include <common.h>
+#include "common.h"
 
 namespace skyline::audio {
     /**
-     * @brief The Resampler class handles resampling audio PCM data
+     * @brief The Resampler class handles streaming resampling of audio PCM data using a 4-tap polyphase filter
+     * @note The trailing input frames of every call are retained so consecutive buffers are filtered as a continuous stream, the ratio may change between calls
      */
     class Resampler {
       private:
-        u32 fraction{}; //!< The fractional value used for storing the resamplers last frame
+        static constexpr size_t HistoryFrames{3}; //!< The amount of frames carried over between calls, one less than the amount of filter taps
+
+        u32 fraction{}; //!< The fractional position of the next output frame between two input frames in Q0.15
+        size_t frameOffset{}; //!< The integer position of the next output frame relative to the start of the history
+        std::array<i16, HistoryFrames * constant::SurroundChannelCount> history{}; //!< The last input frames of the previous call
+
+        /**
+         * @brief Replaces the history with the last frames of the stream formed by the current history followed by the supplied input
+         */
+        void RetainHistory(span<i16> input, u8 channelCount);
 
       public:
         /**
-         * @brief Resamples the given sample buffer by the given ratio
-         * @param inputBuffer A buffer containing PCM sample data
-         * @param ratio The conversion ratio needed
-         * @param channelCount The amount of channels the buffer contains
+         * @return The maximum amount of samples that `Process` can output for an input buffer of the given size
+         */
+        static size_t GetMaxOutputSize(size_t inputSize, double ratio, u8 channelCount);
+
+        /**
+         * @brief Resamples the supplied input buffer by the given ratio, the entire input buffer is always consumed
+         * @param output The buffer to write resampled samples into, it should be at least `GetMaxOutputSize` samples large or the remaining output will be dropped
+         * @param ratio The ratio of the input sample rate to the output sample rate
+         * @param channelCount The amount of interleaved channels both buffers contain
+         * @return The amount of samples written to the output buffer
+         */
+        size_t Process(span<i16> input, span<i16> output, double ratio, u8 channelCount);
+
+        /**
+         * @brief Records an input buffer that was output without being resampled, so a subsequent call to `Process` continues the stream from it without a discontinuity
+         */
+        void Passthrough(span<i16> input, u8 channelCount);
+
+        /**
+         * @brief Clears all carried over state so the next call starts a new stream
          */
-        std::vector<i16> ResampleBuffer(span <i16> inputBuffer, double ratio, u8 channelCount);
+        void Reset();
     };
 }
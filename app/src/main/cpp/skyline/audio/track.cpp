@@ -55,33 +55,101 @@ namespace skyline::audio {
         return bufferIds;
     }
 
+    void AudioTrack::MeasureDrift(size_t appendedSize) {
+        if (playbackState != AudioOutState::Started) {
+            driftWindowStart = 0;
+            return;
+        }
+
+        auto now{util::GetTimeNs()};
+        auto consumed{sampleCounter.load(std::memory_order_acquire)};
+        auto underruns{underrunCount.load(std::memory_order_relaxed)};
+        if (driftWindowStart == 0 || now - driftWindowStart >= DriftMeasurementWindow) {
+            if (driftWindowStart != 0 && underruns == driftWindowUnderrunStart && consumed != driftWindowConsumedStart) {
+                // The consumer reads at the rate of the output stream clock while the guest appends at the rate of its own clock, the ratio of the two over a long enough window is the drift between them
+                // Measurements beyond the maximum adjustment can't be drift, they're caused by the guest appending in bursts (such as when prefilling buffers) and are discarded
+                auto measuredRatio{static_cast<double>(driftWindowProduced) / static_cast<double>(consumed - driftWindowConsumedStart)};
+                if (std::abs(measuredRatio - 1.0) <= MaxRateAdjustment)
+                    measuredDriftRatio += (measuredRatio - measuredDriftRatio) * DriftSmoothing;
+            }
+
+            driftWindowStart = now;
+            driftWindowProduced = 0;
+            driftWindowConsumedStart = consumed;
+            driftWindowUnderrunStart = underruns;
+        }
+
+        driftWindowProduced += appendedSize;
+    }
+
+    double AudioTrack::GetDriftCorrectionRatio(size_t appendedSize) {
+        auto readSize{consumerReadSize.load(std::memory_order_relaxed)};
+        if (appendedSize == 0 || readSize == 0)
+            return 1.0;
+
+        // The fill level is measured against what the consumer needs to not underrun: the buffer being appended and a few reads by the consumer on top of it
+        // The error is smoothed as the consumer reads in bursts which makes the instantaneous fill level oscillate by up to a read on every append
+        auto playedSamples{sampleCounter.load(std::memory_order_acquire)};
+        auto queuedSamples{(identifiers.empty() || identifiers.front().finalSample <= playedSamples) ? 0.0 : static_cast<double>(identifiers.front().finalSample - playedSamples)};
+        auto targetSamples{static_cast<double>(appendedSize + (TargetConsumerReads * readSize))};
+        auto fillError{std::clamp((queuedSamples - targetSamples) / targetSamples, -1.0, 1.0)};
+        smoothedFillError += (fillError - smoothedFillError) * ErrorSmoothing;
+
+        // The measured drift does the bulk of the correction, the PI controller only pulls the fill level back to the target and corrects any residual drift
+        integralFillError = std::clamp(integralFillError + (smoothedFillError * IntegralGain), -FillCorrectionMax, FillCorrectionMax);
+        auto fillCorrection{std::clamp((smoothedFillError * ProportionalGain) + integralFillError, -FillCorrectionMax, FillCorrectionMax)};
+
+        auto maxAdjustment{std::min(MaxRateAdjustment, std::abs(measuredDriftRatio - 1.0) + FillCorrectionMax)};
+        auto ratio{std::clamp(measuredDriftRatio + fillCorrection, 1.0 - maxAdjustment, 1.0 + maxAdjustment)};
+        return (std::abs(ratio - 1.0) < BypassThreshold) ? 1.0 : ratio;
+    }
+
     void AudioTrack::AppendBuffer(u64 tag, span<i16> buffer) {
         std::scoped_lock lock(bufferLock);
 
-        size_t size{(channelCount == constant::SurroundChannelCount) ? (buffer.size() / sizeof(Surround51Sample)) * sizeof(StereoSample) : buffer.size()};
+        std::vector<StereoSample> stereoBuffer;
+        if (channelCount == constant::SurroundChannelCount) {
+            stereoBuffer = DownMix(buffer.cast<Surround51Sample>());
+            buffer = span(stereoBuffer).cast<i16>();
+        }
+
+        MeasureDrift(buffer.size());
+        auto ratio{GetDriftCorrectionRatio(buffer.size())};
+        if (ratio == 1.0) {
+            // The resampler is bypassed when there's no drift to correct, the passthrough samples are still fed into its history so it resumes without a discontinuity
+            driftResampler.Passthrough(buffer, constant::StereoChannelCount);
+        } else {
+            resampledBuffer.resize(Resampler::GetMaxOutputSize(buffer.size(), ratio, constant::StereoChannelCount));
+            resampledBuffer.resize(driftResampler.Process(buffer, resampledBuffer, ratio, constant::StereoChannelCount));
+            buffer = resampledBuffer;
+        }
+
+        // Samples that don't fit into the sample buffer are dropped and excluded from the buffer's extent so it's still released correctly
+        auto appendedSize{samples.Append(buffer)};
+        if (appendedSize != buffer.size())
+            overrunCount.fetch_add(1, std::memory_order_relaxed);
+
         BufferIdentifier identifier{
             .released = false,
             .tag = tag,
-            .finalSample = identifiers.empty() ? size : (size + identifiers.front().finalSample)
+            .finalSample = identifiers.empty() ? appendedSize : (appendedSize + identifiers.front().finalSample)
         };
 
         identifiers.push_front(identifier);
-
-        if (channelCount == constant::SurroundChannelCount) {
-            auto stereoBuffer{DownMix(buffer.cast<Surround51Sample>())};
-            samples.Append(span(stereoBuffer).cast<i16>());
-        } else {
-            samples.Append(buffer);
-        }
     }
 
     void AudioTrack::CheckReleasedBuffers() {
         bool anyReleased{};
 
-        for (auto &identifier : identifiers) {
-            if (identifier.finalSample <= sampleCounter && !identifier.released) {
-                anyReleased = true;
-                identifier.released = true;
+        {
+            std::scoped_lock lock{bufferLock};
+
+            auto playedSamples{sampleCounter.load(std::memory_order_acquire)};
+            for (auto &identifier : identifiers) {
+                if (identifier.finalSample <= playedSamples && !identifier.released) {
+                    anyReleased = true;
+                    identifier.released = true;
+                }
             }
         }
 
@@ -7,6 +7,7 @@
 #include <kernel/types/KEvent.h>
 #include <common/circular_buffer.h>
 #include "common.h"
+#include "resampler.h"
 
 namespace skyline::audio {
     /**
@@ -14,18 +15,53 @@ namespace skyline::audio {
      */
     class AudioTrack {
       private:
+        static constexpr double MaxRateAdjustment{0.005}; //!< The maximum deviation from the nominal playback rate, this is far beyond the drift between any two real clocks
+        static constexpr double FillCorrectionMax{0.001}; //!< The maximum deviation from the measured drift that is used to pull the fill level back to the target
+        static constexpr double ProportionalGain{0.0005}; //!< The rate adjustment for a fill level error equal to the target fill level
+        static constexpr double IntegralGain{0.000005}; //!< The rate adjustment accumulated per append for a smoothed fill level error equal to the target fill level
+        static constexpr double ErrorSmoothing{0.05}; //!< The weight of every new fill level measurement in the smoothed error, this filters out the jitter from the consumer reading in bursts
+        static constexpr double BypassThreshold{0.0001}; //!< Rate adjustments smaller than this are inaudible and aren't worth resampling for, the resampler is bypassed instead
+        static constexpr size_t TargetConsumerReads{2}; //!< The amount of reads by the consumer that should be buffered on top of an appended buffer
+        static constexpr i64 DriftMeasurementWindow{2 * constant::NsInSecond}; //!< The duration over which the producer and consumer rates are compared to measure the drift
+        static constexpr double DriftSmoothing{0.25}; //!< The weight of every new drift measurement in the measured drift ratio
+
         std::function<void()> releaseCallback; //!< Callback called when a buffer has been played
         std::deque<BufferIdentifier> identifiers; //!< Queue of all appended buffer identifiers
+        Resampler driftResampler; //!< Resamples appended buffers at a rate adjusted for the drift between the guest and the output stream clock
+        std::vector<i16> resampledBuffer; //!< A scratch buffer reused for the output of the drift resampler
+
+        double smoothedFillError{}; //!< The smoothed deviation of the fill level from the target relative to the target
+        double integralFillError{}; //!< The accumulated rate adjustment of the integral term of the drift controller
+        double measuredDriftRatio{1.0}; //!< The ratio of the producer rate to the consumer rate measured over the last window
+        i64 driftWindowStart{}; //!< The time at which the current drift measurement window started
+        u64 driftWindowProduced{}; //!< The amount of samples appended by the guest during the current drift measurement window
+        u64 driftWindowConsumedStart{}; //!< The value of sampleCounter at the start of the current drift measurement window
+        u64 driftWindowUnderrunStart{}; //!< The value of underrunCount at the start of the current drift measurement window, a window with underruns doesn't reflect the consumer rate
 
         u8 channelCount;
         u32 sampleRate;
 
+        /**
+         * @brief Updates the measured drift between the producer and the consumer with a newly appended buffer
+         * @note bufferLock MUST be locked when calling this
+         */
+        void MeasureDrift(size_t appendedSize);
+
+        /**
+         * @return The rate to consume appended samples at relative to the nominal rate, this is based on the measured drift and how many samples are queued compared to the target
+         * @note bufferLock MUST be locked when calling this
+         */
+        double GetDriftCorrectionRatio(size_t appendedSize);
+
       public:
-        CircularBuffer<i16, constant::SampleRate * constant::StereoChannelCount * 10> samples; //!< A circular buffer with all appended audio samples
-        std::mutex bufferLock; //!< Synchronizes appending to audio buffers
+        CircularBuffer<i16, 1 << 20> samples; //!< A circular buffer with all appended audio samples (~10 seconds of stereo audio), this is read from the audio callback without any locking
+        std::mutex bufferLock; //!< Synchronizes appending to audio buffers and access to buffer identifiers, this is never locked by the audio callback
 
-        AudioOutState playbackState{AudioOutState::Stopped}; //!< The current state of playback
-        u64 sampleCounter{}; //!< A counter used for tracking when buffers have been played and can be released
+        std::atomic<AudioOutState> playbackState{AudioOutState::Stopped}; //!< The current state of playback
+        std::atomic<u64> sampleCounter{}; //!< A counter used for tracking when buffers have been played and can be released
+        std::atomic<size_t> consumerReadSize{}; //!< The amount of samples requested by the last read of the audio callback
+        std::atomic<u64> underrunCount{}; //!< The amount of times the audio callback requested more samples than were available while playing
+        std::atomic<u64> overrunCount{}; //!< The amount of times appended samples were dropped due to the sample buffer being full
 
         /**
          * @param channelCount The amount channels that will be present in the track
@@ -69,7 +105,7 @@ namespace skyline::audio {
 
         /**
          * @brief Checks if any buffers have been released and calls the appropriate callback for them
-         * @note bufferLock MUST be locked when calling this
+         * @note This must not be called from the audio callback as it locks bufferLock and the release callback may block
          */
         void CheckReleasedBuffers();
     };
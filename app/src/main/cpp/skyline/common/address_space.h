@@ -109,6 +109,8 @@ namespace skyline {
         static constexpr size_t AddressSpaceSize{1ULL << AddressSpaceBits};
         SegmentTable<SegmentTableEntry, AddressSpaceSize, VaGranularityBits, VaL2GranularityBits> blockSegmentTable; //!< A page table of all buffer mappings for O(1) lookups on full matches
 
+        u64 mappingGeneration{}; //!< Incremented on every change to the mappings, this allows consumers to cheaply detect when any mappings they've recorded are stale
+
         TranslatedAddressRange TranslateRangeImpl(VaType virt, VaType size, std::function<void(span<u8>)> cpuAccessCallback = {});
 
         std::pair<span<u8>, size_t> LookupBlockLocked(VaType virt, std::function<void(span<u8>)> cpuAccessCallback = {}) {
@@ -251,12 +253,31 @@ namespace skyline {
             std::scoped_lock lock(this->blockMutex);
             blockSegmentTable.Set(virt, virt + size, {virt, phys, size, extraInfo});
             this->MapLocked(virt, phys, size, extraInfo);
+            mappingGeneration++;
         }
 
         void Unmap(VaType virt, VaType size) {
             std::scoped_lock lock(this->blockMutex);
             blockSegmentTable.Set(virt, virt + size, {});
             this->UnmapLocked(virt, size);
+            mappingGeneration++;
+        }
+
+        u64 GetMappingGeneration() {
+            std::shared_lock lock(this->blockMutex);
+            return mappingGeneration;
+        }
+
+        /**
+         * @brief Calls the supplied function with the VA, size and sparseness of every mapped block in the AS
+         * @return The generation of the mappings that were enumerated
+         */
+        u64 ForEachMapping(const std::function<void(VaType virt, VaType size, bool sparse)> &callback) {
+            std::shared_lock lock(this->blockMutex);
+            for (auto it{this->blocks.begin()}; it != this->blocks.end() && std::next(it) != this->blocks.end(); it++)
+                if (it->Mapped() || it->extraInfo.sparseMapped)
+                    callback(it->virt, std::next(it)->virt - it->virt, it->extraInfo.sparseMapped);
+            return mappingGeneration;
         }
     };
 
@@ -37,8 +37,13 @@ namespace skyline {
             systemLanguage = ktSettings.GetInt<skyline::language::SystemLanguage>("systemLanguage");
             systemRegion = ktSettings.GetInt<skyline::region::RegionCode>("systemRegion");
             internetEnabled = ktSettings.GetBool("internetEnabled");
+            enableHugePages = ktSettings.GetBool("enableHugePages");
+            prefaultGuestMemory = ktSettings.GetBool("prefaultGuestMemory");
             forceTripleBuffering = ktSettings.GetBool("forceTripleBuffering");
+            frameLatency = ktSettings.GetInt<u32>("frameLatency");
             disableFrameThrottling = ktSettings.GetBool("disableFrameThrottling");
+            enableFramePacing = ktSettings.GetBool("enableFramePacing");
+            resolutionScale = ktSettings.GetInt<u32>("resolutionScale");
             gpuDriver = ktSettings.GetString("gpuDriver");
             gpuDriverLibraryName = ktSettings.GetString("gpuDriverLibraryName");
             executorSlotCountScale = ktSettings.GetInt<u32>("executorSlotCountScale");
@@ -53,6 +58,7 @@ namespace skyline {
             disableSubgroupShuffle = ktSettings.GetBool("disableSubgroupShuffle");
             isAudioOutputDisabled = ktSettings.GetBool("isAudioOutputDisabled");
             validationLayer = ktSettings.GetBool("validationLayer");
+            gpfifoCapture = ktSettings.GetBool("gpfifoCapture");
         };
     };
 }
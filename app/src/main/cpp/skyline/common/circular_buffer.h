@@ -7,140 +7,66 @@
 
 namespace skyline {
     /**
-     * @brief An abstraction of an array into a circular buffer
+     * @brief A wait-free single-producer single-consumer abstraction of an array into a circular buffer
      * @tparam Type The type of elements stored in the buffer
-     * @tparam Size The maximum size of the circular buffer
+     * @tparam Size The maximum size of the circular buffer, this must be a power of two
+     * @note Only a single thread may call Append and only a single thread may call Read at any point in time, they may be different threads
      * @url https://en.wikipedia.org/wiki/Circular_buffer
      */
     template<typename Type, size_t Size>
     class CircularBuffer {
       private:
+        static_assert(std::has_single_bit(Size), "The size of a circular buffer must be a power of two");
+
         std::array<Type, Size> array{}; //!< The internal array holding the circular buffer
-        Type *start{array.begin()}; //!< The start/oldest element of the internal array
-        Type *end{array.begin()}; //!< The end/newest element of the internal array
-        bool empty{true}; //!< If the buffer is full or empty, as start == end can mean either
-        std::mutex mtx; //!< Synchronizes buffer operations so they don't overlap
+        alignas(64) std::atomic<size_t> readIndex{}; //!< The monotonically increasing index of the oldest element, this is only written by the consumer
+        alignas(64) std::atomic<size_t> writeIndex{}; //!< The monotonically increasing index past the newest element, this is only written by the producer
 
       public:
         /**
-         * @brief Reads data from this buffer into the specified buffer
-         * @param copyFunction If this is specified, then this is called rather than memcpy
-         * @param copyOffset The offset into the buffer after which to use memcpy rather than copyFunction, -1 will use it for the entire buffer
-         * @return The amount of data written into the input buffer in units of Type
+         * @return The amount of elements currently in the buffer
          */
-        size_t Read(span <Type> buffer, void copyFunction(Type *, Type *) = {}, ssize_t copyOffset = -1) {
-            std::scoped_lock guard{mtx};
-
-            if (empty)
-                return 0;
-
-            Type *pointer{buffer.data()};
-            ssize_t maxSize{static_cast<ssize_t>(buffer.size())}, size{}, sizeBegin{}, sizeEnd{};
-
-            if (start < end) {
-                sizeEnd = std::min(end - start, maxSize);
-
-                size = sizeEnd;
-            } else {
-                sizeEnd = std::min(array.end() - start, maxSize);
-                sizeBegin = std::min(end - array.begin(), maxSize - sizeEnd);
-
-                size = sizeBegin + sizeEnd;
-            }
-
-            if (copyFunction && (copyOffset != 0 && copyOffset < sizeEnd)) {
-                auto sourceEnd{start + ((copyOffset != -1) ? copyOffset : sizeEnd)};
-
-                for (auto source{start}, destination{pointer}; source < sourceEnd; source++, destination++)
-                    copyFunction(source, destination);
-
-                if (copyOffset != -1) {
-                    std::memcpy(pointer + copyOffset, start + copyOffset, static_cast<size_t>(sizeEnd - copyOffset) * sizeof(Type));
-                    copyOffset -= sizeEnd;
-                }
-            } else {
-                if (copyOffset)
-                    copyOffset -= static_cast<size_t>(sizeEnd) * sizeof(Type);
-                std::memcpy(pointer, start, static_cast<size_t>(sizeEnd) * sizeof(Type));
-            }
-
-            pointer += sizeEnd;
-
-            if (sizeBegin) {
-                if (copyFunction && copyOffset) {
-                    auto sourceEnd{array.begin() + ((copyOffset != -1) ? copyOffset : sizeBegin)};
-
-                    for (auto source{array.begin()}, destination{pointer}; source < sourceEnd; source++, destination++)
-                        copyFunction(source, destination);
-
-                    if (copyOffset != -1)
-                        std::memcpy(array.begin() + copyOffset, pointer + copyOffset, static_cast<size_t>(sizeBegin - copyOffset) * sizeof(Type));
-                } else {
-                    std::memcpy(pointer, array.begin(), static_cast<size_t>(sizeBegin) * sizeof(Type));
-                }
-
-                start = array.begin() + sizeBegin;
-            } else {
-                start += sizeEnd;
-            }
-
-            if (start == end)
-                empty = true;
+        size_t Count() const {
+            return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+        }
 
-            return static_cast<size_t>(size);
+        /**
+         * @brief Consumes elements from this buffer, they are passed to the supplied function in up to two contiguous spans
+         * @param maxSize The maximum amount of elements to consume
+         * @param function A function that is called with each span of consumed elements, in order
+         * @return The amount of elements consumed
+         */
+        template<typename Function>
+        size_t Read(size_t maxSize, Function function) {
+            size_t read{readIndex.load(std::memory_order_relaxed)};
+            size_t size{std::min(writeIndex.load(std::memory_order_acquire) - read, maxSize)};
+
+            size_t offset{read & (Size - 1)};
+            size_t sizeEnd{std::min(size, Size - offset)};
+            if (sizeEnd)
+                function(span<Type>{array.data() + offset, sizeEnd});
+            if (size > sizeEnd)
+                function(span<Type>{array.data(), size - sizeEnd});
+
+            readIndex.store(read + size, std::memory_order_release);
+            return size;
         }
 
         /**
          * @brief Appends data from the specified buffer into this buffer
+         * @return The amount of elements appended, this will be less than the size of the supplied buffer if there wasn't enough free space
          */
-        void Append(span <Type> buffer) {
-            std::scoped_lock guard{mtx};
-
-            Type *pointer{buffer.data()};
-            ssize_t size{static_cast<ssize_t>(buffer.size())};
-            while (size) {
-                if (start <= end && end != array.end()) {
-                    auto sizeEnd{std::min(array.end() - end, size)};
-                    std::memcpy(end, pointer, static_cast<size_t>(sizeEnd) * sizeof(Type));
-
-                    pointer += sizeEnd;
-                    size -= sizeEnd;
-
-                    end += sizeEnd;
-                } else {
-                    auto sizePreStart{(end == array.end()) ? std::min(start - array.begin(), size) : std::min(start - end, size)};
-                    auto sizePostStart{std::min(array.end() - start, size - sizePreStart)};
-
-                    if (sizePreStart)
-                        std::memcpy((end == array.end()) ? array.begin() : end, pointer, static_cast<size_t>(sizePreStart) * sizeof(Type));
-
-                    if (end == array.end())
-                        end = array.begin() + sizePreStart;
-                    else
-                        end += sizePreStart;
-
-                    pointer += sizePreStart;
-                    size -= sizePreStart;
-
-                    if (sizePostStart)
-                        std::memcpy(end, pointer, static_cast<size_t>(sizePostStart) * sizeof(Type));
-
-                    if (start == array.end())
-                        start = array.begin() + sizePostStart;
-                    else
-                        start += sizePostStart;
-
-                    if (end == array.end())
-                        end = array.begin() + sizePostStart;
-                    else
-                        end += sizePostStart;
+        size_t Append(span<Type> buffer) {
+            size_t write{writeIndex.load(std::memory_order_relaxed)};
+            size_t size{std::min(Size - (write - readIndex.load(std::memory_order_acquire)), buffer.size())};
 
-                    pointer += sizePostStart;
-                    size -= sizePostStart;
-                }
+            size_t offset{write & (Size - 1)};
+            size_t sizeEnd{std::min(size, Size - offset)};
+            std::memcpy(array.data() + offset, buffer.data(), sizeEnd * sizeof(Type));
+            std::memcpy(array.data(), buffer.data() + sizeEnd, (size - sizeEnd) * sizeof(Type));
 
-                empty = false;
-            }
+            writeIndex.store(write + size, std::memory_order_release);
+            return size;
         }
     };
 }
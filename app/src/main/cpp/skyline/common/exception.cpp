@@ -1,12 +1,16 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#if !defined(__aarch64__)
+#include <execinfo.h>
+#endif
 #include "signal.h"
 #include "exception.h"
 
 namespace skyline {
     std::vector<void *> exception::GetStackFrames() {
         std::vector<void*> frames;
+        #if defined(__aarch64__)
         signal::StackFrame *frame{};
         asm("MOV %0, FP" : "=r"(frame));
         if (frame)
@@ -15,6 +19,14 @@ namespace skyline {
             frames.push_back(frame->lr);
             frame = frame->next;
         }
+        #else
+        // Host libraries are generally built without frame pointers so the chain of frame records isn't terminated, the unwinder is used instead
+        constexpr int MaxFrames{64};
+        frames.resize(MaxFrames);
+        frames.resize(static_cast<size_t>(backtrace(frames.data(), MaxFrames)));
+        if (!frames.empty())
+            frames.erase(frames.begin()); // We want to skip the first frame as it's going to be the caller of this function
+        #endif
         return frames;
     }
 }
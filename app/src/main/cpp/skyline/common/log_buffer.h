@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "base.h"
+
+namespace skyline::log {
+    /**
+     * @brief The type of a captured log argument, this determines the size of the payload following it
+     * @note This is shared with the binary log format and must not be reordered
+     */
+    enum class ArgumentType : u8 {
+        Signed, //!< An i64
+        Unsigned, //!< A u64
+        Float, //!< A double
+        Bool, //!< A u8 that's either 0 or 1
+        Char, //!< A single char
+        String, //!< A u32 length followed by the characters, this isn't null-terminated
+    };
+
+    enum class RecordType : u8 {
+        Padding, //!< Unused space at the end of the buffer, the record after it is at the start of the buffer
+        Message, //!< A log message, the format string and arguments follow the header
+        ThreadName, //!< The name of the thread owning the buffer has changed, the name follows the header as the format string
+    };
+
+    /**
+     * @brief The header of every record in a LogBuffer
+     */
+    struct RecordHeader {
+        u32 size; //!< The size of the entire record including the header, this is aligned to 8 bytes
+        RecordType type;
+        u8 level;
+        u8 argumentCount;
+        bool preformatted; //!< If the format string is the complete message and shouldn't be formatted
+        void *context; //!< The LoggerContext that the record should be written to, this may be nullptr to only write to logcat
+        i64 timestamp; //!< The time at which the record was captured in nanoseconds
+        const char *function; //!< The name of the function that logged the message, this has a static lifetime and may be nullptr
+        u32 formatSize; //!< The size of the format string following the header
+        u32 argumentSize; //!< The size of the arguments following the format string
+    };
+    static_assert(sizeof(RecordHeader) % 8 == 0);
+
+    /**
+     * @brief A lock-free single-producer single-consumer ring buffer of variable-sized log records
+     * @note Records are always contiguous in memory, a padding record is inserted when one wouldn't fit at the end of the buffer
+     */
+    class LogBuffer {
+      public:
+        static constexpr size_t Capacity{64 * 1024}; //!< The size of the buffer in bytes, this must be a power of two
+        static constexpr size_t MaxRecordSize{Capacity / 2}; //!< The largest record that can be written, larger messages are truncated
+
+      private:
+        alignas(64) std::atomic<size_t> writeOffset{}; //!< The total amount of bytes written by the producer, this is only modified by the producer
+        alignas(64) std::atomic<size_t> readOffset{}; //!< The total amount of bytes consumed by the consumer, this is only modified by the consumer
+        alignas(64) std::array<u8, Capacity> buffer;
+
+      public:
+        LogBuffer *next{}; //!< The next buffer in the global list of buffers
+        std::atomic<bool> abandoned{}; //!< If the thread that owned this buffer has exited, an abandoned buffer can be claimed by a new thread once it has been drained
+        std::string threadName; //!< The name of the producer thread, this is only accessed by the consumer
+
+        /**
+         * @brief Reserves contiguous space for a record in the buffer, it must be committed with Commit() prior to any further reservations
+         * @param size The size of the record, this must be aligned to 8 bytes and not exceed MaxRecordSize
+         * @return A pointer to the reserved space or nullptr if there's not enough free space at the moment
+         */
+        u8 *Reserve(u32 size) {
+            size_t write{writeOffset.load(std::memory_order_relaxed)}, read{readOffset.load(std::memory_order_acquire)};
+            size_t index{write & (Capacity - 1)}, contiguous{Capacity - index};
+            if (size > contiguous) {
+                if (write + contiguous + size - read > Capacity)
+                    return nullptr;
+
+                auto &padding{*reinterpret_cast<RecordHeader *>(buffer.data() + index)};
+                padding.size = static_cast<u32>(contiguous);
+                padding.type = RecordType::Padding;
+                writeOffset.store(write + contiguous, std::memory_order_release);
+                return buffer.data();
+            }
+
+            if (write + size - read > Capacity)
+                return nullptr;
+            return buffer.data() + index;
+        }
+
+        /**
+         * @brief Publishes the record that was last reserved to the consumer
+         */
+        void Commit(u32 size) {
+            writeOffset.store(writeOffset.load(std::memory_order_relaxed) + size, std::memory_order_release);
+        }
+
+        /**
+         * @return The oldest record in the buffer or nullptr if the buffer is empty
+         */
+        RecordHeader *Peek() {
+            size_t read{readOffset.load(std::memory_order_relaxed)};
+            while (read != writeOffset.load(std::memory_order_acquire)) {
+                auto record{reinterpret_cast<RecordHeader *>(buffer.data() + (read & (Capacity - 1)))};
+                if (record->type != RecordType::Padding)
+                    return record;
+
+                read += record->size;
+                readOffset.store(read, std::memory_order_release);
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Releases the record returned by Peek() back to the producer
+         */
+        void Pop() {
+            size_t read{readOffset.load(std::memory_order_relaxed)};
+            readOffset.store(read + reinterpret_cast<RecordHeader *>(buffer.data() + (read & (Capacity - 1)))->size, std::memory_order_release);
+        }
+
+        bool Empty() const {
+            return readOffset.load(std::memory_order_acquire) == writeOffset.load(std::memory_order_acquire);
+        }
+    };
+
+    template<typename Type>
+    concept StringArgument = !std::is_pointer_v<Type> && std::is_convertible_v<const Type &, std::string_view>;
+
+    /**
+     * @brief If an argument can be captured into a record as-is and formatted later by the consumer, all other arguments require the message to be formatted by the producer
+     */
+    template<typename Type>
+    concept CapturableArgument = std::is_same_v<Type, char *> || std::is_same_v<Type, const char *> || StringArgument<Type> || (std::is_arithmetic_v<Type> && sizeof(Type) <= sizeof(u64));
+
+    /**
+     * @return The argument after the same transformations that util::Format() applies, this avoids copying any non-pointer arguments
+     */
+    template<typename Type>
+    constexpr decltype(auto) NormalizeArgument(const Type &argument) {
+        if constexpr (std::is_pointer_v<Type>)
+            return util::FmtCast(argument);
+        else
+            return (argument);
+    }
+
+    /**
+     * @return The size of the argument once it has been captured by WriteArgument()
+     */
+    template<typename Type>
+    size_t ArgumentSize(const Type &argument) {
+        if constexpr (std::is_same_v<Type, char *> || std::is_same_v<Type, const char *>)
+            return sizeof(ArgumentType) + sizeof(u32) + std::strlen(argument);
+        else if constexpr (StringArgument<Type>)
+            return sizeof(ArgumentType) + sizeof(u32) + std::string_view{argument}.size();
+        else if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, char>)
+            return sizeof(ArgumentType) + sizeof(u8);
+        else
+            return sizeof(ArgumentType) + sizeof(u64);
+    }
+
+    /**
+     * @brief Captures an argument into the supplied pointer and advances it past the argument
+     */
+    template<typename Type>
+    void WriteArgument(u8 *&pointer, const Type &argument) {
+        auto write{[&pointer](ArgumentType type, const void *data, size_t size) {
+            *pointer++ = static_cast<u8>(type);
+            std::memcpy(pointer, data, size);
+            pointer += size;
+        }};
+
+        if constexpr (std::is_same_v<Type, char *> || std::is_same_v<Type, const char *> || StringArgument<Type>) {
+            std::string_view string{argument};
+            u32 size{static_cast<u32>(string.size())};
+            write(ArgumentType::String, &size, sizeof(u32));
+            std::memcpy(pointer, string.data(), size);
+            pointer += size;
+        } else if constexpr (std::is_same_v<Type, bool>) {
+            u8 value{argument};
+            write(ArgumentType::Bool, &value, sizeof(u8));
+        } else if constexpr (std::is_same_v<Type, char>) {
+            write(ArgumentType::Char, &argument, sizeof(char));
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            double value{argument};
+            write(ArgumentType::Float, &value, sizeof(double));
+        } else if constexpr (std::is_signed_v<Type>) {
+            i64 value{argument};
+            write(ArgumentType::Signed, &value, sizeof(i64));
+        } else {
+            u64 value{argument};
+            write(ArgumentType::Unsigned, &value, sizeof(u64));
+        }
+    }
+}
@@ -2,41 +2,316 @@
 // Copyright © 2021 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <android/log.h>
+#include <condition_variable>
+#include <thread>
+#include <fmt/args.h>
 #include "utils.h"
 #include "logger.h"
 
 namespace skyline {
+    static std::atomic<log::LogBuffer *> buffers; //!< A singly-linked list of every thread's log buffer, buffers are never freed but are reused after their thread exits
+    // These are intentionally leaked as the detached logger thread may still be using them during static destruction
+    static std::mutex &drainMutex{*new std::mutex}; //!< Synchronizes consuming records from the log buffers, this is held by the logger thread while draining
+    static std::condition_variable &drainCondition{*new std::condition_variable}; //!< Wakes the logger thread prior to its regular interval, this is signalled when a buffer is full
+    static std::once_flag loggerThreadFlag;
+    constexpr auto DrainInterval{std::chrono::milliseconds(10)}; //!< The interval at which the logger thread drains the log buffers
+
+    /**
+     * @brief The calling thread's log buffer, it's marked as abandoned on thread exit so it can be reused
+     */
+    struct ThreadBuffer {
+        log::LogBuffer *buffer{};
+        u32 pendingSize{}; //!< The size of the record that has been reserved but not committed yet
+
+        ~ThreadBuffer() {
+            if (buffer)
+                buffer->abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local static ThreadBuffer threadBuffer;
+    thread_local static Logger::LoggerContext *context{&Logger::EmulationContext};
+
+    /**
+     * @brief Formats the message in a record from its format string and captured arguments
+     */
+    static std::string FormatRecord(const log::RecordHeader &record) {
+        auto data{reinterpret_cast<const u8 *>(&record) + sizeof(log::RecordHeader)};
+        std::string_view format{reinterpret_cast<const char *>(data), record.formatSize};
+        data += record.formatSize;
+
+        std::string message;
+        if (record.function)
+            message = fmt::format("{}: ", record.function);
+
+        if (record.preformatted) {
+            message += format;
+            return message;
+        }
+
+        auto read{[&data]<typename Type>() {
+            Type value;
+            std::memcpy(&value, data, sizeof(Type));
+            data += sizeof(Type);
+            return value;
+        }};
+
+        fmt::dynamic_format_arg_store<fmt::format_context> arguments;
+        arguments.reserve(record.argumentCount, 0);
+        for (u8 index{}; index < record.argumentCount; index++) {
+            switch (static_cast<log::ArgumentType>(*data++)) {
+                case log::ArgumentType::Signed:
+                    arguments.push_back(read.operator()<i64>());
+                    break;
+                case log::ArgumentType::Unsigned:
+                    arguments.push_back(read.operator()<u64>());
+                    break;
+                case log::ArgumentType::Float:
+                    arguments.push_back(read.operator()<double>());
+                    break;
+                case log::ArgumentType::Bool:
+                    arguments.push_back(read.operator()<u8>() != 0);
+                    break;
+                case log::ArgumentType::Char:
+                    arguments.push_back(read.operator()<char>());
+                    break;
+                case log::ArgumentType::String: {
+                    auto size{read.operator()<u32>()};
+                    arguments.push_back(std::string_view{reinterpret_cast<const char *>(data), size});
+                    data += size;
+                    break;
+                }
+            }
+        }
+
+        try {
+            fmt::vformat_to(std::back_inserter(message), format, arguments);
+        } catch (const fmt::format_error &e) {
+            message += fmt::format("{} (Format Error: {})", format, e.what());
+        }
+        return message;
+    }
+
+    /**
+     * @brief Formats and writes out all records in every thread's buffer in the order they were captured
+     * @note This must be called with the drain mutex held
+     */
+    static void Drain() {
+        while (true) {
+            // Records are merged across buffers by their timestamp so that the output retains the global order of messages
+            log::LogBuffer *oldestBuffer{};
+            log::RecordHeader *oldest{};
+            for (auto buffer{buffers.load(std::memory_order_acquire)}; buffer; buffer = buffer->next) {
+                auto record{buffer->Peek()};
+                if (record && (!oldest || record->timestamp < oldest->timestamp)) {
+                    oldestBuffer = buffer;
+                    oldest = record;
+                }
+            }
+
+            if (!oldest)
+                return;
+
+            if (oldest->type == log::RecordType::ThreadName) {
+                oldestBuffer->threadName.assign(reinterpret_cast<const char *>(oldest) + sizeof(log::RecordHeader), oldest->formatSize);
+            } else {
+                std::string message{FormatRecord(*oldest)};
+                auto level{static_cast<Logger::LogLevel>(oldest->level)};
+                Logger::WriteAndroid(level, oldestBuffer->threadName, message);
+                if (oldest->context)
+                    static_cast<Logger::LoggerContext *>(oldest->context)->Write(*oldestBuffer, *oldest, message);
+            }
+
+            oldestBuffer->Pop();
+        }
+    }
+
+    [[noreturn]] static void LoggerThread() {
+        if (int result{pthread_setname_np(pthread_self(), "Sky-Logger")})
+            __android_log_print(ANDROID_LOG_WARN, "emu-cpp-Sky-Logger", "Failed to set the thread name: %s", strerror(result));
+
+        std::unique_lock lock{drainMutex};
+        while (true) {
+            Drain();
+            drainCondition.wait_for(lock, DrainInterval);
+        }
+    }
+
+    /**
+     * @brief Reserves space for a record in the calling thread's buffer and fills in its header
+     * @return A pointer to the space following the header
+     */
+    static u8 *ReserveRecord(log::RecordType type, u8 level, const char *function, std::string_view &format, size_t argumentSize, u8 argumentCount, bool preformatted) {
+        auto buffer{threadBuffer.buffer};
+        format = format.substr(0, log::LogBuffer::MaxRecordSize - sizeof(log::RecordHeader) - argumentSize);
+        auto size{static_cast<u32>(util::AlignUp(sizeof(log::RecordHeader) + format.size() + argumentSize, 8))};
+
+        u8 *pointer;
+        while (!(pointer = buffer->Reserve(size))) {
+            // The buffer is full, we need to wait for the logger thread to drain it
+            drainCondition.notify_one();
+            std::this_thread::yield();
+        }
+
+        *reinterpret_cast<log::RecordHeader *>(pointer) = {
+            .size = size,
+            .type = type,
+            .level = level,
+            .argumentCount = argumentCount,
+            .preformatted = preformatted,
+            .context = context,
+            .timestamp = util::GetTimeNs(),
+            .function = function,
+            .formatSize = static_cast<u32>(format.size()),
+            .argumentSize = static_cast<u32>(argumentSize),
+        };
+        std::memcpy(pointer + sizeof(log::RecordHeader), format.data(), format.size());
+        threadBuffer.pendingSize = size;
+
+        return pointer + sizeof(log::RecordHeader) + format.size();
+    }
+
+    /**
+     * @brief Assigns a log buffer to the calling thread, an abandoned buffer is reused if possible
+     */
+    static void AcquireThreadBuffer() {
+        std::call_once(loggerThreadFlag, [] {
+            std::thread(LoggerThread).detach();
+        });
+
+        for (auto buffer{buffers.load(std::memory_order_acquire)}; buffer; buffer = buffer->next) {
+            bool abandoned{true};
+            if (buffer->abandoned.load(std::memory_order_relaxed) && buffer->Empty() && buffer->abandoned.compare_exchange_strong(abandoned, false, std::memory_order_acquire)) {
+                threadBuffer.buffer = buffer;
+                break;
+            }
+        }
+
+        if (!threadBuffer.buffer) {
+            auto buffer{new log::LogBuffer()};
+            buffer->next = buffers.load(std::memory_order_relaxed);
+            while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed));
+            threadBuffer.buffer = buffer;
+        }
+
+        Logger::UpdateTag(); // The consumer needs to be informed of the name of the thread that now owns the buffer
+    }
+
     void Logger::LoggerContext::Initialize(const std::string &path) {
-        start = util::GetTimeNs() / constant::NsInMillisecond;
+        std::scoped_lock lock{mutex};
+        start = util::GetTimeNs();
+
+        #ifdef LOGGER_BINARY_FORMAT
+        logFile.open(path, std::ios::trunc | std::ios::binary);
+        strings.clear();
+
+        constexpr u32 BinaryLogMagic{util::MakeMagic<u32>("SKLB")}, BinaryLogVersion{1};
+        logFile.write(reinterpret_cast<const char *>(&BinaryLogMagic), sizeof(u32));
+        logFile.write(reinterpret_cast<const char *>(&BinaryLogVersion), sizeof(u32));
+        #else
         logFile.open(path, std::ios::trunc);
+        #endif
     }
 
     void Logger::LoggerContext::Finalize() {
+        {
+            std::scoped_lock lock{drainMutex};
+            Drain();
+        }
+
         std::scoped_lock lock{mutex};
         logFile.close();
     }
 
     void Logger::LoggerContext::TryFlush() {
+        std::unique_lock drainLock{drainMutex, std::try_to_lock};
+        if (drainLock)
+            Drain();
+
         std::unique_lock lock(mutex, std::try_to_lock);
         if (lock)
             logFile.flush();
     }
 
     void Logger::LoggerContext::Flush() {
+        {
+            std::scoped_lock lock{drainMutex};
+            Drain();
+        }
+
         std::scoped_lock lock{mutex};
         logFile.flush();
     }
 
-    thread_local static std::string logTag, threadName;
-    thread_local static Logger::LoggerContext *context{&Logger::EmulationContext};
+    #ifdef LOGGER_BINARY_FORMAT
+    u32 Logger::LoggerContext::InternString(std::string_view string) {
+        auto it{strings.find(std::string{string})};
+        if (it != strings.end())
+            return it->second;
+
+        u32 id{static_cast<u32>(strings.size())}, size{static_cast<u32>(string.size())};
+        strings.emplace(string, id);
+
+        constexpr u8 StringRecord{0};
+        logFile.put(static_cast<char>(StringRecord));
+        logFile.write(reinterpret_cast<const char *>(&id), sizeof(u32));
+        logFile.write(reinterpret_cast<const char *>(&size), sizeof(u32));
+        logFile.write(string.data(), size);
+        return id;
+    }
+    #endif
+
+    void Logger::LoggerContext::Write(const log::LogBuffer &buffer, const log::RecordHeader &record, std::string_view message) {
+        std::scoped_lock guard{mutex};
+        if (!logFile.is_open())
+            return;
+
+        #ifdef LOGGER_BINARY_FORMAT
+        // Messages are written with their format string and arguments as they were captured, the strings are interned to keep the log compact
+        constexpr u8 MessageRecord{1};
+        constexpr u32 NoString{std::numeric_limits<u32>::max()};
+        auto data{reinterpret_cast<const char *>(&record) + sizeof(log::RecordHeader)};
+
+        u32 threadId{InternString(buffer.threadName)};
+        u32 functionId{record.function ? InternString(record.function) : NoString};
+        u32 formatId{record.preformatted ? NoString : InternString(std::string_view{data, record.formatSize})}; // Preformatted messages are unique, they're written as a single string argument instead
+        i64 timestamp{record.timestamp - start};
+        u8 argumentCount{record.preformatted ? u8{1} : record.argumentCount};
+        u32 argumentSize{record.preformatted ? static_cast<u32>(sizeof(log::ArgumentType) + sizeof(u32) + record.formatSize) : record.argumentSize};
+
+        logFile.put(static_cast<char>(MessageRecord));
+        logFile.put(static_cast<char>(record.level));
+        logFile.put(static_cast<char>(argumentCount));
+        logFile.write(reinterpret_cast<const char *>(&threadId), sizeof(u32));
+        logFile.write(reinterpret_cast<const char *>(&functionId), sizeof(u32));
+        logFile.write(reinterpret_cast<const char *>(&formatId), sizeof(u32));
+        logFile.write(reinterpret_cast<const char *>(&timestamp), sizeof(i64));
+        logFile.write(reinterpret_cast<const char *>(&argumentSize), sizeof(u32));
+        if (record.preformatted) {
+            logFile.put(static_cast<char>(log::ArgumentType::String));
+            logFile.write(reinterpret_cast<const char *>(&record.formatSize), sizeof(u32));
+            logFile.write(data, record.formatSize);
+        } else {
+            logFile.write(data + record.formatSize, record.argumentSize);
+        }
+        #else
+        constexpr std::array<char, 5> levelCharacter{'E', 'W', 'I', 'D', 'V'}; // The LogLevel as written out to a file
+
+        // We use RS (\036) and GS (\035) as our delimiters
+        logFile << fmt::format("\036{}\035{}\035{}\035{}\n", levelCharacter[record.level], (record.timestamp - start) / constant::NsInMillisecond, buffer.threadName, message);
+        #endif
+    }
 
     void Logger::UpdateTag() {
+        if (!threadBuffer.buffer) {
+            AcquireThreadBuffer();
+            return;
+        }
+
         std::array<char, 16> name;
-        if (!pthread_getname_np(pthread_self(), name.data(), name.size()))
-            threadName = name.data();
-        else
-            threadName = "unk";
-        logTag = std::string("emu-cpp-") + threadName;
+        std::string_view threadName{!pthread_getname_np(pthread_self(), name.data(), name.size()) ? name.data() : "unk"};
+        ReserveRecord(log::RecordType::ThreadName, 0, nullptr, threadName, 0, 0, true);
+        threadBuffer.buffer->Commit(threadBuffer.pendingSize);
     }
 
     Logger::LoggerContext *Logger::GetContext() {
@@ -47,25 +322,23 @@ namespace skyline {
         context = pContext;
     }
 
-    void Logger::WriteAndroid(LogLevel level, const std::string &str) {
+    void Logger::WriteAndroid(LogLevel level, const std::string &threadName, const std::string &str) {
         constexpr std::array<int, 5> levelAlog{ANDROID_LOG_ERROR, ANDROID_LOG_WARN, ANDROID_LOG_INFO, ANDROID_LOG_DEBUG, ANDROID_LOG_VERBOSE}; // This corresponds to LogLevel and provides its equivalent for NDK Logging
-        if (logTag.empty())
-            UpdateTag();
-
-        __android_log_write(levelAlog[static_cast<u8>(level)], logTag.c_str(), str.c_str());
+        __android_log_write(levelAlog[static_cast<u8>(level)], (std::string("emu-cpp-") + threadName).c_str(), str.c_str());
     }
 
     void Logger::Write(LogLevel level, const std::string &str) {
-        constexpr std::array<char, 5> levelCharacter{'E', 'W', 'I', 'D', 'V'}; // The LogLevel as written out to a file
-        WriteAndroid(level, str);
+        BeginRecord(level, nullptr, str, 0, 0, true);
+        EndRecord();
+    }
 
-        if (context)
-            // We use RS (\036) and GS (\035) as our delimiters
-            context->Write(fmt::format("\036{}\035{}\035{}\035{}\n", levelCharacter[static_cast<u8>(level)], (util::GetTimeNs() / constant::NsInMillisecond) - context->start, threadName, str));
+    u8 *Logger::BeginRecord(LogLevel level, const char *function, std::string_view format, size_t argumentSize, u8 argumentCount, bool preformatted) {
+        if (!threadBuffer.buffer)
+            AcquireThreadBuffer();
+        return ReserveRecord(log::RecordType::Message, static_cast<u8>(level), function, format, argumentSize, argumentCount, preformatted);
     }
 
-    void Logger::LoggerContext::Write(const std::string &str) {
-        std::scoped_lock guard{mutex};
-        logFile << str;
+    void Logger::EndRecord() {
+        threadBuffer.buffer->Commit(threadBuffer.pendingSize);
     }
 }
@@ -5,11 +5,16 @@
 
 #include <fstream>
 #include <mutex>
+#include <unordered_map>
 #include "base.h"
+#include "log_buffer.h"
+
+// #define LOGGER_BINARY_FORMAT // Writes log files in a compact binary format rather than text, they can be decoded with scripts/decode_log.py
 
 namespace skyline {
     /**
      * @brief A wrapper around writing logs into a log file and logcat using Android Log APIs
+     * @note Messages are captured as their format string and raw arguments into a lock-free per-thread buffer, they're formatted and written out asynchronously by a dedicated logger thread
      */
     class Logger {
       private:
@@ -26,25 +31,79 @@ namespace skyline {
 
         static inline LogLevel configLevel{LogLevel::Verbose}; //!< The minimum level of logs to write
 
+      private:
+        /**
+         * @brief Reserves space for a record in the calling thread's buffer and writes the header and format string into it
+         * @return A pointer to the space for the arguments of the record, the record must be published with EndRecord() after they're written
+         * @note If the record would exceed the maximum record size then the format string is truncated, this should only be used for preformatted messages
+         */
+        static u8 *BeginRecord(LogLevel level, const char *function, std::string_view format, size_t argumentSize, u8 argumentCount, bool preformatted);
+
+        static void EndRecord();
+
+        /**
+         * @brief Captures a message into the calling thread's buffer, the message is formatted by the logger thread unless it has any arguments that can't be captured
+         */
+        template<typename... Args>
+        static void Capture(LogLevel level, const char *function, std::string_view format, const Args &... args) {
+            if constexpr ((log::CapturableArgument<std::remove_cvref_t<decltype(log::NormalizeArgument(args))>> && ...)) {
+                size_t argumentSize{(log::ArgumentSize(log::NormalizeArgument(args)) + ... + 0)};
+                if (sizeof(log::RecordHeader) + format.size() + argumentSize <= log::LogBuffer::MaxRecordSize) {
+                    u8 *pointer{BeginRecord(level, function, format, argumentSize, sizeof...(Args), false)};
+                    (log::WriteArgument(pointer, log::NormalizeArgument(args)), ...);
+                    EndRecord();
+                    return;
+                }
+            }
+
+            // Any arguments without a trivial representation are formatted on the calling thread, such as those with custom formatters
+            BeginRecord(level, function, util::Format(format, args...), 0, 0, true);
+            EndRecord();
+        }
+
+      public:
         /**
          * @brief Holds logger variables that cannot be static
          */
         struct LoggerContext {
             std::mutex mutex; //!< Synchronizes all output I/O to ensure there are no races
             std::ofstream logFile; //!< An output stream to the log file
-            i64 start; //!< A timestamp in milliseconds for when the logger was started, this is used as the base for all log timestamps
+            i64 start; //!< A timestamp in nanoseconds for when the logger was started, this is used as the base for all log timestamps
+            #ifdef LOGGER_BINARY_FORMAT
+            std::unordered_map<std::string, u32> strings; //!< A map from strings to their identifiers in the binary log, strings are only written out on their first occurrence
+            #endif
 
             LoggerContext() {}
 
             void Initialize(const std::string &path);
 
+            /**
+             * @brief Writes out all pending messages and closes the log file
+             */
             void Finalize();
 
+            /**
+             * @brief Writes out all pending messages and flushes the log file if this wouldn't block on another thread
+             */
             void TryFlush();
 
+            /**
+             * @brief Synchronously writes out all pending messages from every thread and flushes the log file
+             */
             void Flush();
 
-            void Write(const std::string &str);
+            /**
+             * @brief Writes a record from a thread's log buffer into the log file
+             * @param message The formatted message, this is unused in the binary format
+             */
+            void Write(const log::LogBuffer &buffer, const log::RecordHeader &record, std::string_view message);
+
+            #ifdef LOGGER_BINARY_FORMAT
+            /**
+             * @return The identifier of the supplied string in the binary log, it's written to the log if it's the first occurrence
+             */
+            u32 InternString(std::string_view string);
+            #endif
         };
         static inline LoggerContext EmulationContext, LoaderContext;
 
@@ -57,8 +116,11 @@ namespace skyline {
 
         static void SetContext(LoggerContext *context);
 
-        static void WriteAndroid(LogLevel level, const std::string &str);
+        static void WriteAndroid(LogLevel level, const std::string &threadName, const std::string &str);
 
+        /**
+         * @brief Writes a preformatted message
+         */
         static void Write(LogLevel level, const std::string &str);
 
         /**
@@ -81,62 +143,62 @@ namespace skyline {
         template<typename... Args>
         static void Error(FunctionString<const char *> formatString, Args &&... args) {
             if (LogLevel::Error <= configLevel)
-                Write(LogLevel::Error, util::Format(*formatString, args...));
+                Capture(LogLevel::Error, formatString.function, formatString.string, args...);
         }
 
         template<typename... Args>
         static void Error(FunctionString<std::string> formatString, Args &&... args) {
             if (LogLevel::Error <= configLevel)
-                Write(LogLevel::Error, util::Format(*formatString, args...));
+                Capture(LogLevel::Error, formatString.function, formatString.string, args...);
         }
 
         template<typename S, typename... Args>
         static void ErrorNoPrefix(S formatString, Args &&... args) {
             if (LogLevel::Error <= configLevel)
-                Write(LogLevel::Error, util::Format(formatString, args...));
+                Capture(LogLevel::Error, nullptr, formatString, args...);
         }
 
         template<typename... Args>
         static void Warn(FunctionString<const char *> formatString, Args &&... args) {
             if (LogLevel::Warn <= configLevel)
-                Write(LogLevel::Warn, util::Format(*formatString, args...));
+                Capture(LogLevel::Warn, formatString.function, formatString.string, args...);
         }
 
         template<typename... Args>
         static void Warn(FunctionString<std::string> formatString, Args &&... args) {
             if (LogLevel::Warn <= configLevel)
-                Write(LogLevel::Warn, util::Format(*formatString, args...));
+                Capture(LogLevel::Warn, formatString.function, formatString.string, args...);
         }
 
         template<typename S, typename... Args>
         static void WarnNoPrefix(S formatString, Args &&... args) {
             if (LogLevel::Warn <= configLevel)
-                Write(LogLevel::Warn, util::Format(formatString, args...));
+                Capture(LogLevel::Warn, nullptr, formatString, args...);
         }
 
         template<typename... Args>
         static void Info(FunctionString<const char *> formatString, Args &&... args) {
             if (LogLevel::Info <= configLevel)
-                Write(LogLevel::Info, util::Format(*formatString, args...));
+                Capture(LogLevel::Info, formatString.function, formatString.string, args...);
         }
 
         template<typename... Args>
         static void Info(FunctionString<std::string> formatString, Args &&... args) {
             if (LogLevel::Info <= configLevel)
-                Write(LogLevel::Info, util::Format(*formatString, args...));
+                Capture(LogLevel::Info, formatString.function, formatString.string, args...);
         }
 
         template<typename S, typename... Args>
         static void InfoNoPrefix(S formatString, Args &&... args) {
             if (LogLevel::Info <= configLevel)
-                Write(LogLevel::Info, util::Format(formatString, args...));
+                Capture(LogLevel::Info, nullptr, formatString, args...);
         }
 
         template<typename... Args>
         static void Debug(FunctionString<const char *> formatString, Args &&... args) {
             #ifndef NDEBUG
             if (LogLevel::Debug <= configLevel)
-                Write(LogLevel::Debug, util::Format(*formatString, args...));
+                Capture(LogLevel::Debug, formatString.function, formatString.string, args...);
             #endif
         }
 
@@ -144,7 +206,7 @@ namespace skyline {
         static void Debug(FunctionString<std::string> formatString, Args &&... args) {
             #ifndef NDEBUG
             if (LogLevel::Debug <= configLevel)
-                Write(LogLevel::Debug, util::Format(*formatString, args...));
+                Capture(LogLevel::Debug, formatString.function, formatString.string, args...);
             #endif
         }
 
@@ -152,7 +214,7 @@ namespace skyline {
         static void DebugNoPrefix(S formatString, Args &&... args) {
             #ifndef NDEBUG
             if (LogLevel::Debug <= configLevel)
-                Write(LogLevel::Debug, util::Format(formatString, args...));
+                Capture(LogLevel::Debug, nullptr, formatString, args...);
             #endif
         }
 
@@ -160,7 +222,7 @@ namespace skyline {
         static void Verbose(FunctionString<const char *> formatString, Args &&... args) {
             #ifndef NDEBUG
             if (LogLevel::Verbose <= configLevel)
-                Write(LogLevel::Verbose, util::Format(*formatString, args...));
+                Capture(LogLevel::Verbose, formatString.function, formatString.string, args...);
             #endif
         }
 
@@ -168,7 +230,7 @@ namespace skyline {
         static void Verbose(FunctionString<std::string> formatString, Args &&... args) {
             #ifndef NDEBUG
             if (LogLevel::Verbose <= configLevel)
-                Write(LogLevel::Verbose, util::Format(*formatString, args...));
+                Capture(LogLevel::Verbose, formatString.function, formatString.string, args...);
             #endif
         }
 
@@ -176,7 +238,7 @@ namespace skyline {
         static void VerboseNoPrefix(S formatString, Args &&... args) {
             #ifndef NDEBUG
             if (LogLevel::Verbose <= configLevel)
-                Write(LogLevel::Verbose, util::Format(formatString, args...));
+                Capture(LogLevel::Verbose, nullptr, formatString, args...);
             #endif
         }
     };
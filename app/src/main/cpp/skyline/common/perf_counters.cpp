@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "trace.h"
+#include "perf_counters.h"
+
+namespace skyline::perf {
+    namespace detail {
+        std::array<Slot, CounterCount> counters{};
+        std::array<std::array<Slot, HistogramBucketCount>, HistogramCount> histograms{};
+    }
+
+    constexpr std::array<const char *, CounterCount> CounterNames{
+        "Draws",
+        "Pipeline Compiles",
+        "Pipeline Cache Hits",
+        "Pipeline Cache Misses",
+        "Texture Upload Bytes",
+        "Trap Faults",
+        "SVCs",
+        "IPC Calls",
+        "Megabuffer Bytes",
+        "Fence Waits",
+    };
+
+    constexpr std::array<const char *, HistogramCount> HistogramNames{
+        "Fence Wait Time (us)",
+    };
+
+    const char *GetName(Counter counter) {
+        return CounterNames[static_cast<size_t>(counter)];
+    }
+
+    void Snapshot(span<u64, SnapshotSize> output) {
+        auto it{output.begin()};
+        for (auto &counter : detail::counters)
+            *it++ = counter.value.load(std::memory_order_relaxed);
+        for (auto &histogram : detail::histograms)
+            for (auto &bucket : histogram)
+                *it++ = bucket.value.load(std::memory_order_relaxed);
+    }
+
+    void EmitTraceCounters() {
+        // Perfetto requires track names to outlive the tracks, so the names of the histogram buckets are generated once
+        static const auto histogramBucketNames{[]() {
+            std::array<std::array<std::string, HistogramBucketCount>, HistogramCount> names;
+            for (size_t i{}; i < HistogramCount; i++) {
+                for (size_t bucket{}; bucket < HistogramBucketCount; bucket++) {
+                    if (bucket == 0)
+                        names[i][bucket] = fmt::format("{}: 0", HistogramNames[i]);
+                    else if (bucket == HistogramBucketCount - 1)
+                        names[i][bucket] = fmt::format("{}: >={}", HistogramNames[i], 1ULL << (bucket - 1));
+                    else
+                        names[i][bucket] = fmt::format("{}: {}-{}", HistogramNames[i], 1ULL << (bucket - 1), (1ULL << bucket) - 1);
+                }
+            }
+            return names;
+        }()};
+
+        for (size_t i{}; i < CounterCount; i++)
+            TRACE_COUNTER("perf", perfetto::CounterTrack(CounterNames[i]), detail::counters[i].value.load(std::memory_order_relaxed));
+
+        for (size_t i{}; i < HistogramCount; i++)
+            for (size_t bucket{}; bucket < HistogramBucketCount; bucket++)
+                TRACE_COUNTER("perf", perfetto::CounterTrack(histogramBucketNames[i][bucket].c_str()), detail::histograms[i][bucket].value.load(std::memory_order_relaxed));
+    }
+
+    void Reset() {
+        for (auto &counter : detail::counters)
+            counter.value.store(0, std::memory_order_relaxed);
+        for (auto &histogram : detail::histograms)
+            for (auto &bucket : histogram)
+                bucket.value.store(0, std::memory_order_relaxed);
+    }
+}
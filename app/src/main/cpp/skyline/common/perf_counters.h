@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <common.h>
+
+namespace skyline::perf {
+    /**
+     * @brief Lock-free performance counters that are cheap enough to be updated from hot paths
+     * @note These are exported as Perfetto counter tracks on every presented frame and as a snapshot through JNI for the on-screen overlay
+     * @note The overlay in EmulationActivity locates counters in a snapshot by their names from GetName rather than by their position
+     */
+    enum class Counter : u8 {
+        Draws, //!< Draws submitted through Maxwell 3D
+        PipelineCompiles, //!< Graphics pipelines compiled at runtime or loaded from the pipeline cache
+        PipelineCacheHits, //!< Graphics pipeline lookups that were satisfied by an existing pipeline
+        PipelineCacheMisses, //!< Graphics pipeline lookups that required a new pipeline to be compiled
+        TextureUploadBytes, //!< The amount of guest texture data synchronized to the host in bytes
+        TrapFaults, //!< Accesses to trapped guest memory that were handled by NCE
+        Svcs, //!< Supervisor calls made by the guest
+        IpcCalls, //!< Synchronous IPC requests to HLE services
+        MegaBufferBytes, //!< The amount of megabuffer space allocated in bytes
+        FenceWaits, //!< Blocking waits on fence cycles that weren't signalled yet
+        Count,
+    };
+
+    enum class Histogram : u8 {
+        FenceWaitTime, //!< The duration of blocking waits on fence cycles in microseconds
+        Count,
+    };
+
+    constexpr size_t CounterCount{static_cast<size_t>(Counter::Count)};
+    constexpr size_t HistogramCount{static_cast<size_t>(Histogram::Count)};
+    constexpr size_t HistogramBucketCount{16}; //!< Histogram values are bucketed by their bit width, the last bucket covers all larger values
+    constexpr size_t SnapshotSize{CounterCount + (HistogramCount * HistogramBucketCount)}; //!< The amount of values in a snapshot, counters are followed by each histogram's buckets
+
+    namespace detail {
+        /**
+         * @brief A single value on its own cache line, this prevents counters updated from different threads from contending with each other
+         */
+        struct alignas(64) Slot {
+            std::atomic<u64> value;
+        };
+
+        extern std::array<Slot, CounterCount> counters;
+        extern std::array<std::array<Slot, HistogramBucketCount>, HistogramCount> histograms;
+    }
+
+    /**
+     * @return The display name of a counter, this is also the name of its Perfetto track
+     */
+    const char *GetName(Counter counter);
+
+    /**
+     * @brief Adds the supplied value to a counter
+     */
+    inline void Add(Counter counter, u64 value = 1) {
+        detail::counters[static_cast<size_t>(counter)].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records a single sample into a histogram
+     */
+    inline void Record(Histogram histogram, u64 value) {
+        size_t bucket{std::min(static_cast<size_t>(std::bit_width(value)), HistogramBucketCount - 1)};
+        detail::histograms[static_cast<size_t>(histogram)][bucket].value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Writes the current value of all counters followed by all histogram buckets into the supplied span
+     * @note The values aren't captured atomically as a whole, they might be slightly out of sync with each other
+     */
+    void Snapshot(span<u64, SnapshotSize> output);
+
+    /**
+     * @brief Emits the current value of all counters and histogram buckets as Perfetto counter tracks
+     */
+    void EmitTraceCounters();
+
+    /**
+     * @brief Resets all counters and histograms to zero, this should be done when emulation is (re)started
+     */
+    void Reset();
+}
@@ -14,7 +14,7 @@ namespace skyline {
      * @tparam L1Bits The size of an L1 segment as a power of 2, this should be lower than L2 and will determine the minimum granularity of the table
      * @tparam L2Bits The size of an L2 segment as a power of 2, this should be higher than L2 and will determine the maximum granularity of the table
      * @tparam EnablePointerAccess Whether or not to enable pointer access to the table, this is useful when host addresses are used as the key for the table
-     * @note This class is **NOT** thread-safe, any access to the table must be protected by a mutex
+     * @note This class is **NOT** thread-safe, any access to the table must be protected by a mutex with the exception of Load(...) which may be used concurrently with Set(...) for pointer and integral segments
      */
     template<typename SegmentType, size_t Size, size_t L1Bits, size_t L2Bits, bool EnablePointerAccess = false> requires std::is_trivial_v<SegmentType>
     class SegmentTable {
@@ -30,7 +30,7 @@ namespace skyline {
             SegmentType segment; //!< The segment associated with the entry, this is 0'd out if the entry is unset
         };
 
-        static constexpr size_t L2Size{1 << L2Bits}, L2Entries{util::DivideCeil(Size, L2Size)}, L1inL2Count{L1Size / L2Size};
+        static constexpr size_t L2Size{1 << L2Bits}, L2Entries{util::DivideCeil(Size, L2Size)}, L1inL2Count{L2Size / L1Size};
         span<RangeEntry, L2Entries> level2Table; //!< The second level of the segment table, this is the lowest granularity of the table
 
         template<typename Type, size_t Amount>
@@ -41,6 +41,22 @@ namespace skyline {
             return span<Type, Amount>(static_cast<Type *>(ptr), Amount);
         }
 
+        static constexpr bool IsAtomicSegment{std::is_pointer_v<SegmentType> || std::is_integral_v<SegmentType>}; //!< If segments can be loaded and stored atomically, this allows for Load(...) to be used concurrently with Set(...)
+
+        /**
+         * @brief Stores a segment with release semantics if it can be done atomically, this is required for concurrent lookups to never observe a torn segment
+         */
+        static void StoreSegment(SegmentType &destination, SegmentType segment) {
+            if constexpr (IsAtomicSegment)
+                __atomic_store_n(&destination, segment, __ATOMIC_RELEASE);
+            else
+                destination = segment;
+        }
+
+        static void StoreValid(RangeEntry &entry, bool valid) {
+            __atomic_store_n(&entry.valid, valid, __ATOMIC_RELEASE);
+        }
+
       public:
         SegmentTable() : level1Table{AllocateTable<SegmentType, L1Entries>()}, level2Table{AllocateTable<RangeEntry, L2Entries>()} {}
 
@@ -84,6 +100,18 @@ namespace skyline {
                 return level1Table[index >> L1Bits];
         }
 
+        /**
+         * @return A copy of the segment at the given index, unlike operator[] this may be called concurrently with Set(...)
+         * @note A concurrent Set(...) covering the index may or may not be observed, the returned segment will always be one that was set at some point however
+         */
+        SegmentType Load(size_t index) const requires IsAtomicSegment {
+            auto &l2Entry{level2Table[index >> L2Bits]};
+            if (__atomic_load_n(&l2Entry.valid, __ATOMIC_ACQUIRE)) [[likely]]
+                return __atomic_load_n(&l2Entry.segment, __ATOMIC_ACQUIRE);
+            else
+                return __atomic_load_n(&level1Table[index >> L1Bits], __ATOMIC_ACQUIRE);
+        }
+
         /**
          * @brief Sets a segment of segments between the start and end to the supplied value
          */
@@ -95,21 +123,22 @@ namespace skyline {
             if (l1StartPaddingStart != l1StartPaddingEnd) {
                 auto &l2Entry{level2Table[start >> L2Bits]};
                 if (l2Entry.valid) {
-                    l2Entry.valid = false;
-
+                    // The L1 entries must be filled in prior to invalidating the L2 entry for concurrent lookups to remain consistent
                     size_t l1L2Start{(start >> L2Bits) << (L2Bits - L1Bits)};
                     for (size_t i{l1L2Start}; i < l1StartPaddingStart; i++)
-                        level1Table[i] = l2Entry.segment;
+                        StoreSegment(level1Table[i], l2Entry.segment);
 
                     for (size_t i{l1StartPaddingStart}; i < l1StartPaddingEnd; i++)
-                        level1Table[i] = segment;
+                        StoreSegment(level1Table[i], segment);
 
                     size_t l1L2End{l2AlignedAddress >> L1Bits};
                     for (size_t i{l1StartPaddingEnd}; i < l1L2End; i++)
-                        level1Table[i] = l2Entry.segment;
+                        StoreSegment(level1Table[i], l2Entry.segment);
+
+                    StoreValid(l2Entry, false);
                 } else {
                     for (size_t i{l1StartPaddingStart}; i < l1StartPaddingEnd; i++)
-                        level1Table[i] = segment;
+                        StoreSegment(level1Table[i], segment);
                 }
             }
 
@@ -120,8 +149,8 @@ namespace skyline {
             size_t l2IndexEnd{end >> L2Bits};
             for (size_t i{l2IndexStart}; i < l2IndexEnd; i++) {
                 auto &l2Entry{level2Table[i]};
-                l2Entry.segment = segment;
-                l2Entry.valid = true;
+                StoreSegment(l2Entry.segment, segment);
+                StoreValid(l2Entry, true);
             }
 
             size_t l1EndPaddingStart{l2IndexEnd << (L2Bits - L1Bits)};
@@ -129,16 +158,16 @@ namespace skyline {
             if (l1EndPaddingStart != l1EndPaddingEnd) {
                 auto &l2Entry{level2Table[l2IndexEnd]};
                 if (l2Entry.valid) {
-                    l2Entry.valid = false;
-
                     for (size_t i{l1EndPaddingStart}; i < l1EndPaddingEnd; i++)
-                        level1Table[i] = segment;
+                        StoreSegment(level1Table[i], segment);
 
                     for (size_t i{l1EndPaddingEnd}; i < l1EndPaddingStart + L1inL2Count; i++)
-                        level1Table[i] = l2Entry.segment;
+                        StoreSegment(level1Table[i], l2Entry.segment);
+
+                    StoreValid(l2Entry, false);
                 } else {
                     for (size_t i{l1EndPaddingStart}; i < l1EndPaddingEnd; i++)
-                        level1Table[i] = segment;
+                        StoreSegment(level1Table[i], segment);
                 }
             }
         }
@@ -151,6 +180,12 @@ namespace skyline {
             return (*this)[reinterpret_cast<size_t>(pointer)];
         }
 
+        template<typename T>
+        requires std::is_pointer_v<T>
+        SegmentType Load(T pointer) const requires IsAtomicSegment {
+            return Load(reinterpret_cast<size_t>(pointer));
+        }
+
         template<typename T>
         requires std::is_pointer_v<T>
         void Set(T pointer, SegmentType segment) {
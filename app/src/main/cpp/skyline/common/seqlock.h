@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "base.h"
+
+namespace skyline {
+    /**
+     * @brief A sequence lock guarding a trivially copyable value, readers never block writers and instead retry their copy if a write raced with it
+     * @note Writers are serialized with each other by spinning on the sequence, so writes should be short
+     * @note This is intended for small snapshots that are written by one thread and periodically consumed by another, such as host input state
+     */
+    template<typename Type> requires std::is_trivially_copyable_v<Type>
+    class SeqLock {
+      private:
+        std::atomic<u32> sequence{}; //!< A counter that is odd while a write is in progress, a change in it implies the value was modified
+        Type value{};
+
+      public:
+        /**
+         * @brief Modifies the value in-place with the supplied function, which is passed a reference to it
+         */
+        template<typename Function>
+        void Write(Function function) {
+            u32 current{sequence.load(std::memory_order_relaxed)};
+            while (true) {
+                if (current & 1) {
+                    std::this_thread::yield();
+                    current = sequence.load(std::memory_order_relaxed);
+                } else if (sequence.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_release); // Orders the sequence becoming odd prior to any stores to the value
+            function(value);
+            sequence.store(current + 2, std::memory_order_release);
+        }
+
+        /**
+         * @param start The sequence of the write that the copy reflects, this can be compared against GetSequence() to detect subsequent writes
+         * @return A consistent copy of the value that isn't torn by any concurrent writes
+         */
+        Type Read(u32 &start) const {
+            Type copy;
+            do {
+                start = sequence.load(std::memory_order_acquire);
+                while (start & 1) {
+                    std::this_thread::yield();
+                    start = sequence.load(std::memory_order_acquire);
+                }
+
+                std::memcpy(&copy, &value, sizeof(Type));
+                std::atomic_thread_fence(std::memory_order_acquire); // Orders the copy prior to the sequence being reloaded
+            } while (sequence.load(std::memory_order_relaxed) != start);
+            return copy;
+        }
+
+        /**
+         * @return A consistent copy of the value that isn't torn by any concurrent writes
+         */
+        Type Read() const {
+            u32 start;
+            return Read(start);
+        }
+
+        /**
+         * @return A value that changes every time the value is written, this can be compared to cheaply detect modification
+         */
+        u32 GetSequence() const {
+            return sequence.load(std::memory_order_acquire);
+        }
+    };
+}
@@ -65,11 +65,16 @@ namespace skyline {
         Setting<language::SystemLanguage> systemLanguage; //!< The system language
         Setting<region::RegionCode> systemRegion; //!< The system region
         Setting<bool> internetEnabled;
+        Setting<bool> enableHugePages; //!< If the guest heap should be backed by transparent huge pages when the host supports them
+        Setting<bool> prefaultGuestMemory; //!< If executable segments should have all their pages faulted in when they're loaded
 
         // Display
         Setting<bool> forceTripleBuffering; //!< If the presentation engine should always triple buffer even if the swapchain supports double buffering
+        Setting<u32> frameLatency; //!< The maximum amount of frames that can be in flight on the host GPU prior to presentation blocking, lower values reduce input latency at the cost of throughput
         Setting<bool> disableFrameThrottling; //!< Allow the guest to submit frames without any blocking calls
+        Setting<bool> enableFramePacing; //!< If frames should be presented on a stable cadence of display refreshes, this withholds V-Sync signals from the guest on refreshes that are skipped by the cadence
         Setting<bool> disableShaderCache;  //!< Prevents cached shaders from being loaded and disables caching of new shaders
+        Setting<u32> resolutionScale; //!< The percentage of the guest resolution that render targets are rendered at on the host, this is hidden in the UI as shader accesses in texel coordinates (gl_FragCoord, texelFetch, textureSize) aren't rescaled yet
 
         // GPU
         Setting<std::string> gpuDriver; //!< The label of the GPU driver to use
@@ -90,6 +95,7 @@ namespace skyline {
 
         // Debug
         Setting<bool> validationLayer; //!< If the vulkan validation layer is enabled
+        Setting<bool> gpfifoCapture; //!< If a trace of all pushbuffers processed by each GPU channel and the guest memory they reference should be captured, see GpfifoCapture
 
         Settings() = default;
 
@@ -16,7 +16,9 @@ PERFETTO_DEFINE_CATEGORIES(
     perfetto::Category("host").SetDescription("Events relating to host code"),
     perfetto::Category("gpu").SetDescription("Events from the emulated GPU"),
     perfetto::Category("service").SetDescription("Events from the HLE sysmodule implementations"),
-    perfetto::Category("containers").SetDescription("Events from custom container implementations")
+    perfetto::Category("audio").SetDescription("Events from the audio output backend"),
+    perfetto::Category("containers").SetDescription("Events from custom container implementations"),
+    perfetto::Category("perf").SetDescription("Counters from the performance counter registry")
 );
 
 namespace skyline::trace {
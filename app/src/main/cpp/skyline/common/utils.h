@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <random>
 #include <span>
 #include <frozen/unordered_map.h>
@@ -41,10 +42,27 @@ namespace skyline::util {
             else if (board == "s5e8825")        // Exynos 1280
                 frequency = 26000000;
             else
+                #if defined(__aarch64__)
                 asm volatile("MRS %0, CNTFRQ_EL0" : "=r"(frequency));
+                #else
+                frequency = constant::NsInSecond; // Host builds on other architectures use the steady clock as the system counter
+                #endif
 
             return frequency;
         }
+
+        /**
+         * @return The current value of the system counter
+         */
+        inline u64 ReadSystemCounter() {
+            #if defined(__aarch64__)
+            u64 ticks;
+            asm volatile("MRS %0, CNTVCT_EL0" : "=r"(ticks));
+            return ticks;
+            #else
+            return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+            #endif
+        }
     }
 
     inline const u64 ClockFrequency{detail::InitFrequency()}; //!< The system counter clock frequency in Hz
@@ -55,8 +73,7 @@ namespace skyline::util {
      */
     inline i64 GetTimeNs() {
         u64 frequency{ClockFrequency};
-        u64 ticks;
-        asm volatile("MRS %0, CNTVCT_EL0" : "=r"(ticks));
+        u64 ticks{detail::ReadSystemCounter()};
         return static_cast<i64>(((ticks / frequency) * constant::NsInSecond) + (((ticks % frequency) * constant::NsInSecond + (frequency / 2)) / frequency));
     }
 
@@ -65,9 +82,7 @@ namespace skyline::util {
      * @return The current time in ticks
      */
     inline u64 GetTimeTicks() {
-        u64 ticks;
-        asm volatile("MRS %0, CNTVCT_EL0" : "=r"(ticks));
-        return ticks;
+        return detail::ReadSystemCounter();
     }
 
     /**
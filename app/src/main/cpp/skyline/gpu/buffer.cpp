@@ -116,6 +116,28 @@ namespace skyline::gpu {
         });
     }
 
+    void Buffer::TrackGuestWrites() {
+        if (SequencedCpuBackingWritesBlocked()) {
+            // Guest writes have to be sequenced against GPU usage of the backing while it's blocked, this is only possible with traps
+            gpu.state.nce->TrapRegions(*trapHandle, true);
+            writesTracked = false;
+            return;
+        }
+
+        writesTracked = gpu.state.nce->TrackWrites(*trapHandle);
+    }
+
+    void Buffer::CollectGuestWrites() {
+        if (writesTracked && dirtyState == DirtyState::Clean && gpu.state.nce->CollectWrites(*trapHandle))
+            dirtyState = DirtyState::CpuDirty;
+    }
+
+    void Buffer::TrapTrackedGuestWrites() {
+        CollectGuestWrites();
+        gpu.state.nce->TrapRegions(*trapHandle, true);
+        writesTracked = false;
+    }
+
     void Buffer::InsertWriteIntervalDirect(WriteTrackingInterval entry) {
         auto firstIt{std::lower_bound(directTrackedWrites.begin(), directTrackedWrites.end(), entry, [](const auto &lhs, const auto &rhs) {
             return lhs.end < rhs.offset;
@@ -255,6 +277,7 @@ namespace skyline::gpu {
 
     void Buffer::CopyFromImplStaged(vk::DeviceSize dstOffset, Buffer *src, vk::DeviceSize srcOffset, vk::DeviceSize size, const std::function<void()> &gpuCopyCallback) {
         std::scoped_lock lock{stateMutex, src->stateMutex}; // Fine even if src and dst are same since recursive mutex
+        CollectGuestWrites(); // Any tracked guest writes need to be accounted for before the CPU dirty state is relied upon
 
         if (dirtyState == DirtyState::CpuDirty && SequencedCpuBackingWritesBlocked())
             // If the buffer is used in sequence directly on the GPU, SynchronizeHost before modifying the mirror contents to ensure proper sequencing. This write will then be sequenced on the GPU instead (the buffer will be kept clean for the rest of the execution due to gpuCopyCallback blocking all writes)
@@ -311,6 +334,7 @@ namespace skyline::gpu {
     bool Buffer::WriteImplStaged(span<u8> data, vk::DeviceSize offset, const std::function<void()> &gpuCopyCallback) {
         // We cannot have *ANY* state changes for the duration of this function, if the buffer became CPU dirty partway through the GPU writes would mismatch the CPU writes
         std::scoped_lock lock{stateMutex};
+        CollectGuestWrites(); // Any tracked guest writes need to be accounted for before the CPU dirty state is relied upon
 
         // If the buffer is GPU dirty do the write on the GPU and we're done
         if (dirtyState == DirtyState::GpuDirty) {
@@ -381,7 +405,9 @@ namespace skyline::gpu {
         if (dirtyState == DirtyState::GpuDirty)
             return;
 
+        CollectGuestWrites();
         gpu.state.nce->TrapRegions(*trapHandle, false); // This has to occur prior to any synchronization as it'll skip trapping
+        writesTracked = false;
 
         if (dirtyState == DirtyState::CpuDirty)
             SynchronizeHost(true); // Will transition the Buffer to Clean
@@ -476,6 +502,7 @@ namespace skyline::gpu {
 
         {
             std::scoped_lock lock{stateMutex};
+            CollectGuestWrites();
             if (dirtyState != DirtyState::CpuDirty)
                 return;
 
@@ -485,7 +512,7 @@ namespace skyline::gpu {
             AdvanceSequence(); // We are modifying GPU backing contents so advance to the next sequence
 
             if (!skipTrap)
-                gpu.state.nce->TrapRegions(*trapHandle, true); // Trap any future CPU writes to this buffer, must be done before the memcpy so that any modifications during the copy are tracked
+                TrackGuestWrites(); // Track any future CPU writes to this buffer, must be done before the memcpy so that any modifications during the copy are tracked
         }
 
         std::memcpy(backing->data(), mirror.data(), mirror.size());
@@ -510,10 +537,10 @@ namespace skyline::gpu {
             std::memcpy(mirror.data(), backing->data(), mirror.size());
 
             dirtyState = DirtyState::Clean;
-        }
 
-        if (!skipTrap)
-            gpu.state.nce->TrapRegions(*trapHandle, true);
+            if (!skipTrap)
+                TrackGuestWrites();
+        }
 
         return true;
     }
@@ -65,6 +65,7 @@ namespace skyline::gpu {
         std::optional<memory::ImportedBuffer> directBacking;
 
         std::optional<nce::NCE::TrapHandle> trapHandle{}; //!< (Staged) The handle of the traps for the guest mappings
+        bool writesTracked{}; //!< (Staged) If guest writes are tracked asynchronously rather than trapped, they must be collected with CollectGuestWrites() prior to relying on the CPU dirty state, checks against GpuDirty alone don't require this as tracked writes only ever transition Clean to CpuDirty
 
         enum class DirtyState {
             Clean, //!< The CPU mappings are in sync with the GPU buffer
@@ -128,6 +129,26 @@ namespace skyline::gpu {
 
         void SetupStagedTraps();
 
+        /**
+         * @brief Tracks any future guest writes to the buffer asynchronously when supported, otherwise they are trapped
+         * @note Writes are always trapped while any CPU backing writes are blocked
+         * @note The state mutex **must** be locked prior to calling this
+         */
+        void TrackGuestWrites();
+
+        /**
+         * @brief Transitions a clean buffer to being CPU dirty if any asynchronously tracked guest writes were made to it
+         * @note The state mutex **must** be locked prior to calling this
+         */
+        void CollectGuestWrites();
+
+        /**
+         * @brief Switches from asynchronously tracking guest writes to trapping them after collecting any prior writes
+         * @note This is required while any CPU backing writes are blocked as tracked writes can't be sequenced against the GPU like trapped ones are
+         * @note The state mutex **must** be locked prior to calling this
+         */
+        void TrapTrackedGuestWrites();
+
         /**
          * @brief Forces future accesses to the given interval to use the shadow copy
          */
@@ -260,6 +281,9 @@ namespace skyline::gpu {
             if (!isDirect)
                 lock.lock();
 
+            if (writesTracked)
+                TrapTrackedGuestWrites();
+
             if (backingImmutability == BackingImmutability::None)
                 backingImmutability = BackingImmutability::SequencedWrites;
         }
@@ -273,6 +297,9 @@ namespace skyline::gpu {
             if (!isDirect)
                 lock.lock();
 
+            if (writesTracked)
+                TrapTrackedGuestWrites();
+
             backingImmutability = BackingImmutability::AllWrites;
         }
 
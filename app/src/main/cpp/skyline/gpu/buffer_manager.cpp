@@ -8,6 +8,18 @@
 namespace skyline::gpu {
     BufferManager::BufferManager(GPU &gpu) : gpu{gpu} {}
 
+    void BufferManager::lock() {
+        mutex.lock();
+    }
+
+    void BufferManager::unlock() {
+        mutex.unlock();
+    }
+
+    bool BufferManager::try_lock() {
+        return mutex.try_lock();
+    }
+
     bool BufferManager::BufferLessThan(const std::shared_ptr<Buffer> &it, u8 *pointer) {
         return it->guest->begin().base() < pointer;
     }
@@ -41,6 +53,14 @@ namespace skyline::gpu {
         return overlaps;
     }
 
+    bool BufferManager::IsGpuDirty(span<u8> range, ContextTag tag) {
+        for (auto &buffer : Lookup(range, tag))
+            if (buffer->isDirect ? buffer->directGpuWritesActive : buffer->dirtyState == Buffer::DirtyState::GpuDirty)
+                return true;
+
+        return false;
+    }
+
     void BufferManager::InsertBuffer(std::shared_ptr<Buffer> buffer) {
         auto bufferStart{buffer->guest->begin().base()}, bufferEnd{buffer->guest->end().base()};
         bufferTable.Set(bufferStart, bufferEnd, buffer.get());
@@ -15,6 +15,7 @@ namespace skyline::gpu {
     class BufferManager {
       private:
         GPU &gpu;
+        RecursiveSpinLock mutex; //!< Synchronizes accesses to the buffer mappings, recursive as attaching buffers during lookups may re-enter the manager
         std::vector<std::shared_ptr<Buffer>> bufferMappings; //!< A sorted vector of all buffer mappings
         LinearAllocatorState<> delegateAllocatorState; //!< Linear allocator used to allocate buffer delegates
         size_t nextBufferId{}; //!< The next unique buffer id to be assigned
@@ -74,13 +75,13 @@ namespace skyline::gpu {
         BufferManager(GPU &gpu);
 
         /**
-         * @brief Acquires an exclusive lock on the texture for the calling thread
+         * @brief Acquires an exclusive lock on the buffer manager for the calling thread
          * @note Naming is in accordance to the BasicLockable named requirement
          */
         void lock();
 
         /**
-         * @brief Relinquishes an existing lock on the texture by the calling thread
+         * @brief Relinquishes an existing lock on the buffer manager by the calling thread
          * @note Naming is in accordance to the BasicLockable named requirement
          */
         void unlock();
@@ -98,6 +99,16 @@ namespace skyline::gpu {
          */
         BufferView FindOrCreateImpl(GuestBuffer guestMapping, ContextTag tag, const std::function<void(std::shared_ptr<Buffer>, ContextLock<Buffer> &&)> &attachBuffer);
 
+        /**
+         * @return If any buffer overlapping the supplied range may have GPU writes which haven't been synchronized to the guest
+         * @note The buffer manager **must** be locked prior to calling this
+         */
+        bool IsGpuDirty(span<u8> range, ContextTag tag);
+
+        /**
+         * @return A pre-existing or newly created Buffer object which covers the supplied mappings
+         * @note The buffer manager **must** be locked prior to calling this
+         */
         BufferView FindOrCreate(GuestBuffer guestMapping, ContextTag tag = {}, const std::function<void(std::shared_ptr<Buffer>, ContextLock<Buffer> &&)> &attachBuffer = {}) {
             auto lookupBuffer{bufferTable[guestMapping.begin().base()]};
             if (lookupBuffer != nullptr)
@@ -7,6 +7,7 @@
 #include <vulkan/vulkan_raii.hpp>
 #include <common.h>
 #include <common/spin_lock.h>
+#include <common/perf_counters.h>
 #include <common/atomic_forward_list.h>
 
 namespace skyline::gpu {
@@ -25,6 +26,8 @@ namespace skyline::gpu {
         std::recursive_timed_mutex mutex;
         std::condition_variable_any submitCondition;
         bool submitted{}; //!< If the fence has been submitted to the GPU
+        i64 submitTimestamp{}; //!< The time at which the fence was submitted to the GPU in nanoseconds
+        std::atomic<i64> signalTimestamp{}; //!< The time at which the fence was first observed to be signalled in nanoseconds, this is 0 if it hasn't been
         vk::Fence fence;
         vk::Semaphore semaphore; //!< Semaphore that will be signalled upon GPU completion of the fence
         bool semaphoreSubmitWait{}; //!< If the semaphore needs to be waited on (on GPU) before the fence's command buffer begins. Used to ensure fences that wouldn't otherwise be unsignalled are unsignalled
@@ -155,6 +158,9 @@ namespace skyline::gpu {
                 return;
             }
 
+            perf::Add(perf::Counter::FenceWaits);
+            i64 waitStartTime{util::GetTimeNs()};
+
             vk::Result waitResult;
             while ((waitResult = (*device).waitForFences(1, &fence, false, std::numeric_limits<u64>::max(), *device.getDispatcher())) != vk::Result::eSuccess) {
                 if (waitResult == vk::Result::eTimeout)
@@ -167,10 +173,12 @@ namespace skyline::gpu {
 
                 throw exception("An error occurred while waiting for fence 0x{:X}: {}", static_cast<VkFence>(fence), vk::to_string(waitResult));
             }
+            perf::Record(perf::Histogram::FenceWaitTime, static_cast<u64>((util::GetTimeNs() - waitStartTime) / constant::NsInMicrosecond));
 
             if (semaphoreUnsignalCycle)
                 semaphoreUnsignalCycle->Wait();
 
+            signalTimestamp.store(util::GetTimeNs(), std::memory_order_release);
             signalled.test_and_set(std::memory_order_relaxed);
             if (shouldDestroy)
                 DestroyDependencies();
@@ -222,6 +230,7 @@ namespace skyline::gpu {
                 if (semaphoreUnsignalCycle && !semaphoreUnsignalCycle->Poll())
                     return false;
 
+                signalTimestamp.store(util::GetTimeNs(), std::memory_order_release);
                 signalled.test_and_set(std::memory_order_relaxed);
                 if (shouldDestroy)
                     DestroyDependencies();
@@ -265,7 +274,24 @@ namespace skyline::gpu {
         void NotifySubmitted() {
             std::scoped_lock lock{mutex};
             submitted = true;
+            submitTimestamp = util::GetTimeNs();
             submitCondition.notify_all();
         }
+
+        /**
+         * @return The duration between the fence being submitted and being signalled in nanoseconds, std::nullopt if the fence hasn't been signalled through a wait on the GPU fence
+         * @note The signal is generally observed by the cycle waiter thread shortly after GPU completion, so this is a close upper bound on the GPU execution time
+         */
+        std::optional<i64> GetExecutionTime() {
+            if (!signalled.test(std::memory_order_acquire))
+                return std::nullopt;
+
+            i64 signalTime{signalTimestamp.load(std::memory_order_acquire)};
+            if (!signalTime)
+                return std::nullopt; // The cycle was cancelled or created signalled
+
+            std::scoped_lock lock{mutex};
+            return signalTime - submitTimestamp;
+        }
     };
 }
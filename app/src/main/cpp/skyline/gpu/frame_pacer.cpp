@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "frame_pacer.h"
+
+namespace skyline::gpu {
+    void FramePacer::UpdateCadence(i64 refreshCycleDuration) {
+        if (intervalCount < HistorySize / 2)
+            return; // There aren't enough samples to make a decision yet
+
+        std::array<i64, HistorySize> sorted{intervals};
+        auto percentile{sorted.begin() + static_cast<ssize_t>((intervalCount * IntervalPercentile) / 100)};
+        std::nth_element(sorted.begin(), percentile, sorted.begin() + static_cast<ssize_t>(intervalCount));
+        i64 interval{*percentile};
+
+        u32 current{cadence.load(std::memory_order_relaxed)}, next{current};
+        if (interval * 100 > current * refreshCycleDuration * RaiseThresholdPercent)
+            // Frames are regularly missing their refresh, we hold them for as many refreshes as they take to be consistent
+            next = std::max(current + 1, static_cast<u32>(util::DivideCeil(interval, refreshCycleDuration)));
+        else if (current > 1 && interval * 100 <= (current - 1) * refreshCycleDuration * LowerThresholdPercent)
+            // Frames consistently fit within fewer refreshes with some headroom, the headroom avoids oscillating between cadences
+            next = current - 1;
+
+        next = std::clamp(next, 1U, MaxCadence);
+        if (next != current) {
+            Logger::Debug("Frame pacing cadence changed from {} to {} refreshes ({}th percentile frame interval: {:.2f}ms)", current, next, IntervalPercentile, static_cast<double>(interval) / constant::NsInMillisecond);
+            cadence.store(next, std::memory_order_relaxed);
+            TRACE_COUNTER("gpu", perfetto::CounterTrack("Frame Pacing Cadence"), next);
+
+            // The history reflects the previous cadence, clearing it prevents immediately switching again
+            intervalCount = 0;
+            intervalIndex = 0;
+        }
+    }
+
+    void FramePacer::RecordCopyTime(i64 executionTime) {
+        averageCopyTime = averageCopyTime ? ((averageCopyTime * 7) + executionTime) / 8 : executionTime;
+    }
+
+    i64 FramePacer::Schedule(i64 readyTime, i64 currentTime, i64 refreshCycleDuration, i64 lastVsyncTime, i64 swapInterval) {
+        if (lastReadyTime) {
+            intervals[intervalIndex] = readyTime - lastReadyTime;
+            intervalIndex = (intervalIndex + 1) % HistorySize;
+            intervalCount = std::min(intervalCount + 1, HistorySize);
+        }
+        lastReadyTime = readyTime;
+
+        if (!refreshCycleDuration || !lastVsyncTime)
+            return 0; // We can't schedule anything without knowing the display timing
+
+        UpdateCadence(refreshCycleDuration);
+
+        // A frame can be displayed no earlier than the refresh after the presentation copy completes, as the compositor latches buffers a refresh ahead
+        i64 earliestTime{currentTime + averageCopyTime + refreshCycleDuration};
+        i64 interval{std::max(static_cast<i64>(cadence.load(std::memory_order_relaxed)), swapInterval)};
+        lastSwapInterval.store(swapInterval, std::memory_order_relaxed);
+        i64 lastTarget{lastTargetTime.load(std::memory_order_relaxed)};
+        i64 targetTime{lastTarget ? lastTarget + (interval * refreshCycleDuration) : earliestTime};
+        if (targetTime < earliestTime) {
+            TRACE_EVENT_INSTANT("gpu", "Missed Frame Pacing Target", "LateNs", earliestTime - targetTime);
+            targetTime = earliestTime; // We've fallen behind the cadence, it's restarted from the earliest refresh possible
+        }
+
+        // Targets are snapped to the nearest refresh so that small deviations in the refresh cycle duration don't accumulate
+        i64 refreshes{(std::max(targetTime - lastVsyncTime, i64{}) + (refreshCycleDuration / 2)) / refreshCycleDuration};
+        targetTime = lastVsyncTime + (refreshes * refreshCycleDuration);
+        if (targetTime < earliestTime)
+            targetTime += refreshCycleDuration;
+
+        lastTargetTime.store(targetTime, std::memory_order_relaxed);
+        return targetTime;
+    }
+
+    void FramePacer::RecordFrameTime(i64 frameTime) {
+        constexpr std::array<const char *, HistogramBuckets.size()> HistogramBucketNames{
+            "Frame Time Histogram: <8.3ms",
+            "Frame Time Histogram: 8.3-16.7ms",
+            "Frame Time Histogram: 16.7-25ms",
+            "Frame Time Histogram: 25-33.3ms",
+            "Frame Time Histogram: 33.3-50ms",
+            "Frame Time Histogram: >50ms",
+        };
+
+        size_t bucket{static_cast<size_t>(std::distance(HistogramBuckets.begin(), std::lower_bound(HistogramBuckets.begin(), HistogramBuckets.end(), frameTime)))};
+        histogram[bucket]++;
+        TRACE_COUNTER("gpu", perfetto::CounterTrack(HistogramBucketNames[bucket]), histogram[bucket]);
+    }
+
+    bool FramePacer::ShouldSignalVsync(i64 vsyncTime, i64 refreshCycleDuration) {
+        u32 currentCadence{cadence.load(std::memory_order_relaxed)};
+        i64 lastTarget{lastTargetTime.load(std::memory_order_relaxed)};
+        if (static_cast<i64>(currentCadence) <= lastSwapInterval.load(std::memory_order_relaxed) || !lastTarget || !refreshCycleDuration)
+            return true; // The guest is already pacing itself to the cadence, it might depend on every V-Sync being signalled for timing
+
+        // The guest is only woken up on refreshes which a frame could be presented on, so it begins rendering in phase with the cadence
+        i64 refreshes{(std::abs(vsyncTime - lastTarget) + (refreshCycleDuration / 2)) / refreshCycleDuration};
+        return refreshes % currentCadence == 0;
+    }
+
+    void FramePacer::Reset() {
+        intervalCount = 0;
+        intervalIndex = 0;
+        lastReadyTime = 0;
+        cadence.store(1, std::memory_order_relaxed);
+        lastTargetTime.store(0, std::memory_order_relaxed);
+        lastSwapInterval.store(0, std::memory_order_relaxed);
+    }
+}
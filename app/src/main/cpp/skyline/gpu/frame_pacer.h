@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common/trace.h>
+
+namespace skyline::gpu {
+    /**
+     * @brief Paces presentation to a consistent cadence of display refreshes, trading a lower framerate for evenly spaced frames when the guest can't sustain a higher one
+     * @note The cadence is derived from the recent interval between frames becoming presentable, which includes guest GPU completion, and the GPU time of the presentation copy
+     * @note All timestamps are in nanoseconds on the CLOCK_MONOTONIC timebase that the window and Choreographer use
+     */
+    class FramePacer {
+      private:
+        static constexpr size_t HistorySize{32}; //!< The amount of frames which the cadence is determined by, this should cover roughly half a second
+        static constexpr u32 MaxCadence{4}; //!< The maximum amount of refreshes a frame will be held for, beyond this consistency doesn't matter anymore
+        static constexpr i64 RaiseThresholdPercent{105}; //!< A cadence is raised when the frame interval percentile exceeds this percentage of its duration
+        static constexpr i64 LowerThresholdPercent{90}; //!< A cadence is lowered when the frame interval percentile fits within this percentage of the lower cadence's duration
+        static constexpr size_t IntervalPercentile{90}; //!< The percentile of frame intervals that is compared against the thresholds, outliers above this are accepted as stutters
+
+        std::array<i64, HistorySize> intervals{}; //!< A ring buffer of the intervals between the most recent frames becoming presentable
+        size_t intervalIndex{};
+        size_t intervalCount{};
+        i64 lastReadyTime{}; //!< The time at which the previous frame became presentable
+        i64 averageCopyTime{}; //!< A moving average of the GPU execution time of the presentation copy
+
+        std::atomic<u32> cadence{1}; //!< The amount of display refreshes each frame is currently held for
+        std::atomic<i64> lastTargetTime{}; //!< The present time targeted by the previous frame
+        std::atomic<i64> lastSwapInterval{}; //!< The swap interval requested by the guest for the previous frame
+
+        static constexpr std::array<i64, 6> HistogramBuckets{8'333'333, 16'666'667, 25'000'000, 33'333'333, 50'000'000, std::numeric_limits<i64>::max()}; //!< The upper bounds of each frame-time histogram bucket
+        std::array<u64, HistogramBuckets.size()> histogram{}; //!< The amount of presented frames with a frame time inside each bucket
+
+        /**
+         * @brief Re-evaluates the cadence based on the interval history
+         */
+        void UpdateCadence(i64 refreshCycleDuration);
+
+      public:
+        /**
+         * @brief Records the GPU execution time of the presentation copy of a prior frame
+         */
+        void RecordCopyTime(i64 executionTime);
+
+        /**
+         * @brief Records that a frame has become presentable and determines the time it should be presented at
+         * @param readyTime The time at which the frame became presentable, after all guest GPU work for it was completed
+         * @param currentTime The current time, the frame can't be presented earlier than a refresh after this
+         * @param lastVsyncTime The time of the most recent display refresh
+         * @param swapInterval The minimum amount of refreshes requested by the guest between frames
+         * @return The timestamp the frame should be presented at
+         */
+        i64 Schedule(i64 readyTime, i64 currentTime, i64 refreshCycleDuration, i64 lastVsyncTime, i64 swapInterval);
+
+        /**
+         * @brief Records the interval between the presented frame and the prior one in the frame-time histogram
+         */
+        void RecordFrameTime(i64 frameTime);
+
+        /**
+         * @return If the guest V-Sync event should be signalled on the display refresh at the supplied time, refreshes that can't have a frame presented on them with the current cadence are skipped
+         */
+        bool ShouldSignalVsync(i64 vsyncTime, i64 refreshCycleDuration);
+
+        /**
+         * @brief Resets all history, this should be used when the pacing is disabled or the timing has been disrupted by a swapchain recreation
+         */
+        void Reset();
+    };
+}
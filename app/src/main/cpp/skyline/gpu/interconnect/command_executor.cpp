@@ -8,6 +8,7 @@
 #include <common/settings.h>
 #include <loader/loader.h>
 #include <gpu.h>
+#include <soc/host1x/syncpoint.h>
 #include <dlfcn.h>
 #include "command_executor.h"
 #include <nce.h>
@@ -197,6 +198,14 @@ namespace skyline::gpu::interconnect {
         incoming.Push(slot);
     }
 
+    void ExecutionWaiterThread::FlushIncrements() {
+        for (size_t i{}; i < batchedIncrementCount; i++) {
+            auto &[syncpoint, amount]{batchedIncrements[i]};
+            syncpoint->Increment(amount);
+        }
+        batchedIncrementCount = 0;
+    }
+
     void ExecutionWaiterThread::Run() {
         signal::SetSignalHandler({SIGSEGV}, nce::NCE::HostSignalHandler); // We may access NCE trapped memory
 
@@ -205,10 +214,17 @@ namespace skyline::gpu::interconnect {
             adrenotools_set_turbo(true);
 
         while (true) {
-            std::pair<std::shared_ptr<FenceCycle>, std::function<void()>> item{};
+            PendingSignal item{};
             {
                 std::unique_lock lock{mutex};
                 if (pendingSignalQueue.empty()) {
+                    // Any batched increments need to be applied prior to waiting as there might not be anything else queued to flush them
+                    if (batchedIncrementCount) {
+                        lock.unlock();
+                        FlushIncrements();
+                        continue;
+                    }
+
                     idle = true;
 
                     // Don't force turbo clocks when the GPU is idle
@@ -226,14 +242,32 @@ namespace skyline::gpu::interconnect {
                 item = std::move(pendingSignalQueue.front());
                 pendingSignalQueue.pop();
             }
-            {
+
+            if (item.cycle) {
+                // Increments for completed work shouldn't be held back while waiting on the GPU for further work
+                if (batchedIncrementCount && !item.cycle->Poll(false))
+                    FlushIncrements();
+
                 TRACE_EVENT("gpu", "GPU");
-                if (item.first)
-                    item.first->Wait();
+                item.cycle->Wait();
+            }
+
+            if (item.callback) {
+                // Callbacks are ordered after all prior increments as the guest may depend on them
+                FlushIncrements();
+                item.callback();
             }
 
-            if (item.second)
-                item.second();
+            if (item.syncpoint) {
+                auto batched{std::find_if(batchedIncrements.begin(), batchedIncrements.begin() + static_cast<ssize_t>(batchedIncrementCount), [&](const auto &increment) { return increment.first == item.syncpoint; })};
+                if (batched != batchedIncrements.begin() + static_cast<ssize_t>(batchedIncrementCount)) {
+                    batched->second++;
+                } else {
+                    if (batchedIncrementCount == MaxBatchedSyncpoints)
+                        FlushIncrements();
+                    batchedIncrements[batchedIncrementCount++] = {item.syncpoint, 1};
+                }
+            }
         }
     }
 
@@ -243,9 +277,9 @@ namespace skyline::gpu::interconnect {
         return idle;
     }
 
-    void ExecutionWaiterThread::Queue(std::shared_ptr<FenceCycle> cycle, std::function<void()> &&callback) {
+    void ExecutionWaiterThread::Queue(std::shared_ptr<FenceCycle> cycle, std::function<void()> &&callback, soc::host1x::Syncpoint *syncpoint) {
         std::unique_lock lock{mutex};
-        pendingSignalQueue.push({std::move(cycle), std::move(callback)});
+        pendingSignalQueue.push({std::move(cycle), std::move(callback), syncpoint});
         condition.notify_all();
     }
 
@@ -503,6 +537,10 @@ namespace skyline::gpu::interconnect {
         pipelineChangeCallbacks.emplace_back(std::forward<decltype(callback)>(callback));
     }
 
+    void CommandExecutor::AddCompletionCallback(std::function<void()> &&callback) {
+        completionCallbacks.emplace_back(std::forward<decltype(callback)>(callback));
+    }
+
     void CommandExecutor::NotifyPipelineChange() {
         for (auto &callback : pipelineChangeCallbacks)
             callback();
@@ -570,17 +608,22 @@ namespace skyline::gpu::interconnect {
         }
     }
 
-    void CommandExecutor::Submit(std::function<void()> &&callback, bool wait) {
+    void CommandExecutor::SubmitImpl(std::function<void()> &&callback, soc::host1x::Syncpoint *syncpoint, bool wait) {
         for (const auto &flushCallback : flushCallbacks)
             flushCallback();
 
         executionTag = AllocateTag();
 
+        // Completion callbacks may write GPU results to guest memory, the submission callback must be ordered after them so the guest can't observe it before the results
+        bool deferCallback{*state.settings->useDirectMemoryImport || !completionCallbacks.empty()};
         if (!slot->nodes.empty()) {
             TRACE_EVENT("gpu", "CommandExecutor::Submit");
 
-            if (callback && *state.settings->useDirectMemoryImport)
-                waiterThread.Queue(cycle, std::move(callback));
+            for (auto &completionCallback : completionCallbacks)
+                waiterThread.Queue(cycle, std::move(completionCallback));
+
+            if ((callback || syncpoint) && deferCallback)
+                waiterThread.Queue(cycle, std::move(callback), syncpoint);
             else
                 waiterThread.Queue(cycle, {});
 
@@ -588,12 +631,20 @@ namespace skyline::gpu::interconnect {
             submissionNumber++;
 
         } else {
-            if (callback && *state.settings->useDirectMemoryImport)
-                waiterThread.Queue(nullptr, std::move(callback));
+            for (auto &completionCallback : completionCallbacks)
+                waiterThread.Queue(nullptr, std::move(completionCallback));
+
+            if ((callback || syncpoint) && deferCallback)
+                waiterThread.Queue(nullptr, std::move(callback), syncpoint);
         }
+        completionCallbacks.clear();
 
-        if (callback && !*state.settings->useDirectMemoryImport)
-            callback();
+        if (!deferCallback) {
+            if (callback)
+                callback();
+            if (syncpoint)
+                syncpoint->Increment();
+        }
 
         ResetInternal();
 
@@ -613,6 +664,14 @@ namespace skyline::gpu::interconnect {
         }
     }
 
+    void CommandExecutor::Submit(std::function<void()> &&callback, bool wait) {
+        SubmitImpl(std::move(callback), nullptr, wait);
+    }
+
+    void CommandExecutor::SubmitWithSyncpointIncrement(soc::host1x::Syncpoint &syncpoint) {
+        SubmitImpl({}, &syncpoint, false);
+    }
+
     void CommandExecutor::LockPreserve() {
         if (!preserveLocked) {
             preserveLocked = true;
@@ -10,6 +10,10 @@
 #include "command_nodes.h"
 #include "common/spin_lock.h"
 
+namespace skyline::soc::host1x {
+    class Syncpoint;
+}
+
 namespace skyline::gpu::interconnect {
     /*
      * @brief Thread responsible for recording Vulkan commands from the execution nodes and submitting them
@@ -102,9 +106,26 @@ namespace skyline::gpu::interconnect {
         std::thread thread;
         SpinLock mutex;
         std::condition_variable_any condition;
-        std::queue<std::pair<std::shared_ptr<FenceCycle>, std::function<void()>>> pendingSignalQueue; //!< Queue of callbacks to be executed when their coressponding fence is signalled
+        /**
+         * @brief A callback and/or syncpoint increment to be done once the corresponding fence is signalled
+         */
+        struct PendingSignal {
+            std::shared_ptr<FenceCycle> cycle;
+            std::function<void()> callback;
+            soc::host1x::Syncpoint *syncpoint; //!< A syncpoint to increment after the callback, consecutive increments are batched into a single update
+        };
+        std::queue<PendingSignal> pendingSignalQueue; //!< Queue of callbacks to be executed when their coressponding fence is signalled
         std::atomic<bool> idle{};
 
+        static constexpr size_t MaxBatchedSyncpoints{8}; //!< The maximum amount of distinct syncpoints that increments can be batched for prior to being flushed
+        std::array<std::pair<soc::host1x::Syncpoint *, u32>, MaxBatchedSyncpoints> batchedIncrements{}; //!< Syncpoint increments which have been completed by the GPU but not yet applied, only accessed by the waiter thread
+        size_t batchedIncrementCount{};
+
+        /**
+         * @brief Applies all batched syncpoint increments, each syncpoint is only updated once regardless of the amount of increments to it
+         */
+        void FlushIncrements();
+
         void Run();
 
       public:
@@ -115,7 +136,7 @@ namespace skyline::gpu::interconnect {
         /**
          * @brief Queues `callback` to be executed when `cycle` is signalled, null values are valid for either, will null cycle representing an immediate callback (dep on previously queued cycles) and null callback representing a wait with no callback
          */
-        void Queue(std::shared_ptr<FenceCycle> cycle, std::function<void()> &&callback);
+        void Queue(std::shared_ptr<FenceCycle> cycle, std::function<void()> &&callback, soc::host1x::Syncpoint *syncpoint = nullptr);
     };
 
     /**
@@ -181,6 +202,7 @@ namespace skyline::gpu::interconnect {
 
         std::vector<std::function<void()>> flushCallbacks; //!< Set of persistent callbacks that will be called at the start of Execute in order to flush data required for recording
         std::vector<std::function<void()>> pipelineChangeCallbacks; //!< Set of persistent callbacks that will be called after any non-Maxwell 3D engine changes the active pipeline
+        std::vector<std::function<void()>> completionCallbacks; //!< Set of callbacks that will be called upon GPU completion of the current execution
 
         void RotateRecordSlot();
 
@@ -203,6 +225,11 @@ namespace skyline::gpu::interconnect {
          */
         void SubmitInternal();
 
+        /**
+         * @brief Implements Submit(...) with an optional syncpoint to increment alongside the callback
+         */
+        void SubmitImpl(std::function<void()> &&callback, soc::host1x::Syncpoint *syncpoint, bool wait);
+
         /**
          * @brief Resets all the internal state, this must be called before starting a new submission as it clears everything from a past submission
          */
@@ -298,6 +325,12 @@ namespace skyline::gpu::interconnect {
          */
         void AddPipelineChangeCallback(std::function<void()> &&callback);
 
+        /**
+         * @brief Adds a callback that will be called on the waiter thread upon GPU completion of the current execution, unlike the callback supplied to Submit this doesn't force a submission
+         * @note Any callback supplied to the submission of this execution will only be called after all completion callbacks
+         */
+        void AddCompletionCallback(std::function<void()> &&callback);
+
         /**
          * @brief Calls all registered pipeline change callbacks
          */
@@ -310,6 +343,12 @@ namespace skyline::gpu::interconnect {
          */
         void Submit(std::function<void()> &&callback = {}, bool wait = false);
 
+        /**
+         * @brief Execute all the nodes and submit the resulting command buffer to the GPU, the supplied syncpoint is incremented upon GPU completion
+         * @note This should be preferred over incrementing the syncpoint in a callback as increments from submissions that complete together are batched
+         */
+        void SubmitWithSyncpointIncrement(soc::host1x::Syncpoint &syncpoint);
+
         /**
          * @brief Locks all preserve attached buffers/textures
          * @note This **MUST** be called before attaching any buffers/textures to an execution
@@ -37,6 +37,7 @@ namespace skyline::gpu::interconnect {
                 return;
 
         // Otherwise perform a full lookup
+        std::scoped_lock lock{ctx.gpu.buffer};
         view = ctx.gpu.buffer.FindOrCreate(viewMapping, ctx.executor.tag, [&ctx](std::shared_ptr<Buffer> buffer, ContextLock<Buffer> &&lock) {
             ctx.executor.AttachLockedBuffer(buffer, std::move(lock));
         });
@@ -203,6 +203,44 @@ namespace skyline::gpu::interconnect {
     };
     using SetBaseStencilStateCmd = CmdHolder<SetBaseStencilStateCmdImpl>;
 
+    struct SetExtendedDynamicStateCmdImpl {
+        void Record(GPU &gpu, vk::raii::CommandBuffer &commandBuffer) {
+            commandBuffer.setCullModeEXT(cullMode);
+            commandBuffer.setFrontFaceEXT(frontFace);
+            commandBuffer.setDepthTestEnableEXT(depthTestEnable);
+            commandBuffer.setDepthWriteEnableEXT(depthWriteEnable);
+            commandBuffer.setDepthCompareOpEXT(depthCompareOp);
+            commandBuffer.setDepthBoundsTestEnableEXT(depthBoundsTestEnable);
+            commandBuffer.setStencilTestEnableEXT(stencilTestEnable);
+            commandBuffer.setStencilOpEXT(vk::StencilFaceFlagBits::eFront, stencilFront.failOp, stencilFront.passOp, stencilFront.depthFailOp, stencilFront.compareOp);
+            commandBuffer.setStencilOpEXT(vk::StencilFaceFlagBits::eBack, stencilBack.failOp, stencilBack.passOp, stencilBack.depthFailOp, stencilBack.compareOp);
+        }
+
+        vk::CullModeFlags cullMode;
+        vk::FrontFace frontFace;
+        bool depthTestEnable;
+        bool depthWriteEnable;
+        vk::CompareOp depthCompareOp;
+        bool depthBoundsTestEnable;
+        bool stencilTestEnable;
+        vk::StencilOpState stencilFront;
+        vk::StencilOpState stencilBack;
+    };
+    using SetExtendedDynamicStateCmd = CmdHolder<SetExtendedDynamicStateCmdImpl>;
+
+    struct SetExtendedDynamicState2CmdImpl {
+        void Record(GPU &gpu, vk::raii::CommandBuffer &commandBuffer) {
+            commandBuffer.setDepthBiasEnableEXT(depthBiasEnable);
+            commandBuffer.setPrimitiveRestartEnableEXT(primitiveRestartEnable);
+            commandBuffer.setRasterizerDiscardEnableEXT(rasterizerDiscardEnable);
+        }
+
+        bool depthBiasEnable;
+        bool primitiveRestartEnable;
+        bool rasterizerDiscardEnable;
+    };
+    using SetExtendedDynamicState2Cmd = CmdHolder<SetExtendedDynamicState2CmdImpl>;
+
     template<bool PushDescriptor>
     struct SetDescriptorSetCmdImpl {
         void Record(GPU &gpu, vk::raii::CommandBuffer &commandBuffer) {
@@ -469,6 +507,19 @@ namespace skyline::gpu::interconnect {
                 });
         }
 
+        void SetExtendedDynamicState(const SetExtendedDynamicStateCmdImpl &state) {
+            AppendCmd<SetExtendedDynamicStateCmd>(SetExtendedDynamicStateCmdImpl{state});
+        }
+
+        void SetExtendedDynamicState2(bool depthBiasEnable, bool primitiveRestartEnable, bool rasterizerDiscardEnable) {
+            AppendCmd<SetExtendedDynamicState2Cmd>(
+                {
+                    .depthBiasEnable = depthBiasEnable,
+                    .primitiveRestartEnable = primitiveRestartEnable,
+                    .rasterizerDiscardEnable = rasterizerDiscardEnable,
+                });
+        }
+
         void SetDescriptorSetWithUpdate(DescriptorUpdateInfo *updateInfo, DescriptorAllocator::ActiveDescriptorSet *dstSet, DescriptorAllocator::ActiveDescriptorSet *srcSet) {
             AppendCmd<SetDescriptorSetWithUpdateCmd>(
                 {
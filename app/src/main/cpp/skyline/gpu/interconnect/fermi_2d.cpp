@@ -120,7 +120,7 @@ namespace skyline::gpu::interconnect {
         executor.AttachDependency(srcTextureView);
         executor.AttachTexture(srcTextureView.get());
 
-        auto dstTextureView{gpu.texture.FindOrCreate(dstGuestTexture, executor.tag)};
+        auto dstTextureView{gpu.texture.FindOrCreate(dstGuestTexture, executor.tag, Texture::GetConfiguredScale(gpu))};
         executor.AttachDependency(dstTextureView);
         executor.AttachTexture(dstTextureView.get());
 
@@ -128,28 +128,32 @@ namespace skyline::gpu::interconnect {
         float centredSrcRectX{sampleOrigin == SampleModeOrigin::Corner ? srcRectX - 0.5f : srcRectX};
         float centredSrcRectY{sampleOrigin == SampleModeOrigin::Corner ? srcRectY - 0.5f : srcRectY};
 
+        // Either texture may be rendered at a scaled resolution, the rects are converted to the host resolution of their respective texture while the guest ratio between them is retained
+        auto srcScale{srcTextureView->texture->scale}, dstScale{dstTextureView->texture->scale};
+        vk::Rect2D dstRenderArea{dstScale.Scale(vk::Rect2D{{static_cast<i32>(dstRectX), static_cast<i32>(dstRectY)}, {dstRectWidth, dstRectHeight}})};
+
         gpu.helperShaders.blitHelperShader.Blit(
             gpu,
             {
-                .width = duDx * dstRectWidth,
-                .height = dvDy * dstRectHeight,
-                .x = centredSrcRectX,
-                .y = centredSrcRectY,
+                .width = srcScale.Scale(duDx * dstRectWidth),
+                .height = srcScale.Scale(dvDy * dstRectHeight),
+                .x = srcScale.Scale(centredSrcRectX),
+                .y = srcScale.Scale(centredSrcRectY),
             },
             {
-                .width = static_cast<float>(dstRectWidth),
-                .height = static_cast<float>(dstRectHeight),
-                .x = static_cast<float>(dstRectX),
-                .y = static_cast<float>(dstRectY),
+                .width = dstScale.Scale(static_cast<float>(dstRectWidth)),
+                .height = dstScale.Scale(static_cast<float>(dstRectHeight)),
+                .x = dstScale.Scale(static_cast<float>(dstRectX)),
+                .y = dstScale.Scale(static_cast<float>(dstRectY)),
             },
-            srcGuestTexture.dimensions, dstGuestTexture.dimensions,
+            srcScale.Scale(srcGuestTexture.dimensions), dstScale.Scale(dstGuestTexture.dimensions),
             duDx, dvDy,
             filter == SampleModeFilter::Bilinear,
             srcTextureView.get(), dstTextureView.get(),
             [=](auto &&executionCallback) {
                 auto dst{dstTextureView.get()};
                 std::array<TextureView *, 1> sampledImages{srcTextureView.get()};
-                executor.AddSubpass(std::move(executionCallback), {{static_cast<i32>(dstRectX), static_cast<i32>(dstRectY)}, {dstRectWidth, dstRectHeight} },
+                executor.AddSubpass(std::move(executionCallback), dstRenderArea,
                                     sampledImages, {}, {dst}, {}, false,
                                     vk::PipelineStageFlagBits::eAllGraphics, vk::PipelineStageFlagBits::eAllGraphics);
             }
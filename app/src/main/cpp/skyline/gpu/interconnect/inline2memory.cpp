@@ -16,6 +16,7 @@ namespace skyline::gpu::interconnect {
           executor{channelCtx.executor} {}
 
     void Inline2Memory::UploadSingleMapping(span<u8> dst, span<u8> src) {
+        std::scoped_lock bufferManagerLock{gpu.buffer};
         auto dstBuf{gpu.buffer.FindOrCreate(dst, executor.tag, [this](std::shared_ptr<Buffer> buffer, ContextLock<Buffer> &&lock) {
             executor.AttachLockedBuffer(buffer, std::move(lock));
         })};
@@ -186,6 +186,14 @@ namespace skyline::gpu::interconnect::maxwell3d {
         megaBufferBinding = {};
     }
 
+    u32 IndexBufferState::GetMaxElementCount() const {
+        u64 address{engine->indexBuffer.address}, limit{engine->indexBuffer.limit};
+        if (limit < address)
+            return 0;
+
+        return static_cast<u32>(std::min<u64>(limit - address + 1, std::numeric_limits<u32>::max()) / GetIndexBufferSize(engine->indexBuffer.indexSize, 1));
+    }
+
     /* Transform Feedback Buffer */
     void TransformFeedbackBufferState::EngineRegisters::DirtyBind(DirtyManager &manager, dirty::Handle handle) const {
         manager.Bind(handle, streamOutBuffer.address, streamOutBuffer.loadWritePointerStartOffset, streamOutBuffer.size, streamOutEnable);
@@ -282,23 +290,23 @@ namespace skyline::gpu::interconnect::maxwell3d {
         return vkViewport;
     }
 
-    void ViewportState::Flush(InterconnectContext &ctx, StateUpdateBuilder &builder) {
+    void ViewportState::Flush(InterconnectContext &ctx, StateUpdateBuilder &builder, texture::RenderScale scale) {
         if (index != 0 && !ctx.gpu.traits.supportsMultipleViewports)
             return;
 
         if (!engine->viewportScaleOffsetEnable) {
-            builder.SetViewport(index, vk::Viewport{
+            builder.SetViewport(index, scale.Scale(vk::Viewport{
                 .x = static_cast<float>(engine->surfaceClip.horizontal.x),
                 .y = static_cast<float>(engine->surfaceClip.vertical.y),
                 .width = engine->surfaceClip.horizontal.width ? static_cast<float>(engine->surfaceClip.horizontal.width) : 1.0f,
                 .height = engine->surfaceClip.vertical.height ? static_cast<float>(engine->surfaceClip.vertical.height) : 1.0f,
                 .minDepth = 0.0f,
                 .maxDepth = 1.0f,
-            });
+            }));
         } else if (engine->viewport.scaleX == 0.0f || engine->viewport.scaleY == 0.0f) {
-            builder.SetViewport(index, ConvertViewport(engine->viewport0, engine->viewportClip0, engine->windowOrigin, engine->viewportScaleOffsetEnable));
+            builder.SetViewport(index, scale.Scale(ConvertViewport(engine->viewport0, engine->viewportClip0, engine->windowOrigin, engine->viewportScaleOffsetEnable)));
         } else {
-            builder.SetViewport(index, ConvertViewport(engine->viewport, engine->viewportClip, engine->windowOrigin, engine->viewportScaleOffsetEnable));
+            builder.SetViewport(index, scale.Scale(ConvertViewport(engine->viewport, engine->viewportClip, engine->windowOrigin, engine->viewportScaleOffsetEnable)));
         }
     }
 
@@ -309,11 +317,11 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
     ScissorState::ScissorState(dirty::Handle dirtyHandle, DirtyManager &manager, const EngineRegisters &engine, u32 index) : engine{manager, dirtyHandle, engine}, index{index} {}
 
-    void ScissorState::Flush(InterconnectContext &ctx, StateUpdateBuilder &builder) {
+    void ScissorState::Flush(InterconnectContext &ctx, StateUpdateBuilder &builder, texture::RenderScale scale) {
         if (index != 0 && !ctx.gpu.traits.supportsMultipleViewports)
             return;
 
-        builder.SetScissor(index, [&]() {
+        builder.SetScissor(index, scale.Scale([&]() {
             if (engine->scissor.enable) {
                 const auto &vertical{engine->scissor.vertical};
                 const auto &horizontal{engine->scissor.horizontal};
@@ -334,7 +342,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
                     .extent.width = std::numeric_limits<i32>::max(),
                 };
             }
-        }());
+        }()));
     }
 
     /* Line Width */
@@ -442,12 +450,22 @@ namespace skyline::gpu::interconnect::maxwell3d {
         auto updateFuncBuffer{[&](auto &stateElem, auto &&... args) { stateElem.Update(ctx, builder, srcStageMask, dstStageMask, args...); }};
 
         pipeline.Update(ctx, textures, constantBuffers, builder);
+
+        // The scale is decided by the pipeline state alongside the render targets, any state in guest coordinates needs to be flushed again when it changes
+        auto scale{pipeline.Get().renderScale};
+        if (scale != renderScale) {
+            renderScale = scale;
+            ranges::for_each(viewports, [](auto &viewport) { viewport.MarkDirty(false); });
+            ranges::for_each(scissors, [](auto &scissor) { scissor.MarkDirty(false); });
+        }
+        auto updateFuncScaled{[&](auto &stateElem) { stateElem.Update(ctx, builder, renderScale); }};
+
         ranges::for_each(vertexBuffers, updateFuncBuffer);
         if (indexed)
             updateFuncBuffer(indexBuffer, directState.inputAssembly.NeedsQuadConversion(), drawFirstIndex, drawElementCount);
         ranges::for_each(transformFeedbackBuffers, updateFuncBuffer);
-        ranges::for_each(viewports, updateFunc);
-        ranges::for_each(scissors, updateFunc);
+        ranges::for_each(viewports, updateFuncScaled);
+        ranges::for_each(scissors, updateFuncScaled);
         updateFunc(lineWidth);
         updateFunc(depthBias);
         updateFunc(blendConstants);
@@ -455,6 +473,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
         updateFunc(stencilValues);
     }
 
+    u32 ActiveState::GetIndexBufferMaxElementCount() {
+        return indexBuffer.Get().GetMaxElementCount();
+    }
+
     Pipeline *ActiveState::GetPipeline() {
         return pipeline.Get().pipeline;
     }
@@ -467,11 +489,18 @@ namespace skyline::gpu::interconnect::maxwell3d {
         return pipeline.Get().depthAttachment;
     }
 
-    std::shared_ptr<TextureView> ActiveState::GetColorRenderTargetForClear(InterconnectContext &ctx, size_t index) {
-        return pipeline.Get().GetColorRenderTargetForClear(ctx, index);
+    texture::RenderScale ActiveState::GetRenderScale() {
+        return renderScale;
     }
 
-    std::shared_ptr<TextureView> ActiveState::GetDepthRenderTargetForClear(InterconnectContext &ctx) {
-        return pipeline.Get().GetDepthRenderTargetForClear(ctx);
+    std::pair<std::shared_ptr<TextureView>, std::shared_ptr<TextureView>> ActiveState::GetRenderTargetsForClear(InterconnectContext &ctx, std::optional<size_t> colorIndex, bool depthStencil) {
+        auto views{pipeline.Get().GetRenderTargetsForClear(ctx, colorIndex, depthStencil)};
+
+        // Render targets recreated at another scale for the clear replace the attachments of the pipeline state, it needs to be flushed again to pick them up
+        auto &[colorView, depthStencilView]{views};
+        if ((colorView && colorView->texture->scale != renderScale) || (depthStencilView && depthStencilView->texture->scale != renderScale))
+            pipeline.MarkDirty(false);
+
+        return views;
     }
 }
\ No newline at end of file
@@ -59,6 +59,11 @@ namespace skyline::gpu::interconnect::maxwell3d {
         bool Refresh(InterconnectContext &ctx, StateUpdateBuilder &builder, vk::PipelineStageFlags &srcStageMask, vk::PipelineStageFlags &dstStageMask, bool quadConversion, u32 firstIndex, u32 elementCount);
 
         void PurgeCaches();
+
+        /**
+         * @return The amount of indices between the start of the index buffer and its limit
+         */
+        u32 GetMaxElementCount() const;
     };
 
     class TransformFeedbackBufferState : dirty::CachedManualDirty, dirty::RefreshableManualDirty {
@@ -106,7 +111,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
       public:
         ViewportState(dirty::Handle dirtyHandle, DirtyManager &manager, const EngineRegisters &engine, u32 index);
 
-        void Flush(InterconnectContext &ctx, StateUpdateBuilder &builder);
+        /**
+         * @param scale The scale of the bound render targets, the guest viewport is scaled by this to match their host resolution
+         */
+        void Flush(InterconnectContext &ctx, StateUpdateBuilder &builder, texture::RenderScale scale);
     };
 
     class ScissorState : dirty::ManualDirty {
@@ -124,7 +132,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
       public:
         ScissorState(dirty::Handle dirtyHandle, DirtyManager &manager, const EngineRegisters &engine, u32 index);
 
-        void Flush(InterconnectContext &ctx, StateUpdateBuilder &builder);
+        /**
+         * @param scale The scale of the bound render targets, the guest scissor is scaled by this to match their host resolution
+         */
+        void Flush(InterconnectContext &ctx, StateUpdateBuilder &builder, texture::RenderScale scale);
     };
 
     struct LineWidthState : dirty::ManualDirty {
@@ -235,6 +246,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
         dirty::ManualDirtyState<BlendConstantsState> blendConstants;
         dirty::ManualDirtyState<DepthBoundsState> depthBounds;
         dirty::ManualDirtyState<StencilValuesState> stencilValues;
+        texture::RenderScale renderScale{}; //!< The scale that the bound render targets are rendered at, any state in guest coordinates is scaled by this
 
       public:
         struct EngineRegisters {
@@ -264,14 +276,26 @@ namespace skyline::gpu::interconnect::maxwell3d {
                     bool indexed, engine::DrawTopology topology, u32 drawFirstIndex, u32 drawElementCount,
                     vk::PipelineStageFlags &srcStageMask, vk::PipelineStageFlags &dstStageMask);
 
+        /**
+         * @return The maximum amount of indices that can be read from the currently bound index buffer, this is used for draws where the amount of indices isn't known on the CPU
+         * @note Unlike other accessors this only depends on register state, so it can be called prior to `Update()`
+         */
+        u32 GetIndexBufferMaxElementCount();
+
         Pipeline *GetPipeline();
 
         span<TextureView *> GetColorAttachments();
 
         TextureView *GetDepthAttachment();
 
-        std::shared_ptr<TextureView> GetColorRenderTargetForClear(InterconnectContext &ctx, size_t index);
+        /**
+         * @return The scale of the bound render targets, guest coordinates need to be scaled by this to match their host resolution
+         */
+        texture::RenderScale GetRenderScale();
 
-        std::shared_ptr<TextureView> GetDepthRenderTargetForClear(InterconnectContext &ctx);
+        /**
+         * @note See PipelineState::GetRenderTargetsForClear
+         */
+        std::pair<std::shared_ptr<TextureView>, std::shared_ptr<TextureView>> GetRenderTargetsForClear(InterconnectContext &ctx, std::optional<size_t> colorIndex, bool depthStencil);
     };
 }
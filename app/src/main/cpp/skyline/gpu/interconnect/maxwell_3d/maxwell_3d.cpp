@@ -6,6 +6,7 @@
 #include <gpu/interconnect/conversion/quads.h>
 #include <gpu/interconnect/common/state_updater.h>
 #include <soc/gm20b/channel.h>
+#include <common/perf_counters.h>
 #include "common/utils.h"
 #include "maxwell_3d.h"
 #include "common.h"
@@ -24,6 +25,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
           samplers{manager, registerBundle.samplerPoolRegisters},
           samplerBinding{registerBundle.samplerBinding},
           textures{manager, registerBundle.texturePoolRegisters},
+          queries{registerBundle.queriesRegisters},
           directState{activeState.directState} {
         ctx.executor.AddFlushCallback([this] {
             if (attachedDescriptorSets) {
@@ -37,6 +39,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
             samplers.MarkAllDirty();
             textures.MarkAllDirty();
             quadConversionBufferAttached = false;
+            queries.ResetExecutionState();
             constantBuffers.DisableQuickBind();
         });
 
@@ -132,9 +135,32 @@ namespace skyline::gpu::interconnect::maxwell3d {
         if (scissor.extent.width == 0 || scissor.extent.height == 0)
             return;
 
+        // Clears are subject to the render condition in the same way as draws
+        auto renderCondition{queries.GetRenderCondition(ctx)};
+        if (renderCondition.skip)
+            return;
+
+        // Wraps a subpass function in conditional rendering if the render condition is evaluated on the GPU, this applies to clearAttachments and the helper shader draws
+        auto predicate{[renderCondition](std::function<void(vk::raii::CommandBuffer &, const std::shared_ptr<FenceCycle> &, GPU &, vk::RenderPass, u32)> &&function) {
+            return [renderCondition, function = std::move(function)](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &cycle, GPU &gpu, vk::RenderPass renderPass, u32 subpassIndex) {
+                if (renderCondition.buffer)
+                    commandBuffer.beginConditionalRenderingEXT(vk::ConditionalRenderingBeginInfoEXT{
+                        .buffer = renderCondition.buffer,
+                        .offset = renderCondition.offset,
+                    });
+
+                function(commandBuffer, cycle, gpu, renderPass, subpassIndex);
+
+                if (renderCondition.buffer)
+                    commandBuffer.endConditionalRenderingEXT();
+            };
+        }};
+
+        // Render pass load op clears can't be predicated, so conditional clears must use clearAttachments
         auto needsAttachmentClearCmd{[&](auto &view) {
-            return scissor.offset.x != 0 || scissor.offset.y != 0 ||
-                scissor.extent != vk::Extent2D{view->texture->dimensions} ||
+            auto viewScissor{view->texture->scale.Scale(scissor)};
+            return renderCondition.buffer || viewScissor.offset.x != 0 || viewScissor.offset.y != 0 ||
+                viewScissor.extent != vk::Extent2D{view->texture->dimensions} ||
                 view->range.layerCount != 1 || view->range.baseArrayLayer != 0 || clearSurface.rtArrayIndex != 0;
         }};
 
@@ -148,8 +174,12 @@ namespace skyline::gpu::interconnect::maxwell3d {
         std::shared_ptr<TextureView> colorView{};
         std::shared_ptr<TextureView> depthStencilView{};
 
-        if (clearSurface.rEnable || clearSurface.gEnable || clearSurface.bEnable || clearSurface.aEnable) {
-            if (auto view{activeState.GetColorRenderTargetForClear(ctx, clearSurface.mrtSelect)}) {
+        // Both render targets are looked up together so they're rendered at the same scale, this allows clearing them in a single subpass
+        bool colorClear{clearSurface.rEnable || clearSurface.gEnable || clearSurface.bEnable || clearSurface.aEnable}, depthStencilClear{clearSurface.stencilEnable || clearSurface.zEnable};
+        auto [colorRenderTarget, depthStencilRenderTarget]{activeState.GetRenderTargetsForClear(ctx, colorClear ? std::optional<size_t>{clearSurface.mrtSelect} : std::nullopt, depthStencilClear)};
+
+        if (colorClear) {
+            if (auto view{colorRenderTarget}) {
                 ctx.executor.AttachTexture(&*view);
 
                 bool partialClear{!(clearSurface.rEnable && clearSurface.gEnable && clearSurface.bEnable && clearSurface.aEnable)};
@@ -165,7 +195,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
                                                                   (clearSurface.aEnable ? vk::ColorComponentFlagBits::eA : vk::ColorComponentFlags{}),
                                                                   {clearEngineRegisters.colorClearValue}, &*view, [=](auto &&executionCallback) {
                         auto dst{view.get()};
-                        ctx.executor.AddSubpass(std::move(executionCallback), renderArea, {}, {}, span<TextureView *>{dst}, nullptr);
+                        ctx.executor.AddSubpass(predicate(std::move(executionCallback)), view->texture->scale.Scale(renderArea), {}, {}, span<TextureView *>{dst}, nullptr);
                     });
                     ctx.executor.NotifyPipelineChange();
                 } else if (needsAttachmentClearCmd(view)) {
@@ -177,8 +207,8 @@ namespace skyline::gpu::interconnect::maxwell3d {
             }
         }
 
-        if (clearSurface.stencilEnable || clearSurface.zEnable) {
-            if (auto view{activeState.GetDepthRenderTargetForClear(ctx)}) {
+        if (depthStencilClear) {
+            if (auto view{depthStencilRenderTarget}) {
                 ctx.executor.AttachTexture(&*view);
 
                 bool viewHasDepth{view->range.aspectMask & vk::ImageAspectFlagBits::eDepth}, viewHasStencil{view->range.aspectMask & vk::ImageAspectFlagBits::eStencil};
@@ -208,16 +238,41 @@ namespace skyline::gpu::interconnect::maxwell3d {
         if (clearAttachments.empty())
             return;
 
-        std::array<TextureView *, 1> colorAttachments{colorView ? &*colorView : nullptr};
-        ctx.executor.AddSubpass([clearAttachments, clearRects](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &, vk::RenderPass, u32) {
+        // The clear rects and render area are in guest coordinates, they're scaled to match the host resolution of the attachments
+        auto scale{(colorView ? colorView : depthStencilView)->texture->scale};
+        for (auto &clearRect : clearRects)
+            clearRect.rect = scale.Scale(clearRect.rect);
+
+        std::array<TextureView *, 1> colorAttachments{colorView ? colorView.get() : nullptr};
+        ctx.executor.AddSubpass(predicate([clearAttachments, clearRects](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &, vk::RenderPass, u32) {
             commandBuffer.clearAttachments(clearAttachments, span(clearRects).first(clearAttachments.size()));
-        }, renderArea, {}, {}, colorView ? colorAttachments : span<TextureView *>{}, depthStencilView ? &*depthStencilView : nullptr);
+        }), scale.Scale(renderArea), {}, {}, colorView ? colorAttachments : span<TextureView *>{}, depthStencilView.get());
     }
 
-    void Maxwell3D::Draw(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u32 count, u32 first, u32 instanceCount, u32 vertexOffset, u32 firstInstance) {
+    void Maxwell3D::ResetSamplesPassedCounter() {
+        queries.ResetCounter();
+    }
+
+    void Maxwell3D::ReportSamplesPassedCounter(u64 address, std::function<void(u64)> &&callback) {
+        queries.ReportCounter(ctx, address, std::move(callback));
+    }
+
+    void Maxwell3D::DrawImpl(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u32 count, u32 first, u32 instanceCount, u32 vertexOffset, u32 firstInstance, IndirectDraw *indirect) {
+        auto renderCondition{queries.GetRenderCondition(ctx)};
+        if (renderCondition.skip)
+            return;
+        perf::Add(perf::Counter::Draws);
+
         StateUpdateBuilder builder{*ctx.executor.allocator};
         vk::PipelineStageFlags srcStageMask{}, dstStageMask{};
 
+        if (indirect) {
+            // The draw parameters may have been written by prior GPU work in the same execution
+            indirect->buffer.GetBuffer()->PopulateReadBarrier(vk::PipelineStageFlagBits::eDrawIndirect, srcStageMask, dstStageMask);
+            if (indirect->countBuffer)
+                indirect->countBuffer.GetBuffer()->PopulateReadBarrier(vk::PipelineStageFlagBits::eDrawIndirect, srcStageMask, dstStageMask);
+        }
+
         Pipeline *oldPipeline{activeState.GetPipeline()};
         samplers.Update(ctx, samplerBinding.value == engine::SamplerBinding::Value::ViaHeaderBinding);
         activeState.Update(ctx, textures, constantBuffers.boundConstantBuffers, builder, indexed, topology, first, count, srcStageMask, dstStageMask);
@@ -289,16 +344,21 @@ namespace skyline::gpu::interconnect::maxwell3d {
             u32 firstInstance;
             bool indexed;
             bool transformFeedbackEnable;
+            Queries::DrawQuery query;
+            Queries::RenderCondition renderCondition;
+            IndirectDraw indirect;
         };
         auto *drawParams{ctx.executor.allocator->EmplaceUntracked<DrawParams>(DrawParams{stateUpdater,
                                                                                          count, first, instanceCount, vertexOffset, firstInstance, indexed,
-                                                                                         ctx.gpu.traits.supportsTransformFeedback ? transformFeedbackEnable : false})};
+                                                                                         ctx.gpu.traits.supportsTransformFeedback ? transformFeedbackEnable : false,
+                                                                                         queries.GetDrawQuery(ctx), renderCondition,
+                                                                                         indirect ? *indirect : IndirectDraw{}})};
 
         const auto &surfaceClip{clearEngineRegisters.surfaceClip};
-        vk::Rect2D scissor{
+        vk::Rect2D scissor{activeState.GetRenderScale().Scale(vk::Rect2D{
             {surfaceClip.horizontal.x, surfaceClip.vertical.y},
             {surfaceClip.horizontal.width, surfaceClip.vertical.height}
-        };
+        })};
 
         auto colorAttachments{activeState.GetColorAttachments()};
         auto depthStencilAttachment{activeState.GetDepthAttachment()};
@@ -315,16 +375,94 @@ namespace skyline::gpu::interconnect::maxwell3d {
         ctx.executor.AddSubpass([drawParams](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &gpu, vk::RenderPass, u32) {
             drawParams->stateUpdater.RecordAll(gpu, commandBuffer);
 
+            if (drawParams->renderCondition.buffer)
+                commandBuffer.beginConditionalRenderingEXT(vk::ConditionalRenderingBeginInfoEXT{
+                    .buffer = drawParams->renderCondition.buffer,
+                    .offset = drawParams->renderCondition.offset,
+                });
+
+            if (drawParams->query.pool)
+                commandBuffer.beginQuery(drawParams->query.pool, drawParams->query.index, drawParams->query.flags);
+
             if (drawParams->transformFeedbackEnable)
                 commandBuffer.beginTransformFeedbackEXT(0, {}, {});
 
-            if (drawParams->indexed)
+            if (const auto &indirect{drawParams->indirect}; indirect.buffer) {
+                auto binding{indirect.buffer.GetBinding(gpu)};
+                if (indirect.countBuffer) {
+                    auto countBinding{indirect.countBuffer.GetBinding(gpu)};
+                    if (drawParams->indexed)
+                        commandBuffer.drawIndexedIndirectCountKHR(binding.buffer, binding.offset, countBinding.buffer, countBinding.offset, indirect.drawCount, indirect.stride);
+                    else
+                        commandBuffer.drawIndirectCountKHR(binding.buffer, binding.offset, countBinding.buffer, countBinding.offset, indirect.drawCount, indirect.stride);
+                } else {
+                    if (drawParams->indexed)
+                        commandBuffer.drawIndexedIndirect(binding.buffer, binding.offset, indirect.drawCount, indirect.stride);
+                    else
+                        commandBuffer.drawIndirect(binding.buffer, binding.offset, indirect.drawCount, indirect.stride);
+                }
+            } else if (drawParams->indexed) {
                 commandBuffer.drawIndexed(drawParams->count, drawParams->instanceCount, drawParams->first, static_cast<i32>(drawParams->vertexOffset), drawParams->firstInstance);
-            else
+            } else {
                 commandBuffer.draw(drawParams->count, drawParams->instanceCount, drawParams->first, drawParams->firstInstance);
+            }
 
             if (drawParams->transformFeedbackEnable)
                 commandBuffer.endTransformFeedbackEXT(0, {}, {});
+
+            if (drawParams->query.pool)
+                commandBuffer.endQuery(drawParams->query.pool, drawParams->query.index);
+
+            if (drawParams->renderCondition.buffer)
+                commandBuffer.endConditionalRenderingEXT();
         }, scissor, activeDescriptorSetSampledImages, {}, activeState.GetColorAttachments(), activeState.GetDepthAttachment(), !ctx.gpu.traits.quirks.relaxedRenderPassCompatibility, srcStageMask, dstStageMask);
     }
-}
\ No newline at end of file
+
+    void Maxwell3D::Draw(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u32 count, u32 first, u32 instanceCount, u32 vertexOffset, u32 firstInstance) {
+        DrawImpl(topology, transformFeedbackEnable, indexed, count, first, instanceCount, vertexOffset, firstInstance, nullptr);
+    }
+
+    bool Maxwell3D::DrawIndirect(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u64 indirectAddress, u32 drawCount, u32 stride, u64 countAddress) {
+        // Quad conversion requires knowing the draw parameters on the CPU
+        if (topology == engine::DrawTopology::Quads)
+            return false;
+
+        if (!drawCount)
+            return true;
+
+        if ((drawCount > 1 && !ctx.gpu.traits.supportsMultiDrawIndirect) || (countAddress && !ctx.gpu.traits.supportsDrawIndirectCount))
+            return false;
+
+        vk::DeviceSize structSize{indexed ? sizeof(vk::DrawIndexedIndirectCommand) : sizeof(vk::DrawIndirectCommand)};
+        if (!stride)
+            stride = static_cast<u32>(structSize);
+
+        CachedMappedBufferView indirectView{}, countView{};
+        indirectView.Update(ctx, indirectAddress, static_cast<u64>(stride) * (drawCount - 1) + structSize);
+        if (!*indirectView) {
+            Logger::Warn("Unmapped indirect draw buffer: 0x{:X}", indirectAddress);
+            return false;
+        }
+        ctx.executor.AttachBuffer(*indirectView);
+
+        if (countAddress) {
+            countView.Update(ctx, countAddress, sizeof(u32));
+            if (!*countView) {
+                Logger::Warn("Unmapped indirect draw count buffer: 0x{:X}", countAddress);
+                return false;
+            }
+            ctx.executor.AttachBuffer(*countView);
+        }
+
+        IndirectDraw indirect{
+            .buffer = *indirectView,
+            .countBuffer = *countView,
+            .drawCount = drawCount,
+            .stride = stride,
+        };
+
+        // The amount of indices used by the draw is unknown so the entire index buffer needs to be bound
+        DrawImpl(topology, transformFeedbackEnable, indexed, indexed ? activeState.GetIndexBufferMaxElementCount() : 0, 0, 0, 0, 0, &indirect);
+        return true;
+    }
+}
@@ -9,6 +9,7 @@
 #include "common.h"
 #include "active_state.h"
 #include "constant_buffers.h"
+#include "queries.h"
 
 namespace skyline::gpu::interconnect::maxwell3d {
     /**
@@ -37,6 +38,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
             SamplerPoolState::EngineRegisters samplerPoolRegisters;
             const engine::SamplerBinding &samplerBinding;
             TexturePoolState::EngineRegisters texturePoolRegisters;
+            Queries::EngineRegisters queriesRegisters;
         };
 
       private:
@@ -47,6 +49,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
         Samplers samplers;
         const engine::SamplerBinding &samplerBinding;
         Textures textures;
+        Queries queries;
         std::shared_ptr<memory::Buffer> quadConversionBuffer{};
         bool quadConversionBufferAttached{};
 
@@ -55,8 +58,23 @@ namespace skyline::gpu::interconnect::maxwell3d {
         DescriptorAllocator::ActiveDescriptorSet *activeDescriptorSet{};
         std::vector<TextureView *> activeDescriptorSetSampledImages{};
 
+        /**
+         * @brief The GPU-resident parameters of an indirect draw
+         */
+        struct IndirectDraw {
+            BufferView buffer; //!< A view of the draw parameter structures
+            BufferView countBuffer; //!< A view of the 32-bit draw count, this is only valid for indirect count draws
+            u32 drawCount; //!< The amount of draws or the upper bound of the draw count for indirect count draws
+            u32 stride;
+        };
+
         size_t UpdateQuadConversionBuffer(u32 count, u32 firstVertex);
 
+        /**
+         * @brief Updates all state required for a draw and records it, the draw parameters are sourced from `indirect` if it's non-null
+         */
+        void DrawImpl(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u32 count, u32 first, u32 instanceCount, u32 vertexOffset, u32 firstInstance, IndirectDraw *indirect);
+
         vk::Rect2D GetClearScissor();
 
       public:
@@ -86,6 +104,24 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
         void Clear(engine::ClearSurface &clearSurface);
 
+        /**
+         * @brief Resets the samples passed counter to zero
+         */
+        void ResetSamplesPassedCounter();
+
+        /**
+         * @brief Reports the value of the samples passed counter, the result is passed to the callback asynchronously once it is available
+         * @note See Queries::ReportCounter
+         */
+        void ReportSamplesPassedCounter(u64 address, std::function<void(u64)> &&callback);
+
         void Draw(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u32 count, u32 first, u32 instanceCount, u32 vertexOffset, u32 firstInstance);
+
+        /**
+         * @brief Performs a draw with parameters read directly from guest GPU memory by the host GPU, this avoids any CPU synchronization when they were written by the GPU
+         * @note See MacroEngineBase::DrawIndirect
+         * @return If the draw could be performed, draws that require CPU-side conversion can't be performed indirectly
+         */
+        bool DrawIndirect(engine::DrawTopology topology, bool transformFeedbackEnable, bool indexed, u64 indirectAddress, u32 drawCount, u32 stride, u64 countAddress);
     };
 }
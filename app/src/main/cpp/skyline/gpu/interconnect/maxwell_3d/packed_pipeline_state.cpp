@@ -482,6 +482,73 @@ namespace skyline::gpu::interconnect::maxwell3d {
     void PackedPipelineState::SetDepthClampEnable(engine::ViewportClipControl::GeometryClip clip) {
         depthClampEnable = (clip != engine::ViewportClipControl::GeometryClip::Passthru) && (clip != engine::ViewportClipControl::GeometryClip::FrustrumXYZClip) && (clip != engine::ViewportClipControl::GeometryClip::FrustrumZClip);
     }
+
+    void PackedPipelineState::Normalize(bool extendedDynamicState, bool extendedDynamicState2) {
+        using ShaderType = engine::Pipeline::Shader::Type;
+
+        if (!shaderHashes[static_cast<size_t>(ShaderType::Tessellation)]) {
+            // Tessellation state is only consumed by the tessellation evaluation shader and the patch list topology that requires it
+            patchSize = 0;
+            domainType = {};
+            spacing = {};
+            outputPrimitives = {};
+        }
+
+        // The fixed point size is only used for point topologies or when a geometry shader could output points
+        if (topology != engine::DrawTopology::Points && !shaderHashes[static_cast<size_t>(ShaderType::Geometry)])
+            pointSize = 0;
+
+        if (!logicOpEnable)
+            logicOp = 0;
+
+        for (auto &state : attachmentBlendStates) {
+            if (!state.colorWriteMask)
+                state.blendEnable = false; // Blending has no effect on attachments that aren't written to
+
+            if (!state.blendEnable) {
+                state.colorBlendOp = 0;
+                state.srcColorBlendFactor = 0;
+                state.dstColorBlendFactor = 0;
+                state.alphaBlendOp = 0;
+                state.srcAlphaBlendFactor = 0;
+                state.dstAlphaBlendFactor = 0;
+            }
+        }
+
+        if (depthRenderTargetFormat == DepthDisabledMagic) {
+            // Depth and stencil tests are implicitly disabled without a depth attachment
+            depthTestEnable = false;
+            depthBoundsTestEnable = false;
+            stencilTestEnable = false;
+            SetStencilOps({ .func = engine::CompareFunc::OglAlways }, { .func = engine::CompareFunc::OglAlways });
+        }
+
+        if (!depthTestEnable) {
+            // Depth writes are implicitly disabled alongside the depth test
+            depthWriteEnable = false;
+            SetDepthFunc(engine::CompareFunc::OglAlways);
+        }
+
+        if (extendedDynamicState) {
+            // All of this state is supplied through VK_EXT_extended_dynamic_state and needs to be reset to a single value as it'd otherwise be ignored
+            cullMode = {};
+            frontFaceClockwise = false;
+            depthTestEnable = false;
+            depthWriteEnable = false;
+            depthFunc = 0;
+            depthBoundsTestEnable = false;
+            stencilTestEnable = false;
+            stencilFront = {};
+            stencilBack = {};
+        }
+
+        if (extendedDynamicState2) {
+            // Similarly, this state is supplied through VK_EXT_extended_dynamic_state2
+            depthBiasEnable = false;
+            primitiveRestartEnabled = false;
+            rasterizerDiscardEnable = false;
+        }
+    }
 }
 
 #pragma clang diagnostic pop
\ No newline at end of file
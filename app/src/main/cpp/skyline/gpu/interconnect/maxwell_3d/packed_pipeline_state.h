@@ -166,6 +166,14 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
         void SetDepthClampEnable(engine::ViewportClipControl::GeometryClip clip);
 
+        /**
+         * @brief Resets any state that can't affect the pipeline to a canonical value, so that keys for functionally identical pipelines compare equal
+         * @param extendedDynamicState If the state covered by VK_EXT_extended_dynamic_state is supplied dynamically rather than being baked into the pipeline
+         * @param extendedDynamicState2 If the state covered by VK_EXT_extended_dynamic_state2 is supplied dynamically rather than being baked into the pipeline
+         * @note This should only be applied to a copy of the state that's used as the pipeline key, the dynamic state needs to be sourced from the original state
+         */
+        void Normalize(bool extendedDynamicState, bool extendedDynamicState2);
+
         bool operator==(const PackedPipelineState &other) const {
             // Only hash transform feedback state if it's enabled
             if (other.transformFeedbackEnable && transformFeedbackEnable)
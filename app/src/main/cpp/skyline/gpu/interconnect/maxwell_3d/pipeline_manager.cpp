@@ -2,6 +2,8 @@
 // Copyright © 2022 yuzu Team and Contributors (https://github.com/yuzu-emu/)
 // Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <common/trace.h>
+#include <common/perf_counters.h>
 #include <gpu/texture/texture.h>
 #include <gpu/interconnect/command_executor.h>
 #include <gpu/interconnect/common/pipeline.inc>
@@ -608,9 +610,11 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
 
         static constexpr u32 BaseDynamicStateCount{9};
-        static constexpr u32 ExtendedDynamicStateCount{BaseDynamicStateCount + 1};
+        static constexpr u32 ExtendedDynamicStateCount{BaseDynamicStateCount + 9};
+        static constexpr u32 ExtendedDynamicState2Count{ExtendedDynamicStateCount + 3};
 
-        constexpr std::array<vk::DynamicState, ExtendedDynamicStateCount> dynamicStates{
+        // Any state that's made dynamic here must be reset in PackedPipelineState::Normalize and supplied by PipelineState::Flush
+        constexpr std::array<vk::DynamicState, ExtendedDynamicState2Count> dynamicStates{
             vk::DynamicState::eViewport,
             vk::DynamicState::eScissor,
             vk::DynamicState::eLineWidth,
@@ -621,11 +625,23 @@ namespace skyline::gpu::interconnect::maxwell3d {
             vk::DynamicState::eStencilWriteMask,
             vk::DynamicState::eStencilReference,
             // VK_EXT_dynamic_state starts here
-            vk::DynamicState::eVertexInputBindingStrideEXT
+            vk::DynamicState::eVertexInputBindingStrideEXT,
+            vk::DynamicState::eCullModeEXT,
+            vk::DynamicState::eFrontFaceEXT,
+            vk::DynamicState::eDepthTestEnableEXT,
+            vk::DynamicState::eDepthWriteEnableEXT,
+            vk::DynamicState::eDepthCompareOpEXT,
+            vk::DynamicState::eDepthBoundsTestEnableEXT,
+            vk::DynamicState::eStencilTestEnableEXT,
+            vk::DynamicState::eStencilOpEXT,
+            // VK_EXT_extended_dynamic_state2 starts here
+            vk::DynamicState::eDepthBiasEnableEXT,
+            vk::DynamicState::ePrimitiveRestartEnableEXT,
+            vk::DynamicState::eRasterizerDiscardEnableEXT
         };
 
         vk::PipelineDynamicStateCreateInfo dynamicState{
-            .dynamicStateCount = gpu.traits.supportsExtendedDynamicState ? ExtendedDynamicStateCount : BaseDynamicStateCount,
+            .dynamicStateCount = gpu.traits.supportsExtendedDynamicState2 ? ExtendedDynamicState2Count : (gpu.traits.supportsExtendedDynamicState ? ExtendedDynamicStateCount : BaseDynamicStateCount),
             .pDynamicStates = dynamicStates.data()
         };
 
@@ -662,6 +678,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
     Pipeline::Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState)
         : sourcePackedState{packedState} {
+        perf::Add(perf::Counter::PipelineCompiles);
         auto shaderStages{MakePipelineShaders(gpu, accessor, sourcePackedState)};
         descriptorInfo = MakePipelineDescriptorInfo(shaderStages, gpu.traits.quirks.needsIndividualTextureBindingWrites);
         compiledPipeline = MakeCompiledPipeline(gpu, sourcePackedState, shaderStages, descriptorInfo.descriptorSetLayoutBindings);
@@ -958,8 +975,15 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
             while (bundle.Deserialise(stream)) {
                 lastKnownGoodOffset = stream.tellg();
+
+                // Pipelines cached prior to key normalization or on a host with different dynamic state support may be equivalent to one that was already loaded
+                auto packedState{bundle.GetKey<PackedPipelineState>()};
+                packedState.Normalize(gpu.traits.supportsExtendedDynamicState, gpu.traits.supportsExtendedDynamicState2);
+                if (map.find(packedState) != map.end())
+                    continue;
+
                 auto accessor{FilePipelineStateAccessor{bundle}};
-                auto *pipeline{map.emplace(bundle.GetKey<PackedPipelineState>(), std::make_unique<Pipeline>(gpu, accessor, bundle.GetKey<PackedPipelineState>())).first.value().get()};
+                auto *pipeline{map.emplace(packedState, std::make_unique<Pipeline>(gpu, accessor, packedState)).first.value().get()};
                 #ifdef PIPELINE_STATS
                 auto sharedIt{sharedPipelines.find(pipeline->sourcePackedState.shaderHashes)};
                 if (sharedIt == sharedPipelines.end())
@@ -994,11 +1018,27 @@ namespace skyline::gpu::interconnect::maxwell3d {
         }
     }
 
+    PipelineManager::~PipelineManager() {
+        if (census.rawKeys.size())
+            Logger::Info("Pipeline key census: {} unique keys were normalized into {} unique keys", census.rawKeys.size(), census.normalizedKeys.size());
+    }
+
+    void PipelineManager::RecordKeyCensus(const PackedPipelineState &rawState, const PackedPipelineState &normalizedState) {
+        constexpr PackedPipelineStateHash Hash{};
+        if (census.rawKeys.emplace(Hash(rawState)).second)
+            TRACE_COUNTER("gpu", perfetto::CounterTrack("Pipeline Keys"), census.rawKeys.size());
+        if (census.normalizedKeys.emplace(Hash(normalizedState)).second)
+            TRACE_COUNTER("gpu", perfetto::CounterTrack("Normalized Pipeline Keys"), census.normalizedKeys.size());
+    }
+
     Pipeline *PipelineManager::FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries) {
         auto it{map.find(packedState)};
-        if (it != map.end())
+        if (it != map.end()) {
+            perf::Add(perf::Counter::PipelineCacheHits);
             return it->second.get();
+        }
 
+        perf::Add(perf::Counter::PipelineCacheMisses);
         auto bundle{std::make_unique<PipelineStateBundle>()};
         bundle->Reset(packedState);
         auto accessor{RuntimeGraphicsPipelineStateAccessor{std::move(bundle), ctx, textures, constantBuffers, shaderBinaries}};
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <tsl/robin_map.h>
+#include <tsl/robin_set.h>
 #include <shader_compiler/frontend/ir/program.h>
 #include <gpu/graphics_pipeline_assembler.h>
 #include <gpu/interconnect/common/samplers.h>
@@ -271,9 +272,26 @@ namespace skyline::gpu::interconnect::maxwell3d {
         std::vector<std::list<Pipeline*>*> sortedSharedPipelines; //!< Sorted list of shared pipelines
         #endif
 
+        /**
+         * @brief A census of the unique pipeline keys encountered at runtime, this is used to track how effective key normalization is for a title
+         * @note Keys are tracked by their hash, the counts may be slightly inaccurate in the case of collisions
+         * @note Keys are only recorded while the "gpu" trace category is enabled, the census only covers the traced portion of a session
+         */
+        struct {
+            tsl::robin_set<u64> rawKeys; //!< The hashes of all keys prior to normalization
+            tsl::robin_set<u64> normalizedKeys; //!< The hashes of all keys after normalization, these correspond to the pipelines that were actually used
+        } census;
+
       public:
         PipelineManager(GPU &gpu);
 
+        ~PipelineManager();
+
+        /**
+         * @brief Records a pipeline key in the census both before and after normalization
+         */
+        void RecordKeyCensus(const PackedPipelineState &rawState, const PackedPipelineState &normalizedState);
+
         Pipeline *FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries);
     };
 }
@@ -43,7 +43,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
             return;
         }
 
-        GuestTexture guest{};
+        guest = {};
         guest.format = packedState.GetColorRenderTargetFormat(index);
         guest.aspect = vk::ImageAspectFlagBits::eColor;
         guest.baseArrayLayer = target.layerOffset;
@@ -77,7 +77,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
             if (guest.tileConfig.mode == gpu::texture::TileMode::Block)
                 DetermineRenderTargetDimensions(guest, engine->surfaceClip);
 
-            view = ctx.gpu.texture.FindOrCreate(guest, ctx.executor.tag);
+            view = ctx.gpu.texture.FindOrCreate(guest, ctx.executor.tag, Texture::GetConfiguredScale(ctx.gpu));
         } else {
             format = engine::ColorTarget::Format::Disabled;
             packedState.SetColorRenderTargetFormat(index, engine::ColorTarget::Format::Disabled);
@@ -100,7 +100,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
             return;
         }
 
-        GuestTexture guest{};
+        guest = {};
         guest.format = packedState.GetDepthRenderTargetFormat();
         guest.aspect = guest.format->vkAspect;
         guest.baseArrayLayer = engine->ztLayer.offset;
@@ -130,7 +130,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
             if (guest.tileConfig.mode == gpu::texture::TileMode::Block)
                 DetermineRenderTargetDimensions(guest, engine->surfaceClip);
 
-            view = ctx.gpu.texture.FindOrCreate(guest, ctx.executor.tag);
+            view = ctx.gpu.texture.FindOrCreate(guest, ctx.executor.tag, Texture::GetConfiguredScale(ctx.gpu));
         } else {
             packedState.SetDepthRenderTargetFormat(engine->ztFormat, false);
             view = {};
@@ -351,6 +351,35 @@ namespace skyline::gpu::interconnect::maxwell3d {
         packedState.viewportTransformEnable = engine.viewportScaleOffsetEnable;
     }
 
+    /**
+     * @brief Decides the scale that a render pass with the supplied render targets is rendered at, any render targets at another scale are recreated at it
+     * @return The scale that the render pass must be rendered at
+     * @note The viewports, scissors and render area are shared by all attachments so they must all be rendered at a single scale, the configured scale is only used if every render target can be rendered at it
+     */
+    static texture::RenderScale MatchRenderTargetScales(InterconnectContext &ctx, span<ColorRenderTargetState *> colorTargets, DepthRenderTargetState *depthTarget) {
+        auto configuredScale{Texture::GetConfiguredScale(ctx.gpu)};
+
+        bool scaled{!configuredScale.IsNative()};
+        auto checkTarget{[&](auto *target) {
+            if (target && target->view && target->view->texture->scale != configuredScale)
+                scaled &= Texture::IsScalable(target->guest) && target->view->texture->CanRescale(configuredScale);
+        }};
+        ranges::for_each(colorTargets, checkTarget);
+        checkTarget(depthTarget);
+
+        texture::RenderScale scale{scaled ? configuredScale : texture::RenderScale{}};
+        auto rescaleTarget{[&](auto *target) {
+            if (target && target->view && target->view->texture->scale != scale) {
+                Logger::Debug("Recreating a render target at {}% to match the render pass scale", scale.percent);
+                target->view = ctx.gpu.texture.FindOrCreate(target->guest, ctx.executor.tag, scale, true);
+            }
+        }};
+        ranges::for_each(colorTargets, rescaleTarget);
+        rescaleTarget(depthTarget);
+
+        return scale;
+    }
+
     /* Pipeline State */
     void PipelineState::EngineRegisters::DirtyBind(DirtyManager &manager, dirty::Handle handle) const {
         auto bindFunc{[&](auto &regs) { regs.DirtyBind(manager, handle); }};
@@ -397,23 +426,29 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
         colorBlend.Update(packedState);
 
-        colorAttachments.clear();
+        std::array<ColorRenderTargetState *, engine::ColorTargetCount> boundColorRenderTargets{};
         packedState.colorRenderTargetFormats = {};
         for (size_t i{}; i < engine::ColorTargetCount; i++) {
             if (i < ctSelect.count && colorBlend.Get().writtenCtMask.test(i)) {
-                const auto &rt{colorRenderTargets[ctSelect[i]].UpdateGet(ctx, packedState)};
-                const auto view{rt.view.get()};
+                auto &rt{colorRenderTargets[ctSelect[i]].UpdateGet(ctx, packedState)};
                 packedState.SetColorRenderTargetFormat(ctSelect[i], rt.format);
-                colorAttachments.push_back(view);
-
-                if (view)
-                    ctx.executor.AttachTexture(view);
-            } else {
-                colorAttachments.push_back({});
+                boundColorRenderTargets[i] = &rt;
             }
         }
 
-        depthAttachment = depthRenderTarget.UpdateGet(ctx, packedState).view.get();
+        auto &depthRt{depthRenderTarget.UpdateGet(ctx, packedState)};
+        renderScale = MatchRenderTargetScales(ctx, boundColorRenderTargets, &depthRt);
+
+        colorAttachments.clear();
+        for (auto rt : boundColorRenderTargets) {
+            auto view{rt ? rt->view.get() : nullptr};
+            colorAttachments.push_back(view);
+
+            if (view)
+                ctx.executor.AttachTexture(view);
+        }
+
+        depthAttachment = depthRt.view.get();
         if (depthAttachment)
             ctx.executor.AttachTexture(depthAttachment);
 
@@ -425,14 +460,39 @@ namespace skyline::gpu::interconnect::maxwell3d {
         transformFeedback.Update(packedState);
         globalShaderConfig.Update(packedState);
 
+        const auto &traits{ctx.gpu.traits};
+        if (traits.supportsExtendedDynamicState) {
+            auto [stencilFront, stencilBack]{packedState.GetStencilOpsState()};
+            builder.SetExtendedDynamicState({
+                .cullMode = vk::CullModeFlags{packedState.cullMode},
+                .frontFace = packedState.frontFaceClockwise ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise,
+                .depthTestEnable = packedState.depthTestEnable,
+                .depthWriteEnable = packedState.depthWriteEnable,
+                .depthCompareOp = packedState.GetDepthFunc(),
+                .depthBoundsTestEnable = packedState.depthBoundsTestEnable,
+                .stencilTestEnable = packedState.stencilTestEnable,
+                .stencilFront = stencilFront,
+                .stencilBack = stencilBack,
+            });
+        }
+
+        if (traits.supportsExtendedDynamicState2)
+            builder.SetExtendedDynamicState2(packedState.depthBiasEnable, packedState.primitiveRestartEnabled, packedState.rasterizerDiscardEnable);
+
+        // The pipeline is looked up with a normalized copy of the state while the original state is retained as the source of any dynamic state
+        PackedPipelineState pipelineKey{packedState};
+        pipelineKey.Normalize(traits.supportsExtendedDynamicState, traits.supportsExtendedDynamicState2);
+        if (TRACE_EVENT_CATEGORY_ENABLED("gpu")) // Both keys are hashed for the census, this is only done while its counter tracks are being traced to keep it off the draw path
+            ctx.gpu.graphicsPipelineManager->RecordKeyCensus(packedState, pipelineKey);
+
         if (pipeline) {
-            if (auto newPipeline{pipeline->LookupNext(packedState)}) {
+            if (auto newPipeline{pipeline->LookupNext(pipelineKey)}) {
                 pipeline = newPipeline;
                 return;
             }
         }
 
-        auto newPipeline{ctx.gpu.graphicsPipelineManager->FindOrCreate(ctx, textures, constantBuffers, packedState, shaderBinaries)};
+        auto newPipeline{ctx.gpu.graphicsPipelineManager->FindOrCreate(ctx, textures, constantBuffers, pipelineKey, shaderBinaries)};
         if (pipeline)
             pipeline->AddTransition(newPipeline);
         pipeline = newPipeline;
@@ -444,11 +504,11 @@ namespace skyline::gpu::interconnect::maxwell3d {
             stage.MarkDirty(true);
     }
 
-    std::shared_ptr<TextureView> PipelineState::GetColorRenderTargetForClear(InterconnectContext &ctx, size_t index) {
-        return colorRenderTargets[index].UpdateGet(ctx, packedState).view;
-    }
+    std::pair<std::shared_ptr<TextureView>, std::shared_ptr<TextureView>> PipelineState::GetRenderTargetsForClear(InterconnectContext &ctx, std::optional<size_t> colorIndex, bool depthStencil) {
+        std::array<ColorRenderTargetState *, 1> colorRt{colorIndex ? &colorRenderTargets[*colorIndex].UpdateGet(ctx, packedState) : nullptr};
+        auto depthRt{depthStencil ? &depthRenderTarget.UpdateGet(ctx, packedState) : nullptr};
+        MatchRenderTargetScales(ctx, colorRt, depthRt);
 
-    std::shared_ptr<TextureView> PipelineState::GetDepthRenderTargetForClear(InterconnectContext &ctx) {
-        return depthRenderTarget.UpdateGet(ctx, packedState).view;
+        return {colorRt[0] ? colorRt[0]->view : nullptr, depthRt ? depthRt->view : nullptr};
     }
 }
@@ -27,6 +27,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
       public:
         ColorRenderTargetState(dirty::Handle dirtyHandle, DirtyManager &manager, const EngineRegisters &engine, size_t index);
 
+        GuestTexture guest; //!< The guest texture of the render target, this is retained so the texture can be recreated at another scale
         std::shared_ptr<TextureView> view;
         engine::ColorTarget::Format format{engine::ColorTarget::Format::Disabled};
 
@@ -58,6 +59,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
       public:
         DepthRenderTargetState(dirty::Handle dirtyHandle, DirtyManager &manager, const EngineRegisters &engine);
 
+        GuestTexture guest; //!< The guest texture of the render target, this is retained so the texture can be recreated at another scale
         std::shared_ptr<TextureView> view;
 
         void Flush(InterconnectContext &ctx, PackedPipelineState &packedState);
@@ -324,6 +326,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
         Pipeline *pipeline{};
         boost::container::static_vector<TextureView *, engine::ColorTargetCount> colorAttachments;
         TextureView *depthAttachment{};
+        texture::RenderScale renderScale{}; //!< The scale that all bound attachments are rendered at, see MatchRenderTargetScales
 
         PipelineState(dirty::Handle dirtyHandle, DirtyManager &manager, const EngineRegisters &engine);
 
@@ -331,8 +334,12 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
         void PurgeCaches();
 
-        std::shared_ptr<TextureView> GetColorRenderTargetForClear(InterconnectContext &ctx, size_t index);
-
-        std::shared_ptr<TextureView> GetDepthRenderTargetForClear(InterconnectContext &ctx);
+        /**
+         * @brief Looks up the render targets written by a clear, they're recreated as necessary so that both are rendered at the same scale
+         * @param colorIndex The index of the colour render target to clear, if any
+         * @param depthStencil If the depth/stencil render target is cleared
+         * @return The views of the colour and depth/stencil render targets, these are null if they aren't cleared or aren't bound
+         */
+        std::pair<std::shared_ptr<TextureView>, std::shared_ptr<TextureView>> GetRenderTargetsForClear(InterconnectContext &ctx, std::optional<size_t> colorIndex, bool depthStencil);
     };
 }
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <gpu/interconnect/command_executor.h>
+#include <soc/gm20b/channel.h>
+#include <gpu.h>
+#include "queries.h"
+
+namespace skyline::gpu::interconnect::maxwell3d {
+    Queries::QueryPool::QueryPool(GPU &gpu)
+        : pool{gpu.vkDevice, vk::QueryPoolCreateInfo{
+              .queryType = vk::QueryType::eOcclusion,
+              .queryCount = QueryPoolSize,
+          }},
+          resultBuffer{gpu.memory.AllocateBuffer(QueryPoolSize * sizeof(u64))} {}
+
+    Queries::Queries(const EngineRegisters &engine) : engine{engine} {}
+
+    void Queries::AcquirePool(InterconnectContext &ctx) {
+        auto it{std::find_if(pools.begin(), pools.end(), [](const std::shared_ptr<QueryPool> &pool) { return pool.use_count() == 1; })};
+        if (it != pools.end())
+            activePool = *it;
+        else
+            activePool = pools.emplace_back(std::make_shared<QueryPool>(ctx.gpu));
+
+        nextQuery = 0;
+        ctx.executor.AttachDependency(activePool);
+        activePoolAttached = true;
+
+        // Queries must be reset before they can be used, this can only be done outside of a render pass so the entire pool is reset at once to amortize the render pass break
+        ctx.executor.AddOutsideRpCommand([pool = *activePool->pool](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &) {
+            commandBuffer.resetQueryPool(pool, 0, QueryPoolSize);
+        });
+    }
+
+    std::optional<u64> Queries::ReadReport(InterconnectContext &ctx, u64 address) {
+        if (auto it{reports.find(address)}; it != reports.end() && !it->second->resolved.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        return ctx.channelCtx.asCtx->gmmu.Read<u64>(address);
+    }
+
+    void Queries::ResetExecutionState() {
+        activePoolAttached = false;
+        predicateBufferAttached = false;
+    }
+
+    void Queries::ResetCounter() {
+        counterRanges.clear();
+    }
+
+    void Queries::ReportCounter(InterconnectContext &ctx, u64 address, std::function<void(u64)> &&callback) {
+        auto report{std::make_shared<Report>()};
+        reports[address] = report;
+
+        if (counterRanges.empty()) {
+            // Nothing has been counted since the last reset, the result is known but it still needs to be written in order with other GPU work
+            ctx.executor.AddCompletionCallback([callback = std::move(callback), report] {
+                callback(0);
+                report->resolved.store(true, std::memory_order_release);
+            });
+            ctx.executor.Submit();
+            return;
+        }
+
+        // Conditional rendering can only be predicated on a single value so only reports consisting of a single query can be evaluated on the GPU, this is the common case of a bounding box test
+        vk::Buffer predicateVkBuffer{};
+        vk::DeviceSize predicateOffset{};
+        if (ctx.gpu.traits.supportsConditionalRendering && counterRanges.size() == 1 && counterRanges.front().count == 1) {
+            if (!predicateBuffer)
+                predicateBuffer = std::make_shared<memory::Buffer>(ctx.gpu.memory.AllocateBuffer(PredicateSlotCount * sizeof(u32)));
+
+            if (!predicateBufferAttached) {
+                ctx.executor.AttachDependency(predicateBuffer);
+                predicateBufferAttached = true;
+            }
+
+            report->hasPredicate = true;
+            report->predicateIndex = nextPredicateIndex++;
+            predicateVkBuffer = predicateBuffer->vkBuffer;
+            predicateOffset = (report->predicateIndex % PredicateSlotCount) * sizeof(u32);
+        }
+
+        ctx.executor.AddOutsideRpCommand([queryRanges = counterRanges, predicateVkBuffer, predicateOffset](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &) {
+            for (const auto &range : queryRanges)
+                commandBuffer.copyQueryPoolResults(*range.pool->pool, range.first, range.count, range.pool->resultBuffer.vkBuffer, range.first * sizeof(u64), sizeof(u64), vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+
+            if (predicateVkBuffer) {
+                // Any prior conditional rendering that read from this slot must be complete before it's overwritten
+                commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eConditionalRenderingEXT, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, {});
+
+                const auto &range{queryRanges.front()};
+                commandBuffer.copyQueryPoolResults(*range.pool->pool, range.first, 1, predicateVkBuffer, predicateOffset, sizeof(u32), vk::QueryResultFlagBits::eWait);
+                commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eConditionalRenderingEXT, {}, vk::MemoryBarrier{
+                    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                    .dstAccessMask = vk::AccessFlagBits::eConditionalRenderingReadEXT,
+                }, {}, {});
+            }
+
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, vk::MemoryBarrier{
+                .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                .dstAccessMask = vk::AccessFlagBits::eHostRead,
+            }, {}, {});
+        });
+
+        // The results are only read back on the CPU once the GPU has finished executing the copy, this doesn't block recording
+        ctx.executor.AddCompletionCallback([queryRanges = counterRanges, callback = std::move(callback), report] {
+            u64 result{};
+            for (const auto &range : queryRanges)
+                for (u64 value : range.pool->resultBuffer.cast<u64>().subspan(range.first, range.count))
+                    result += value;
+
+            callback(result);
+            report->resolved.store(true, std::memory_order_release);
+        });
+
+        // The guest may poll the report without anything else causing a submission, so it's submitted immediately as is done for semaphore releases
+        ctx.executor.Submit();
+    }
+
+    Queries::DrawQuery Queries::GetDrawQuery(InterconnectContext &ctx) {
+        if (!engine.sampleCounterEnable)
+            return {};
+
+        if (nextQuery == QueryPoolSize) {
+            AcquirePool(ctx);
+        } else if (!activePoolAttached) {
+            ctx.executor.AttachDependency(activePool);
+            activePoolAttached = true;
+        }
+
+        u32 index{nextQuery++};
+        if (!counterRanges.empty() && counterRanges.back().pool == activePool && counterRanges.back().first + counterRanges.back().count == index)
+            counterRanges.back().count++;
+        else
+            counterRanges.push_back({activePool, index, 1});
+
+        return {
+            .pool = *activePool->pool,
+            .index = index,
+            .flags = ctx.gpu.traits.supportsPreciseOcclusionQueries ? vk::QueryControlFlagBits::ePrecise : vk::QueryControlFlags{},
+        };
+    }
+
+    Queries::RenderCondition Queries::GetRenderCondition(InterconnectContext &ctx) {
+        const auto &renderEnable{engine.renderEnable};
+        u64 address{renderEnable.address};
+
+        switch (renderEnable.mode) {
+            case engine::RenderEnable::Mode::False:
+                return {.skip = true};
+
+            case engine::RenderEnable::Mode::Conditional: {
+                if (auto it{reports.find(address)}; it != reports.end() && !it->second->resolved.load(std::memory_order_acquire)) {
+                    const auto &report{*it->second};
+                    if (report.hasPredicate && nextPredicateIndex - report.predicateIndex <= PredicateSlotCount) {
+                        if (!predicateBufferAttached) {
+                            ctx.executor.AttachDependency(predicateBuffer);
+                            predicateBufferAttached = true;
+                        }
+
+                        return {
+                            .buffer = predicateBuffer->vkBuffer,
+                            .offset = (report.predicateIndex % PredicateSlotCount) * sizeof(u32),
+                        };
+                    }
+
+                    // The result isn't available yet and can't be evaluated on the GPU, rendering unconditionally is always correct albeit slower
+                    return {};
+                }
+
+                return {.skip = ctx.channelCtx.asCtx->gmmu.Read<u64>(address) == 0};
+            }
+
+            case engine::RenderEnable::Mode::IfEqual:
+            case engine::RenderEnable::Mode::IfNotEqual: {
+                auto first{ReadReport(ctx, address)}, second{ReadReport(ctx, address + ReportSize)};
+                if (!first || !second)
+                    return {};
+
+                return {.skip = (*first == *second) != (renderEnable.mode == engine::RenderEnable::Mode::IfEqual)};
+            }
+
+            default:
+                return {};
+        }
+    }
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <gpu/memory_manager.h>
+#include "common.h"
+
+namespace skyline::gpu::interconnect::maxwell3d {
+    /**
+     * @brief Emulates the Maxwell 3D samples passed counter with host occlusion queries alongside render enable conditions that depend on reports of it
+     * @note Query results are never waited on while recording, they're copied into host-visible memory on the GPU and only read back on the CPU for reports the guest requests once the execution containing the report has completed
+     */
+    class Queries {
+      public:
+        struct EngineRegisters {
+            const u32 &sampleCounterEnable;
+            const engine::RenderEnable &renderEnable;
+        };
+
+        /**
+         * @brief The occlusion query a single draw should be wrapped in, a null pool denotes that the draw isn't counted
+         */
+        struct DrawQuery {
+            vk::QueryPool pool;
+            u32 index;
+            vk::QueryControlFlags flags;
+        };
+
+        /**
+         * @brief The host state required to evaluate the guest render enable condition for a single draw
+         */
+        struct RenderCondition {
+            bool skip; //!< If the draw should be skipped entirely as the condition could be evaluated on the CPU and failed
+            vk::Buffer buffer; //!< If non-null, the draw must be predicated on the 32-bit value at `offset` in this buffer with VK_EXT_conditional_rendering
+            vk::DeviceSize offset;
+        };
+
+      private:
+        static constexpr u32 QueryPoolSize{0x400}; //!< The amount of queries in a single pool, a render pass break is required to reset a pool so this is kept fairly large
+        static constexpr u32 PredicateSlotCount{0x400}; //!< The amount of reports that can have their predicate value resident on the GPU at once
+        static constexpr u64 ReportSize{0x10}; //!< The size of a four-word report in guest memory, render conditions comparing two reports read them from consecutive addresses
+
+        /**
+         * @brief A pool of occlusion queries alongside a host-visible buffer that their results are copied into
+         * @note Pools are recycled once nothing aside from the free list references them, which implies no pending executions or reports use them
+         */
+        struct QueryPool {
+            vk::raii::QueryPool pool;
+            memory::Buffer resultBuffer; //!< The result of query N is copied to the 64-bit word at index N
+
+            QueryPool(GPU &gpu);
+        };
+
+        /**
+         * @brief A contiguous range of queries inside a single pool that contribute to the counter
+         */
+        struct QueryRange {
+            std::shared_ptr<QueryPool> pool;
+            u32 first;
+            u32 count;
+        };
+
+        /**
+         * @brief The state of the most recent report written to a guest address, this allows evaluating render conditions without reading back the result on the CPU
+         */
+        struct Report {
+            std::atomic<bool> resolved{}; //!< If the result has been written to guest memory and can be read by the CPU
+            bool hasPredicate{}; //!< If the result is resident in the predicate buffer
+            u64 predicateIndex{}; //!< The monotonic index of the predicate slot, the slot is only valid while it hasn't been reused
+        };
+
+        EngineRegisters engine;
+        std::vector<std::shared_ptr<QueryPool>> pools; //!< All allocated query pools, including the active one
+        std::shared_ptr<QueryPool> activePool;
+        u32 nextQuery{QueryPoolSize}; //!< The index of the next unused query in the active pool
+        bool activePoolAttached{}; //!< If the active pool has been attached to the current execution
+        std::vector<QueryRange> counterRanges; //!< All queries that have contributed to the counter since it was last reset
+        std::shared_ptr<memory::Buffer> predicateBuffer; //!< A ring of 32-bit report results that conditional rendering can be predicated on
+        u64 nextPredicateIndex{};
+        bool predicateBufferAttached{};
+        std::unordered_map<u64, std::shared_ptr<Report>> reports; //!< A map from guest addresses to the latest report written to them
+
+        /**
+         * @brief Switches to a recycled or newly allocated query pool, resetting it prior to use
+         */
+        void AcquirePool(InterconnectContext &ctx);
+
+        /**
+         * @return The 64-bit report value at the supplied guest address, std::nullopt if it is pending resolution
+         */
+        std::optional<u64> ReadReport(InterconnectContext &ctx, u64 address);
+
+      public:
+        Queries(const EngineRegisters &engine);
+
+        /**
+         * @brief Resets any state tied to the current execution, this must be called when the executor is flushed
+         */
+        void ResetExecutionState();
+
+        /**
+         * @brief Resets the samples passed counter to zero
+         */
+        void ResetCounter();
+
+        /**
+         * @brief Records a report of the current samples passed counter value
+         * @param address The guest address the report will be written to, this is used to track render conditions that depend on the report
+         * @param callback A function that writes the result to the guest, this is called on the execution waiter thread once the value is available
+         * @note This submits the current execution so the result is written without depending on later GPU work to force a submission
+         */
+        void ReportCounter(InterconnectContext &ctx, u64 address, std::function<void(u64)> &&callback);
+
+        /**
+         * @return The query that a draw should be wrapped in based on the current counter enable state
+         */
+        DrawQuery GetDrawQuery(InterconnectContext &ctx);
+
+        /**
+         * @return The render condition for a draw based on the current render enable state
+         */
+        RenderCondition GetRenderCondition(InterconnectContext &ctx);
+    };
+}
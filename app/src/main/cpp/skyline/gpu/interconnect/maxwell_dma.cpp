@@ -14,6 +14,7 @@ namespace skyline::gpu::interconnect {
           executor{channelCtx.executor} {}
 
     void MaxwellDma::Copy(span<u8> dstMapping, span<u8> srcMapping) {
+        std::scoped_lock bufferManagerLock{gpu.buffer};
         auto srcBuf{gpu.buffer.FindOrCreate(srcMapping, executor.tag, [this](std::shared_ptr<Buffer> buffer, ContextLock<Buffer> &&lock) {
             executor.AttachLockedBuffer(buffer, std::move(lock));
         })};
@@ -57,6 +58,7 @@ namespace skyline::gpu::interconnect {
         if (!util::IsAligned(mapping.size(), 4))
             throw exception("Cleared buffer's size is not aligned to 4 bytes!");
 
+        std::scoped_lock bufferManagerLock{gpu.buffer};
         auto clearBuf{gpu.buffer.FindOrCreate(mapping, executor.tag, [this](std::shared_ptr<Buffer> buffer, ContextLock<Buffer> &&lock) {
             executor.AttachLockedBuffer(buffer, std::move(lock));
         })};
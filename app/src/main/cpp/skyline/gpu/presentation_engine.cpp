@@ -5,6 +5,7 @@
 #include <android/choreographer.h>
 #include <common/settings.h>
 #include <common/signal.h>
+#include <common/perf_counters.h>
 #include <jvm.h>
 #include <gpu.h>
 #include <soc.h>
@@ -62,7 +63,11 @@ namespace skyline::gpu {
 
         // Record the current cycle's timestamp and signal the V-Sync event to notify the game that a frame has been displayed
         engine->lastChoreographerTime = frameTimeNanos;
-        if (!engine->skipSignal.exchange(false))
+        engine->vsyncTiming.Write([&](VsyncTiming &timing) {
+            timing.timestamp = frameTimeNanos;
+            timing.period = engine->refreshCycleDuration;
+        });
+        if (!engine->skipSignal.exchange(false) && (*engine->state.settings->disableFrameThrottling || !*engine->state.settings->enableFramePacing || engine->pacer.ShouldSignalVsync(frameTimeNanos, engine->refreshCycleDuration)))
             engine->vsyncEvent->Signal();
 
         // Post the frame callback to be triggered on the next display refresh
@@ -93,11 +98,27 @@ namespace skyline::gpu {
         }
     }
 
+    /**
+     * @return The current time on the CLOCK_MONOTONIC timebase that is used by the window and Choreographer in nanoseconds
+     */
+    static i64 GetMonotonicNs() {
+        timespec time;
+        if (clock_gettime(CLOCK_MONOTONIC, &time))
+            throw exception("Failed to clock_gettime with '{}'", strerror(errno));
+        return (time.tv_sec * constant::NsInSecond) + time.tv_nsec;
+    }
+
     void PresentationEngine::PresentFrame(const PresentableFrame &frame) {
         std::unique_lock lock(mutex);
         surfaceCondition.wait(lock, [this]() { return vkSurface.has_value(); });
 
+        i64 fenceWaitStart{GetMonotonicNs()};
         frame.fence.Wait(state.soc->host1x);
+        i64 fenceWaitEnd{GetMonotonicNs()};
+
+        // If waiting on the fence didn't block then the frame was presentable from when it was queued, using the current time would instead measure the backpressure on this thread
+        constexpr i64 FenceBlockThreshold{constant::NsInMillisecond / 10};
+        i64 readyTime{(fenceWaitEnd - fenceWaitStart > FenceBlockThreshold) ? fenceWaitEnd : frame.queueTime};
 
         std::scoped_lock textureLock(*frame.textureView);
 
@@ -105,11 +126,16 @@ namespace skyline::gpu {
         if (frame.textureView->format != swapchainFormat || texture->dimensions != swapchainExtent)
             UpdateSwapchain(frame.textureView->format, texture->dimensions);
 
+        // The guest crop is in guest pixels while the swapchain matches the host resolution of the texture, which differs when it's scaled
+        auto crop{frame.crop};
+        if (!texture->scale.IsNative())
+            crop = AndroidRect{texture->scale.Scale(crop.left), texture->scale.Scale(crop.top), texture->scale.Scale(crop.right), texture->scale.Scale(crop.bottom)};
+
         int result;
-        if (frame.crop && frame.crop != windowCrop) {
-            if ((result = window->perform(window, NATIVE_WINDOW_SET_CROP, &frame.crop)))
-                throw exception("Setting the layer crop to ({}-{})x({}-{}) failed with {}", frame.crop.left, frame.crop.right, frame.crop.top, frame.crop.bottom, result);
-            windowCrop = frame.crop;
+        if (crop && crop != windowCrop) {
+            if ((result = window->perform(window, NATIVE_WINDOW_SET_CROP, &crop)))
+                throw exception("Setting the layer crop to ({}-{})x({}-{}) failed with {}", crop.left, crop.right, crop.top, crop.bottom, result);
+            windowCrop = crop;
         }
 
         if (frame.scalingMode != NativeWindowScalingMode::Freeze && windowScalingMode != frame.scalingMode) {
@@ -124,10 +150,13 @@ namespace skyline::gpu {
 
         auto &acquireSemaphore{acquireSemaphores[frameIndex]};
         auto &frameFence{frameFences[frameIndex]};
-        if (frameFence)
+        if (frameFence) {
             frameFence->Wait();
+            if (auto copyTime{frameFence->GetExecutionTime()})
+                pacer.RecordCopyTime(*copyTime);
+        }
 
-        frameIndex = (frameIndex + 1) % swapchainImageCount;
+        frameIndex = (frameIndex + 1) % frameSlotCount;
 
         std::pair<vk::Result, u32> nextImage;
         while (nextImage = vkSwapchain->acquireNextImage(std::numeric_limits<u64>::max(), *acquireSemaphore, {}), nextImage.first != vk::Result::eSuccess) [[unlikely]] {
@@ -149,13 +178,6 @@ namespace skyline::gpu {
 
         frameFence = nextImageTexture->cycle;
 
-        auto getMonotonicNsNow{[]() -> i64 {
-            timespec time;
-            if (clock_gettime(CLOCK_MONOTONIC, &time))
-                throw exception("Failed to clock_gettime with '{}'", strerror(errno));
-            return (time.tv_sec * constant::NsInSecond) + time.tv_nsec;
-        }};
-
         i64 timestamp{frame.timestamp};
         if (timestamp) {
             // If the timestamp is specified, we need to convert it from the util::GetTimeNs base to the CLOCK_MONOTONIC one
@@ -163,13 +185,16 @@ namespace skyline::gpu {
             // Note: It's important we do this right before present as going past the timestamp could lead to fewer Binder IPC calls
             i64 current{util::GetTimeNs()};
             if (current < timestamp) {
-                timestamp = getMonotonicNsNow() + (timestamp - current);
+                timestamp = GetMonotonicNs() + (timestamp - current);
             } else {
                 timestamp = 0;
             }
         }
 
-        if (frame.swapInterval) {
+        if (frame.swapInterval && !*state.settings->disableFrameThrottling && *state.settings->enableFramePacing) {
+            // The pacer schedules frames on a consistent cadence of refreshes, the swap interval acts as a lower bound on the amount of refreshes in it
+            timestamp = std::max(timestamp, pacer.Schedule(readyTime, GetMonotonicNs(), refreshCycleDuration, lastChoreographerTime, frame.swapInterval));
+        } else if (frame.swapInterval) {
             // If we have a swap interval, we have to adjust the timestamp to emulate the swap interval
             i64 lastFramePresentTime{util::AlignUpNpot(windowLastTimestamp, refreshCycleDuration)};
             if (lastFramePresentTime > lastChoreographerTime)
@@ -203,7 +228,7 @@ namespace skyline::gpu {
             }); // We don't care about suboptimal images as they are caused by not respecting the transform hint, we handle transformations externally
         }
 
-        timestamp = (timestamp && !*state.settings->disableFrameThrottling) ? timestamp : getMonotonicNsNow(); // We tie FPS to the submission time rather than presentation timestamp, if we don't have the presentation timestamp available or if frame throttling is disabled as we want the maximum measured FPS to not be restricted to the refresh rate
+        timestamp = (timestamp && !*state.settings->disableFrameThrottling) ? timestamp : GetMonotonicNs(); // We tie FPS to the submission time rather than presentation timestamp, if we don't have the presentation timestamp available or if frame throttling is disabled as we want the maximum measured FPS to not be restricted to the refresh rate
         if (frameTimestamp) {
             i64 sampleWeight{Fps ? Fps : 1}; //!< The weight of each sample in calculating the average, we want to roughly average the past second
 
@@ -222,6 +247,8 @@ namespace skyline::gpu {
             Fps = static_cast<jint>(std::round(static_cast<float>(constant::NsInSecond) / static_cast<float>(averageFrametimeNs)));
 
             TRACE_EVENT_INSTANT("gpu", "Present", presentationTrack, "FrameTimeNs", timestamp - frameTimestamp, "Fps", Fps);
+            perf::EmitTraceCounters();
+            pacer.RecordFrameTime(currentFrametime);
 
             frameTimestamp = timestamp;
         } else {
@@ -281,7 +308,13 @@ namespace skyline::gpu {
     }
 
     void PresentationEngine::UpdateSwapchain(texture::Format format, texture::Dimensions extent) {
-        auto minImageCount{std::max(vkSurfaceCapabilities.minImageCount, *state.settings->forceTripleBuffering ? 3U : 2U)};
+        pacer.Reset(); // Swapchain recreation disrupts frame timing, the cadence is re-evaluated from scratch
+        // An image is required for each frame that can be in flight alongside the one being displayed
+        constexpr u32 MaxFrameLatency{3};
+        u32 frameLatency{std::clamp(*state.settings->frameLatency, 1U, MaxFrameLatency)};
+        if (vkSurfaceCapabilities.maxImageCount && frameLatency + 1 > vkSurfaceCapabilities.maxImageCount)
+            frameLatency = std::max(vkSurfaceCapabilities.maxImageCount, 2U) - 1; // Surfaces that only support a few images can't accommodate the requested latency, it's reduced rather than failing swapchain creation
+        auto minImageCount{std::max({vkSurfaceCapabilities.minImageCount, *state.settings->forceTripleBuffering ? 3U : 2U, frameLatency + 1})};
         if (minImageCount > MaxSwapchainImageCount)
             throw exception("Requesting swapchain with higher image count ({}) than maximum slot count ({})", minImageCount, MaxSwapchainImageCount);
 
@@ -340,6 +373,11 @@ namespace skyline::gpu {
         swapchainFormat = format;
         swapchainExtent = extent;
         swapchainImageCount = vkImages.size();
+        frameSlotCount = std::min<size_t>(frameLatency, swapchainImageCount);
+        if (frameSlotCount < *state.settings->frameLatency)
+            Logger::Warn("Frame latency is limited to {} frames by a surface with at most {} images, {} frames were requested", frameSlotCount, vkSurfaceCapabilities.maxImageCount, *state.settings->frameLatency);
+        if (frameIndex >= frameSlotCount)
+            frameIndex = 0;
     }
 
     void PresentationEngine::OnDisableFrameThrottlingChanged(const bool &value) {
@@ -415,12 +453,23 @@ namespace skyline::gpu {
             nextFrameId,
             crop,
             scalingMode,
-            transform
+            transform,
+            GetMonotonicNs(),
         });
 
         return nextFrameId++;
     }
 
+    std::optional<i64> PresentationEngine::GetNextVsyncTime(i64 time) {
+        auto timing{vsyncTiming.Read()};
+        if (!timing.period)
+            return std::nullopt;
+
+        if (time < timing.timestamp)
+            return timing.timestamp;
+        return timing.timestamp + (((time - timing.timestamp) / timing.period) + 1) * timing.period;
+    }
+
     NativeWindowTransform PresentationEngine::GetTransformHint() {
         if (!vkSurface.has_value()) {
             std::unique_lock lock{mutex};
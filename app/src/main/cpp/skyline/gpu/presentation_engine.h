@@ -7,9 +7,11 @@
 #include <android/looper.h>
 #include <common/trace.h>
 #include <common/circular_queue.h>
+#include <common/seqlock.h>
 #include <kernel/types/KEvent.h>
 #include <services/hosbinder/GraphicBufferProducer.h>
 #include "texture/texture.h"
+#include "frame_pacer.h"
 
 struct ANativeWindow;
 
@@ -45,6 +47,7 @@ namespace skyline::gpu {
         std::array<std::shared_ptr<FenceCycle>, MaxSwapchainImageCount> frameFences{}; //!< Array of fences used to wait on the GPU for copying of swapchain images to be completed, indexed by `frameIndex`
         size_t frameIndex{}; //!< The index of the next semaphore/fence to be used for acquiring swapchain images
         size_t swapchainImageCount{}; //!< The number of images in the current swapchain
+        size_t frameSlotCount{}; //!< The number of frames that can be in flight on the GPU at once, it's the frame latency setting bounded by the maximum image count of the surface
 
         i64 frameTimestamp{}; //!< The timestamp of the last frame being shown in nanoseconds
         i64 averageFrametimeNs{}; //!< The average time between frames in nanoseconds
@@ -62,6 +65,14 @@ namespace skyline::gpu {
         i64 refreshCycleDuration{}; //!< The duration of a single refresh cycle for the display in nanoseconds
         bool choreographerStop{}; //!< If the Choreographer thread should stop on the next ALooper_wake()
 
+        struct VsyncTiming {
+            i64 timestamp; //!< The timestamp of the last V-Sync in nanoseconds on the monotonic clock
+            i64 period; //!< The refresh cycle duration at the time of the last V-Sync in nanoseconds
+        };
+        SeqLock<VsyncTiming> vsyncTiming; //!< A copy of the Choreographer timing that can be read from any thread without racing the Choreographer thread
+
+        FramePacer pacer; //!< Schedules frame presentation when frame pacing is enabled and frame throttling isn't disabled, all non-atomic state in it is protected by the presentation mutex
+
         struct PresentableFrame {
             std::shared_ptr<TextureView> textureView{};
             skyline::service::hosbinder::AndroidFence fence{}; //!< The fence that must be waited on prior to using the texture
@@ -73,6 +84,7 @@ namespace skyline::gpu {
             service::hosbinder::AndroidRect crop{};
             service::hosbinder::NativeWindowScalingMode scalingMode{};
             service::hosbinder::NativeWindowTransform transform{};
+            i64 queueTime{}; //!< The time at which the frame was queued on the CLOCK_MONOTONIC timebase
         };
 
         std::thread presentationThread; //!< A thread for asynchronously presenting queued frames after their corresponded fences are signalled
@@ -92,6 +104,7 @@ namespace skyline::gpu {
 
         /**
          * @brief Submits a single frame to the host API for presentation with the appropriate waits and copies
+         * @note The frame is always copied into a swapchain image, the guest texture can't be scanned out directly as swapchain images are owned by the Vulkan WSI and can't back guest memory
          */
         void PresentFrame(const PresentableFrame& frame);
 
@@ -134,6 +147,12 @@ namespace skyline::gpu {
          */
         u64 Present(const std::shared_ptr<TextureView> &texture, i64 timestamp, i64 swapInterval, service::hosbinder::AndroidRect crop, service::hosbinder::NativeWindowScalingMode scalingMode, service::hosbinder::NativeWindowTransform transform, skyline::service::hosbinder::AndroidFence fence, const std::function<void()>& presentCallback);
 
+        /**
+         * @return The predicted timestamp of the first V-Sync after the supplied time in nanoseconds on the monotonic clock, std::nullopt if V-Sync hasn't occurred yet
+         * @note This is used to align periodic work such as HID updates to the point at which the guest is woken up by V-Sync
+         */
+        std::optional<i64> GetNextVsyncTime(i64 time);
+
         /**
          * @return A transform that the application should render with to elide costly transforms later
          */
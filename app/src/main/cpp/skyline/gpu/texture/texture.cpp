@@ -5,6 +5,7 @@
 #include <kernel/memory.h>
 #include <kernel/types/KProcess.h>
 #include <common/trace.h>
+#include <common/perf_counters.h>
 #include <common/settings.h>
 #include "texture.h"
 #include "layout.h"
@@ -243,9 +244,10 @@ namespace skyline::gpu {
     }
 
     std::shared_ptr<memory::StagingBuffer> Texture::SynchronizeHostImpl() {
-        if (guest->dimensions != dimensions)
-            throw exception("Guest and host dimensions being different is not supported currently");
+        if (scale.Scale(guest->dimensions) != dimensions)
+            throw exception("Guest and host dimensions being different is only supported for scaled textures");
 
+        perf::Add(perf::Counter::TextureUploadBytes, surfaceSize);
         auto pointer{mirror.data()};
 
         WaitOnBacking();
@@ -402,7 +404,49 @@ namespace skyline::gpu {
         return bufferImageCopies;
     }
 
-    void Texture::CopyFromStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer) {
+    std::shared_ptr<memory::Image> Texture::AllocateNativeImage() {
+        return std::make_shared<memory::Image>(gpu.memory.AllocateImage(vk::ImageCreateInfo{
+            .imageType = guest->GetImageType(),
+            .format = *format,
+            .extent = guest->dimensions,
+            .mipLevels = 1,
+            .arrayLayers = layerCount,
+            .samples = vk::SampleCountFlagBits::e1,
+            .tiling = vk::ImageTiling::eOptimal,
+            .usage = vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst,
+            .sharingMode = vk::SharingMode::eExclusive,
+            .queueFamilyIndexCount = 1,
+            .pQueueFamilyIndices = &gpu.vkQueueFamilyIndex,
+            .initialLayout = vk::ImageLayout::eUndefined,
+        }));
+    }
+
+    /**
+     * @brief Records a blit of all layers of the first mip level between images of differing dimensions
+     * @note Nearest filtering is used as it's supported for all formats, including integer and depth/stencil formats
+     */
+    static void RecordScalingBlit(const vk::raii::CommandBuffer &commandBuffer, vk::ImageAspectFlags aspect, u32 layerCount,
+                                  vk::Image srcImage, vk::ImageLayout srcLayout, texture::Dimensions srcDimensions,
+                                  vk::Image dstImage, vk::ImageLayout dstLayout, texture::Dimensions dstDimensions) {
+        vk::ImageSubresourceLayers subresourceLayers{
+            .aspectMask = aspect,
+            .layerCount = layerCount,
+        };
+        commandBuffer.blitImage(srcImage, srcLayout, dstImage, dstLayout, vk::ImageBlit{
+            .srcSubresource = subresourceLayers,
+            .srcOffsets = std::array<vk::Offset3D, 2>{
+                vk::Offset3D{0, 0, 0},
+                vk::Offset3D{static_cast<i32>(srcDimensions.width), static_cast<i32>(srcDimensions.height), static_cast<i32>(srcDimensions.depth)}
+            },
+            .dstSubresource = subresourceLayers,
+            .dstOffsets = std::array<vk::Offset3D, 2>{
+                vk::Offset3D{0, 0, 0},
+                vk::Offset3D{static_cast<i32>(dstDimensions.width), static_cast<i32>(dstDimensions.height), static_cast<i32>(dstDimensions.depth)}
+            },
+        }, vk::Filter::eNearest);
+    }
+
+    std::shared_ptr<memory::Image> Texture::CopyFromStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer) {
         auto image{GetBacking()};
         if (layout == vk::ImageLayout::eUndefined)
             commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eHost, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, vk::ImageMemoryBarrier{
@@ -421,10 +465,46 @@ namespace skyline::gpu {
             });
 
         auto bufferImageCopies{GetBufferImageCopies()};
-        commandBuffer.copyBufferToImage(stagingBuffer->vkBuffer, image, layout, vk::ArrayProxy(static_cast<u32>(bufferImageCopies.size()), bufferImageCopies.data()));
+        if (scale.IsNative()) {
+            commandBuffer.copyBufferToImage(stagingBuffer->vkBuffer, image, layout, vk::ArrayProxy(static_cast<u32>(bufferImageCopies.size()), bufferImageCopies.data()));
+            return nullptr;
+        }
+
+        // Guest data is at the guest resolution, so it's copied into an image of that resolution before being scaled into the backing
+        auto nativeImage{AllocateNativeImage()};
+        vk::ImageSubresourceRange nativeRange{
+            .aspectMask = format->vkAspect,
+            .levelCount = 1,
+            .layerCount = layerCount,
+        };
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, vk::ImageMemoryBarrier{
+            .image = nativeImage->vkImage,
+            .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .oldLayout = vk::ImageLayout::eUndefined,
+            .newLayout = vk::ImageLayout::eTransferDstOptimal,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .subresourceRange = nativeRange,
+        });
+
+        commandBuffer.copyBufferToImage(stagingBuffer->vkBuffer, nativeImage->vkImage, vk::ImageLayout::eTransferDstOptimal, vk::ArrayProxy(static_cast<u32>(bufferImageCopies.size()), bufferImageCopies.data()));
+
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, vk::ImageMemoryBarrier{
+            .image = nativeImage->vkImage,
+            .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+            .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+            .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .subresourceRange = nativeRange,
+        });
+
+        RecordScalingBlit(commandBuffer, format->vkAspect, layerCount, nativeImage->vkImage, vk::ImageLayout::eTransferSrcOptimal, guest->dimensions, image, layout, dimensions);
+        return nativeImage;
     }
 
-    void Texture::CopyIntoStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer) {
+    std::shared_ptr<memory::Image> Texture::CopyIntoStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer) {
         auto image{GetBacking()};
         commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eBottomOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, vk::ImageMemoryBarrier{
             .image = image,
@@ -442,7 +522,42 @@ namespace skyline::gpu {
         });
 
         auto bufferImageCopies{GetBufferImageCopies()};
-        commandBuffer.copyImageToBuffer(image, layout, stagingBuffer->vkBuffer, vk::ArrayProxy(static_cast<u32>(bufferImageCopies.size()), bufferImageCopies.data()));
+        std::shared_ptr<memory::Image> nativeImage;
+        if (scale.IsNative()) {
+            commandBuffer.copyImageToBuffer(image, layout, stagingBuffer->vkBuffer, vk::ArrayProxy(static_cast<u32>(bufferImageCopies.size()), bufferImageCopies.data()));
+        } else {
+            // The guest expects data at its own resolution, so the backing is scaled down into an image of that resolution prior to the copy
+            nativeImage = AllocateNativeImage();
+            vk::ImageSubresourceRange nativeRange{
+                .aspectMask = format->vkAspect,
+                .levelCount = 1,
+                .layerCount = layerCount,
+            };
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, vk::ImageMemoryBarrier{
+                .image = nativeImage->vkImage,
+                .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+                .oldLayout = vk::ImageLayout::eUndefined,
+                .newLayout = vk::ImageLayout::eTransferDstOptimal,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .subresourceRange = nativeRange,
+            });
+
+            RecordScalingBlit(commandBuffer, format->vkAspect, layerCount, image, layout, dimensions, nativeImage->vkImage, vk::ImageLayout::eTransferDstOptimal, guest->dimensions);
+
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, vk::ImageMemoryBarrier{
+                .image = nativeImage->vkImage,
+                .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+                .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+                .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .subresourceRange = nativeRange,
+            });
+
+            commandBuffer.copyImageToBuffer(nativeImage->vkImage, vk::ImageLayout::eTransferSrcOptimal, stagingBuffer->vkBuffer, vk::ArrayProxy(static_cast<u32>(bufferImageCopies.size()), bufferImageCopies.data()));
+        }
 
         commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, {}, vk::BufferMemoryBarrier{
             .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
@@ -453,6 +568,8 @@ namespace skyline::gpu {
             .offset = 0,
             .size = stagingBuffer->size(),
         }, {});
+
+        return nativeImage;
     }
 
     void Texture::CopyToGuest(u8 *hostBuffer) {
@@ -574,16 +691,17 @@ namespace skyline::gpu {
         return surfaceSize;
     }
 
-    Texture::Texture(GPU &pGpu, GuestTexture pGuest)
+    Texture::Texture(GPU &pGpu, GuestTexture pGuest, texture::RenderScale pScale)
         : gpu(pGpu),
           guest(std::move(pGuest)),
-          dimensions(guest->dimensions),
+          scale(IsScalable(*guest) ? pScale : texture::RenderScale{}),
+          dimensions(scale.Scale(guest->dimensions)),
           format(ConvertHostCompatibleFormat(guest->format, gpu.traits)),
           layout(vk::ImageLayout::eUndefined),
           tiling(vk::ImageTiling::eOptimal), // Force Optimal due to not adhering to host subresource layout during Linear synchronization
           layerCount(guest->layerCount),
-          deswizzledLayerStride(static_cast<u32>(guest->format->GetSize(dimensions))),
-          layerStride(format == guest->format ? deswizzledLayerStride : static_cast<u32>(format->GetSize(dimensions))),
+          deswizzledLayerStride(static_cast<u32>(guest->format->GetSize(guest->dimensions))),
+          layerStride(format == guest->format ? deswizzledLayerStride : static_cast<u32>(format->GetSize(guest->dimensions))),
           levelCount(guest->mipLevelCount),
           mipLayouts(
               texture::GetBlockLinearMipLayout(
@@ -630,6 +748,22 @@ namespace skyline::gpu {
         SetupGuestMappings();
     }
 
+    bool Texture::IsScalable(const GuestTexture &guest) {
+        constexpr u32 MinimumScaledDimension{64}; //!< Render targets smaller than this are generally lookup tables or intermediate buffers which don't benefit from scaling
+
+        return guest.GetImageType() == vk::ImageType::e2D && guest.mipLevelCount == 1 && guest.tileConfig.mode == texture::TileMode::Block &&
+            !guest.format->IsCompressed() && guest.dimensions.width >= MinimumScaledDimension && guest.dimensions.height >= MinimumScaledDimension;
+    }
+
+    texture::RenderScale Texture::GetConfiguredScale(GPU &gpu) {
+        u32 percent{*gpu.state.settings->resolutionScale};
+        return percent ? texture::RenderScale{percent} : texture::RenderScale{};
+    }
+
+    bool Texture::CanRescale(texture::RenderScale target) const {
+        return target.IsNative() || (guest && !nativeScalePinned && IsScalable(*guest));
+    }
+
     Texture::~Texture() {
         SynchronizeGuest(true);
         if (trapHandle)
@@ -756,10 +890,13 @@ namespace skyline::gpu {
         if (stagingBuffer) {
             if (cycle)
                 cycle->WaitSubmit();
+            std::shared_ptr<memory::Image> nativeImage;
             auto lCycle{gpu.scheduler.Submit([&](vk::raii::CommandBuffer &commandBuffer) {
-                CopyFromStagingBuffer(commandBuffer, stagingBuffer);
+                nativeImage = CopyFromStagingBuffer(commandBuffer, stagingBuffer);
             })};
             lCycle->AttachObjects(stagingBuffer, shared_from_this());
+            if (nativeImage)
+                lCycle->AttachObject(nativeImage);
             lCycle->ChainCycle(cycle);
             cycle = lCycle;
         }
@@ -798,7 +935,8 @@ namespace skyline::gpu {
 
         auto stagingBuffer{SynchronizeHostImpl()};
         if (stagingBuffer) {
-            CopyFromStagingBuffer(commandBuffer, stagingBuffer);
+            if (auto nativeImage{CopyFromStagingBuffer(commandBuffer, stagingBuffer)})
+                pCycle->AttachObject(nativeImage);
             pCycle->AttachObjects(stagingBuffer, shared_from_this());
             pCycle->ChainCycle(cycle);
             cycle = pCycle;
@@ -845,10 +983,11 @@ namespace skyline::gpu {
                 downloadStagingBuffer = gpu.memory.AllocateStagingBuffer(surfaceSize);
 
             WaitOnFence();
+            std::shared_ptr<memory::Image> nativeImage;
             auto lCycle{gpu.scheduler.Submit([&](vk::raii::CommandBuffer &commandBuffer) {
-                CopyIntoStagingBuffer(commandBuffer, downloadStagingBuffer);
+                nativeImage = CopyIntoStagingBuffer(commandBuffer, downloadStagingBuffer);
             })};
-            lCycle->Wait(); // We block till the copy is complete
+            lCycle->Wait(); // We block till the copy is complete, this also makes it safe to destroy any transient image used for the copy
 
             CopyToGuest(downloadStagingBuffer->data());
         } else if (tiling == vk::ImageTiling::eLinear) {
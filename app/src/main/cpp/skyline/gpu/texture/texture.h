@@ -227,6 +227,66 @@ namespace skyline::gpu {
 
             constexpr MipLevelLayout(Dimensions dimensions, size_t linearSize, size_t targetLinearSize, size_t blockLinearSize, size_t blockHeight, size_t blockDepth) : dimensions{dimensions}, linearSize{linearSize}, targetLinearSize{targetLinearSize}, blockLinearSize{blockLinearSize}, blockHeight{blockHeight}, blockDepth{blockDepth} {}
         };
+
+        /**
+         * @brief The ratio between the host and guest resolution of a texture, this is used to render at a resolution other than the guest's
+         * @note Only the width and height are scaled, the depth and layer count of a texture always match the guest
+         */
+        struct RenderScale {
+            u32 percent{100}; //!< The host resolution as a percentage of the guest resolution
+
+            constexpr bool IsNative() const {
+                return percent == 100;
+            }
+
+            /**
+             * @return The supplied guest size scaled to the host resolution, non-zero sizes never become zero
+             */
+            constexpr u32 Scale(u32 value) const {
+                if (IsNative() || !value)
+                    return value;
+                return std::max(static_cast<u32>((static_cast<u64>(value) * percent) / 100), 1U);
+            }
+
+            constexpr i32 Scale(i32 value) const {
+                return IsNative() ? value : static_cast<i32>((static_cast<i64>(value) * percent) / 100);
+            }
+
+            constexpr float Scale(float value) const {
+                return IsNative() ? value : (value * static_cast<float>(percent)) / 100.0f;
+            }
+
+            constexpr Dimensions Scale(Dimensions dimensions) const {
+                return Dimensions{Scale(dimensions.width), Scale(dimensions.height), dimensions.depth};
+            }
+
+            /**
+             * @note Rects with an unbounded extent are left unbounded
+             */
+            constexpr vk::Rect2D Scale(vk::Rect2D rect) const {
+                constexpr u32 Unbounded{static_cast<u32>(std::numeric_limits<i32>::max())};
+                return vk::Rect2D{
+                    .offset = {Scale(rect.offset.x), Scale(rect.offset.y)},
+                    .extent = {
+                        rect.extent.width >= Unbounded ? rect.extent.width : Scale(rect.extent.width),
+                        rect.extent.height >= Unbounded ? rect.extent.height : Scale(rect.extent.height),
+                    },
+                };
+            }
+
+            /**
+             * @note The depth range of the viewport is unaffected
+             */
+            constexpr vk::Viewport Scale(vk::Viewport viewport) const {
+                viewport.x = Scale(viewport.x);
+                viewport.y = Scale(viewport.y);
+                viewport.width = Scale(viewport.width);
+                viewport.height = Scale(viewport.height);
+                return viewport;
+            }
+
+            constexpr bool operator==(const RenderScale &) const = default;
+        };
     }
 
     class Texture;
@@ -429,16 +489,23 @@ namespace skyline::gpu {
          */
         std::shared_ptr<memory::StagingBuffer> SynchronizeHostImpl();
 
+        /**
+         * @return A transient image with the guest dimensions that can be used to convert between the guest and host resolution of a scaled texture
+         */
+        std::shared_ptr<memory::Image> AllocateNativeImage();
+
         /**
          * @brief Records commands for copying data from a staging buffer to the texture's backing into the supplied command buffer
+         * @return A transient image that was used to scale the data to the host resolution, it must be attached to the cycle of the command buffer if it isn't null
          */
-        void CopyFromStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer);
+        std::shared_ptr<memory::Image> CopyFromStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer);
 
         /**
-         * @brief Records commands for copying data from the texture's backing to a staging buffer into the supplied command buffer
+         * @brief Records commands for copying data from the texture's backing to a staging buffer into the supplied command buffer, scaled textures are copied at the guest resolution
+         * @return A transient image that was used to scale the data to the guest resolution, it must be attached to the cycle of the command buffer if it isn't null
          * @note Any caller **must** ensure that the layout is not `eUndefined`
          */
-        void CopyIntoStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer);
+        std::shared_ptr<memory::Image> CopyIntoStagingBuffer(const vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<memory::StagingBuffer> &stagingBuffer);
 
         /**
          * @brief Copies data from the supplied host buffer into the guest texture
@@ -468,7 +535,8 @@ namespace skyline::gpu {
       public:
         std::shared_ptr<FenceCycle> cycle; //!< A fence cycle for when any host operation mutating the texture has completed, it must be waited on prior to any mutations to the backing
         std::optional<GuestTexture> guest;
-        texture::Dimensions dimensions;
+        texture::RenderScale scale{}; //!< The scale of the host image relative to the guest texture, this is only non-native for render targets
+        texture::Dimensions dimensions; //!< The dimensions of the host image, these only differ from the guest dimensions when the texture is scaled
         texture::Format format;
         vk::ImageLayout layout;
         vk::ImageTiling tiling;
@@ -483,6 +551,7 @@ namespace skyline::gpu {
         size_t surfaceSize{}; //!< The size of the entire surface given linear tiling, this contains all mip levels and layers
         vk::SampleCountFlagBits sampleCount;
         bool replaced{};
+        bool nativeScalePinned{}; //!< If the texture replaced a scaled texture to be rendered at the native scale alongside textures that can't be scaled, it's never scaled again to avoid repeatedly recreating it
 
         /**
          * @brief Creates a texture object wrapping the supplied backing with the supplied attributes
@@ -492,9 +561,26 @@ namespace skyline::gpu {
 
         /**
          * @brief Creates a texture object wrapping the guest texture with a backing that can represent the guest texture data
+         * @param scale The scale the texture will be rendered at, this is ignored for textures which can't be scaled
          * @note The guest mappings will not be setup until SetupGuestMappings() is called
          */
-        Texture(GPU &gpu, GuestTexture guest);
+        Texture(GPU &gpu, GuestTexture guest, texture::RenderScale scale = {});
+
+        /**
+         * @return If the supplied guest texture can be rendered at a scale other than the native one
+         * @note Only 2D block-linear textures without mipmaps are scaled, other textures are either rarely rendered to or likely to be accessed by the CPU in ways that depend on their exact resolution
+         */
+        static bool IsScalable(const GuestTexture &guest);
+
+        /**
+         * @return The scale that render targets are rendered at with the current settings
+         */
+        static texture::RenderScale GetConfiguredScale(GPU &gpu);
+
+        /**
+         * @return If the texture can be recreated at the supplied scale, textures can always be recreated at the native scale
+         */
+        bool CanRescale(texture::RenderScale target) const;
 
         ~Texture();
 
@@ -6,7 +6,7 @@
 namespace skyline::gpu {
     TextureManager::TextureManager(GPU &gpu) : gpu(gpu) {}
 
-    std::shared_ptr<TextureView> TextureManager::FindOrCreate(const GuestTexture &guestTexture, ContextTag tag) {
+    std::shared_ptr<TextureView> TextureManager::FindOrCreate(const GuestTexture &guestTexture, ContextTag tag, texture::RenderScale renderScale, bool rescale) {
         auto guestMapping{guestTexture.mappings.front()};
 
         /*
@@ -107,6 +107,18 @@ namespace skyline::gpu {
             }
          }
 
+        // A match at another scale is replaced by a texture at the requested scale, the contents are retained by synchronizing the match to the guest and uploading them to the new texture
+        bool rescaled{};
+        auto replaceForScale{[&](std::shared_ptr<Texture> &match) {
+            if (match && rescale && match->scale != renderScale && match->CanRescale(renderScale)) {
+                match->replaced = true;
+                matches.push_back(std::move(match));
+                rescaled = true;
+            }
+        }};
+        replaceForScale(layerMipMatch);
+        replaceForScale(fullMatch);
+
         if (layerMipMatch) {
             ContextLock textureLock{tag, *layerMipMatch};
             return layerMipMatch->GetView(guestTexture.viewType, vk::ImageSubresourceRange{
@@ -131,7 +143,8 @@ namespace skyline::gpu {
             texture->SynchronizeGuest(false, true);
 
         // Create a texture as we cannot find one that matches
-        auto texture{std::make_shared<Texture>(gpu, guestTexture)};
+        auto texture{std::make_shared<Texture>(gpu, guestTexture, renderScale)};
+        texture->nativeScalePinned = rescaled && renderScale.IsNative();
         texture->SetupGuestMappings();
         texture->TransitionLayout(vk::ImageLayout::eGeneral);
         auto it{texture->guest->mappings.begin()};
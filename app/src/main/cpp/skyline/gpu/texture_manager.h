@@ -32,9 +32,11 @@ namespace skyline::gpu {
         TextureManager(GPU &gpu);
 
         /**
+         * @param renderScale The scale a newly created texture will be rendered at, this should only be non-native for textures that are being looked up to be rendered to
+         * @param rescale If a matching texture at a scale other than `renderScale` should be replaced by one at `renderScale`, this is only done if Texture::CanRescale allows it so the caller must still check the scale of the returned texture
          * @return A pre-existing or newly created Texture object which matches the specified criteria
          * @note The texture manager **must** be locked prior to calling this
          */
-        std::shared_ptr<TextureView> FindOrCreate(const GuestTexture &guestTexture, ContextTag tag = {});
+        std::shared_ptr<TextureView> FindOrCreate(const GuestTexture &guestTexture, ContextTag tag = {}, texture::RenderScale renderScale = {}, bool rescale = false);
     };
 }
@@ -4,6 +4,7 @@
 #include <common/signal.h>
 #include <loader/loader.h>
 #include <kernel/types/KProcess.h>
+#include <gpu.h>
 #include "input.h"
 
 namespace skyline::input {
@@ -31,18 +32,30 @@ namespace skyline::input {
                     : period{period}, next{std::chrono::steady_clock::now() + period}, callback{std::move(callback)} {}
 
                 void operator()() {
-                    callback(*this);
                     next += period;
+                    callback(*this); // The callback may override the next invocation time
                 }
             };
 
             constexpr std::chrono::milliseconds NPadUpdatePeriod{4}; //!< The period at which a Joy-Con is updated (250Hz)
             constexpr std::chrono::milliseconds TouchUpdatePeriod{4}; //!< The period at which the touch screen is updated (250Hz)
+            constexpr std::chrono::microseconds VsyncLeadTime{500}; //!< The duration prior to V-Sync at which NPads are updated, this accounts for the wakeup latency of this thread
 
             std::array<UpdateCallback, 2> updateCallbacks{
                 UpdateCallback{NPadUpdatePeriod, [&](UpdateCallback &callback) {
-                    for (auto &pad : npad.npads)
-                        pad.UpdateSharedMemory();
+                    {
+                        std::scoped_lock lock{npad.mutex}; // This only contends with HID service calls, host input is staged without locking
+                        for (auto &pad : npad.npads)
+                            pad.UpdateSharedMemory();
+                    }
+
+                    // Games typically sample input right after being woken up by V-Sync, we ensure an update is published shortly before it to minimize the age of the sampled input
+                    auto now{std::chrono::steady_clock::now()};
+                    if (auto nextVsync{state.gpu->presentation.GetNextVsyncTime(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count())}) {
+                        std::chrono::steady_clock::time_point vsyncUpdate{std::chrono::nanoseconds{*nextVsync} - VsyncLeadTime};
+                        if (vsyncUpdate > now && vsyncUpdate < callback.next)
+                            callback.next = vsyncUpdate;
+                    }
                 }},
                 UpdateCallback{TouchUpdatePeriod, [&](UpdateCallback &callback) {
                     touch.UpdateSharedMemory();
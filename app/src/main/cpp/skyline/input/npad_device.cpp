@@ -293,25 +293,22 @@ namespace skyline::input {
         if (!connectionState.connected)
             return;
 
+        auto staged{stagedState.Read()};
         if (controllerInfo)
-            WriteNextEntry(*controllerInfo, controllerState);
-        WriteNextEntry(section.defaultController, defaultState);
+            WriteNextEntry(*controllerInfo, staged.controllerState);
+        WriteNextEntry(section.defaultController, staged.defaultState);
 
         // TODO: SixAxis should be updated every 5 ms
         if (sixAxisInfoLeft)
-            WriteNextEntry(*sixAxisInfoLeft, sixAxisStateLeft);
+            WriteNextEntry(*sixAxisInfoLeft, staged.sixAxisStateLeft);
         if (sixAxisInfoRight)
-            WriteNextEntry(*sixAxisInfoRight, sixAxisStateRight);
+            WriteNextEntry(*sixAxisInfoRight, staged.sixAxisStateRight);
 
         globalTimestamp++;
     }
 
     void NpadDevice::SetButtonState(NpadButton mask, bool pressed) {
-        if (pressed)
-            controllerState.buttons.raw |= mask.raw;
-        else
-            controllerState.buttons.raw &= ~mask.raw;
-
+        NpadButton defaultMask{mask}; // The default controller has its buttons oriented based on the Joy-Con orientation
         if (manager.orientation == NpadJoyOrientation::Horizontal && (type == NpadControllerType::JoyconLeft || type == NpadControllerType::JoyconRight)) {
             NpadButton orientedMask{};
 
@@ -342,152 +339,165 @@ namespace skyline::input {
             orientedMask.rightSl = mask.rightSl;
             orientedMask.rightSr = mask.rightSr;
 
-            mask = orientedMask;
+            defaultMask = orientedMask;
         }
 
-        if (pressed)
-            defaultState.buttons.raw |= mask.raw;
-        else
-            defaultState.buttons.raw &= ~mask.raw;
+        stagedState.Write([&](StagedState &staged) {
+            if (pressed) {
+                staged.controllerState.buttons.raw |= mask.raw;
+                staged.defaultState.buttons.raw |= defaultMask.raw;
+            } else {
+                staged.controllerState.buttons.raw &= ~mask.raw;
+                staged.defaultState.buttons.raw &= ~defaultMask.raw;
+            }
+        });
     }
 
     void NpadDevice::SetAxisValue(NpadAxisId axis, i32 value) {
         constexpr i16 threshold{std::numeric_limits<i16>::max() / 2}; // A 50% deadzone for the stick buttons
 
-        if (manager.orientation == NpadJoyOrientation::Vertical || (type != NpadControllerType::JoyconLeft && type != NpadControllerType::JoyconRight)) {
-            switch (axis) {
-                case NpadAxisId::LX:
-                    controllerState.leftX = value;
-                    defaultState.leftX = value;
-
-                    controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
-                    defaultState.buttons.leftStickLeft = controllerState.buttons.leftStickLeft;
-
-                    controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
-                    defaultState.buttons.leftStickRight = controllerState.buttons.leftStickRight;
-                    break;
-                case NpadAxisId::LY:
-                    controllerState.leftY = value;
-                    defaultState.leftY = value;
-
-                    defaultState.buttons.leftStickUp = controllerState.buttons.leftStickUp;
-                    controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
-
-                    controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
-                    defaultState.buttons.leftStickDown = controllerState.buttons.leftStickDown;
-                    break;
-                case NpadAxisId::RX:
-                    controllerState.rightX = value;
-                    defaultState.rightX = value;
-
-                    controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
-                    defaultState.buttons.rightStickLeft = controllerState.buttons.rightStickLeft;
-
-                    controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
-                    defaultState.buttons.rightStickRight = controllerState.buttons.rightStickRight;
-                    break;
-                case NpadAxisId::RY:
-                    controllerState.rightY = value;
-                    defaultState.rightY = value;
-
-                    controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
-                    defaultState.buttons.rightStickUp = controllerState.buttons.rightStickUp;
-
-                    controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
-                    defaultState.buttons.rightStickDown = controllerState.buttons.rightStickDown;
-                    break;
-            }
-        } else {
-            switch (axis) {
-                case NpadAxisId::LX:
-                    controllerState.leftY = value;
-                    controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
-                    controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
-
-                    defaultState.leftX = value;
-                    defaultState.buttons.leftStickLeft = defaultState.leftX <= -threshold;
-                    defaultState.buttons.leftStickRight = defaultState.leftX >= threshold;
-                    break;
-                case NpadAxisId::LY:
-                    controllerState.leftX = -value;
-                    controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
-                    controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
-
-                    defaultState.leftY = value;
-                    defaultState.buttons.leftStickUp = defaultState.leftY >= threshold;
-                    defaultState.buttons.leftStickDown = defaultState.leftY <= -threshold;
-                    break;
-                case NpadAxisId::RX:
-                    controllerState.rightY = value;
-                    controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
-                    controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
-
-                    defaultState.rightX = value;
-                    defaultState.buttons.rightStickLeft = defaultState.rightX <= -threshold;
-                    defaultState.buttons.rightStickRight = defaultState.rightX >= threshold;
-                    break;
-                case NpadAxisId::RY:
-                    controllerState.rightX = -value;
-                    controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
-                    controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
-
-                    defaultState.rightY = value;
-                    defaultState.buttons.rightStickUp = defaultState.rightY >= threshold;
-                    defaultState.buttons.rightStickDown = defaultState.rightY <= -threshold;
-                    break;
+        stagedState.Write([&](StagedState &staged) {
+            auto &controllerState{staged.controllerState};
+            auto &defaultState{staged.defaultState};
+
+            if (manager.orientation == NpadJoyOrientation::Vertical || (type != NpadControllerType::JoyconLeft && type != NpadControllerType::JoyconRight)) {
+                switch (axis) {
+                    case NpadAxisId::LX:
+                        controllerState.leftX = value;
+                        defaultState.leftX = value;
+
+                        controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
+                        defaultState.buttons.leftStickLeft = controllerState.buttons.leftStickLeft;
+
+                        controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
+                        defaultState.buttons.leftStickRight = controllerState.buttons.leftStickRight;
+                        break;
+                    case NpadAxisId::LY:
+                        controllerState.leftY = value;
+                        defaultState.leftY = value;
+
+                        defaultState.buttons.leftStickUp = controllerState.buttons.leftStickUp;
+                        controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
+
+                        controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
+                        defaultState.buttons.leftStickDown = controllerState.buttons.leftStickDown;
+                        break;
+                    case NpadAxisId::RX:
+                        controllerState.rightX = value;
+                        defaultState.rightX = value;
+
+                        controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
+                        defaultState.buttons.rightStickLeft = controllerState.buttons.rightStickLeft;
+
+                        controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
+                        defaultState.buttons.rightStickRight = controllerState.buttons.rightStickRight;
+                        break;
+                    case NpadAxisId::RY:
+                        controllerState.rightY = value;
+                        defaultState.rightY = value;
+
+                        controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
+                        defaultState.buttons.rightStickUp = controllerState.buttons.rightStickUp;
+
+                        controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
+                        defaultState.buttons.rightStickDown = controllerState.buttons.rightStickDown;
+                        break;
+                }
+            } else {
+                switch (axis) {
+                    case NpadAxisId::LX:
+                        controllerState.leftY = value;
+                        controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
+                        controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
+
+                        defaultState.leftX = value;
+                        defaultState.buttons.leftStickLeft = defaultState.leftX <= -threshold;
+                        defaultState.buttons.leftStickRight = defaultState.leftX >= threshold;
+                        break;
+                    case NpadAxisId::LY:
+                        controllerState.leftX = -value;
+                        controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
+                        controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
+
+                        defaultState.leftY = value;
+                        defaultState.buttons.leftStickUp = defaultState.leftY >= threshold;
+                        defaultState.buttons.leftStickDown = defaultState.leftY <= -threshold;
+                        break;
+                    case NpadAxisId::RX:
+                        controllerState.rightY = value;
+                        controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
+                        controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
+
+                        defaultState.rightX = value;
+                        defaultState.buttons.rightStickLeft = defaultState.rightX <= -threshold;
+                        defaultState.buttons.rightStickRight = defaultState.rightX >= threshold;
+                        break;
+                    case NpadAxisId::RY:
+                        controllerState.rightX = -value;
+                        controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
+                        controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
+
+                        defaultState.rightY = value;
+                        defaultState.buttons.rightStickUp = defaultState.rightY >= threshold;
+                        defaultState.buttons.rightStickDown = defaultState.rightY <= -threshold;
+                        break;
+                }
             }
-        }
+        });
     }
 
     void NpadDevice::SetMotionValue(MotionId sensor, MotionSensorState *value) {
         if (!connectionState.connected)
             return;
 
-        NpadSixAxisState *sixAxisState{sensor == MotionId::Right? &sixAxisStateRight : &sixAxisStateLeft};
-        MotionInput* motionSensor{sensor == MotionId::Right ? &motionRight : &motionLeft};
-
-        motionSensor->SetAcceleration(Common::Vec3f{
-            value->accelerometer[0],
-            value->accelerometer[1],
-            value->accelerometer[2],
-        });
-        motionSensor->SetGyroscope(Common::Vec3f{
-            value->gyroscope[0],
-            value->gyroscope[1],
-            value->gyroscope[2],
+        // The sensor fusion state is only modified while writing to the staged state, this serializes it across sensor threads
+        stagedState.Write([&](StagedState &staged) {
+            NpadSixAxisState *sixAxisState{sensor == MotionId::Right ? &staged.sixAxisStateRight : &staged.sixAxisStateLeft};
+            MotionInput* motionSensor{sensor == MotionId::Right ? &motionRight : &motionLeft};
+
+            motionSensor->SetAcceleration(Common::Vec3f{
+                value->accelerometer[0],
+                value->accelerometer[1],
+                value->accelerometer[2],
+            });
+            motionSensor->SetGyroscope(Common::Vec3f{
+                value->gyroscope[0],
+                value->gyroscope[1],
+                value->gyroscope[2],
+            });
+            motionSensor->UpdateRotation(value->deltaTimestamp / 1000);
+            motionSensor->UpdateOrientation(value->deltaTimestamp / 1000);
+
+            const auto gyroscope = motionSensor->GetGyroscope();
+            const auto accelerometer = motionSensor->GetAcceleration();
+            const auto rotation = motionSensor->GetRotations();
+            const auto orientation = motionSensor->GetOrientation();
+
+            sixAxisState->accelerometer.x = accelerometer.x;
+            sixAxisState->accelerometer.y = accelerometer.y;
+            sixAxisState->accelerometer.z = accelerometer.z;
+
+            sixAxisState->gyroscope.x = gyroscope.x;
+            sixAxisState->gyroscope.y = gyroscope.y;
+            sixAxisState->gyroscope.z = gyroscope.z;
+
+            sixAxisState->rotation.x = rotation.x;
+            sixAxisState->rotation.y = rotation.y;
+            sixAxisState->rotation.z = rotation.z;
+
+            sixAxisState->orientation[0].x = orientation[0].x;
+            sixAxisState->orientation[0].y = orientation[0].y;
+            sixAxisState->orientation[0].z = orientation[0].z;
+            sixAxisState->orientation[1].x = orientation[1].x;
+            sixAxisState->orientation[1].y = orientation[1].y;
+            sixAxisState->orientation[1].z = orientation[1].z;
+            sixAxisState->orientation[2].x = orientation[2].x;
+            sixAxisState->orientation[2].y = orientation[2].y;
+            sixAxisState->orientation[2].z = orientation[2].z;
+
+            sixAxisState->deltaTimestamp = value->deltaTimestamp;
+            sixAxisState->attribute.isConnected = true;
         });
-        motionSensor->UpdateRotation(value->deltaTimestamp / 1000);
-        motionSensor->UpdateOrientation(value->deltaTimestamp / 1000);
-
-        const auto gyroscope = motionSensor->GetGyroscope();
-        const auto accelerometer = motionSensor->GetAcceleration();
-        const auto rotation = motionSensor->GetRotations();
-        const auto orientation = motionSensor->GetOrientation();
-
-        sixAxisState->accelerometer.x = accelerometer.x;
-        sixAxisState->accelerometer.y = accelerometer.y;
-        sixAxisState->accelerometer.z = accelerometer.z;
-
-        sixAxisState->gyroscope.x = gyroscope.x;
-        sixAxisState->gyroscope.y = gyroscope.y;
-        sixAxisState->gyroscope.z = gyroscope.z;
-
-        sixAxisState->rotation.x = rotation.x;
-        sixAxisState->rotation.y = rotation.y;
-        sixAxisState->rotation.z = rotation.z;
-
-        sixAxisState->orientation[0].x = orientation[0].x;
-        sixAxisState->orientation[0].y = orientation[0].y;
-        sixAxisState->orientation[0].z = orientation[0].z;
-        sixAxisState->orientation[1].x = orientation[1].x;
-        sixAxisState->orientation[1].y = orientation[1].y;
-        sixAxisState->orientation[1].z = orientation[1].z;
-        sixAxisState->orientation[2].x = orientation[2].x;
-        sixAxisState->orientation[2].y = orientation[2].y;
-        sixAxisState->orientation[2].z = orientation[2].z;
-
-        sixAxisState->deltaTimestamp = value->deltaTimestamp;
-        sixAxisState->attribute.isConnected = true;
     }
 
     constexpr jlong MsInSecond{1000}; //!< The amount of milliseconds in a single second of time
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <common/seqlock.h>
 #include <kernel/types/KEvent.h>
 #include "shared_mem.h"
 #include "motion_input.h"
@@ -172,9 +173,19 @@ namespace skyline::input {
         NpadSixAxisInfo *sixAxisInfoLeft{}; //!< The NpadSixAxisInfo for the main or left side of this controller's type
         NpadSixAxisInfo *sixAxisInfoRight{}; //!< The NpadSixAxisInfo for the right side of this controller's type
         u64 globalTimestamp{}; //!< An incrementing timestamp that's common across all sections
-        NpadControllerState controllerState{}, defaultState{}; //!< The current state of the controller (normal and default)
-        NpadSixAxisState sixAxisStateLeft{}, sixAxisStateRight{}; //!< The current state of the sixaxis (left and right)
-        MotionInput motionLeft{},motionRight{};
+
+        /**
+         * @brief The state of the controller as set by the host, this is staged until it's published to HID shared memory by the input update thread
+         */
+        struct StagedState {
+            NpadControllerState controllerState; //!< The current state of the controller
+            NpadControllerState defaultState; //!< The current state of the controller as seen by the default controller section
+            NpadSixAxisState sixAxisStateLeft;
+            NpadSixAxisState sixAxisStateRight;
+        };
+
+        SeqLock<StagedState> stagedState; //!< Host input threads write to this without blocking on the update thread which reads consistent snapshots of it
+        MotionInput motionLeft{}, motionRight{}; //!< Motion sensor fusion state, this is only accessed while writing to the staged state
 
         /**
          * @brief Updates the headers and writes a new entry in HID Shared Memory
@@ -17,9 +17,14 @@ namespace skyline::input {
     }
 
     void TouchManager::SetState(span<TouchScreenPoint> touchPoints) {
-        std::scoped_lock lock{mutex};
+        stagedState.Write([&](StagedState &staged) {
+            staged.pointCount = std::min(touchPoints.size(), staged.points.size());
+            std::copy_n(touchPoints.begin(), staged.pointCount, staged.points.begin());
+        });
+    }
 
-        touchPoints = touchPoints.first(std::min(touchPoints.size(), screenState.data.size()));
+    void TouchManager::ApplyStagedState(const StagedState &staged) {
+        auto touchPoints{span(staged.points).first(std::min(staged.pointCount, screenState.data.size()))};
         screenState.touchCount = touchPoints.size();
 
         for (size_t i{}; i < touchPoints.size(); i++) {
@@ -48,6 +53,10 @@ namespace skyline::input {
     void TouchManager::UpdateSharedMemory() {
         std::scoped_lock lock{mutex};
 
+        // Touch points are only applied when the host has supplied new ones, ended points must otherwise persist until they time out
+        if (stagedState.GetSequence() != appliedSequence)
+            ApplyStagedState(stagedState.Read(appliedSequence));
+
         for (size_t i{}; i < screenState.data.size(); i++) {
             // Remove any touch points which have ended after they are timed out
             if (screenState.data[i].attribute.end) {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <jni.h>
+#include <common/seqlock.h>
 #include "shared_mem.h"
 
 namespace skyline::input {
@@ -31,10 +32,26 @@ namespace skyline::input {
         bool activated{};
         TouchScreenSection &section;
 
+        /**
+         * @brief The touch points supplied by the host, these are staged until they're applied by the input update thread
+         */
+        struct StagedState {
+            std::array<TouchScreenPoint, 16> points;
+            size_t pointCount;
+        };
+
+        SeqLock<StagedState> stagedState; //!< Host input threads write to this without blocking on the update thread
+        u32 appliedSequence{}; //!< The sequence of the staged state that was last applied to the screen state
+
         std::recursive_mutex mutex;
-        TouchScreenState screenState{}; //!< The current state of the touch screen
+        TouchScreenState screenState{}; //!< The current state of the touch screen, this is only modified by the update thread
         std::array<uint8_t, 16> pointTimeout; //!< A frame timeout counter for each point which has ended (according to it's attribute), when it reaches 0 the point is removed from the screen
 
+        /**
+         * @brief Applies the staged touch points to the screen state
+         */
+        void ApplyStagedState(const StagedState &staged);
+
       public:
         /**
          * @param hid A pointer to HID Shared Memory on the host
@@ -43,6 +60,10 @@ namespace skyline::input {
 
         void Activate();
 
+        /**
+         * @brief Stages the supplied touch points, they'll be reflected in HID shared memory on the next update
+         * @note This doesn't block on the update thread and is safe to call from any thread
+         */
         void SetState(span<TouchScreenPoint> touchPoints);
 
         /**
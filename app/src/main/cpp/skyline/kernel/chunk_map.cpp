@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "memory.h"
+
+namespace skyline::kernel {
+    void ChunkMap::Split(u8 *address) {
+        auto next{chunks.upper_bound(address)};
+        if (next == chunks.begin())
+            return;
+
+        auto &chunk{std::prev(next)->second};
+        if (chunk.ptr == address || chunk.ptr + chunk.size <= address)
+            return;
+
+        ChunkDescriptor upper{chunk};
+        upper.ptr = address;
+        upper.size = static_cast<size_t>((chunk.ptr + chunk.size) - address);
+        chunk.size = static_cast<size_t>(address - chunk.ptr);
+        chunks.emplace_hint(next, address, upper);
+    }
+
+    void ChunkMap::Reset(std::initializer_list<ChunkDescriptor> initialChunks) {
+        chunks.clear();
+        for (const auto &chunk : initialChunks)
+            chunks.emplace(chunk.ptr, chunk);
+    }
+
+    void ChunkMap::Insert(const ChunkDescriptor &chunk) {
+        if (chunks.empty() || chunk.ptr < chunks.begin()->first)
+            throw exception("InsertChunk: Chunk inserted outside address space: 0x{:X} - 0x{:X}", chunk.ptr, chunk.ptr + chunk.size);
+
+        // Any chunks partially overlapping the edges of the new chunk are split so that the chunks it covers can be replaced wholesale
+        Split(chunk.ptr);
+        Split(chunk.ptr + chunk.size);
+
+        auto it{chunks.erase(chunks.lower_bound(chunk.ptr), chunks.lower_bound(chunk.ptr + chunk.size))};
+        it = chunks.emplace_hint(it, chunk.ptr, chunk);
+
+        // Compatible neighbours are merged with the new chunk, chunks are contiguous so this keeps the amount of chunks minimal
+        if (auto next{std::next(it)}; next != chunks.end() && chunk.IsCompatible(next->second)) {
+            it->second.size += next->second.size;
+            chunks.erase(next);
+        }
+
+        if (it != chunks.begin()) {
+            if (auto previous{std::prev(it)}; chunk.IsCompatible(previous->second)) {
+                previous->second.size += it->second.size;
+                chunks.erase(it);
+            }
+        }
+    }
+
+    std::optional<ChunkDescriptor> ChunkMap::Get(void *ptr) const {
+        auto chunk{chunks.upper_bound(reinterpret_cast<u8 *>(ptr))};
+        if (chunk-- != chunks.begin())
+            if ((chunk->second.ptr + chunk->second.size) > ptr)
+                return std::make_optional(chunk->second);
+
+        return std::nullopt;
+    }
+}
@@ -28,6 +28,7 @@ namespace skyline::kernel::ipc {
 
         for (u8 index{}; header->xNo > index; index++) {
             auto bufX{reinterpret_cast<BufferDescriptorX *>(pointer)};
+            this->bufX.emplace_back(bufX->Pointer() ? span<u8>{bufX->Pointer(), static_cast<u16>(bufX->size)} : span<u8>{});
             if (bufX->Pointer()) {
                 inputBuf.emplace_back(bufX->Pointer(), static_cast<u16>(bufX->size));
                 Logger::Verbose("Buf X #{}: 0x{:X}, 0x{:X}, #{}", index, bufX->Pointer(), static_cast<u16>(bufX->size), static_cast<u16>(bufX->Counter()));
@@ -37,6 +38,7 @@ namespace skyline::kernel::ipc {
 
         for (u8 index{}; header->aNo > index; index++) {
             auto bufA{reinterpret_cast<BufferDescriptorABW *>(pointer)};
+            this->bufA.emplace_back(bufA->Pointer() ? span<u8>{bufA->Pointer(), bufA->Size()} : span<u8>{});
             if (bufA->Pointer()) {
                 inputBuf.emplace_back(bufA->Pointer(), bufA->Size());
                 Logger::Verbose("Buf A #{}: 0x{:X}, 0x{:X}", index, bufA->Pointer(), static_cast<u64>(bufA->Size()));
@@ -46,6 +48,7 @@ namespace skyline::kernel::ipc {
 
         for (u8 index{}; header->bNo > index; index++) {
             auto bufB{reinterpret_cast<BufferDescriptorABW *>(pointer)};
+            this->bufB.emplace_back(bufB->Pointer() ? span<u8>{bufB->Pointer(), bufB->Size()} : span<u8>{});
             if (bufB->Pointer()) {
                 outputBuf.emplace_back(bufB->Pointer(), bufB->Size());
                 Logger::Verbose("Buf B #{}: 0x{:X}, 0x{:X}", index, bufB->Pointer(), static_cast<u64>(bufB->Size()));
@@ -104,6 +107,7 @@ namespace skyline::kernel::ipc {
 
         if (header->cFlag == BufferCFlag::SingleDescriptor) {
             auto bufC{reinterpret_cast<BufferDescriptorC *>(bufCPointer)};
+            this->bufC.emplace_back(bufC->address ? span<u8>{bufC->Pointer(), static_cast<u16>(bufC->size)} : span<u8>{});
             if (bufC->address) {
                 outputBuf.emplace_back(bufC->Pointer(), static_cast<u16>(bufC->size));
                 Logger::Verbose("Buf C: 0x{:X}, 0x{:X}", bufC->Pointer(), static_cast<u16>(bufC->size));
@@ -111,6 +115,7 @@ namespace skyline::kernel::ipc {
         } else if (header->cFlag > BufferCFlag::SingleDescriptor) {
             for (u8 index{}; (static_cast<u8>(header->cFlag) - 2) > index; index++) { // (cFlag - 2) C descriptors are present
                 auto bufC{reinterpret_cast<BufferDescriptorC *>(bufCPointer)};
+                this->bufC.emplace_back(bufC->address ? span<u8>{bufC->Pointer(), static_cast<u16>(bufC->size)} : span<u8>{});
                 if (bufC->address) {
                     outputBuf.emplace_back(bufC->Pointer(), static_cast<u16>(bufC->size));
                     Logger::Verbose("Buf C #{}: 0x{:X}, 0x{:X}", index, bufC->Pointer(), static_cast<u16>(bufC->size));
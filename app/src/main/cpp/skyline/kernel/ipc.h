@@ -207,9 +207,33 @@ namespace skyline {
             boost::container::small_vector<KHandle, 2> domainObjects;
             boost::container::small_vector<span<u8>, 3> inputBuf;
             boost::container::small_vector<span<u8>, 3> outputBuf;
+            boost::container::small_vector<span<u8>, 3> bufX; //!< All X buffers in the order of their descriptors, unlike inputBuf null descriptors are retained as empty spans
+            boost::container::small_vector<span<u8>, 3> bufA; //!< All A buffers in the order of their descriptors, null descriptors are retained as empty spans
+            boost::container::small_vector<span<u8>, 3> bufB; //!< All B buffers in the order of their descriptors, null descriptors are retained as empty spans
+            boost::container::small_vector<span<u8>, 3> bufC; //!< All C buffers in the order of their descriptors, null descriptors are retained as empty spans
 
             IpcRequest(bool isDomain, const DeviceState &state);
 
+            /**
+             * @return The input buffer at the specified position of an auto-select (HipcAutoSelect) buffer list, these are passed as both an X and an A descriptor of which only one is non-null
+             * @note An empty span is returned if the guest passed a null buffer at this position
+             */
+            span<u8> GetAutoSelectInputBuffer(size_t index) {
+                if (index < bufX.size() && !bufX[index].empty())
+                    return bufX[index];
+                return index < bufA.size() ? bufA[index] : span<u8>{};
+            }
+
+            /**
+             * @return The output buffer at the specified position of an auto-select (HipcAutoSelect) buffer list, these are passed as both a B and a C descriptor of which only one is non-null
+             * @note An empty span is returned if the guest passed a null buffer at this position
+             */
+            span<u8> GetAutoSelectOutputBuffer(size_t index) {
+                if (index < bufB.size() && !bufB[index].empty())
+                    return bufB[index];
+                return index < bufC.size() ? bufC[index] : span<u8>{};
+            }
+
             /**
              * @brief Returns a reference to an item from the top of the payload
              */
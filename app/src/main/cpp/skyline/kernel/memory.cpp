@@ -3,9 +3,15 @@
 
 #include <asm-generic/unistd.h>
 #include <fcntl.h>
+#include <common/trace.h>
+#include <common/settings.h>
 #include "memory.h"
 #include "types/KProcess.h"
 
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23 // Introduced in Linux 5.14, the NDK headers may not define it
+#endif
+
 namespace skyline::kernel {
     MemoryManager::MemoryManager(const DeviceState &state) : state(state) {}
 
@@ -15,6 +21,7 @@ namespace skyline::kernel {
     }
 
     constexpr size_t RegionAlignment{1ULL << 21}; //!< The minimum alignment of a HOS memory region
+    constexpr size_t HugePageSize{1ULL << 21}; //!< The size of a PMD-level transparent huge page on the host
     constexpr size_t CodeRegionSize{4ULL * 1024 * 1024 * 1024}; //!< The assumed maximum size of the code region (4GiB)
 
     static span<u8> AllocateMappedRange(size_t minSize, size_t align, size_t minAddress, size_t maxAddress, bool findLargest) {
@@ -83,7 +90,7 @@ namespace skyline::kernel {
         if (type != memory::AddressSpaceType::AddressSpace36Bit) {
             base = AllocateMappedRange(baseSize, RegionAlignment, KgslReservedRegionSize, addressSpace.size(), false);
 
-            chunks = {
+            chunks.Reset({
                 ChunkDescriptor{
                     .ptr = addressSpace.data(),
                     .size = static_cast<size_t>(base.data() - addressSpace.data()),
@@ -98,7 +105,7 @@ namespace skyline::kernel {
                     .ptr = base.end().base(),
                     .size = addressSpace.size() - reinterpret_cast<u64>(base.end().base()),
                     .state = memory::states::Reserved,
-                }};
+                }});
 
             code = base;
 
@@ -106,7 +113,7 @@ namespace skyline::kernel {
             base = AllocateMappedRange(baseSize, 1ULL << 36, KgslReservedRegionSize, addressSpace.size(), false);
             codeBase36Bit = AllocateMappedRange(0x32000000, RegionAlignment, 0xC000000, 0x78000000ULL + reinterpret_cast<size_t>(addressSpace.data()), true);
 
-            chunks = {
+            chunks.Reset({
                 ChunkDescriptor{
                     .ptr = addressSpace.data(),
                     .size = static_cast<size_t>(codeBase36Bit.data() - addressSpace.data()),
@@ -131,7 +138,7 @@ namespace skyline::kernel {
                     .ptr = base.end().base(),
                     .size = addressSpace.size() - reinterpret_cast<u64>(base.end().base()),
                     .state = memory::states::Reserved,
-                }};
+                }});
             code = codeBase36Bit;
         }
     }
@@ -235,74 +242,45 @@ namespace skyline::kernel {
                 throw exception("Failed to free memory: {}", strerror(errno))   ;
     }
 
-    void MemoryManager::InsertChunk(const ChunkDescriptor &chunk) {
-        std::unique_lock lock(mutex);
+    void MemoryManager::AdviseHugePages(span<u8> memory) {
+        if (!*state.settings->enableHugePages)
+            return;
 
-        auto upper{std::upper_bound(chunks.begin(), chunks.end(), chunk.ptr, [](const u8 *ptr, const ChunkDescriptor &chunk) -> bool { return ptr < chunk.ptr; })};
-        if (upper == chunks.begin())
-            throw exception("InsertChunk: Chunk inserted outside address space: 0x{:X} - 0x{:X} and 0x{:X} - 0x{:X}", upper->ptr, upper->ptr + upper->size, chunk.ptr, chunk.ptr + chunk.size);
+        u8 *alignedStart{util::AlignUp(memory.data(), HugePageSize)};
+        u8 *alignedEnd{util::AlignDown(memory.end().base(), HugePageSize)};
 
-        upper = chunks.erase(upper, std::upper_bound(upper, chunks.end(), chunk.ptr + chunk.size, [](const u8 *ptr, const ChunkDescriptor &chunk) -> bool { return ptr < chunk.ptr + chunk.size; }));
-        if (upper != chunks.end() && upper->ptr < chunk.ptr + chunk.size) {
-            auto end{upper->ptr + upper->size};
-            upper->ptr = chunk.ptr + chunk.size;
-            upper->size = static_cast<size_t>(end - upper->ptr);
-        }
+        // The guest address space is shmem-backed so this depends on /sys/kernel/mm/transparent_hugepage/shmem_enabled being set to "advise" or higher, EINVAL is returned on kernels without THP
+        if (alignedStart < alignedEnd)
+            if (madvise(alignedStart, static_cast<size_t>(alignedEnd - alignedStart), MADV_HUGEPAGE) == -1 && errno != EINVAL)
+                Logger::Warn("Failed to advise huge pages for 0x{:X} - 0x{:X}: {}", alignedStart, alignedEnd, strerror(errno));
+    }
 
-        auto lower{std::prev(upper)};
-        if (lower->ptr == chunk.ptr && lower->size == chunk.size) {
-            lower->state = chunk.state;
-            lower->permission = chunk.permission;
-            lower->attributes = chunk.attributes;
-            lower->memory = chunk.memory;
-        } else if (lower->ptr + lower->size > chunk.ptr + chunk.size) {
-            auto lowerExtension{*lower};
-            lowerExtension.ptr = chunk.ptr + chunk.size;
-            lowerExtension.size = static_cast<size_t>((lower->ptr + lower->size) - lowerExtension.ptr);
-
-            lower->size = static_cast<size_t>(chunk.ptr - lower->ptr);
-            if (lower->size) {
-                upper = chunks.insert(upper, lowerExtension);
-                chunks.insert(upper, chunk);
-            } else {
-                auto lower2{std::prev(lower)};
-                if (chunk.IsCompatible(*lower2) && lower2->ptr + lower2->size >= chunk.ptr) {
-                    lower2->size = static_cast<size_t>(chunk.ptr + chunk.size - lower2->ptr);
-                    upper = chunks.erase(lower);
-                } else {
-                    *lower = chunk;
-                }
-                upper = chunks.insert(upper, lowerExtension);
-            }
-        } else if (chunk.IsCompatible(*lower) && lower->ptr + lower->size >= chunk.ptr) {
-            lower->size = static_cast<size_t>(chunk.ptr + chunk.size - lower->ptr);
-        } else {
-            if (lower->ptr + lower->size > chunk.ptr)
-                lower->size = static_cast<size_t>(chunk.ptr - lower->ptr);
-            if (upper != chunks.end() && chunk.IsCompatible(*upper) && chunk.ptr + chunk.size >= upper->ptr) {
-                upper->ptr = chunk.ptr;
-                upper->size = chunk.size + upper->size;
-            } else {
-                chunks.insert(upper, chunk);
-            }
-        }
+    void MemoryManager::PrefaultMemory(span<u8> memory) {
+        if (!*state.settings->prefaultGuestMemory)
+            return;
+
+        u8 *alignedStart{util::AlignDown(memory.data(), constant::PageSize)};
+        u8 *alignedEnd{util::AlignUp(memory.end().base(), constant::PageSize)};
+
+        TRACE_EVENT("host", "MemoryManager::PrefaultMemory", "size", alignedEnd - alignedStart);
+        if (madvise(alignedStart, static_cast<size_t>(alignedEnd - alignedStart), MADV_POPULATE_WRITE) == -1 && errno != EINVAL)
+            Logger::Warn("Failed to prefault 0x{:X} - 0x{:X}: {}", alignedStart, alignedEnd, strerror(errno));
+    }
+
+    void MemoryManager::InsertChunk(const ChunkDescriptor &chunk) {
+        std::unique_lock lock(mutex);
+        chunks.Insert(chunk);
     }
 
     std::optional<ChunkDescriptor> MemoryManager::Get(void *ptr) {
         std::shared_lock lock(mutex);
-
-        auto chunk{std::upper_bound(chunks.begin(), chunks.end(), reinterpret_cast<u8 *>(ptr), [](const u8 *ptr, const ChunkDescriptor &chunk) -> bool { return ptr < chunk.ptr; })};
-        if (chunk-- != chunks.begin())
-            if ((chunk->ptr + chunk->size) > ptr)
-                return std::make_optional(*chunk);
-
-        return std::nullopt;
+        return chunks.Get(ptr);
     }
 
     size_t MemoryManager::GetUserMemoryUsage() {
         std::shared_lock lock(mutex);
         size_t size{};
-        for (const auto &chunk : chunks)
+        for (const auto &[ptr, chunk] : chunks)
             if (chunk.state == memory::states::Heap)
                 size += chunk.size;
         return size + code.size() + state.process->mainThreadStack->guest.size();
@@ -311,6 +289,6 @@ namespace skyline::kernel {
     size_t MemoryManager::GetSystemResourceUsage() {
         std::shared_lock lock(mutex);
         constexpr size_t KMemoryBlockSize{0x40};
-        return std::min(static_cast<size_t>(state.process->npdm.meta.systemResourceSize), util::AlignUp(chunks.size() * KMemoryBlockSize, constant::PageSize));
+        return std::min(static_cast<size_t>(state.process->npdm.meta.systemResourceSize), util::AlignUp(chunks.Size() * KMemoryBlockSize, constant::PageSize));
     }
 }
@@ -31,9 +31,9 @@ namespace skyline {
              */
             constexpr Permission(bool read, bool write, bool execute) : r(read), w(write), x(execute) {}
 
-            inline bool operator==(const Permission &rhs) const { return r == rhs.r && w == rhs.w && x == rhs.x; }
+            constexpr bool operator==(const Permission &rhs) const { return r == rhs.r && w == rhs.w && x == rhs.x; }
 
-            inline bool operator!=(const Permission &rhs) const { return !operator==(rhs); }
+            constexpr bool operator!=(const Permission &rhs) const { return !operator==(rhs); }
 
             /**
              * @return The value of the permission struct in Linux format
@@ -206,13 +206,55 @@ namespace skyline {
             }
         };
 
+        /**
+         * @brief A map from the base address of each chunk to its descriptor, all chunks are contiguous and together cover the entire address space
+         * @note This isn't synchronized, MemoryManager guards all accesses with its mutex
+         */
+        class ChunkMap {
+          private:
+            std::map<u8 *, ChunkDescriptor> chunks;
+
+            /**
+             * @brief Splits the chunk containing the supplied address into two chunks at it, this is a no-op if a chunk already starts at the address
+             */
+            void Split(u8 *address);
+
+          public:
+            /**
+             * @brief Replaces all chunks with the supplied chunks, they must be contiguous and cover the entire address space
+             */
+            void Reset(std::initializer_list<ChunkDescriptor> initialChunks);
+
+            /**
+             * @brief Replaces the range covered by the supplied chunk, it's merged with any compatible neighbours
+             */
+            void Insert(const ChunkDescriptor &chunk);
+
+            /**
+             * @return The chunk containing the supplied address or std::nullopt if it's outside the address space
+             */
+            std::optional<ChunkDescriptor> Get(void *ptr) const;
+
+            size_t Size() const {
+                return chunks.size();
+            }
+
+            auto begin() const {
+                return chunks.begin();
+            }
+
+            auto end() const {
+                return chunks.end();
+            }
+        };
+
         /**
          * @brief MemoryManager allocates and keeps track of guest virtual memory and its related attributes
          */
         class MemoryManager {
           private:
             const DeviceState &state;
-            std::vector<ChunkDescriptor> chunks;
+            ChunkMap chunks;
 
           public:
             memory::AddressSpaceType addressSpaceType{};
@@ -260,6 +302,18 @@ namespace skyline {
              */
             void FreeMemory(span<u8> memory);
 
+            /**
+             * @brief Requests that the host back all 2MiB-aligned blocks in the mapping with transparent huge pages
+             * @note This is a no-op if huge pages are disabled in the settings or unsupported for shared memory by the host kernel
+             */
+            void AdviseHugePages(span<u8> memory);
+
+            /**
+             * @brief Faults in all pages in the contained mapping as writable in a single pass, this avoids taking a fault on the first access to each page
+             * @note This is a no-op if prefaulting is disabled in the settings or unsupported by the host kernel (Linux 5.14+)
+             */
+            void PrefaultMemory(span<u8> memory);
+
             void InsertChunk(const ChunkDescriptor &chunk);
 
             std::optional<ChunkDescriptor> Get(void *ptr);
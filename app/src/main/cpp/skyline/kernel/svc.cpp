@@ -22,7 +22,10 @@ namespace skyline::kernel::svc {
         }
 
         auto &heap{state.process->heap};
+        size_t oldSize{heap->guest.size()};
         heap->Resize(size);
+        if (size > oldSize)
+            state.process->memory.AdviseHugePages(heap->guest.subspan(oldSize)); // Heap growth is always 2MiB-aligned so every newly mapped block is eligible for a huge page
 
         state.ctx->gpr.w0 = Result{};
         state.ctx->gpr.x1 = reinterpret_cast<u64>(heap->guest.data());
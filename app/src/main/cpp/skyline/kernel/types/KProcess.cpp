@@ -51,6 +51,7 @@ namespace skyline::kernel::type {
         constexpr size_t DefaultHeapSize{0x200000};
         heap = std::make_shared<KPrivateMemory>(state, 0, span<u8>{state.process->memory.heap.data(), DefaultHeapSize}, memory::Permission{true, true, false}, memory::states::Heap);
         InsertItem(heap); // Insert it into the handle table so GetMemoryObject will contain it
+        memory.AdviseHugePages(heap->guest);
         tlsExceptionContext = AllocateTlsSlot();
     }
 
@@ -106,6 +106,7 @@ namespace skyline::loader {
         Logger::Debug("Successfully mapped section .data + .bss @ 0x{:X}, Size = 0x{:X}", executableBase + executable.data.offset, dataSize);
 
         size_t size{patch.size + hookSize + textSize + roSize + dataSize};
+        process->memory.PrefaultMemory(span<u8>{base, size}); // All of the executable is written below aside from .bss, populating it in one pass is far cheaper than faulting on each page
         {
             // Note: We need to copy out the symbols here as it'll be overwritten by any hooks
             ExecutableSymbolicInfo symbolicInfo{
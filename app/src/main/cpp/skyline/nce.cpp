@@ -5,6 +5,7 @@
 #include <unistd.h>
 #include "common/signal.h"
 #include "common/trace.h"
+#include "common/perf_counters.h"
 #include "os.h"
 #include "jvm.h"
 #include "kernel/types/KProcess.h"
@@ -24,6 +25,7 @@ namespace skyline::nce {
         TRACE_EVENT_END("guest");
 
         const auto &state{*ctx->state};
+        perf::Add(perf::Counter::Svcs);
         auto svc{kernel::svc::SvcTable[svcId]};
         try {
             if (svc) [[likely]] {
@@ -153,7 +155,7 @@ namespace skyline::nce {
         }
     }
 
-    void NCE::SignalHandler(int signal, siginfo *info, ucontext *ctx, void **tls) {
+    void NCE::SignalHandler(int signal, siginfo_t *info, ucontext_t *ctx, void **tls) {
         if (*tls) { // If TLS was restored then this occurred in guest code
             auto &mctx{ctx->uc_mcontext};
             const auto &state{*reinterpret_cast<ThreadContext *>(*tls)->state};
@@ -196,7 +198,7 @@ namespace skyline::nce {
 
     static NCE *staticNce{nullptr}; //!< A static instance of NCE for use in the signal handler
 
-    void NCE::HostSignalHandler(int signal, siginfo *info, ucontext *ctx) {
+    void NCE::HostSignalHandler(int signal, siginfo_t *info, ucontext_t *ctx) {
         if (signal == SIGSEGV) {
             if (staticNce && staticNce->TrapHandler(reinterpret_cast<u8 *>(info->si_addr), true))
                 return;
@@ -247,9 +249,14 @@ namespace skyline::nce {
         return threadCtx;
     }
 
-    NCE::NCE(const DeviceState &state) : state(state) {
+    NCE::NCE(const DeviceState &state) : state(state), writeTracker{WriteTracker::Create()} {
         signal::SetTlsRestorer(&NceTlsRestorer);
         staticNce = this;
+
+        if (writeTracker)
+            Logger::Info("Tracking guest writes asynchronously with {}", writeTracker->GetBackend() == WriteTracker::Backend::UffdWriteProtect ? "userfaultfd write-protection" : "soft-dirty bits");
+        else
+            Logger::Info("Asynchronous write tracking is unsupported by the host kernel, falling back to traps");
     }
 
     NCE::~NCE() {
@@ -606,151 +613,387 @@ namespace skyline::nce {
         }
     }
 
-    NCE::CallbackEntry::CallbackEntry(TrapProtection protection, LockCallback lockCallback, TrapCallback readCallback, TrapCallback writeCallback) : protection{protection}, lockCallback{std::move(lockCallback)}, readCallback{std::move(readCallback)}, writeCallback{std::move(writeCallback)} {}
+    NCE::TrapGroup::TrapGroup(span<span<u8>> pRegions, LockCallback lockCallback, TrapCallback readCallback, TrapCallback writeCallback) : regions{pRegions.begin(), pRegions.end()}, shardMask{}, lockCallback{std::move(lockCallback)}, readCallback{std::move(readCallback)}, writeCallback{std::move(writeCallback)} {
+        for (auto region : regions)
+            shardMask |= GetTrapShardMask(region);
+    }
 
-    void NCE::ReprotectIntervals(const std::vector<TrapMap::Interval> &intervals, TrapProtection protection) {
-        TRACE_EVENT("host", "NCE::ReprotectIntervals");
+    NCE::TrapShardLock::TrapShardLock(NCE &nce, u64 shardMask) : nce{nce}, shardMask{shardMask} {
+        for (u64 mask{shardMask}; mask; mask &= mask - 1)
+            nce.trapShards[static_cast<size_t>(std::countr_zero(mask))].mutex.lock();
+    }
 
-        auto reprotectIntervalsWithFunction = [&intervals](auto getProtection) {
-            for (auto region : intervals) {
-                region = region.Align(constant::PageSize);
-                mprotect(region.start, region.Size(), getProtection(region));
-            }
-        };
-
-        // We need to determine the lowest protection possible for the given interval
-        if (protection == TrapProtection::None) {
-            reprotectIntervalsWithFunction([&](auto region) {
-                auto entries{trapMap.GetRange(region)};
-
-                TrapProtection lowestProtection{TrapProtection::None};
-                for (const auto &entry : entries) {
-                    auto entryProtection{entry.get().protection};
-                    if (entryProtection > lowestProtection) {
-                        lowestProtection = entryProtection;
-                        if (entryProtection == TrapProtection::ReadWrite)
-                            return PROT_NONE;
-                    }
+    NCE::TrapShardLock::~TrapShardLock() {
+        for (u64 mask{shardMask}; mask; mask &= mask - 1)
+            nce.trapShards[static_cast<size_t>(std::countr_zero(mask))].mutex.unlock();
+    }
+
+    NCE::TrapEpochGuard::TrapEpochGuard(NCE &nce) : nce{nce} {
+        // The epoch may advance between loading it and registering as a reader, in which case the reader could be missed by the reclaimer so we need to retry
+        while (true) {
+            epoch = nce.trapEpoch.load();
+            nce.trapEpochReaders[epoch & 1].fetch_add(1);
+            if (nce.trapEpoch.load() == epoch)
+                break;
+            nce.trapEpochReaders[epoch & 1].fetch_sub(1);
+        }
+    }
+
+    NCE::TrapEpochGuard::~TrapEpochGuard() {
+        nce.trapEpochReaders[epoch & 1].fetch_sub(1, std::memory_order_release);
+    }
+
+    void NCE::RetireTrapPage(TrapPage *page) {
+        std::scoped_lock lock{retiredTrapMutex};
+        retiredTraps[trapEpoch.load() & 1].pages.emplace_back(page);
+    }
+
+    void NCE::RetireTrapGroup(TrapGroup *group) {
+        std::scoped_lock lock{retiredTrapMutex};
+        retiredTraps[trapEpoch.load() & 1].groups.emplace_back(group);
+    }
+
+    void NCE::ReclaimRetiredTraps() {
+        std::scoped_lock lock{retiredTrapMutex};
+
+        // Readers that entered in the previous epoch may still reference state retired during it, readers from the current epoch entered after it was removed from the table
+        u32 epoch{trapEpoch.load()};
+        size_t previous{(epoch + 1) & 1};
+        if (trapEpochReaders[previous].load(std::memory_order_acquire) != 0)
+            return;
+
+        retiredTraps[previous].pages.clear();
+        retiredTraps[previous].groups.clear();
+        trapEpoch.store(epoch + 1);
+    }
+
+    u64 NCE::GetTrapShardMask(span<u8> region) {
+        if (region.empty())
+            return 0;
+
+        size_t first{reinterpret_cast<size_t>(region.data()) >> TrapShardBits}, last{(reinterpret_cast<size_t>(region.end().base()) - 1) >> TrapShardBits};
+        if (last - first >= TrapShardCount - 1)
+            return ~0ULL;
+
+        u64 mask{};
+        for (size_t shard{first}; shard <= last; shard++)
+            mask |= 1ULL << (shard % TrapShardCount);
+        return mask;
+    }
+
+    void NCE::UpdateTrapPages(TrapGroup &group, bool insert) {
+        TRACE_EVENT("host", "NCE::UpdateTrapPages");
+
+        // Pages with the same list before the update continue sharing a single list after it, this keeps the amount of distinct lists proportional to the amount of overlaps rather than pages
+        std::vector<std::pair<TrapPage *, TrapPage *>> replacements;
+        std::vector<TrapPage *> retiredPages; // Retired lists are only retired after the update to prevent them from being reclaimed and their addresses being reused while they're still in the replacement cache
+
+        auto getReplacement{[&](TrapPage *current) -> TrapPage * {
+            auto it{std::find_if(replacements.begin(), replacements.end(), [current](const auto &replacement) { return replacement.first == current; })};
+            if (it != replacements.end())
+                return it->second;
+
+            bool present{current && std::find(current->groups.begin(), current->groups.end(), &group) != current->groups.end()};
+            TrapPage *replacement{current};
+            if (insert != present) {
+                std::vector<TrapGroup *> groups{current ? current->groups : std::vector<TrapGroup *>{}};
+                if (insert)
+                    groups.push_back(&group);
+                else
+                    std::erase(groups, &group);
+
+                if (!groups.empty()) {
+                    replacement = new TrapPage{.groups = std::move(groups)};
+                    for (auto pageGroup : replacement->groups)
+                        replacement->shardMask |= pageGroup->shardMask;
+                } else {
+                    replacement = nullptr;
                 }
+            }
+
+            replacements.emplace_back(current, replacement);
+            return replacement;
+        }};
+
+        for (auto region : group.regions) {
+            u8 *start{util::AlignDown(region.data(), constant::PageSize)}, *end{util::AlignUp(region.end().base(), constant::PageSize)};
+            while (start < end) {
+                auto current{trapTable.Load(start)};
+                u8 *runEnd{start + constant::PageSize};
+                while (runEnd < end && trapTable.Load(runEnd) == current)
+                    runEnd += constant::PageSize;
 
-                switch (lowestProtection) {
-                    case TrapProtection::None:
-                        return PROT_READ | PROT_WRITE | PROT_EXEC;
-                    case TrapProtection::WriteOnly:
-                        return PROT_READ | PROT_EXEC;
-                    case TrapProtection::ReadWrite:
-                        return PROT_NONE;
+                auto replacement{getReplacement(current)};
+                if (replacement != current) {
+                    size_t pageCount{static_cast<size_t>(runEnd - start) / constant::PageSize};
+                    if (replacement)
+                        replacement->pageCount.fetch_add(pageCount);
+
+                    trapTable.Set(start, runEnd, replacement);
+
+                    if (current && current->pageCount.fetch_sub(pageCount) == pageCount)
+                        retiredPages.push_back(current);
                 }
-            });
-        } else if (protection == TrapProtection::WriteOnly) {
-            reprotectIntervalsWithFunction([&](auto region) {
-                auto entries{trapMap.GetRange(region)};
-                for (const auto &entry : entries)
-                    if (entry.get().protection == TrapProtection::ReadWrite)
-                        return PROT_NONE;
 
+                start = runEnd;
+            }
+        }
+
+        for (auto page : retiredPages)
+            RetireTrapPage(page);
+    }
+
+    int NCE::GetTrapPagePermission(const TrapPage *page) {
+        if (!page)
+            return PROT_READ | PROT_WRITE | PROT_EXEC;
+
+        TrapProtection lowestProtection{TrapProtection::None};
+        for (auto group : page->groups)
+            lowestProtection = std::max(lowestProtection, group->protection);
+
+        switch (lowestProtection) {
+            case TrapProtection::None:
+                return PROT_READ | PROT_WRITE | PROT_EXEC;
+            case TrapProtection::WriteOnly:
                 return PROT_READ | PROT_EXEC;
-            });
-        } else if (protection == TrapProtection::ReadWrite) {
-            reprotectIntervalsWithFunction([&](auto region) {
-                return PROT_NONE; // No checks are needed as this is already the highest level of protection
-            });
+            case TrapProtection::ReadWrite:
+                return PROT_NONE;
+        }
+    }
+
+    void NCE::ReprotectGroup(const TrapGroup &group) {
+        TRACE_EVENT("host", "NCE::ReprotectGroup");
+
+        // Pages at the edges of the regions may be shared with other groups, each run of pages with an identical list is protected to the lowest protection of all groups in the list
+        for (auto region : group.regions) {
+            u8 *start{util::AlignDown(region.data(), constant::PageSize)}, *end{util::AlignUp(region.end().base(), constant::PageSize)};
+            while (start < end) {
+                auto page{trapTable.Load(start)};
+                u8 *runEnd{start + constant::PageSize};
+                while (runEnd < end && trapTable.Load(runEnd) == page)
+                    runEnd += constant::PageSize;
+
+                mprotect(start, static_cast<size_t>(runEnd - start), GetTrapPagePermission(page));
+                start = runEnd;
+            }
         }
     }
 
     bool NCE::TrapHandler(u8 *address, bool write) {
         TRACE_EVENT("host", "NCE::TrapHandler");
+        perf::Add(perf::Counter::TrapFaults);
 
-        LockCallback lockCallback{};
+        TrapEpochGuard epochGuard{*this}; // The lookup is done without any locks, this prevents any state we observe from being reclaimed until we're done with it
+        TrapGroup *blockingGroup{};
         while (true) {
-            if (lockCallback) {
-                // We want to avoid a deadlock of holding trapMutex while locking the resource inside a callback while another thread holding the resource's mutex waits on trapMutex, we solve this by quitting the loop if a callback would be blocking and attempt to lock the resource externally
-                lockCallback();
-                lockCallback = {};
+            if (blockingGroup) {
+                // We want to avoid a deadlock of holding the shard locks while locking the resource inside a callback while another thread holding the resource's mutex waits on them, we solve this by quitting the loop if a callback would be blocking and attempt to lock the resource externally
+                blockingGroup->lockCallback();
+                blockingGroup = nullptr;
             }
 
-            std::scoped_lock lock(trapMutex);
-
             // Retrieve any callbacks for the page that was faulted
-            auto[entries, intervals]{trapMap.GetAlignedRecursiveRange<constant::PageSize>(address)};
-            if (entries.empty())
+            auto page{trapTable.Load(address)};
+            if (!page)
                 return false; // There's no callbacks associated with this page
 
-            // Do callbacks for every entry in the intervals
+            TrapShardLock lock{*this, page->shardMask};
+            if (trapTable.Load(address) != page)
+                continue; // The page was modified prior to us locking it, we need to retry with the latest list
+
+            // Do callbacks for every group on the page
             if (write) {
-                for (auto entryRef : entries) {
-                    auto &entry{entryRef.get()};
-                    if (entry.protection == TrapProtection::None)
-                        // We don't need to do the callback if the entry doesn't require any protection already
+                for (auto group : page->groups) {
+                    if (group->protection == TrapProtection::None)
+                        // We don't need to do the callback if the group doesn't require any protection already
                         continue;
 
-                    if (!entry.writeCallback()) {
-                        lockCallback = entry.lockCallback;
+                    if (!group->writeCallback()) {
+                        blockingGroup = group;
                         break;
                     }
-                    entry.protection = TrapProtection::None; // We don't need to protect this entry anymore
+                    group->protection = TrapProtection::None; // We don't need to protect this group anymore
                 }
-                if (lockCallback)
-                    continue; // We need to retry the loop because a callback was blocking
             } else {
-                bool allNone{true}; // If all entries require no protection, we can protect to allow all accesses
-                for (auto entryRef : entries) {
-                    auto &entry{entryRef.get()};
-                    if (entry.protection < TrapProtection::ReadWrite) {
-                        // We don't need to do the callback if the entry can already handle read accesses
-                        allNone = allNone && entry.protection == TrapProtection::None;
+                for (auto group : page->groups) {
+                    if (group->protection < TrapProtection::ReadWrite)
+                        // We don't need to do the callback if the group can already handle read accesses
                         continue;
-                    }
 
-                    if (!entry.readCallback()) {
-                        lockCallback = entry.lockCallback;
+                    if (!group->readCallback()) {
+                        blockingGroup = group;
                         break;
                     }
-                    entry.protection = TrapProtection::WriteOnly; // We only need to trap writes to this entry
+                    group->protection = TrapProtection::WriteOnly; // We only need to trap writes to this group
                 }
-                if (lockCallback)
-                    continue; // We need to retry the loop because a callback was blocking
-                write = allNone;
             }
 
-            int permission{PROT_READ | (write ? PROT_WRITE : 0) | PROT_EXEC};
-            for (const auto &interval : intervals)
-                // Reprotect the interval to the lowest protection level that the callbacks performed allow
-                mprotect(interval.start, interval.Size(), permission);
+            if (blockingGroup)
+                continue; // We need to retry the loop because a callback was blocking
+
+            // Reprotect the regions of all groups on the page to the lowest protection level that the callbacks performed allow, groups are assumed to be rarely accessed in a partial manner so this avoids faulting on the rest of their regions
+            for (auto group : page->groups)
+                ReprotectGroup(*group);
 
             return true;
         }
     }
 
-    constexpr NCE::TrapHandle::TrapHandle(const TrapMap::GroupHandle &handle) : TrapMap::GroupHandle(handle) {}
-
     NCE::TrapHandle NCE::CreateTrap(span<span<u8>> regions, const LockCallback &lockCallback, const TrapCallback &readCallback, const TrapCallback &writeCallback) {
         TRACE_EVENT("host", "NCE::CreateTrap");
-        std::scoped_lock lock{trapMutex};
-        TrapHandle handle{trapMap.Insert(regions, CallbackEntry{TrapProtection::None, lockCallback, readCallback, writeCallback})};
-        return handle;
+        auto group{new TrapGroup{regions, lockCallback, readCallback, writeCallback}};
+        {
+            TrapShardLock lock{*this, group->shardMask};
+            UpdateTrapPages(*group, true);
+        }
+        ReclaimRetiredTraps();
+        return TrapHandle{group};
+    }
+
+    void NCE::UntrackWrites(TrapGroup &group) {
+        if (!group.writeTracked)
+            return;
+
+        // The region is left write-protected by the write tracker, this is harmless as the kernel resolves any faults on it without our involvement
+        std::scoped_lock lock{writeTrackerMutex};
+        group.writeTracked = false;
+        group.pendingWrite = false;
+        std::erase(writeTrackedGroups, &group);
+    }
+
+    void NCE::ResetWriteTrackerIfRequired() {
+        if (!writeTracker->IsResetRequired())
+            return;
+
+        for (auto group : writeTrackedGroups) {
+            if (group->pendingWrite)
+                continue;
+
+            for (auto region : group->regions) {
+                u8 *start{util::AlignDown(region.data(), constant::PageSize)}, *end{util::AlignUp(region.end().base(), constant::PageSize)};
+                if (writeTracker->IsWritten(span<u8>{start, end})) {
+                    group->pendingWrite = true;
+                    break;
+                }
+            }
+        }
+
+        writeTracker->Reset();
+    }
+
+    bool NCE::TrackWrites(TrapHandle handle) {
+        TRACE_EVENT("host", "NCE::TrackWrites");
+        TrapShardLock lock{*this, handle->shardMask};
+        auto &group{*handle.group};
+
+        if (writeTracker) {
+            std::scoped_lock trackerLock{writeTrackerMutex}; // A reset must not occur between arming and clearing the pending write as it would discard any writes in-between
+
+            // Arming discards writes to entire pages, the pages at the edges of the regions may be shared with other write-tracked groups so any writes to them must be collected on their behalf beforehand
+            auto collectSharedPage{[&](u8 *page) {
+                bool written{}, checked{};
+                for (auto otherGroup : trapTable.Load(page)->groups) {
+                    if (otherGroup == &group || !otherGroup->writeTracked || otherGroup->pendingWrite)
+                        continue;
+
+                    if (!checked) {
+                        written = writeTracker->IsWritten(span<u8>{page, constant::PageSize});
+                        checked = true;
+                    }
+
+                    if (written)
+                        otherGroup->pendingWrite = true;
+                }
+            }};
+
+            for (auto region : group.regions) {
+                if (region.empty())
+                    continue;
+
+                collectSharedPage(util::AlignDown(region.data(), constant::PageSize));
+                collectSharedPage(util::AlignDown(region.end().base() - 1, constant::PageSize));
+            }
+
+            bool armed{true};
+            for (auto region : group.regions) {
+                u8 *start{util::AlignDown(region.data(), constant::PageSize)}, *end{util::AlignUp(region.end().base(), constant::PageSize)};
+                if (!writeTracker->Arm(span<u8>{start, end})) {
+                    armed = false;
+                    break;
+                }
+            }
+
+            if (armed) {
+                if (!group.writeTracked) {
+                    group.writeTracked = true;
+                    writeTrackedGroups.push_back(&group);
+                }
+                group.pendingWrite = false;
+
+                // Any trap must only be removed after arming so that writes in-between are not missed
+                if (group.protection != TrapProtection::None) {
+                    group.protection = TrapProtection::None;
+                    ReprotectGroup(group);
+                }
+                return true;
+            }
+        }
+
+        UntrackWrites(group);
+        group.protection = TrapProtection::WriteOnly;
+        ReprotectGroup(group);
+        return false;
+    }
+
+    bool NCE::CollectWrites(TrapHandle handle) {
+        TRACE_EVENT("host", "NCE::CollectWrites");
+        TrapShardLock lock{*this, handle->shardMask};
+        auto &group{*handle.group};
+        if (!group.writeTracked)
+            return false;
+
+        {
+            std::scoped_lock trackerLock{writeTrackerMutex};
+            ResetWriteTrackerIfRequired();
+        }
+
+        if (group.pendingWrite)
+            return true;
+
+        for (auto region : group.regions) {
+            u8 *start{util::AlignDown(region.data(), constant::PageSize)}, *end{util::AlignUp(region.end().base(), constant::PageSize)};
+            if (writeTracker->IsWritten(span<u8>{start, end}))
+                return true;
+        }
+        return false;
     }
 
     void NCE::TrapRegions(TrapHandle handle, bool writeOnly) {
         TRACE_EVENT("host", "NCE::TrapRegions");
-        std::scoped_lock lock{trapMutex};
-        auto protection{writeOnly ? TrapProtection::WriteOnly : TrapProtection::ReadWrite};
-        handle->value.protection = protection;
-        ReprotectIntervals(handle->intervals, protection);
+        TrapShardLock lock{*this, handle->shardMask};
+        UntrackWrites(*handle.group);
+        handle->protection = writeOnly ? TrapProtection::WriteOnly : TrapProtection::ReadWrite;
+        ReprotectGroup(*handle.group);
     }
 
     void NCE::RemoveTrap(TrapHandle handle) {
         TRACE_EVENT("host", "NCE::RemoveTrap");
-        std::scoped_lock lock{trapMutex};
-        handle->value.protection = TrapProtection::None;
-        ReprotectIntervals(handle->intervals, TrapProtection::None);
+        TrapShardLock lock{*this, handle->shardMask};
+        UntrackWrites(*handle.group);
+        handle->protection = TrapProtection::None;
+        ReprotectGroup(*handle.group);
     }
 
     void NCE::DeleteTrap(TrapHandle handle) {
         TRACE_EVENT("host", "NCE::DeleteTrap");
-        std::scoped_lock lock{trapMutex};
-        handle->value.protection = TrapProtection::None;
-        ReprotectIntervals(handle->intervals, TrapProtection::None);
-        trapMap.Remove(handle);
+        {
+            TrapShardLock lock{*this, handle->shardMask};
+            UntrackWrites(*handle.group);
+            handle->protection = TrapProtection::None;
+            UpdateTrapPages(*handle.group, false);
+            ReprotectGroup(*handle.group);
+        }
+        RetireTrapGroup(handle.group);
+        ReclaimRetiredTraps();
     }
 }
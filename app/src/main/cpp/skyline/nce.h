@@ -7,7 +7,8 @@
 #include <linux/elf.h>
 #include "common.h"
 #include "hle/symbol_hooks.h"
-#include "common/interval_map.h"
+#include "common/segment_table.h"
+#include "nce/write_tracker.h"
 
 namespace skyline::nce {
     /**
@@ -31,22 +32,139 @@ namespace skyline::nce {
         using TrapCallback = std::function<bool()>;
         using LockCallback = std::function<void()>;
 
-        struct CallbackEntry {
-            TrapProtection protection; //!< The least restrictive protection that this callback needs to have
+        /**
+         * @brief A group of regions that are trapped together with a single set of callbacks
+         * @note All mutable state of a group is protected by the trap shards covering its regions, this ensures that any reader holding the shard of a page can access all groups on it
+         */
+        struct TrapGroup {
+            std::vector<span<u8>> regions;
+            u64 shardMask; //!< A mask of all trap shards that the regions overlap
+            TrapProtection protection{TrapProtection::None}; //!< The least restrictive protection that this callback needs to have
             LockCallback lockCallback;
             TrapCallback readCallback, writeCallback;
+            bool writeTracked{}; //!< If writes to this group are tracked asynchronously by the write tracker rather than being trapped, the write callback isn't called for these
+            std::atomic<bool> pendingWrite{}; //!< If a write was collected on behalf of this group prior to a page it shares being rearmed or the write tracker being reset
+
+            TrapGroup(span<span<u8>> regions, LockCallback lockCallback, TrapCallback readCallback, TrapCallback writeCallback);
+        };
+
+        /**
+         * @brief An immutable list of all trap groups overlapping a page, all pages with identical lists share a single instance
+         * @note Lists are replaced rather than modified so that they can be read by the fault handler without holding any locks
+         */
+        struct TrapPage {
+            std::atomic<size_t> pageCount{}; //!< The amount of pages in the trap table referencing this list, it is retired when this reaches zero
+            u64 shardMask{}; //!< The union of the shard masks of all groups in the list, these must be locked to access the groups
+            std::vector<TrapGroup *> groups;
+        };
 
-            CallbackEntry(TrapProtection protection, LockCallback lockCallback, TrapCallback readCallback, TrapCallback writeCallback);
+        static constexpr size_t TrapShardBits{21}; //!< The size of the address range protected by a single shard as a power of 2, this is also the L2 granularity of the trap table so concurrent writers in different shards never touch the same table entries
+        static constexpr size_t TrapShardCount{64}; //!< The amount of shards, this must match the width of a shard mask
+
+        /**
+         * @brief A mutex protecting the trap state for all pages in address ranges that hash to it, padded to avoid false sharing between shards
+         */
+        struct alignas(64) TrapShard {
+            std::mutex mutex;
         };
+        std::array<TrapShard, TrapShardCount> trapShards;
+
+        /**
+         * @brief An RAII lock over a set of trap shards, they are always locked in ascending order to avoid deadlocks
+         */
+        class TrapShardLock {
+          private:
+            NCE &nce;
+            u64 shardMask;
 
-        std::mutex trapMutex; //!< Synchronizes the accesses to the trap map
-        using TrapMap = IntervalMap<u8*, CallbackEntry>;
-        TrapMap trapMap; //!< A map of all intervals and corresponding callbacks that have been registered
+          public:
+            TrapShardLock(NCE &nce, u64 shardMask);
+
+            ~TrapShardLock();
+        };
+
+        SegmentTable<TrapPage *, constant::AddressSpaceSize, constant::PageSizeBits, TrapShardBits> trapTable; //!< A page table of the trap lists for all pages, this is read without any locks by the fault handler
+
+        /**
+         * @brief Trap state that has been removed from the trap table but may still be referenced by a concurrent fault handler
+         */
+        struct RetiredTraps {
+            std::vector<std::unique_ptr<TrapPage>> pages;
+            std::vector<std::unique_ptr<TrapGroup>> groups;
+        };
+
+        std::atomic<u32> trapEpoch{}; //!< The current reclamation epoch, state retired in an epoch is reclaimed once no readers from it remain
+        std::array<std::atomic<u32>, 2> trapEpochReaders{}; //!< The amount of readers that entered in an epoch of either parity
+        std::mutex retiredTrapMutex; //!< Synchronizes retiring state and advancing the epoch
+        std::array<RetiredTraps, 2> retiredTraps; //!< State retired in an epoch of either parity
+
+        /**
+         * @brief An RAII guard over a read-side critical section of the trap table, any trap state looked up inside it will not be reclaimed until it's destroyed
+         * @note This doesn't allocate or block so it's safe to use inside the signal handler
+         */
+        class TrapEpochGuard {
+          private:
+            NCE &nce;
+            u32 epoch;
+
+          public:
+            TrapEpochGuard(NCE &nce);
+
+            ~TrapEpochGuard();
+        };
+
+        /**
+         * @brief Retires a list that is no longer referenced by the trap table
+         */
+        void RetireTrapPage(TrapPage *page);
 
         /**
-         * @brief Reprotects the intervals to the least restrictive protection given the supplied protection
+         * @brief Retires a group that has been removed from the trap table
          */
-        void ReprotectIntervals(const std::vector<TrapMap::Interval>& intervals, TrapProtection protection);
+        void RetireTrapGroup(TrapGroup *group);
+
+        /**
+         * @brief Reclaims any state retired in the previous epoch and advances the epoch if no readers from it remain
+         */
+        void ReclaimRetiredTraps();
+
+        /**
+         * @return A mask of all trap shards that a region overlaps
+         */
+        static u64 GetTrapShardMask(span<u8> region);
+
+        /**
+         * @brief Inserts or removes a group from the lists of all pages it overlaps
+         * @note The shards of the group **must** be locked prior to calling this
+         */
+        void UpdateTrapPages(TrapGroup &group, bool insert);
+
+        /**
+         * @return The memory protection of a page with the supplied trap list, this is the least restrictive protection that all groups in it allow
+         * @note The shards of the list **must** be locked prior to calling this
+         */
+        static int GetTrapPagePermission(const TrapPage *page);
+
+        /**
+         * @brief Reprotects the regions of a group to the least restrictive protection that all groups on each page allow
+         * @note The shards of the group **must** be locked prior to calling this
+         */
+        void ReprotectGroup(const TrapGroup &group);
+
+        std::unique_ptr<WriteTracker> writeTracker; //!< The write tracker used for TrackWrites, this is null if the host kernel doesn't support any form of asynchronous write tracking
+        std::mutex writeTrackerMutex; //!< Synchronizes arming the write tracker and the set of write-tracked groups with the write tracker being reset
+        std::vector<TrapGroup *> writeTrackedGroups; //!< All groups with writes that are currently tracked asynchronously, these must be harvested prior to the write tracker being reset
+
+        /**
+         * @brief Stops tracking writes to the supplied group asynchronously, any collected writes are discarded
+         */
+        void UntrackWrites(TrapGroup &group);
+
+        /**
+         * @brief Harvests the state of all write-tracked groups into their pending writes and resets the write tracker if it requires it
+         * @note The write tracker mutex **must** be locked prior to calling this
+         */
+        void ResetWriteTrackerIfRequired();
 
         bool TrapHandler(u8* address, bool write);
 
@@ -85,13 +203,13 @@ namespace skyline::nce {
         /**
          * @brief Handles any signals in the NCE threads
          */
-        static void SignalHandler(int signal, siginfo *info, ucontext *ctx, void **tls);
+        static void SignalHandler(int signal, siginfo_t *info, ucontext_t *ctx, void **tls);
 
         /**
          * @brief Handles signals for any host threads which may access NCE trapped memory
          * @note Any untrapped SIGSEGVs will emit SIGTRAP when a debugger is attached rather than throwing an exception
          */
-        static void HostSignalHandler(int signal, siginfo *info, ucontext *ctx);
+        static void HostSignalHandler(int signal, siginfo_t *info, ucontext_t *ctx);
 
         /**
          * @note There should only be one instance of NCE concurrently
@@ -127,8 +245,15 @@ namespace skyline::nce {
         /**
          * @brief An opaque handle to a group of trapped region
          */
-        class TrapHandle : private TrapMap::GroupHandle {
-            constexpr TrapHandle(const TrapMap::GroupHandle &handle);
+        class TrapHandle {
+          private:
+            TrapGroup *group;
+
+            constexpr TrapHandle(TrapGroup *group) : group{group} {}
+
+            constexpr TrapGroup *operator->() const {
+                return group;
+            }
 
             friend NCE;
         };
@@ -150,6 +275,20 @@ namespace skyline::nce {
          */
         void TrapRegions(TrapHandle handle, bool writeOnly);
 
+        /**
+         * @brief Tracks writes to a region of memory asynchronously without trapping them, this is far cheaper than a write-only trap for frequently written regions
+         * @return If writes are tracked asynchronously, they must be polled for using CollectWrites as the write callback will not be called. If false, the region is trapped as with TrapRegions(handle, true) instead
+         * @note Writes are not blocked while the resource is locked, any synchronization of the region must be performed after this call so that writes during it are collected
+         * @note Tracking is stopped by any call to TrapRegions, RemoveTrap or DeleteTrap, resources which need to sequence guest writes against other usage must trap the region instead
+         */
+        bool TrackWrites(TrapHandle handle);
+
+        /**
+         * @return If any writes were made to the region since TrackWrites was last called for it, this is always false if the region isn't being tracked asynchronously
+         * @note False positives are possible when regions share pages, this can only result in redundant synchronization
+         */
+        bool CollectWrites(TrapHandle handle);
+
         /**
          * @brief Removes protections from a region of memory
          */
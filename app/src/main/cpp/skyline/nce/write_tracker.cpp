@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#include <linux/userfaultfd.h>
+#include <common/trace.h>
+#include "write_tracker.h"
+
+// The following definitions are from Linux 6.7 UAPI headers which the NDK may not include yet
+#ifndef UFFD_USER_MODE_ONLY
+#define UFFD_USER_MODE_ONLY 1
+#endif
+
+#ifndef UFFD_FEATURE_WP_HUGETLBFS_SHMEM
+#define UFFD_FEATURE_WP_HUGETLBFS_SHMEM (1 << 12)
+#endif
+
+#ifndef UFFD_FEATURE_WP_UNPOPULATED
+#define UFFD_FEATURE_WP_UNPOPULATED (1 << 13)
+#endif
+
+#ifndef UFFD_FEATURE_WP_ASYNC
+#define UFFD_FEATURE_WP_ASYNC (1 << 15)
+#endif
+
+#ifndef PAGEMAP_SCAN
+#define PAGE_IS_WRITTEN (1 << 1)
+
+struct page_region {
+    __u64 start;
+    __u64 end;
+    __u64 categories;
+};
+
+struct pm_scan_arg {
+    __u64 size;
+    __u64 flags;
+    __u64 start;
+    __u64 end;
+    __u64 walk_end;
+    __u64 vec;
+    __u64 vec_len;
+    __u64 max_pages;
+    __u64 category_inverted;
+    __u64 category_mask;
+    __u64 category_anyof_mask;
+    __u64 return_mask;
+};
+
+#define PAGEMAP_SCAN _IOWR('f', 16, struct pm_scan_arg)
+#endif
+
+namespace skyline::nce {
+    constexpr u64 PagemapSoftDirtyBit{1ULL << 55}; //!< The bit in a /proc/self/pagemap entry denoting that the page has been written to since soft-dirty bits were last cleared
+
+    WriteTracker::WriteTracker(Backend backend, int uffd, int pagemapFd, int clearRefsFd) : backend{backend}, uffd{uffd}, pagemapFd{pagemapFd}, clearRefsFd{clearRefsFd}, lastResetTime{util::GetTimeNs()} {}
+
+    WriteTracker::~WriteTracker() {
+        if (uffd != -1)
+            close(uffd);
+        if (pagemapFd != -1)
+            close(pagemapFd);
+        if (clearRefsFd != -1)
+            close(clearRefsFd);
+    }
+
+    /**
+     * @return A userfaultfd with asynchronous write-protection enabled or -1 if it isn't supported
+     */
+    static int CreateAsyncWpUffd() {
+        // UFFD_USER_MODE_ONLY is required to create a userfaultfd without privileges on most distributions, we never handle faults from the kernel so it doesn't restrict us
+        int uffd{static_cast<int>(syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY))};
+        if (uffd == -1)
+            return -1;
+
+        // WP_ASYNC lets the kernel resolve write-protect faults itself by clearing the protection, no fault handler thread is required and the faults never reach userspace
+        uffdio_api api{
+            .api = UFFD_API,
+            .features = UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_HUGETLBFS_SHMEM | UFFD_FEATURE_WP_UNPOPULATED,
+        };
+        if (ioctl(uffd, UFFDIO_API, &api) == -1) {
+            close(uffd);
+            return -1;
+        }
+
+        return uffd;
+    }
+
+    /**
+     * @return If the kernel tracks soft-dirty bits, this is determined by checking if a write to a page is observed after clearing them
+     */
+    static bool IsSoftDirtySupported(int pagemapFd, int clearRefsFd) {
+        auto page{static_cast<u8 *>(mmap(nullptr, constant::PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0))};
+        if (page == MAP_FAILED)
+            return false;
+
+        auto isSoftDirty{[&] {
+            u64 entry{};
+            if (pread(pagemapFd, &entry, sizeof(entry), static_cast<off_t>(reinterpret_cast<u64>(page) / constant::PageSize * sizeof(u64))) != sizeof(entry))
+                return false;
+            return (entry & PagemapSoftDirtyBit) != 0;
+        }};
+
+        *page = 1;
+        bool supported{pwrite(clearRefsFd, "4", 1, 0) == 1 && !isSoftDirty()};
+        *reinterpret_cast<volatile u8 *>(page) = 2;
+        supported = supported && isSoftDirty();
+
+        munmap(page, constant::PageSize);
+        return supported;
+    }
+
+    std::unique_ptr<WriteTracker> WriteTracker::Create(Backend backend) {
+        int pagemapFd{open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC)};
+        if (pagemapFd == -1)
+            return nullptr;
+
+        if (backend == Backend::UffdWriteProtect) {
+            if (int uffd{CreateAsyncWpUffd()}; uffd != -1) {
+                // PAGEMAP_SCAN was introduced alongside WP_ASYNC but we check for it explicitly as an empty scan to avoid any dependency on that
+                pm_scan_arg arg{.size = sizeof(pm_scan_arg)};
+                if (ioctl(pagemapFd, PAGEMAP_SCAN, &arg) != -1)
+                    return std::unique_ptr<WriteTracker>(new WriteTracker(Backend::UffdWriteProtect, uffd, pagemapFd, -1));
+                close(uffd);
+            }
+        } else {
+            if (int clearRefsFd{open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC)}; clearRefsFd != -1) {
+                if (IsSoftDirtySupported(pagemapFd, clearRefsFd))
+                    return std::unique_ptr<WriteTracker>(new WriteTracker(Backend::SoftDirty, -1, pagemapFd, clearRefsFd));
+                close(clearRefsFd);
+            }
+        }
+
+        close(pagemapFd);
+        return nullptr;
+    }
+
+    std::unique_ptr<WriteTracker> WriteTracker::Create() {
+        if (auto tracker{Create(Backend::UffdWriteProtect)})
+            return tracker;
+        return Create(Backend::SoftDirty);
+    }
+
+    bool WriteTracker::Arm(span<u8> region) {
+        if (backend == Backend::SoftDirty)
+            return true; // Soft-dirty bits are tracked for all memory and can't be cleared for individual regions
+
+        TRACE_EVENT("host", "WriteTracker::Arm");
+
+        uffdio_writeprotect writeProtect{
+            .range = {
+                .start = reinterpret_cast<u64>(region.data()),
+                .len = region.size(),
+            },
+            .mode = UFFDIO_WRITEPROTECT_MODE_WP,
+        };
+        if (ioctl(uffd, UFFDIO_WRITEPROTECT, &writeProtect) == 0)
+            return true;
+
+        // Regions are registered lazily as the ioctl is only required the first time a range is armed, this fails if the range spans a mapping which doesn't support write-protection
+        uffdio_register registration{
+            .range = writeProtect.range,
+            .mode = UFFDIO_REGISTER_MODE_WP,
+        };
+        if (ioctl(uffd, UFFDIO_REGISTER, &registration) == -1)
+            return false;
+
+        return ioctl(uffd, UFFDIO_WRITEPROTECT, &writeProtect) == 0;
+    }
+
+    bool WriteTracker::IsWrittenUffd(span<u8> region) {
+        // We only need to know if any page was written, so the scan terminates at the first page that has been
+        page_region result{};
+        pm_scan_arg arg{
+            .size = sizeof(pm_scan_arg),
+            .start = reinterpret_cast<u64>(region.data()),
+            .end = reinterpret_cast<u64>(region.end().base()),
+            .vec = reinterpret_cast<u64>(&result),
+            .vec_len = 1,
+            .max_pages = 1,
+            .category_mask = PAGE_IS_WRITTEN,
+            .return_mask = PAGE_IS_WRITTEN,
+        };
+
+        int count{ioctl(pagemapFd, PAGEMAP_SCAN, &arg)};
+        return count != 0; // Any error is treated as a write as false negatives would result in stale data
+    }
+
+    bool WriteTracker::IsWrittenSoftDirty(span<u8> region) {
+        constexpr size_t EntryBatchSize{0x200}; //!< The amount of pagemap entries read at once
+        std::array<u64, EntryBatchSize> entries;
+
+        size_t pageCount{region.size() / constant::PageSize};
+        auto offset{static_cast<off_t>(reinterpret_cast<u64>(region.data()) / constant::PageSize * sizeof(u64))};
+        while (pageCount) {
+            size_t batchCount{std::min(pageCount, EntryBatchSize)};
+            auto bytesRead{pread(pagemapFd, entries.data(), batchCount * sizeof(u64), offset)};
+            if (bytesRead != static_cast<ssize_t>(batchCount * sizeof(u64)))
+                return true;
+
+            for (u64 entry : span(entries).first(batchCount))
+                if (entry & PagemapSoftDirtyBit)
+                    return true;
+
+            pageCount -= batchCount;
+            offset += static_cast<off_t>(batchCount * sizeof(u64));
+        }
+
+        return false;
+    }
+
+    bool WriteTracker::IsWritten(span<u8> region) {
+        TRACE_EVENT("host", "WriteTracker::IsWritten");
+        if (backend == Backend::UffdWriteProtect)
+            return IsWrittenUffd(region);
+        else
+            return IsWrittenSoftDirty(region);
+    }
+
+    bool WriteTracker::IsResetRequired() {
+        return backend == Backend::SoftDirty && util::GetTimeNs() - lastResetTime >= SoftDirtyResetInterval;
+    }
+
+    void WriteTracker::Reset() {
+        if (backend != Backend::SoftDirty)
+            return;
+
+        TRACE_EVENT("host", "WriteTracker::Reset");
+        if (pwrite(clearRefsFd, "4", 1, 0) != 1)
+            throw exception("Failed to clear soft-dirty bits: {}", strerror(errno));
+        lastResetTime = util::GetTimeNs();
+    }
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::nce {
+    /**
+     * @brief Tracks CPU writes to regions of memory without trapping them, writes are collected in batches by querying the kernel's page tables rather than faulting into userspace on every write
+     * @note This is an alternative to write-only mprotect traps for memory that is written to frequently and only needs to be synchronized at specific points, writes can't be acted upon as they occur so traps are still required for memory that needs writes to be sequenced against other accesses
+     */
+    class WriteTracker {
+      public:
+        /**
+         * @brief The kernel mechanism that is used to track writes
+         */
+        enum class Backend {
+            UffdWriteProtect, //!< Asynchronous userfaultfd write-protection (UFFD_FEATURE_WP_ASYNC) with PAGEMAP_SCAN queries, this requires Linux 6.7+
+            SoftDirty, //!< Soft-dirty PTE bits read from /proc/self/pagemap, these can only be cleared for the entire process so they're periodically harvested and reset
+        };
+
+      private:
+        Backend backend;
+        int uffd{-1}; //!< (UffdWriteProtect) The userfaultfd that all tracked regions are registered with
+        int pagemapFd{-1};
+        int clearRefsFd{-1}; //!< (SoftDirty) A handle to /proc/self/clear_refs, writing "4" to it clears all soft-dirty bits in the process
+        i64 lastResetTime{}; //!< (SoftDirty) The time at which soft-dirty bits were last cleared in nanoseconds
+
+        static constexpr i64 SoftDirtyResetInterval{constant::NsInMillisecond * 16}; //!< The minimum interval between clearing the soft-dirty bits of the process, every page faults on its first write after a reset so this must be infrequent
+
+        WriteTracker(Backend backend, int uffd, int pagemapFd, int clearRefsFd);
+
+        bool IsWrittenUffd(span<u8> region);
+
+        bool IsWrittenSoftDirty(span<u8> region);
+
+      public:
+        /**
+         * @return A write tracker using the supplied backend, nullptr if it isn't supported by the host kernel
+         */
+        static std::unique_ptr<WriteTracker> Create(Backend backend);
+
+        /**
+         * @return A write tracker using the most efficient backend supported by the host kernel, nullptr if none are supported and traps must be used instead
+         */
+        static std::unique_ptr<WriteTracker> Create();
+
+        WriteTracker(const WriteTracker &) = delete;
+
+        ~WriteTracker();
+
+        Backend GetBackend() const {
+            return backend;
+        }
+
+        /**
+         * @brief Starts tracking writes to the supplied page-aligned region, any writes prior to this are discarded
+         * @return If the region could be tracked, this may fail for memory which doesn't support write-protection in which case the caller must fall back to traps
+         * @note The SoftDirty backend cannot discard writes for individual regions, writes prior to arming may be reported until the next reset
+         */
+        bool Arm(span<u8> region);
+
+        /**
+         * @return If any page in the supplied page-aligned region has been written to since it was armed, writes continue to be reported until the region is rearmed
+         * @note False positives are possible, false negatives are not
+         */
+        bool IsWritten(span<u8> region);
+
+        /**
+         * @return If Reset() should be called to prevent the tracker from degrading into reporting every page as written
+         * @note The caller must harvest the state of all tracked regions prior to resetting as it discards all writes
+         */
+        bool IsResetRequired();
+
+        /**
+         * @brief Discards all writes to every tracked region, this is only meaningful for the SoftDirty backend
+         */
+        void Reset();
+    };
+}
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <sys/resource.h>
+#include "common/settings.h"
 #include "gpu.h"
 #include "nce.h"
 #include "nce/guest.h"
@@ -56,8 +58,12 @@ namespace skyline::kernel {
         auto &process{state.process};
         process = std::make_shared<kernel::type::KProcess>(state);
 
+        rusage startUsage{};
+        getrusage(RUSAGE_SELF, &startUsage);
+
         auto entry{state.loader->LoadProcessData(process, state)};
         auto &nacp{state.loader->nacp};
+        std::string title{"Unknown"};
         if (nacp) {
             std::string name{nacp->GetApplicationName(language::ApplicationLanguage::AmericanEnglish)}, publisher{nacp->GetApplicationPublisher(language::ApplicationLanguage::AmericanEnglish)};
             if (name.empty())
@@ -65,6 +71,7 @@ namespace skyline::kernel {
             if (publisher.empty())
                 publisher = nacp->GetApplicationPublisher(nacp->GetFirstSupportedTitleLanguage());
             Logger::InfoNoPrefix(R"(Starting "{}" ({}) v{} by "{}")", name, nacp->GetSaveDataOwnerId(), nacp->GetApplicationVersion(), publisher);
+            title = name;
         }
 
         process->InitializeHeapTls();
@@ -75,5 +82,10 @@ namespace skyline::kernel {
             thread->Start(true);
             process->Kill(true, true, true);
         }
+
+        // Page faults are counted for the entire host process but emulation dominates them, this allows comparing the effect of the paging policies per-title
+        rusage endUsage{};
+        getrusage(RUSAGE_SELF, &endUsage);
+        Logger::Info(R"(Page faults for "{}": {} minor, {} major (Huge Pages: {}, Prefault: {}))", title, endUsage.ru_minflt - startUsage.ru_minflt, endUsage.ru_majflt - startUsage.ru_majflt, *state.settings->enableHugePages, *state.settings->prefaultGuestMemory);
     }
 }
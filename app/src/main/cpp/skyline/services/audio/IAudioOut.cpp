@@ -48,7 +48,9 @@ namespace skyline::service::audio {
 
         span samples(data.sampleBuffer, data.sampleSize / sizeof(i16));
         if (sampleRate != constant::SampleRate) {
-            auto resampledBuffer{resampler.ResampleBuffer(samples, static_cast<double>(sampleRate) / constant::SampleRate, channelCount)};
+            auto ratio{static_cast<double>(sampleRate) / constant::SampleRate};
+            resampledBuffer.resize(skyline::audio::Resampler::GetMaxOutputSize(samples.size(), ratio, channelCount));
+            resampledBuffer.resize(resampler.Process(samples, resampledBuffer, ratio, channelCount));
             track->AppendBuffer(tag, resampledBuffer);
         } else {
             track->AppendBuffer(tag, samples);
@@ -2,6 +2,7 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <common/settings.h>
+#include <common/trace.h>
 #include <kernel/types/KProcess.h>
 #include "IAudioRenderer.h"
 
@@ -13,6 +14,7 @@ namespace skyline::service::audio::IAudioRenderer {
 
         memoryPools.resize(parameters.effectCount + parameters.voiceCount * 4);
         effects.resize(parameters.effectCount);
+        sortedEffects.reserve(parameters.effectCount);
         voices.resize(parameters.voiceCount, Voice(state));
 
         // Fill track with empty samples that we will triple buffer
@@ -69,6 +71,13 @@ namespace skyline::service::audio::IAudioRenderer {
         for (u32 i{}; i < effectsIn.size(); i++)
             effects[i].ProcessInput(effectsIn[i]);
 
+        sortedEffects.clear();
+        for (auto &effect : effects)
+            sortedEffects.push_back(&effect);
+        std::stable_sort(sortedEffects.begin(), sortedEffects.end(), [](const Effect *a, const Effect *b) {
+            return a->ProcessingOrder() < b->ProcessingOrder();
+        });
+
         if (!*state.settings->isAudioOutputDisabled)
             UpdateAudio();
 
@@ -129,38 +138,42 @@ namespace skyline::service::audio::IAudioRenderer {
     }
 
     void IAudioRenderer::MixFinalBuffer() {
-        u32 writtenSamples{};
+        TRACE_EVENT("service", "IAudioRenderer::MixFinalBuffer");
+
+        mixBuffer.fill(0);
 
         for (auto &voice : voices) {
-            if (!voice.Playable())
+            if (!voice.Playable()) {
+                voice.previousVolume = voice.volume;
                 continue;
+            }
 
-            u32 bufferOffset{};
-            u32 pendingSamples{constant::MixBufferSize};
+            // The volume is linearly ramped across the mix to avoid audible discontinuities when it changes between updates
+            float volumeStep{(voice.volume - voice.previousVolume) / constant::MixBufferSize};
+            u32 mixedFrames{};
 
-            while (pendingSamples > 0) {
+            while (mixedFrames < constant::MixBufferSize) {
                 u32 voiceBufferOffset{};
                 u32 voiceBufferSize{};
-                auto &voiceSamples{voice.GetBufferData(pendingSamples, voiceBufferOffset, voiceBufferSize)};
+                auto &voiceSamples{voice.GetBufferData(constant::MixBufferSize - mixedFrames, voiceBufferOffset, voiceBufferSize)};
 
                 if (voiceBufferSize == 0)
                     break;
 
-                pendingSamples -= voiceBufferSize / constant::StereoChannelCount;
-
-                for (auto index{voiceBufferOffset}; index < voiceBufferOffset + voiceBufferSize; index++) {
-                    if (writtenSamples == bufferOffset) {
-                        sampleBuffer[bufferOffset] = skyline::audio::Saturate<i16, i32>(voiceSamples[index] * voice.volume);
+                skyline::audio::dsp::MixWithVolumeRamp(span(mixBuffer).subspan(mixedFrames * constant::StereoChannelCount, voiceBufferSize),
+                                                       span(voiceSamples).subspan(voiceBufferOffset, voiceBufferSize),
+                                                       constant::StereoChannelCount, voice.previousVolume + volumeStep * static_cast<float>(mixedFrames), volumeStep);
 
-                        writtenSamples++;
-                    } else {
-                        sampleBuffer[bufferOffset] = skyline::audio::Saturate<i16, i32>(sampleBuffer[bufferOffset] + (voiceSamples[index] * voice.volume));
-                    }
-
-                    bufferOffset++;
-                }
+                mixedFrames += voiceBufferSize / constant::StereoChannelCount;
             }
+
+            voice.previousVolume = voice.volume;
         }
+
+        for (auto effect : sortedEffects)
+            effect->Process(mixBuffer, constant::StereoChannelCount);
+
+        skyline::audio::dsp::SaturateMix(sampleBuffer, mixBuffer);
     }
 
     Result IAudioRenderer::Start(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
@@ -68,7 +68,9 @@ namespace skyline {
             std::shared_ptr<type::KEvent> systemEvent; //!< The KEvent that is signalled when the DSP has processed all the commands
             std::vector<MemoryPool> memoryPools;
             std::vector<Effect> effects;
+            std::vector<Effect *> sortedEffects; //!< All effects sorted by the order they should be applied in
             std::vector<Voice> voices;
+            std::array<i32, constant::MixBufferSize * constant::StereoChannelCount> mixBuffer{}; //!< The intermediate buffer voices are mixed into at a higher precision, this avoids saturating after every voice
             std::array<i16, constant::MixBufferSize * constant::StereoChannelCount> sampleBuffer{}; //!< The final output data that is appended to the stream
             skyline::audio::AudioOutState playbackState{skyline::audio::AudioOutState::Stopped};
 
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <audio/common.h>
+#include "effect.h"
+
+namespace skyline::service::audio::IAudioRenderer {
+    constexpr float EffectFixedPointScale{1.0f / (1 << 14)}; //!< The scale of the Q18.14 gains used by delay effects
+
+    void Effect::ProcessInput(const EffectIn &input) {
+        if (input.isNew || input.type != parameters.type) {
+            biquadStates = {};
+            delayLines = {};
+            delayLowpassStates = {};
+            delayPosition = 0;
+        }
+
+        parameters = input;
+
+        if (input.isNew)
+            output.state = EffectState::New;
+        else if (input.type != EffectType::Invalid)
+            output.state = input.enabled ? EffectState::Enabled : EffectState::Disabled;
+    }
+
+    void Effect::Process(span<i32> mixBuffer, u8 channelCount) {
+        if (!parameters.enabled)
+            return;
+
+        auto isValidChannel{[channelCount](i8 channel) {
+            return channel >= 0 && channel < channelCount;
+        }};
+
+        switch (parameters.type) {
+            case EffectType::BufferMixer: {
+                const auto &mixer{parameters.bufferMixer};
+                for (u32 i{}; i < std::min<u32>(mixer.mixCount, static_cast<u32>(mixer.input.size())); i++)
+                    if (isValidChannel(mixer.input[i]) && isValidChannel(mixer.output[i]))
+                        skyline::audio::dsp::MixChannel(mixBuffer, channelCount, static_cast<u8>(mixer.input[i]), static_cast<u8>(mixer.output[i]), mixer.volume[i]);
+                break;
+            }
+
+            case EffectType::BiquadFilter: {
+                const auto &filter{parameters.biquadFilter};
+                for (i8 i{}; i < std::min<i8>(filter.channelCount, static_cast<i8>(filter.input.size())); i++)
+                    if (isValidChannel(filter.input[i]) && isValidChannel(filter.output[i]))
+                        skyline::audio::dsp::ApplyBiquadFilter(mixBuffer, channelCount, static_cast<u8>(filter.input[i]), static_cast<u8>(filter.output[i]), filter.coefficients, biquadStates[static_cast<size_t>(i)]);
+                break;
+            }
+
+            case EffectType::Aux:
+                ProcessAux(mixBuffer, channelCount);
+                break;
+
+            case EffectType::Delay:
+                ProcessDelay(mixBuffer, channelCount);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void Effect::ProcessAux(span<i32> mixBuffer, u8 channelCount) {
+        const auto &aux{parameters.aux};
+        if (!aux.sendBufferInfo || !aux.sendBuffer || !aux.returnBufferInfo || !aux.returnBuffer || !aux.sampleCountMax)
+            return;
+
+        auto sendInfo{reinterpret_cast<AuxBufferInfo *>(aux.sendBufferInfo)};
+        auto returnInfo{reinterpret_cast<AuxBufferInfo *>(aux.returnBufferInfo)};
+        span sendBuffer(reinterpret_cast<i32 *>(aux.sendBuffer), aux.sampleCountMax);
+        span returnBuffer(reinterpret_cast<i32 *>(aux.returnBuffer), aux.sampleCountMax);
+
+        u32 writeOffset{sendInfo->writeOffset}, readOffset{returnInfo->readOffset};
+        if (writeOffset >= aux.sampleCountMax || readOffset >= aux.sampleCountMax)
+            return;
+
+        // Every channel is written to and read from the ring buffers as a contiguous block of samples, one after another
+        u32 frameCount{static_cast<u32>(mixBuffer.size() / channelCount)};
+        u32 channels{std::min<u32>(aux.mixBufferCount, static_cast<u32>(aux.input.size()))};
+        for (u32 i{}; i < channels; i++) {
+            i8 input{aux.input[i]}, output{aux.output[i]};
+            if (input < 0 || input >= channelCount || output < 0 || output >= channelCount)
+                continue;
+
+            for (u32 frame{}; frame < frameCount; frame++)
+                sendBuffer[(writeOffset + i * frameCount + frame) % aux.sampleCountMax] = mixBuffer[frame * channelCount + static_cast<u8>(input)];
+
+            for (u32 frame{}; frame < frameCount; frame++)
+                mixBuffer[frame * channelCount + static_cast<u8>(output)] = returnBuffer[(readOffset + i * frameCount + frame) % aux.sampleCountMax];
+        }
+
+        sendInfo->writeOffset = (writeOffset + channels * frameCount) % aux.sampleCountMax;
+        returnInfo->readOffset = (readOffset + channels * frameCount) % aux.sampleCountMax;
+    }
+
+    void Effect::ProcessDelay(span<i32> mixBuffer, u8 channelCount) {
+        const auto &delay{parameters.delay};
+        auto channels{static_cast<size_t>(std::clamp<i16>(delay.channelCount, 0, static_cast<i16>(delay.input.size())))};
+        for (size_t i{}; i < channels; i++)
+            if (delay.input[i] < 0 || delay.input[i] >= channelCount || delay.output[i] < 0 || delay.output[i] >= channelCount)
+                return;
+
+        if (channels == 0)
+            return;
+
+        i32 delayTime{std::clamp(delay.delayTime, 0, std::max(delay.delayTimeMax, 0))};
+        size_t delayLength{std::max<size_t>(static_cast<size_t>(delayTime) * constant::SampleRate / 1000, 1)};
+        if (delayLines[0].size() != delayLength) {
+            for (auto &line : delayLines)
+                line.assign(delayLength, 0.0f);
+            delayLowpassStates = {};
+            delayPosition = 0;
+        }
+
+        // The feedback is attenuated slightly so the delay line always decays, with stereo (or wider) delays the channel spread moves a portion of it to the adjacent channels
+        float feedbackGain{delay.feedbackGain * EffectFixedPointScale * 0.97998046875f};
+        float channelSpread{channels > 1 ? delay.channelSpread * EffectFixedPointScale : 0.0f};
+        float directFeedbackGain{feedbackGain * (1.0f - channelSpread)};
+        float crossFeedbackGain{feedbackGain * channelSpread * (channels > 2 ? 0.5f : 1.0f)};
+        float lowpassFeedbackGain{delay.lowpassAmount * EffectFixedPointScale * 0.949951171875f};
+        float lowpassGain{1.0f - lowpassFeedbackGain};
+        float inGain{delay.inGain * EffectFixedPointScale}, wetGain{delay.wetGain * EffectFixedPointScale}, dryGain{delay.dryGain * EffectFixedPointScale};
+
+        std::array<float, 6> inputs{}, delayed{};
+        for (size_t frame{}; frame < mixBuffer.size() / channelCount; frame++) {
+            auto samples{mixBuffer.subspan(frame * channelCount, channelCount)};
+
+            for (size_t i{}; i < channels; i++) {
+                inputs[i] = static_cast<float>(samples[static_cast<u8>(delay.input[i])]);
+                delayed[i] = delayLines[i][delayPosition];
+            }
+
+            for (size_t i{}; i < channels; i++) {
+                float feedback{delayed[i] * directFeedbackGain};
+                if (channels == 2)
+                    feedback += delayed[i ^ 1] * crossFeedbackGain;
+                else if (channels > 2)
+                    feedback += (delayed[(i + channels - 1) % channels] + delayed[(i + 1) % channels]) * crossFeedbackGain;
+
+                delayLowpassStates[i] = (inputs[i] * inGain + feedback) * lowpassGain + delayLowpassStates[i] * lowpassFeedbackGain;
+                delayLines[i][delayPosition] = delayLowpassStates[i];
+            }
+
+            for (size_t i{}; i < channels; i++)
+                samples[static_cast<u8>(delay.output[i])] = skyline::audio::Saturate<i32, double>(inputs[i] * dryGain + delayed[i] * wetGain);
+
+            delayPosition = (delayPosition + 1) % delayLength;
+        }
+    }
+}
@@ -3,21 +3,126 @@
 
 #pragma once
 
+#include <audio/dsp.h>
 #include <common.h>
 
 namespace skyline::service::audio::IAudioRenderer {
+    enum class EffectType : u8 {
+        Invalid = 0,
+        BufferMixer = 1,
+        Aux = 2,
+        Delay = 3,
+        Reverb = 4,
+        I3dl2Reverb = 5,
+        BiquadFilter = 6,
+    };
+
     enum class EffectState : u8 {
         None = 0, //!< The effect isn't being used
         New = 1,
+        Enabled = 2,
+        Disabled = 3,
+    };
+
+    /**
+     * @brief The parameters of a buffer mixer effect, each input mix buffer is scaled and accumulated into the corresponding output
+     */
+    struct BufferMixerParameters {
+        std::array<i8, 24> input; //!< The mix buffer indices to read from
+        std::array<i8, 24> output; //!< The mix buffer indices to accumulate into
+        std::array<float, 24> volume;
+        u32 mixCount; //!< The amount of valid entries in the arrays above
+    };
+    static_assert(sizeof(BufferMixerParameters) == 0x94);
+
+    /**
+     * @brief The parameters of a biquad filter effect, the same filter is applied to every channel
+     */
+    struct BiquadFilterParameters {
+        std::array<i8, 6> input; //!< The mix buffer indices to read from
+        std::array<i8, 6> output; //!< The mix buffer indices to write to
+        skyline::audio::dsp::BiquadCoefficients coefficients;
+        i8 channelCount;
+        u8 _pad0_;
+    };
+    static_assert(sizeof(BiquadFilterParameters) == 0x18);
+
+    /**
+     * @brief The parameters of an aux effect, the inputs are written into a guest send ring buffer and the outputs are read back from a guest return ring buffer
+     * @url https://switchbrew.org/wiki/Audio_services#AuxParameter
+     */
+    struct AuxParameters {
+        std::array<i8, 24> input; //!< The mix buffer indices to send to the guest
+        std::array<i8, 24> output; //!< The mix buffer indices to replace with the data returned by the guest
+        u32 mixBufferCount; //!< The amount of valid entries in the arrays above
+        u32 sampleRate;
+        u32 sampleCountMax; //!< The size of the send and return ring buffers in samples
+        u32 mixBufferCountMax;
+        u64 sendBufferInfo; //!< The address of the AuxBufferInfo for the send buffer
+        u64 sendBuffer;
+        u64 returnBufferInfo; //!< The address of the AuxBufferInfo for the return buffer
+        u64 returnBuffer;
+        u32 mixBufferSampleSize;
+        u32 sampleCount;
+        u32 mixBufferSampleCount;
+        u32 _pad0_;
     };
+    static_assert(sizeof(AuxParameters) == 0x70);
+
+    /**
+     * @brief The header of an aux ring buffer in guest memory, the DSP advances the write offset of the send buffer and the read offset of the return buffer
+     */
+    struct AuxBufferInfo {
+        u32 readOffset;
+        u32 writeOffset;
+        u32 lostSampleCount;
+        u32 totalSampleCount;
+        u32 _pad0_[12];
+    };
+    static_assert(sizeof(AuxBufferInfo) == 0x40);
+
+    /**
+     * @brief The parameters of a delay effect, all gains are in the Q18.14 fixed point format
+     */
+    struct DelayParameters {
+        std::array<i8, 6> input; //!< The mix buffer indices to read from
+        std::array<i8, 6> output; //!< The mix buffer indices to write to
+        i16 channelCountMax;
+        i16 channelCount;
+        i32 delayTimeMax; //!< The maximum delay time in milliseconds
+        i32 delayTime; //!< The delay time in milliseconds
+        i32 sampleRate;
+        i32 inGain;
+        i32 feedbackGain;
+        i32 wetGain;
+        i32 dryGain;
+        i32 channelSpread; //!< The fraction of the feedback which is sent to neighbouring channels
+        i32 lowpassAmount;
+        u8 state;
+        u8 _pad0_[3];
+    };
+    static_assert(sizeof(DelayParameters) == 0x38);
 
     /**
      * @brief Input containing information on what effects to use on an audio stream
      */
     struct EffectIn {
-        u8 _unk0_;
+        EffectType type;
         u8 isNew; //!< Whether the effect was used in the previous samples
-        u8 _unk1_[0xBE];
+        u8 enabled;
+        u8 _pad0_;
+        u32 mixId;
+        u64 workBuffer;
+        u64 workBufferSize;
+        u32 processingOrder; //!< The order in which this effect is applied relative to other effects
+        u32 _pad1_;
+        union {
+            BufferMixerParameters bufferMixer;
+            BiquadFilterParameters biquadFilter;
+            AuxParameters aux;
+            DelayParameters delay;
+            std::array<u8, 0xA0> raw;
+        };
     };
     static_assert(sizeof(EffectIn) == 0xC0);
 
@@ -31,15 +136,34 @@ namespace skyline::service::audio::IAudioRenderer {
     static_assert(sizeof(EffectOut) == 0x10);
 
     /**
-     * @brief The Effect class stores the state of audio post processing effects
+     * @brief The Effect class stores the state of audio post processing effects and applies them to the final mix
+     * @note Mix buffers aren't emulated so effect inputs and outputs refer directly to channels of the final mix
+     * @note Reverb and I3DL2 reverb effects aren't implemented and are passed through untouched
      */
     class Effect {
+      private:
+        EffectIn parameters{};
+        std::array<skyline::audio::dsp::BiquadState, 6> biquadStates{}; //!< The filter state of each channel for biquad filter effects
+        std::array<std::vector<float>, 6> delayLines{}; //!< The delay line of each channel for delay effects, these are sized to the delay time
+        std::array<float, 6> delayLowpassStates{}; //!< The state of the one-pole lowpass filter on the feedback path of each delay line
+        size_t delayPosition{}; //!< The position in the delay lines which is read from and then written to
+
+        void ProcessAux(span<i32> mixBuffer, u8 channelCount);
+
+        void ProcessDelay(span<i32> mixBuffer, u8 channelCount);
+
       public:
         EffectOut output{};
 
-        void ProcessInput(const EffectIn &input) {
-            if (input.isNew)
-                output.state = EffectState::New;
+        void ProcessInput(const EffectIn &input);
+
+        /**
+         * @brief Applies the effect to an interleaved 32-bit mix buffer
+         */
+        void Process(span<i32> mixBuffer, u8 channelCount);
+
+        u32 ProcessingOrder() const {
+            return parameters.processingOrder;
         }
     };
 }
@@ -19,6 +19,7 @@ namespace skyline::service::audio::IAudioRenderer {
             bufferReload = true;
             bufferIndex = 0;
             sampleOffset = 0;
+            resampler.Reset();
 
             output.playedSamplesCount = 0;
             output.playedWaveBuffersCount = 0;
@@ -50,10 +51,19 @@ namespace skyline::service::audio::IAudioRenderer {
             }
 
             SetWaveBufferIndex(static_cast<u8>(input.baseWaveBufferIndex));
+
+            biquadStates = {};
+            previousVolume = input.volume;
         }
 
         waveBuffers = input.waveBuffers;
         volume = input.volume;
+
+        for (size_t i{}; i < biquadFilters.size(); i++) {
+            if (input.biquadFilters[i].enable && !biquadFilters[i].enable)
+                biquadStates[i] = {};
+            biquadFilters[i] = input.biquadFilters[i];
+        }
         playbackState = input.playbackState;
     }
 
@@ -77,8 +87,12 @@ namespace skyline::service::audio::IAudioRenderer {
                 throw exception("Unsupported PCM format used by Voice: {}", format);
         }
 
-        if (sampleRate != constant::SampleRate)
-            samples = resampler.ResampleBuffer(samples, static_cast<double>(sampleRate) / constant::SampleRate, channelCount);
+        if (sampleRate != constant::SampleRate) {
+            auto ratio{static_cast<double>(sampleRate) / constant::SampleRate};
+            resampledSamples.resize(skyline::audio::Resampler::GetMaxOutputSize(samples.size(), ratio, channelCount));
+            resampledSamples.resize(resampler.Process(samples, resampledSamples, ratio, channelCount));
+            std::swap(samples, resampledSamples);
+        }
 
         if (channelCount == 1 && constant::StereoChannelCount != channelCount) {
             auto originalSize{samples.size()};
@@ -95,6 +109,10 @@ namespace skyline::service::audio::IAudioRenderer {
             span(samples).copy_from(span(skyline::audio::DownMix(span(samples).cast<skyline::audio::Surround51Sample>())));
             samples.resize((samples.size() / constant::SurroundChannelCount) * constant::StereoChannelCount);
         }
+
+        for (size_t i{}; i < biquadFilters.size(); i++)
+            if (biquadFilters[i].enable)
+                skyline::audio::dsp::ApplyBiquadFilter(samples, biquadFilters[i].coefficients, biquadStates[i]);
     }
 
     std::vector<i16> &Voice::GetBufferData(u32 maxSamples, u32 &outOffset, u32 &outSize) {
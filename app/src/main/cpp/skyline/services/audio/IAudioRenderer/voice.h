@@ -5,17 +5,14 @@
 
 #include <audio/resampler.h>
 #include <audio/adpcm_decoder.h>
+#include <audio/dsp.h>
 #include <audio.h>
 
 namespace skyline::service::audio::IAudioRenderer {
     struct BiquadFilter {
         u8 enable;
         u8 _pad0_;
-        u16 b0;
-        u16 b1;
-        u16 b2;
-        u16 a1;
-        u16 a2;
+        skyline::audio::dsp::BiquadCoefficients coefficients; //!< The filter coefficients in Q2.14 fixed point
     };
     static_assert(sizeof(BiquadFilter) == 0xC);
 
@@ -77,8 +74,11 @@ namespace skyline::service::audio::IAudioRenderer {
         const DeviceState &state;
         std::array<WaveBuffer, 4> waveBuffers;
         std::vector<i16> samples; //!< A vector containing processed sample data
+        std::vector<i16> resampledSamples; //!< A scratch buffer for resampled sample data, it is swapped with `samples` after resampling so both allocations are reused
         skyline::audio::Resampler resampler; //!< The resampler object used for changing the sample rate of a wave buffer's stream
         std::optional<skyline::audio::AdpcmDecoder> adpcmDecoder;
+        std::array<BiquadFilter, 2> biquadFilters{};
+        std::array<std::array<skyline::audio::dsp::BiquadState, constant::StereoChannelCount>, 2> biquadStates{}; //!< The per-channel state of each biquad filter, this is carried across wave buffers
 
         bool acquired{false}; //!< If the voice is in use
         bool bufferReload{true};
@@ -103,6 +103,7 @@ namespace skyline::service::audio::IAudioRenderer {
       public:
         VoiceOut output{};
         float volume{};
+        float previousVolume{}; //!< The volume at the end of the previous mix, the volume is ramped from this to `volume` over a mix
 
         Voice(const DeviceState &state);
 
@@ -11,19 +11,51 @@ namespace skyline::service::codec {
         return util::AlignUp(static_cast<u32>(frameSize * channelCount / (OpusFullbandSampleRate / sampleRate)), 0x40);
     }
 
+    u32 CalculateMultiStreamBufferSize(const MultiStreamParameters &parameters, bool useLargerFrameSize) {
+        u32 requiredSize{static_cast<u32>(std::max(opus_multistream_decoder_get_size(parameters.streamCount, parameters.stereoStreamCount), 0))};
+        requiredSize += MaxInputBufferSize + CalculateOutBufferSize(parameters.sampleRate, parameters.channelCount, useLargerFrameSize ? MaxFrameSizeEx : MaxFrameSizeNormal);
+        return requiredSize;
+    }
+
     IHardwareOpusDecoder::IHardwareOpusDecoder(const DeviceState &state, ServiceManager &manager, i32 sampleRate, i32 channelCount, u32 workBufferSize, KHandle workBufferHandle, bool isIsLargerSize)
         : BaseService(state, manager),
           sampleRate(sampleRate),
           channelCount(channelCount),
           workBuffer(state.process->GetHandle<kernel::type::KTransferMemory>(workBufferHandle)),
-          decoderOutputBufferSize(CalculateOutBufferSize(sampleRate, channelCount, isIsLargerSize ? MaxFrameSizeEx : MaxFrameSizeNormal)) {
+          maxFrameSize((isIsLargerSize ? MaxFrameSizeEx : MaxFrameSizeNormal) * sampleRate / OpusFullbandSampleRate) {
+        auto decoderOutputBufferSize{CalculateOutBufferSize(sampleRate, channelCount, isIsLargerSize ? MaxFrameSizeEx : MaxFrameSizeNormal)};
         if (workBufferSize < decoderOutputBufferSize)
             throw exception("Work Buffer doesn't have adequate space for Opus Decoder: 0x{:X} (Required: 0x{:X})", workBufferSize, decoderOutputBufferSize);
 
-        // We utilize the guest-supplied work buffer for allocating the OpusDecoder object into
-        decoderState = reinterpret_cast<OpusDecoder *>(workBuffer->host.data());
+        // The decoder state is kept in host memory rather than the guest work buffer, so the guest can't observe or corrupt it
+        decoderStateBuffer.resize(static_cast<size_t>(opus_decoder_get_size(channelCount)));
+        decoderState = reinterpret_cast<OpusDecoder *>(decoderStateBuffer.data());
 
-        if (int result = opus_decoder_init(decoderState, sampleRate, channelCount) != OPUS_OK)
+        if (int result{opus_decoder_init(decoderState, sampleRate, channelCount)}; result != OPUS_OK)
+            throw OpusException(result);
+    }
+
+    IHardwareOpusDecoder::IHardwareOpusDecoder(const DeviceState &state, ServiceManager &manager, const MultiStreamParameters &parameters, u32 workBufferSize, KHandle workBufferHandle, bool isIsLargerSize)
+        : BaseService(state, manager),
+          sampleRate(parameters.sampleRate),
+          channelCount(parameters.channelCount),
+          workBuffer(state.process->GetHandle<kernel::type::KTransferMemory>(workBufferHandle)),
+          maxFrameSize((isIsLargerSize ? MaxFrameSizeEx : MaxFrameSizeNormal) * parameters.sampleRate / OpusFullbandSampleRate) {
+        if (parameters.channelCount <= 0 || parameters.channelCount > static_cast<i32>(parameters.mappings.size()))
+            throw exception("Invalid Opus multi-stream channel count: {}", parameters.channelCount);
+
+        i32 stateSize{opus_multistream_decoder_get_size(parameters.streamCount, parameters.stereoStreamCount)};
+        if (stateSize <= 0)
+            throw exception("Invalid Opus multi-stream layout: {} streams ({} stereo)", parameters.streamCount, parameters.stereoStreamCount);
+
+        auto requiredWorkBufferSize{CalculateMultiStreamBufferSize(parameters, isIsLargerSize)};
+        if (workBufferSize < requiredWorkBufferSize)
+            throw exception("Work Buffer doesn't have adequate space for Opus multi-stream Decoder: 0x{:X} (Required: 0x{:X})", workBufferSize, requiredWorkBufferSize);
+
+        decoderStateBuffer.resize(static_cast<size_t>(stateSize));
+        multiStreamDecoderState = reinterpret_cast<OpusMSDecoder *>(decoderStateBuffer.data());
+
+        if (int result{opus_multistream_decoder_init(multiStreamDecoderState, parameters.sampleRate, parameters.channelCount, parameters.streamCount, parameters.stereoStreamCount, parameters.mappings.data())}; result != OPUS_OK)
             throw OpusException(result);
     }
 
@@ -43,8 +75,15 @@ namespace skyline::service::codec {
         return DecodeInterleavedImpl(request, response, true);
     }
 
+    Result IHardwareOpusDecoder::SetContext(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return {};
+    }
+
     void IHardwareOpusDecoder::ResetContext() {
-        opus_decoder_ctl(decoderState, OPUS_RESET_STATE);
+        if (multiStreamDecoderState)
+            opus_multistream_decoder_ctl(multiStreamDecoderState, OPUS_RESET_STATE);
+        else
+            opus_decoder_ctl(decoderState, OPUS_RESET_STATE);
     }
 
     Result IHardwareOpusDecoder::DecodeInterleavedImpl(ipc::IpcRequest &request, ipc::IpcResponse &response, bool writeDecodeTime) {
@@ -62,8 +101,13 @@ namespace skyline::service::codec {
         // Skip past the header in the input buffer to get the Opus packet
         auto sampleDataIn = dataIn.subspan(sizeof(OpusDataHeader));
 
+        // Samples are decoded directly into the guest output buffer, the frame size is bounded by it to prevent libopus from writing past its end
+        auto frameSize{std::min(maxFrameSize, static_cast<i32>(dataOut.size() / static_cast<size_t>(channelCount)))};
+
         auto perfTimer{timesrv::TimeSpanType::FromNanoseconds(util::GetTimeNs())};
-        i32 decodedCount{opus_decode(decoderState, sampleDataIn.data(), opusPacketSize, dataOut.data(), static_cast<int>(decoderOutputBufferSize), false)};
+        i32 decodedCount{multiStreamDecoderState ?
+                         opus_multistream_decode(multiStreamDecoderState, sampleDataIn.data(), opusPacketSize, dataOut.data(), frameSize, false) :
+                         opus_decode(decoderState, sampleDataIn.data(), opusPacketSize, dataOut.data(), frameSize, false)};
         perfTimer = timesrv::TimeSpanType::FromNanoseconds(util::GetTimeNs()) - perfTimer;
 
         if (decodedCount < 0)
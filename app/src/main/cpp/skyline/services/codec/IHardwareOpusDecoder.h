@@ -4,10 +4,12 @@
 #pragma once
 
 #include <opus.h>
+#include <opus_multistream.h>
 
 #include <common.h>
 #include <services/base_service.h>
 #include <kernel/types/KTransferMemory.h>
+#include "IHardwareOpusDecoderManager.h"
 
 namespace skyline::service::codec {
     /**
@@ -15,6 +17,11 @@ namespace skyline::service::codec {
      */
     u32 CalculateOutBufferSize(i32 sampleRate, i32 channelCount, i32 frameSize);
 
+    /**
+     * @return The required work buffer size for a multi-stream decoder with the given parameters
+     */
+    u32 CalculateMultiStreamBufferSize(const MultiStreamParameters &parameters, bool useLargerFrameSize = false);
+
     static constexpr i32 OpusFullbandSampleRate{48000};
     static constexpr i32 MaxFrameSizeNormal{static_cast<u32>(OpusFullbandSampleRate * 0.040f)}; //!< 40ms frame size limit for normal decoders
     static constexpr i32 MaxFrameSizeEx{static_cast<u32>(OpusFullbandSampleRate * 0.120f)}; //!< 120ms frame size limit for ex decoders added in 12.0.0
@@ -26,11 +33,13 @@ namespace skyline::service::codec {
      */
     class IHardwareOpusDecoder : public BaseService {
       private:
-        std::shared_ptr<kernel::type::KTransferMemory> workBuffer;
-        OpusDecoder *decoderState{};
+        std::shared_ptr<kernel::type::KTransferMemory> workBuffer; //!< The guest-supplied work buffer, this is retained for the lifetime of the decoder but host state isn't stored in it
+        std::vector<u8> decoderStateBuffer; //!< Host memory the libopus decoder state is allocated in, this is allocated once when the decoder is created
+        OpusDecoder *decoderState{}; //!< The decoder state for single-stream decoders
+        OpusMSDecoder *multiStreamDecoderState{}; //!< The decoder state for multi-stream decoders
         i32 sampleRate;
         i32 channelCount;
-        u32 decoderOutputBufferSize;
+        i32 maxFrameSize; //!< The maximum amount of samples per channel at the decoder's sample rate that a single packet can decode into
 
         /**
          * @brief Holds information about the Opus packet to be decoded
@@ -60,6 +69,11 @@ namespace skyline::service::codec {
       public:
         IHardwareOpusDecoder(const DeviceState &state, ServiceManager &manager, i32 sampleRate, i32 channelCount, u32 workBufferSize, KHandle workBufferHandle, bool isIsLargerSize = false);
 
+        /**
+         * @brief Creates a decoder for multi-stream Opus packets
+         */
+        IHardwareOpusDecoder(const DeviceState &state, ServiceManager &manager, const MultiStreamParameters &parameters, u32 workBufferSize, KHandle workBufferHandle, bool isIsLargerSize = false);
+
         /**
          * @brief Decodes the Opus source data, returns decoded data size and decoded sample count
          * @url https://switchbrew.org/wiki/Audio_services#DecodeInterleavedOld
@@ -79,11 +93,26 @@ namespace skyline::service::codec {
          */
         Result DecodeInterleaved(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
+        /**
+         * @brief Sets the decoder context, this is a no-op as the decoder state is held on the host
+         * @url https://switchbrew.org/wiki/Audio_services#SetContext
+         */
+        Result SetContext(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
+
+        /**
+         * @note The multi-stream commands are identical to their single-stream counterparts, the type of stream decoded is determined by how the decoder was created
+         */
         SERVICE_DECL(
             SFUNC(0x0, IHardwareOpusDecoder, DecodeInterleavedOld),
+            SFUNC(0x1, IHardwareOpusDecoder, SetContext),
+            SFUNC(0x2, IHardwareOpusDecoder, DecodeInterleavedOld), // DecodeInterleavedForMultiStreamOld
+            SFUNC(0x3, IHardwareOpusDecoder, SetContext), // SetContextForMultiStream
             SFUNC(0x4, IHardwareOpusDecoder, DecodeInterleavedWithPerfOld),
+            SFUNC(0x5, IHardwareOpusDecoder, DecodeInterleavedWithPerfOld), // DecodeInterleavedForMultiStreamWithPerfOld
             SFUNC(0x6, IHardwareOpusDecoder, DecodeInterleaved), // DecodeInterleavedWithPerfAndResetOld is effectively the same as DecodeInterleaved
+            SFUNC(0x7, IHardwareOpusDecoder, DecodeInterleaved), // DecodeInterleavedForMultiStreamWithPerfAndResetOld
             SFUNC(0x8, IHardwareOpusDecoder, DecodeInterleaved),
+            SFUNC(0x9, IHardwareOpusDecoder, DecodeInterleaved), // DecodeInterleavedForMultiStream
         )
     };
 
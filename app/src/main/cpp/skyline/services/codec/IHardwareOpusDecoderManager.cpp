@@ -33,6 +33,24 @@ namespace skyline::service::codec {
         return {};
     }
 
+    Result IHardwareOpusDecoderManager::OpenHardwareOpusDecoderForMultiStream(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        u32 workBufferSize{request.Pop<u32>()};
+        KHandle workBuffer{request.copyHandles.at(0)};
+        const auto &parameters{request.inputBuf.at(0).as<MultiStreamParameters>()};
+
+        Logger::Debug("Creating Opus multi-stream decoder: Sample rate: {}, Channel count: {}, Stream count: {} ({} stereo), Work buffer handle: 0x{:X} (Size: 0x{:X})", parameters.sampleRate, parameters.channelCount, parameters.streamCount, parameters.stereoStreamCount, workBuffer, workBufferSize);
+
+        manager.RegisterService(std::make_shared<IHardwareOpusDecoder>(state, manager, parameters, workBufferSize, workBuffer), session, response);
+        return {};
+    }
+
+    Result IHardwareOpusDecoderManager::GetWorkBufferSizeForMultiStream(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        const auto &parameters{request.inputBuf.at(0).as<MultiStreamParameters>()};
+
+        response.Push<u32>(CalculateMultiStreamBufferSize(parameters));
+        return {};
+    }
+
     Result IHardwareOpusDecoderManager::OpenHardwareOpusDecoderEx(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
         i32 sampleRate{request.Pop<i32>()};
         i32 channelCount{request.Pop<i32>()};
@@ -56,4 +74,22 @@ namespace skyline::service::codec {
         response.Push<u32>(CalculateBufferSize(sampleRate, channelCount, useLargerFrameSize));
         return {};
     }
+
+    Result IHardwareOpusDecoderManager::OpenHardwareOpusDecoderForMultiStreamEx(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        u32 workBufferSize{request.Pop<u32>()};
+        KHandle workBuffer{request.copyHandles.at(0)};
+        const auto &parametersEx{request.inputBuf.at(0).as<MultiStreamParametersEx>()};
+
+        Logger::Debug("Creating Opus multi-stream decoder: Sample rate: {}, Channel count: {}, Stream count: {} ({} stereo), Larger frame size: {}, Work buffer handle: 0x{:X} (Size: 0x{:X})", parametersEx.sampleRate, parametersEx.channelCount, parametersEx.streamCount, parametersEx.stereoStreamCount, parametersEx.useLargerFrameSize, workBuffer, workBufferSize);
+
+        manager.RegisterService(std::make_shared<IHardwareOpusDecoder>(state, manager, parametersEx.ToParameters(), workBufferSize, workBuffer, parametersEx.useLargerFrameSize != 0), session, response);
+        return {};
+    }
+
+    Result IHardwareOpusDecoderManager::GetWorkBufferSizeForMultiStreamEx(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        const auto &parametersEx{request.inputBuf.at(0).as<MultiStreamParametersEx>()};
+
+        response.Push<u32>(CalculateMultiStreamBufferSize(parametersEx.ToParameters(), parametersEx.useLargerFrameSize != 0));
+        return {};
+    }
 }
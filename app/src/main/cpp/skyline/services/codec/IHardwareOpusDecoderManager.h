@@ -19,6 +19,24 @@ namespace skyline::service::codec {
     };
     static_assert(sizeof(MultiStreamParameters) == 0x110);
 
+    /**
+     * @brief Initialization parameters for the Opus multi-stream decoder with the option of larger frame sizes [12.0.0+]
+     */
+    struct MultiStreamParametersEx {
+        i32 sampleRate;
+        i32 channelCount;
+        i32 streamCount;
+        i32 stereoStreamCount;
+        u32 useLargerFrameSize;
+        u32 _pad0_;
+        std::array<u8, 0x100> mappings; //!< Array of channel mappings
+
+        MultiStreamParameters ToParameters() const {
+            return {sampleRate, channelCount, streamCount, stereoStreamCount, mappings};
+        }
+    };
+    static_assert(sizeof(MultiStreamParametersEx) == 0x118);
+
     /**
      * @brief Manages all instances of IHardwareOpusDecoder
      * @url https://switchbrew.org/wiki/Audio_services#hwopus
@@ -39,6 +57,18 @@ namespace skyline::service::codec {
          */
         Result GetWorkBufferSize(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
+        /**
+         * @brief Returns an IHardwareOpusDecoder object for decoding multi-stream packets
+         * @url https://switchbrew.org/wiki/Audio_services#OpenHardwareOpusDecoderForMultiStream
+         */
+        Result OpenHardwareOpusDecoderForMultiStream(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
+
+        /**
+         * @brief Returns the required size for a multi-stream decoder's work buffer
+         * @url https://switchbrew.org/wiki/Audio_services#GetWorkBufferSizeForMultiStream
+         */
+        Result GetWorkBufferSizeForMultiStream(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
+
         /**
          * @brief Returns an IHardwareOpusDecoder object [12.0.0+]
          * @url https://switchbrew.org/wiki/Audio_services#OpenHardwareOpusDecoder
@@ -51,11 +81,29 @@ namespace skyline::service::codec {
          */
         Result GetWorkBufferSizeEx(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
+        /**
+         * @brief Returns an IHardwareOpusDecoder object for decoding multi-stream packets [12.0.0+]
+         * @url https://switchbrew.org/wiki/Audio_services#OpenHardwareOpusDecoderForMultiStreamEx
+         */
+        Result OpenHardwareOpusDecoderForMultiStreamEx(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
+
+        /**
+         * @brief Returns the required size for a multi-stream decoder's work buffer [12.0.0+]
+         * @url https://switchbrew.org/wiki/Audio_services#GetWorkBufferSizeForMultiStreamEx
+         */
+        Result GetWorkBufferSizeForMultiStreamEx(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
+
         SERVICE_DECL(
             SFUNC(0x0, IHardwareOpusDecoderManager, OpenHardwareOpusDecoder),
             SFUNC(0x1, IHardwareOpusDecoderManager, GetWorkBufferSize),
+            SFUNC(0x2, IHardwareOpusDecoderManager, OpenHardwareOpusDecoderForMultiStream),
+            SFUNC(0x3, IHardwareOpusDecoderManager, GetWorkBufferSizeForMultiStream),
             SFUNC(0x4, IHardwareOpusDecoderManager, OpenHardwareOpusDecoderEx),
             SFUNC(0x5, IHardwareOpusDecoderManager, GetWorkBufferSizeEx),
+            SFUNC(0x6, IHardwareOpusDecoderManager, OpenHardwareOpusDecoderForMultiStreamEx),
+            SFUNC(0x7, IHardwareOpusDecoderManager, GetWorkBufferSizeForMultiStreamEx),
+            SFUNC(0x8, IHardwareOpusDecoderManager, GetWorkBufferSizeEx), // GetWorkBufferSizeExEx only differs in the sizes returned by HOS which our host-side decoder state doesn't depend on
+            SFUNC(0x9, IHardwareOpusDecoderManager, GetWorkBufferSizeForMultiStreamEx), // GetWorkBufferSizeForMultiStreamExEx, see above
         )
     };
 }
@@ -595,6 +595,48 @@ namespace skyline::service::hosbinder {
         return AndroidStatus::Ok;
     }
 
+    /**
+     * @brief The arguments to DequeueBuffer in the order they're in the parcel, this allows them to be read in-place at once
+     */
+    struct DequeueBufferInput {
+        u32 async;
+        u32 width;
+        u32 height;
+        AndroidPixelFormat format;
+        u32 usage;
+    };
+    static_assert(sizeof(DequeueBufferInput) == 0x14);
+
+    #pragma pack(push, 4)
+    /**
+     * @url https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/include/gui/IGraphicBufferProducer.h;l=265-315
+     * @note Nintendo has added an additional field for swap interval after the async flag
+     */
+    struct QueueBufferInput {
+        i64 timestamp;
+        u32 isAutoTimestamp;
+        AndroidRect crop;
+        NativeWindowScalingMode scalingMode;
+        NativeWindowTransform transform;
+        NativeWindowTransform stickyTransform;
+        u32 async;
+        u32 swapInterval;
+        AndroidFence fence;
+    };
+    static_assert(sizeof(QueueBufferInput) == 0x54);
+    #pragma pack(pop)
+
+    /**
+     * @url https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/include/gui/IGraphicBufferProducer.h;l=317-341
+     */
+    struct QueueBufferOutput {
+        u32 width;
+        u32 height;
+        NativeWindowTransform transformHint;
+        u32 pendingBufferCount;
+    };
+    static_assert(sizeof(QueueBufferOutput) == 0x10);
+
     void GraphicBufferProducer::OnTransact(TransactionCode code, Parcel &in, Parcel &out) {
         switch (code) {
             case TransactionCode::RequestBuffer: {
@@ -614,7 +656,8 @@ namespace skyline::service::hosbinder {
             case TransactionCode::DequeueBuffer: {
                 i32 slot{};
                 std::optional<AndroidFence> fence{};
-                auto result{DequeueBuffer(in.Pop<u32>(), in.Pop<u32>(), in.Pop<u32>(), in.Pop<AndroidPixelFormat>(), in.Pop<u32>(), slot, fence)};
+                const auto &input{in.Pop<DequeueBufferInput>()};
+                auto result{DequeueBuffer(input.async, input.width, input.height, input.format, input.usage, slot, fence)};
                 out.Push(slot);
                 out.PushOptionalFlattenable(fence);
                 out.Push(result);
@@ -646,21 +689,13 @@ namespace skyline::service::hosbinder {
             }
 
             case TransactionCode::QueueBuffer: {
-                u32 width{}, height{}, pendingBufferCount{};
-                NativeWindowTransform transformHint{};
-
-                constexpr u64 QueueBufferInputSize{0x54}; //!< The size of the QueueBufferInput structure (https://cs.android.com/android/platform/superproject/+/android-5.1.1_r38:frameworks/native/include/gui/IGraphicBufferProducer.h;l=265-315)
+                QueueBufferOutput output{};
 
                 auto slot{in.Pop<i32>()};
-                auto queueBufferInputSize{in.Pop<u64>()};
-                if (queueBufferInputSize != QueueBufferInputSize)
-                    throw exception("The size of QueueBufferInput in the Parcel (0x{:X}) doesn't match the expected size (0x{:X})", queueBufferInputSize, QueueBufferInputSize);
-                auto result{QueueBuffer(slot, in.Pop<i64>(), in.Pop<u32>(), in.Pop<AndroidRect>(), in.Pop<NativeWindowScalingMode>(), in.Pop<NativeWindowTransform>(), in.Pop<NativeWindowTransform>(), in.Pop<u32>(), in.Pop<u32>(), in.Pop<AndroidFence>(), width, height, transformHint, pendingBufferCount)};
+                const auto &input{in.PopFlattenable<QueueBufferInput>()};
+                auto result{QueueBuffer(slot, input.timestamp, input.isAutoTimestamp, input.crop, input.scalingMode, input.transform, input.stickyTransform, input.async, input.swapInterval, input.fence, output.width, output.height, output.transformHint, output.pendingBufferCount)};
 
-                out.Push(width);
-                out.Push(height);
-                out.Push(transformHint);
-                out.Push(pendingBufferCount);
+                out.Push(output);
                 out.Push(result);
                 break;
             }
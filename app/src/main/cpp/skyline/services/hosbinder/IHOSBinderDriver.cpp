@@ -20,14 +20,17 @@ namespace skyline::service::hosbinder {
 
         auto code{request.Pop<GraphicBufferProducer::TransactionCode>()};
 
-        Parcel in(request.inputBuf.at(0), state, true);
-        Parcel out(state);
+        // Both parcels are views into the IPC buffers, the output is only written in-place when it doesn't alias the input as data is read from the input while the output is being written
+        auto inputBuffer{request.inputBuf.at(0)}, outputBuffer{request.outputBuf.at(0)};
+        bool overlapping{inputBuffer.data() < outputBuffer.data() + outputBuffer.size() && outputBuffer.data() < inputBuffer.data() + inputBuffer.size()};
+        Parcel in(inputBuffer, state, true);
+        Parcel out(state, overlapping ? span<u8>{} : outputBuffer);
 
         if (!layer)
             throw exception("Transacting parcel with non-existant layer");
         layer->OnTransact(code, in, out);
 
-        out.WriteParcel(request.outputBuf.at(0));
+        out.WriteParcel(outputBuffer);
         return {};
     }
 
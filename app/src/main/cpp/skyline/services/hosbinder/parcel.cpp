@@ -7,35 +7,61 @@ namespace skyline::service::hosbinder {
     Parcel::Parcel(span<u8> buffer, const DeviceState &state, bool hasToken) : state(state) {
         header = buffer.as<ParcelHeader>();
 
-        if (buffer.size() < (sizeof(ParcelHeader) + header.dataSize + header.objectsSize))
+        if (buffer.size() < (sizeof(ParcelHeader) + header.dataSize + header.objectsSize) || static_cast<size_t>(header.dataOffset) + header.dataSize > buffer.size())
             throw exception("The size of the parcel according to the header exceeds the specified size");
 
         constexpr u8 tokenLength{0x50}; // The length of the token on BufferQueue parcels
+        size_t tokenSize{hasToken ? tokenLength : 0U};
+        if (header.dataSize < tokenSize)
+            throw exception("The size of the parcel data (0x{:X}) is smaller than the token", header.dataSize);
 
-        data.resize(header.dataSize - (hasToken ? tokenLength : 0));
-        std::memcpy(data.data(), buffer.data() + header.dataOffset + (hasToken ? tokenLength : 0), header.dataSize - (hasToken ? tokenLength : 0));
+        data = buffer.subspan(header.dataOffset + tokenSize, header.dataSize - tokenSize);
+    }
+
+    Parcel::Parcel(const DeviceState &state, span<u8> outputBuffer)
+        : state(state),
+          buffer(outputBuffer.size() > sizeof(ParcelHeader) ? outputBuffer : span<u8>{}),
+          data(buffer.valid() ? buffer.subspan(sizeof(ParcelHeader)) : span<u8>{}) {}
+
+    u8 *Parcel::PopData(size_t size) {
+        if (dataOffset + size > data.size())
+            throw exception("Popping 0x{:X} bytes at 0x{:X} from parcel with data size 0x{:X}", size, dataOffset, data.size());
 
-        objects.resize(header.objectsSize);
-        std::memcpy(objects.data(), buffer.data() + header.objectsOffset, header.objectsSize);
+        u8 *pointer{data.data() + dataOffset};
+        dataOffset += size;
+        return pointer;
     }
 
-    Parcel::Parcel(const DeviceState &state) : state(state) {}
+    u8 *Parcel::PushData(size_t size) {
+        auto offset{header.dataSize};
+        if (buffer.valid()) {
+            // The objects are placed after the data so they must also fit into the buffer
+            if (offset + size + objects.size() > data.size())
+                throw exception("The size of the parcel exceeds the size of the output buffer (0x{:X})", buffer.size());
+        } else {
+            ownedData.resize(offset + size);
+            data = span<u8>(ownedData);
+        }
+
+        header.dataSize = static_cast<u32>(offset + size);
+        return data.data() + offset;
+    }
 
-    u64 Parcel::WriteParcel(span<u8> buffer) {
-        header.dataSize = static_cast<u32>(data.size());
+    u64 Parcel::WriteParcel(span<u8> outBuffer) {
         header.dataOffset = sizeof(ParcelHeader);
 
         header.objectsSize = static_cast<u32>(objects.size());
-        header.objectsOffset = static_cast<u32>(sizeof(ParcelHeader) + data.size());
+        header.objectsOffset = static_cast<u32>(sizeof(ParcelHeader) + header.dataSize);
 
         auto totalSize{sizeof(ParcelHeader) + header.dataSize + header.objectsSize};
 
-        if (buffer.size() < totalSize)
+        if (outBuffer.size() < totalSize)
             throw exception("The size of the parcel exceeds maxSize");
 
-        buffer.as<ParcelHeader>() = header;
-        std::memcpy(buffer.data() + header.dataOffset, data.data(), data.size());
-        std::memcpy(buffer.data() + header.objectsOffset, objects.data(), objects.size());
+        outBuffer.as<ParcelHeader>() = header;
+        if (outBuffer.data() != buffer.data() || !buffer.valid())
+            std::memcpy(outBuffer.data() + header.dataOffset, data.data(), header.dataSize);
+        std::memcpy(outBuffer.data() + header.objectsOffset, objects.data(), objects.size());
 
         return totalSize;
     }
@@ -8,6 +8,7 @@
 namespace skyline::service::hosbinder {
     /**
      * @brief This allows easy access and efficient serialization of an Android Parcel object
+     * @note Parcels are views into the IPC buffer they're read from or written to whenever possible, this avoids any copies or allocations for transactions
      * @url https://switchbrew.org/wiki/Display_services#Parcel
      */
     class Parcel {
@@ -21,32 +22,47 @@ namespace skyline::service::hosbinder {
         static_assert(sizeof(ParcelHeader) == 0x10);
 
         const DeviceState &state;
+        span<u8> buffer; //!< The IPC buffer that the parcel is being written into in-place, this is empty if the data is held in ownedData
+        std::vector<u8> ownedData; //!< Backing storage for the data of parcels that aren't written in-place, these aren't created on any hot paths
+        boost::container::small_vector<u8, 0x10> objects; //!< The objects of a parcel being written, these are appended after the data when the parcel is written out
+
+        /**
+         * @return A pointer to the next item of the supplied size in the data
+         */
+        u8 *PopData(size_t size);
+
+        /**
+         * @return A pointer to the space for the next item of the supplied size at the end of the data
+         */
+        u8 *PushData(size_t size);
 
       public:
-        std::vector<u8> data;
-        std::vector<u8> objects;
+        span<u8> data; //!< The data of the parcel, it'll directly point into the IPC buffer for parcels that are read or written in-place
         size_t dataOffset{}; //!< The offset of the data read from the parcel
 
         /**
-         * @brief This constructor fills in the Parcel object with data from a IPC buffer
-         * @param buffer The buffer that contains the parcel
+         * @brief This constructor creates a view of the parcel in the supplied IPC buffer, no data is copied
+         * @param buffer The buffer that contains the parcel, it must remain valid for the lifetime of the parcel
          * @param hasToken If the parcel starts with a token, it's skipped if this flag is true
          */
         Parcel(span<u8> buffer, const DeviceState &state, bool hasToken = false);
 
         /**
          * @brief This constructor is used to create an empty parcel then write to a process
+         * @param outputBuffer If supplied, data is directly written into this buffer at the offset it'll be at in the flattened parcel, WriteParcel must be called with the same buffer
          */
-        Parcel(const DeviceState &state);
+        Parcel(const DeviceState &state, span<u8> outputBuffer = {});
+
+        Parcel(const Parcel &) = delete;
+
+        Parcel(Parcel &&) = default;
 
         /**
          * @return A reference to an item from the top of data
          */
         template<typename ValueType>
         ValueType &Pop() {
-            ValueType &value{*reinterpret_cast<ValueType *>(data.data() + dataOffset)};
-            dataOffset += sizeof(ValueType);
-            return value;
+            return *reinterpret_cast<ValueType *>(PopData(sizeof(ValueType)));
         }
 
         /**
@@ -74,9 +90,7 @@ namespace skyline::service::hosbinder {
 
         template<typename ValueType>
         void Push(const ValueType &value) {
-            auto offset{data.size()};
-            data.resize(offset + sizeof(ValueType));
-            std::memcpy(data.data() + offset, &value, sizeof(ValueType));
+            std::memcpy(PushData(sizeof(ValueType)), &value, sizeof(ValueType));
         }
 
         /**
@@ -92,7 +106,7 @@ namespace skyline::service::hosbinder {
         }
 
         template<typename ObjectType>
-        void PushOptionalFlattenable(std::optional<ObjectType> object) {
+        void PushOptionalFlattenable(const std::optional<ObjectType> &object) {
             Push<u32>(object.has_value());
             if (object) {
                 Push<i64>(sizeof(ObjectType));
@@ -108,7 +122,7 @@ namespace skyline::service::hosbinder {
         }
 
         /**
-         * @param buffer The buffer to write the flattened Parcel into
+         * @param buffer The buffer to write the flattened Parcel into, only the header and objects are written if the data was already written in-place into it
          * @return The total size of the Parcel
          */
         u64 WriteParcel(span<u8> buffer);
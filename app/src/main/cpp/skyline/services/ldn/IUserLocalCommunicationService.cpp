@@ -6,11 +6,59 @@
 namespace skyline::service::ldn {
     IUserLocalCommunicationService::IUserLocalCommunicationService(const DeviceState &state, ServiceManager &manager)
         : BaseService(state, manager),
-          event{std::make_shared<type::KEvent>(state, false)} {}
+          event{std::make_shared<type::KEvent>(state, false)},
+          lanDiscovery{state, event} {}
 
     Result IUserLocalCommunicationService::GetState(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        static constexpr u32 StateNone{0x0};
-        response.Push<u32>(StateNone);
+        response.Push(lanDiscovery.GetState());
+        return {};
+    }
+
+    Result IUserLocalCommunicationService::GetNetworkInfo(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.GetNetworkInfo(request.outputBuf.at(0).as<NetworkInfo>());
+    }
+
+    Result IUserLocalCommunicationService::GetIpv4Address(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        u32 address{}, subnetMask{};
+        auto result{lanDiscovery.GetIpv4Address(address, subnetMask)};
+        if (result)
+            return result;
+
+        response.Push(address);
+        response.Push(subnetMask);
+        return {};
+    }
+
+    Result IUserLocalCommunicationService::GetDisconnectReason(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        response.Push(lanDiscovery.GetDisconnectReason());
+        return {};
+    }
+
+    Result IUserLocalCommunicationService::GetSecurityParameter(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        NetworkInfo info{};
+        auto result{lanDiscovery.GetNetworkInfo(info)};
+        if (result)
+            return result;
+
+        response.Push(SecurityParameter{
+            .data = info.ldn.securityParameter,
+            .sessionId = info.networkId.sessionId,
+        });
+        return {};
+    }
+
+    Result IUserLocalCommunicationService::GetNetworkConfig(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        NetworkInfo info{};
+        auto result{lanDiscovery.GetNetworkInfo(info)};
+        if (result)
+            return result;
+
+        response.Push(NetworkConfig{
+            .intentId = info.networkId.intentId,
+            .channel = static_cast<u16>(info.common.channel),
+            .nodeCountMax = info.ldn.nodeCountMax,
+            .localCommunicationVersion = info.ldn.nodes[0].localCommunicationVersion,
+        });
         return {};
     }
 
@@ -21,15 +69,75 @@ namespace skyline::service::ldn {
         return {};
     }
 
+    Result IUserLocalCommunicationService::GetNetworkInfoLatestUpdate(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.GetNetworkInfoLatestUpdate(request.outputBuf.at(0).as<NetworkInfo>(), request.outputBuf.at(1).cast<NodeLatestUpdate>());
+    }
+
+    Result IUserLocalCommunicationService::Scan(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        request.Pop<u16>(); // Channel, this is irrelevant as there's no radio
+        request.Skip<std::array<u8, 6>>();
+        const auto &filter{request.Pop<ScanFilter>()};
+
+        u32 count{};
+        auto result{lanDiscovery.Scan(request.outputBuf.at(0).cast<NetworkInfo>(), filter, count)};
+        if (result)
+            return result;
+
+        response.Push(count);
+        return {};
+    }
+
+    Result IUserLocalCommunicationService::OpenAccessPoint(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.OpenAccessPoint();
+    }
+
+    Result IUserLocalCommunicationService::CloseAccessPoint(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.CloseAccessPoint();
+    }
+
+    Result IUserLocalCommunicationService::CreateNetwork(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.CreateNetwork(request.Pop<CreateNetworkConfig>());
+    }
+
+    Result IUserLocalCommunicationService::DestroyNetwork(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.DestroyNetwork();
+    }
+
+    Result IUserLocalCommunicationService::SetAdvertiseData(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.SetAdvertiseData(request.inputBuf.at(0));
+    }
+
+    Result IUserLocalCommunicationService::SetStationAcceptPolicy(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.SetStationAcceptPolicy(request.Pop<AcceptPolicy>());
+    }
+
+    Result IUserLocalCommunicationService::OpenStation(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.OpenStation();
+    }
+
+    Result IUserLocalCommunicationService::CloseStation(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.CloseStation();
+    }
+
+    Result IUserLocalCommunicationService::Connect(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        const auto &data{request.Pop<ConnectNetworkData>()};
+        return lanDiscovery.Connect(request.inputBuf.at(0).as<NetworkInfo>(), data);
+    }
+
+    Result IUserLocalCommunicationService::Disconnect(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        return lanDiscovery.Disconnect();
+    }
+
     Result IUserLocalCommunicationService::InitializeSystem(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        return result::DeviceDisabled;
+        return lanDiscovery.Initialize();
     }
 
     Result IUserLocalCommunicationService::FinalizeSystem(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        lanDiscovery.Finalize();
         return {};
     }
 
     Result IUserLocalCommunicationService::InitializeSystem2(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        return result::DeviceDisabled;
+        return lanDiscovery.Initialize();
     }
 }
@@ -0,0 +1,496 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <common/settings.h>
+#include <common/trace.h>
+#include <kernel/scheduler.h>
+#include "lan_discovery.h"
+
+namespace skyline::service::ldn {
+    LanDiscovery::LanDiscovery(const DeviceState &state, std::shared_ptr<kernel::type::KEvent> stateChangeEvent, TransportFactory transportFactory) : state{state}, stateChangeEvent{std::move(stateChangeEvent)}, transportFactory{std::move(transportFactory)} {
+        util::FillRandomBytes(std::span<u8>{macAddress});
+        macAddress[0] = (macAddress[0] & ~0x1) | 0x2; // A unicast locally administered address, this cannot collide with any real hardware
+    }
+
+    LanDiscovery::~LanDiscovery() {
+        Finalize();
+    }
+
+    void LanDiscovery::SetState(State newState) {
+        ldnState = newState;
+        stateChangeEvent->Signal();
+    }
+
+    void LanDiscovery::SyncNetwork() {
+        std::array<Transport::Endpoint, NodeCountMax> endpoints;
+        size_t count{};
+        for (const auto &endpoint : stationEndpoints)
+            if (endpoint)
+                endpoints[count++] = *endpoint;
+
+        transport->Send(span(endpoints).first(count), PacketType::SyncNetwork, span(networkInfo).cast<u8>());
+        stateChangeEvent->Signal();
+    }
+
+    void LanDiscovery::UpdateNodeChanges(const NetworkInfo &newInfo) {
+        for (size_t i{}; i < NodeCountMax; i++) {
+            const auto &oldNode{networkInfo.ldn.nodes[i]};
+            const auto &newNode{newInfo.ldn.nodes[i]};
+            auto &change{nodeChanges[i].stateChange};
+
+            if (oldNode.isConnected && !newNode.isConnected) {
+                change = NodeStateChange::Disconnect;
+            } else if (!oldNode.isConnected && newNode.isConnected) {
+                change = change == NodeStateChange::Disconnect ? NodeStateChange::DisconnectAndConnect : NodeStateChange::Connect;
+            } else if (oldNode.isConnected && newNode.macAddress != oldNode.macAddress) {
+                change = NodeStateChange::DisconnectAndConnect; // The node was replaced between two updates
+            }
+        }
+    }
+
+    void LanDiscovery::DisconnectStations(bool notify) {
+        std::array<Transport::Endpoint, NodeCountMax> endpoints;
+        size_t count{};
+        for (size_t i{1}; i < NodeCountMax; i++) {
+            if (auto &endpoint{stationEndpoints[i]}) {
+                endpoints[count++] = *endpoint;
+                endpoint.reset();
+                networkInfo.ldn.nodes[i] = {};
+                nodeChanges[i].stateChange = NodeStateChange::Disconnect;
+            }
+        }
+        networkInfo.ldn.nodeCount = networkInfo.ldn.nodes[0].isConnected ? 1 : 0;
+
+        if (notify)
+            transport->Send(span(endpoints).first(count), PacketType::Disconnect, {});
+    }
+
+    NodeInfo LanDiscovery::MakeLocalNode(const UserConfig &userConfig, i16 localCommunicationVersion) {
+        NodeInfo node{
+            .ipv4Address = transport->GetLocalAddress(),
+            .macAddress = macAddress,
+            .isConnected = true,
+            .localCommunicationVersion = localCommunicationVersion,
+        };
+        std::copy(userConfig.userName.begin(), std::prev(userConfig.userName.end()), node.userName.begin()); // The last byte is left as a null terminator
+        return node;
+    }
+
+    void LanDiscovery::OnPacket(const Transport::Endpoint &source, PacketType type, span<u8> payload) {
+        TRACE_EVENT("service", "LanDiscovery::OnPacket", "Type", static_cast<u8>(type));
+        std::scoped_lock lock{mutex};
+
+        switch (type) {
+            case PacketType::Scan: {
+                if (ldnState == State::AccessPointCreated)
+                    transport->Send(span<const Transport::Endpoint>{source}, PacketType::ScanResponse, span(networkInfo).cast<u8>());
+                break;
+            }
+
+            case PacketType::ScanResponse: {
+                if (!scanning || payload.size() != sizeof(NetworkInfo))
+                    break;
+
+                const auto &info{payload.as<NetworkInfo>()};
+                auto it{std::find_if(scanResults.begin(), scanResults.end(), [&](const auto &result) { return result.second == source; })};
+                if (it != scanResults.end())
+                    *it = {info, source};
+                else if (scanResults.size() < ScanResultCountMax)
+                    scanResults.emplace_back(info, source);
+                break;
+            }
+
+            case PacketType::Connect: {
+                if (ldnState != State::AccessPointCreated || payload.size() != sizeof(NodeInfo))
+                    break;
+
+                auto &ldn{networkInfo.ldn};
+                auto existing{std::find(stationEndpoints.begin(), stationEndpoints.end(), source)};
+                size_t nodeId{};
+                if (existing != stationEndpoints.end()) {
+                    nodeId = static_cast<size_t>(std::distance(stationEndpoints.begin(), existing)); // The station retried its connection, we just resend the network state
+                } else if (ldn.stationAcceptPolicy != AcceptPolicy::RejectAll && ldn.nodeCount < ldn.nodeCountMax) {
+                    for (nodeId = 1; nodeId < NodeCountMax && ldn.nodes[nodeId].isConnected; nodeId++);
+                }
+
+                if (nodeId == 0 || nodeId >= ldn.nodeCountMax) {
+                    transport->Send(span<const Transport::Endpoint>{source}, PacketType::Disconnect, {});
+                    break;
+                }
+
+                if (existing == stationEndpoints.end()) {
+                    auto &node{ldn.nodes[nodeId]};
+                    node = payload.as<NodeInfo>();
+                    node.nodeId = static_cast<i8>(nodeId);
+                    node.isConnected = true;
+                    ldn.nodeCount++;
+                    stationEndpoints[nodeId] = source;
+                    nodeChanges[nodeId].stateChange = NodeStateChange::Connect;
+                    Logger::Info("LDN station connected as node {}", nodeId);
+                }
+
+                SyncNetwork();
+                break;
+            }
+
+            case PacketType::SyncNetwork: {
+                if (source != accessPointEndpoint || payload.size() != sizeof(NetworkInfo))
+                    break;
+
+                if (connecting) {
+                    connecting = false;
+                    networkInfo = {};
+                    ldnState = State::StationConnected;
+                    connectCondition.notify_all();
+                } else if (ldnState != State::StationConnected) {
+                    break;
+                }
+
+                const auto &info{payload.as<NetworkInfo>()};
+                UpdateNodeChanges(info);
+                networkInfo = info;
+                stateChangeEvent->Signal();
+                break;
+            }
+
+            case PacketType::Disconnect: {
+                if (ldnState == State::AccessPointCreated) {
+                    auto it{std::find(stationEndpoints.begin(), stationEndpoints.end(), source)};
+                    if (it == stationEndpoints.end())
+                        break;
+
+                    auto nodeId{static_cast<size_t>(std::distance(stationEndpoints.begin(), it))};
+                    it->reset();
+                    networkInfo.ldn.nodes[nodeId] = {};
+                    networkInfo.ldn.nodeCount--;
+                    nodeChanges[nodeId].stateChange = NodeStateChange::Disconnect;
+                    Logger::Info("LDN station disconnected from node {}", nodeId);
+                    SyncNetwork();
+                } else if (source == accessPointEndpoint && (connecting || ldnState == State::StationConnected)) {
+                    disconnectReason = connecting ? DisconnectReason::Rejected : DisconnectReason::DestroyedByUser;
+                    connecting = false;
+                    accessPointEndpoint.reset();
+                    connectCondition.notify_all();
+                    SetState(State::StationOpened);
+                }
+                break;
+            }
+
+            default:
+                Logger::Warn("Unknown LDN packet type: {}", static_cast<u8>(type));
+                break;
+        }
+    }
+
+    Result LanDiscovery::Initialize() {
+        if (!*state.settings->internetEnabled)
+            return result::DeviceDisabled;
+
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::None)
+            return result::InvalidState;
+
+        try {
+            Transport::ReceiveCallback callback{[this](const Transport::Endpoint &source, PacketType type, span<u8> payload) {
+                OnPacket(source, type, payload);
+            }};
+            transport = transportFactory ? transportFactory(std::move(callback)) : std::make_unique<UdpTransport>(std::move(callback));
+        } catch (const std::exception &e) {
+            Logger::Warn("{}", e.what());
+            return result::DeviceDisabled;
+        }
+
+        disconnectReason = DisconnectReason::None;
+        SetState(State::Initialized);
+        return {};
+    }
+
+    void LanDiscovery::Finalize() {
+        std::unique_ptr<Transport> oldTransport;
+        {
+            std::scoped_lock lock{mutex};
+            if (ldnState == State::None)
+                return;
+
+            if (ldnState == State::AccessPointCreated)
+                DisconnectStations(true);
+            else if (accessPointEndpoint)
+                transport->Send(span<const Transport::Endpoint>{*accessPointEndpoint}, PacketType::Disconnect, {});
+
+            accessPointEndpoint.reset();
+            connecting = false;
+            scanning = false;
+            scanResults.clear();
+            networkInfo = {};
+            nodeChanges = {};
+            SetState(State::None);
+
+            oldTransport = std::move(transport);
+        }
+        // The transport must be destroyed without the mutex held as its thread may be waiting on it to dispatch a packet
+    }
+
+    State LanDiscovery::GetState() {
+        std::scoped_lock lock{mutex};
+        return ldnState;
+    }
+
+    DisconnectReason LanDiscovery::GetDisconnectReason() {
+        std::scoped_lock lock{mutex};
+        return disconnectReason;
+    }
+
+    Result LanDiscovery::GetIpv4Address(u32 &address, u32 &subnetMask) {
+        std::scoped_lock lock{mutex};
+        if (!transport)
+            return result::NoIpAddress;
+
+        address = transport->GetLocalAddress();
+        subnetMask = transport->GetSubnetMask();
+        return {};
+    }
+
+    Result LanDiscovery::GetNetworkInfo(NetworkInfo &info) {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::AccessPointCreated && ldnState != State::StationConnected)
+            return result::InvalidState;
+
+        info = networkInfo;
+        return {};
+    }
+
+    Result LanDiscovery::GetNetworkInfoLatestUpdate(NetworkInfo &info, span<NodeLatestUpdate> updates) {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::AccessPointCreated && ldnState != State::StationConnected)
+            return result::InvalidState;
+
+        info = networkInfo;
+        updates.copy_from(span(nodeChanges).first(std::min(updates.size(), nodeChanges.size())));
+        nodeChanges = {};
+        return {};
+    }
+
+    Result LanDiscovery::Scan(span<NetworkInfo> networks, const ScanFilter &filter, u32 &count) {
+        TRACE_EVENT("service", "LanDiscovery::Scan");
+        {
+            std::scoped_lock lock{mutex};
+            if (ldnState == State::None || ldnState == State::Initialized || ldnState == State::Error)
+                return result::InvalidState;
+
+            scanResults.clear();
+            scanning = true;
+            transport->Broadcast(PacketType::Scan, {});
+        }
+
+        {
+            kernel::SchedulerScopedLock schedulerLock{state};
+            std::this_thread::sleep_for(ScanTimeout);
+        }
+
+        std::scoped_lock lock{mutex};
+        scanning = false;
+
+        auto matches{[&](const NetworkInfo &info) {
+            if ((filter.flag & static_cast<u32>(ScanFilterFlag::LocalCommunicationId)) && info.networkId.intentId.localCommunicationId != filter.networkId.intentId.localCommunicationId)
+                return false;
+            if ((filter.flag & static_cast<u32>(ScanFilterFlag::SceneId)) && info.networkId.intentId.sceneId != filter.networkId.intentId.sceneId)
+                return false;
+            if ((filter.flag & static_cast<u32>(ScanFilterFlag::SessionId)) && info.networkId.sessionId != filter.networkId.sessionId)
+                return false;
+            if ((filter.flag & static_cast<u32>(ScanFilterFlag::NetworkType)) && info.common.networkType != filter.networkType)
+                return false;
+            if ((filter.flag & static_cast<u32>(ScanFilterFlag::Ssid)) && info.common.ssid.View() != filter.ssid.View())
+                return false;
+            return true;
+        }};
+
+        count = 0;
+        for (const auto &[info, endpoint] : scanResults)
+            if (count < networks.size() && matches(info))
+                networks[count++] = info;
+        return {};
+    }
+
+    Result LanDiscovery::OpenAccessPoint() {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::Initialized)
+            return result::InvalidState;
+
+        networkInfo = {};
+        SetState(State::AccessPointOpened);
+        return {};
+    }
+
+    Result LanDiscovery::CloseAccessPoint() {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::AccessPointOpened && ldnState != State::AccessPointCreated)
+            return result::InvalidState;
+
+        if (ldnState == State::AccessPointCreated)
+            DisconnectStations(true);
+        networkInfo = {};
+        nodeChanges = {};
+        SetState(State::Initialized);
+        return {};
+    }
+
+    Result LanDiscovery::CreateNetwork(const CreateNetworkConfig &config) {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::AccessPointOpened)
+            return result::InvalidState;
+
+        const auto &networkConfig{config.networkConfig};
+        if (networkConfig.nodeCountMax == 0 || networkConfig.nodeCountMax > NodeCountMax)
+            return result::InvalidNodeCount;
+
+        // The advertise data might have been set prior to the network being created, it's the only state carried over
+        auto advertiseDataSize{networkInfo.ldn.advertiseDataSize};
+        auto advertiseData{networkInfo.ldn.advertiseData};
+        networkInfo = {};
+
+        networkInfo.networkId.intentId = networkConfig.intentId;
+        util::FillRandomBytes(networkInfo.networkId.sessionId);
+
+        auto &common{networkInfo.common};
+        common.bssid = macAddress;
+        auto ssid{fmt::format("{:016X}", networkInfo.networkId.sessionId.low)};
+        common.ssid.length = static_cast<u8>(ssid.size());
+        std::copy(ssid.begin(), ssid.end(), common.ssid.raw.begin());
+        common.channel = static_cast<i16>(networkConfig.channel ? networkConfig.channel : DefaultChannel);
+        common.linkLevel = 3;
+        common.networkType = 2;
+
+        auto &ldn{networkInfo.ldn};
+        util::FillRandomBytes(std::span<u8>{ldn.securityParameter});
+        ldn.securityMode = config.securityConfig.securityMode;
+        ldn.stationAcceptPolicy = AcceptPolicy::AcceptAll;
+        ldn.nodeCountMax = networkConfig.nodeCountMax;
+        ldn.nodeCount = 1;
+        ldn.nodes[0] = MakeLocalNode(config.userConfig, networkConfig.localCommunicationVersion);
+        ldn.advertiseDataSize = advertiseDataSize;
+        ldn.advertiseData = advertiseData;
+        ldn.randomAuthenticationId = util::RandomNumber<u64>(0, std::numeric_limits<u64>::max());
+
+        nodeChanges = {};
+        nodeChanges[0].stateChange = NodeStateChange::Connect;
+        SetState(State::AccessPointCreated);
+        return {};
+    }
+
+    Result LanDiscovery::DestroyNetwork() {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::AccessPointCreated)
+            return result::InvalidState;
+
+        DisconnectStations(true);
+        networkInfo = {};
+        nodeChanges = {};
+        SetState(State::AccessPointOpened);
+        return {};
+    }
+
+    Result LanDiscovery::SetAdvertiseData(span<const u8> data) {
+        std::scoped_lock lock{mutex};
+        if (data.size() > AdvertiseDataSizeMax)
+            return result::AdvertiseDataTooLarge;
+        if (ldnState != State::AccessPointOpened && ldnState != State::AccessPointCreated)
+            return result::InvalidState;
+
+        auto &ldn{networkInfo.ldn};
+        ldn.advertiseData = {};
+        span(ldn.advertiseData).copy_from(data);
+        ldn.advertiseDataSize = static_cast<u16>(data.size());
+
+        if (ldnState == State::AccessPointCreated)
+            SyncNetwork();
+        return {};
+    }
+
+    Result LanDiscovery::SetStationAcceptPolicy(AcceptPolicy policy) {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::AccessPointOpened && ldnState != State::AccessPointCreated)
+            return result::InvalidState;
+
+        networkInfo.ldn.stationAcceptPolicy = policy;
+        return {};
+    }
+
+    Result LanDiscovery::OpenStation() {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::Initialized)
+            return result::InvalidState;
+
+        networkInfo = {};
+        disconnectReason = DisconnectReason::None;
+        SetState(State::StationOpened);
+        return {};
+    }
+
+    Result LanDiscovery::CloseStation() {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::StationOpened && ldnState != State::StationConnected)
+            return result::InvalidState;
+
+        if (accessPointEndpoint)
+            transport->Send(span<const Transport::Endpoint>{*accessPointEndpoint}, PacketType::Disconnect, {});
+        accessPointEndpoint.reset();
+        connecting = false;
+        networkInfo = {};
+        nodeChanges = {};
+        SetState(State::Initialized);
+        return {};
+    }
+
+    Result LanDiscovery::Connect(const NetworkInfo &info, const ConnectNetworkData &data) {
+        TRACE_EVENT("service", "LanDiscovery::Connect");
+        {
+            std::scoped_lock lock{mutex};
+            if (ldnState != State::StationOpened || connecting)
+                return result::InvalidState;
+
+            auto it{std::find_if(scanResults.begin(), scanResults.end(), [&](const auto &result) { return result.first.networkId.sessionId == info.networkId.sessionId; })};
+            if (it == scanResults.end())
+                return result::ConnectionFailed;
+
+            if (it->first.ldn.nodeCount >= it->first.ldn.nodeCountMax)
+                return result::MaximumNodeCount;
+
+            accessPointEndpoint = it->second;
+            connecting = true;
+            disconnectReason = DisconnectReason::None;
+
+            auto node{MakeLocalNode(data.userConfig, static_cast<i16>(data.localCommunicationVersion))};
+            transport->Send(span<const Transport::Endpoint>{*accessPointEndpoint}, PacketType::Connect, span(node).cast<u8>());
+        }
+
+        kernel::SchedulerScopedLock schedulerLock{state};
+        std::unique_lock lock{mutex};
+        connectCondition.wait_for(lock, ConnectTimeout, [this] { return !connecting; });
+
+        if (ldnState == State::StationConnected) {
+            SetState(State::StationConnected);
+            return {};
+        }
+
+        if (connecting) {
+            // The access point didn't respond in time, a late response is ignored as the endpoint is reset
+            connecting = false;
+            accessPointEndpoint.reset();
+        }
+        return result::ConnectionFailed;
+    }
+
+    Result LanDiscovery::Disconnect() {
+        std::scoped_lock lock{mutex};
+        if (ldnState != State::StationConnected)
+            return result::InvalidState;
+
+        transport->Send(span<const Transport::Endpoint>{*accessPointEndpoint}, PacketType::Disconnect, {});
+        accessPointEndpoint.reset();
+        networkInfo = {};
+        nodeChanges = {};
+        disconnectReason = DisconnectReason::DisconnectedByUser;
+        SetState(State::StationOpened);
+        return {};
+    }
+}
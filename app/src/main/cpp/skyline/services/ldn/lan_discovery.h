@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <kernel/types/KEvent.h>
+#include "ldn_types.h"
+#include "lan_transport.h"
+
+namespace skyline::service::ldn {
+    /**
+     * @brief LanDiscovery emulates an LDN network on top of a Transport, access points and stations are emulator instances which can reach each other on the host's network
+     * @note Only the network membership is emulated here, guests communicate with each other using BSD sockets on the host IPv4 addresses of the nodes
+     */
+    class LanDiscovery {
+      private:
+        static constexpr std::chrono::milliseconds ScanTimeout{100}; //!< The duration a scan waits for access points to respond
+        static constexpr std::chrono::seconds ConnectTimeout{1}; //!< The duration a connection attempt waits for the access point to accept it
+        static constexpr u16 DefaultChannel{6};
+
+        const DeviceState &state;
+        std::shared_ptr<kernel::type::KEvent> stateChangeEvent;
+        std::unique_ptr<Transport> transport;
+        std::mutex mutex; //!< Synchronizes all network state between the guest and the transport thread
+        std::condition_variable connectCondition; //!< Signalled when a pending connection attempt has been accepted or rejected
+
+        State ldnState{State::None};
+        DisconnectReason disconnectReason{DisconnectReason::None};
+        MacAddress macAddress; //!< A random locally administered MAC address which identifies this instance in a network
+        NetworkInfo networkInfo{}; //!< The network we're hosting or connected to, it's also used to stage advertise data prior to creating a network
+        std::array<NodeLatestUpdate, NodeCountMax> nodeChanges{}; //!< The node changes since the guest last retrieved them
+        std::array<std::optional<Transport::Endpoint>, NodeCountMax> stationEndpoints{}; //!< The endpoints of the stations connected to the access point, indexed by node ID
+        std::optional<Transport::Endpoint> accessPointEndpoint; //!< The endpoint of the access point we're connecting or connected to
+        bool connecting{}; //!< If there's a pending connection attempt to the access point
+        bool scanning{}; //!< If scan responses should be collected
+        std::vector<std::pair<NetworkInfo, Transport::Endpoint>> scanResults;
+
+        /**
+         * @brief Transitions to the supplied state and signals the state change event
+         * @note The mutex must be locked when calling this
+         */
+        void SetState(State newState);
+
+        /**
+         * @brief Sends the current network state to all stations and signals the state change event
+         * @note The mutex must be locked when calling this
+         */
+        void SyncNetwork();
+
+        /**
+         * @brief Updates the node changes based on the difference in connected nodes between the current and supplied network
+         * @note The mutex must be locked when calling this
+         */
+        void UpdateNodeChanges(const NetworkInfo &newInfo);
+
+        /**
+         * @brief Removes all stations from the network, they're sent a disconnect packet if requested
+         * @note The mutex must be locked when calling this
+         */
+        void DisconnectStations(bool notify);
+
+        /**
+         * @return The NodeInfo describing this instance with the supplied user
+         */
+        NodeInfo MakeLocalNode(const UserConfig &userConfig, i16 localCommunicationVersion);
+
+        void OnPacket(const Transport::Endpoint &source, PacketType type, span<u8> payload);
+
+      public:
+        /**
+         * @brief A function which creates the transport that packets are exchanged over when the discovery is initialized
+         */
+        using TransportFactory = std::function<std::unique_ptr<Transport>(Transport::ReceiveCallback callback)>;
+
+      private:
+        TransportFactory transportFactory;
+
+      public:
+        /**
+         * @param transportFactory The factory for the transport, a UdpTransport on the host network is used if this is empty
+         */
+        LanDiscovery(const DeviceState &state, std::shared_ptr<kernel::type::KEvent> stateChangeEvent, TransportFactory transportFactory = {});
+
+        ~LanDiscovery();
+
+        /**
+         * @brief Creates the transport and transitions to the initialized state
+         */
+        Result Initialize();
+
+        /**
+         * @brief Leaves any network and destroys the transport
+         */
+        void Finalize();
+
+        State GetState();
+
+        DisconnectReason GetDisconnectReason();
+
+        /**
+         * @return The local IPv4 address and subnet mask, in host byte order
+         */
+        Result GetIpv4Address(u32 &address, u32 &subnetMask);
+
+        Result GetNetworkInfo(NetworkInfo &info);
+
+        /**
+         * @brief Retrieves the current network and the node changes since the last call, the node changes are cleared after this
+         */
+        Result GetNetworkInfoLatestUpdate(NetworkInfo &info, span<NodeLatestUpdate> updates);
+
+        /**
+         * @brief Scans for access points matching the supplied filter
+         * @return The amount of networks written to the supplied span
+         * @note The calling guest thread is descheduled for the duration of the scan
+         */
+        Result Scan(span<NetworkInfo> networks, const ScanFilter &filter, u32 &count);
+
+        Result OpenAccessPoint();
+
+        Result CloseAccessPoint();
+
+        Result CreateNetwork(const CreateNetworkConfig &config);
+
+        Result DestroyNetwork();
+
+        Result SetAdvertiseData(span<const u8> data);
+
+        Result SetStationAcceptPolicy(AcceptPolicy policy);
+
+        Result OpenStation();
+
+        Result CloseStation();
+
+        /**
+         * @brief Connects to an access point found by a prior scan
+         * @note The calling guest thread is descheduled while waiting for the access point to respond
+         */
+        Result Connect(const NetworkInfo &info, const ConnectNetworkData &data);
+
+        Result Disconnect();
+    };
+}
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <common/trace.h>
+#include "lan_transport.h"
+
+namespace skyline::service::ldn {
+    static sockaddr_in ToSockAddr(const Transport::Endpoint &endpoint) {
+        return sockaddr_in{
+            .sin_family = AF_INET,
+            .sin_port = htons(endpoint.port),
+            .sin_addr = {.s_addr = htonl(endpoint.address)},
+        };
+    }
+
+    UdpTransport::UdpTransport(ReceiveCallback callback)
+        : callback{std::move(callback)},
+          discoverySocket{socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)},
+          unicastSocket{socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)},
+          wakeFd{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)} {
+        if (discoverySocket == -1 || unicastSocket == -1 || wakeFd == -1)
+            throw exception("Failed to create the LDN transport: {}", strerror(errno));
+
+        FindInterface();
+
+        // Broadcast datagrams are delivered to every socket bound to the discovery port as long as all of them have SO_REUSEADDR set
+        int enable{1};
+        if (setsockopt(discoverySocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == -1)
+            throw exception("Failed to set SO_REUSEADDR on the LDN discovery socket: {}", strerror(errno));
+
+        auto discoveryAddress{ToSockAddr({INADDR_ANY, DiscoveryPort})};
+        if (bind(discoverySocket, reinterpret_cast<sockaddr *>(&discoveryAddress), sizeof(discoveryAddress)) == -1)
+            throw exception("Failed to bind the LDN discovery socket: {}", strerror(errno));
+
+        if (setsockopt(unicastSocket, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable)) == -1)
+            throw exception("Failed to set SO_BROADCAST on the LDN unicast socket: {}", strerror(errno));
+
+        auto unicastAddress{ToSockAddr({INADDR_ANY, 0})};
+        socklen_t unicastAddressLength{sizeof(unicastAddress)};
+        if (bind(unicastSocket, reinterpret_cast<sockaddr *>(&unicastAddress), sizeof(unicastAddress)) == -1 || getsockname(unicastSocket, reinterpret_cast<sockaddr *>(&unicastAddress), &unicastAddressLength) == -1)
+            throw exception("Failed to bind the LDN unicast socket: {}", strerror(errno));
+        localPort = ntohs(unicastAddress.sin_port);
+
+        Logger::Info("LDN transport on {}.{}.{}.{}:{}", localAddress >> 24, (localAddress >> 16) & 0xFF, (localAddress >> 8) & 0xFF, localAddress & 0xFF, localPort);
+
+        thread = std::thread(&UdpTransport::Run, this);
+    }
+
+    UdpTransport::~UdpTransport() {
+        exiting = true;
+        eventfd_write(wakeFd, 1);
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void UdpTransport::FindInterface() {
+        localAddress = INADDR_LOOPBACK;
+        subnetMask = IN_CLASSA_NET;
+
+        ifaddrs *interfaces{};
+        if (getifaddrs(&interfaces) == -1) {
+            Logger::Warn("Failed to enumerate network interfaces, falling back to loopback: {}", strerror(errno));
+        } else {
+            for (auto interface{interfaces}; interface; interface = interface->ifa_next) {
+                if (!interface->ifa_addr || interface->ifa_addr->sa_family != AF_INET || !interface->ifa_netmask)
+                    continue;
+                if (!(interface->ifa_flags & IFF_UP) || (interface->ifa_flags & IFF_LOOPBACK))
+                    continue;
+
+                localAddress = ntohl(reinterpret_cast<sockaddr_in *>(interface->ifa_addr)->sin_addr.s_addr);
+                subnetMask = ntohl(reinterpret_cast<sockaddr_in *>(interface->ifa_netmask)->sin_addr.s_addr);
+                break;
+            }
+            freeifaddrs(interfaces);
+        }
+
+        broadcastAddress = localAddress | ~subnetMask;
+    }
+
+    void UdpTransport::Drain(int socket) {
+        std::array<std::array<u8, DatagramSizeMax>, ReceiveBatchSize> buffers;
+        std::array<sockaddr_in, ReceiveBatchSize> addresses;
+        std::array<iovec, ReceiveBatchSize> iovecs;
+        std::array<mmsghdr, ReceiveBatchSize> messages;
+
+        while (true) {
+            for (size_t i{}; i < ReceiveBatchSize; i++) {
+                iovecs[i] = iovec{buffers[i].data(), buffers[i].size()};
+                messages[i] = mmsghdr{.msg_hdr = {
+                    .msg_name = &addresses[i],
+                    .msg_namelen = sizeof(sockaddr_in),
+                    .msg_iov = &iovecs[i],
+                    .msg_iovlen = 1,
+                }};
+            }
+
+            int count{recvmmsg(socket, messages.data(), static_cast<unsigned int>(messages.size()), MSG_DONTWAIT, nullptr)};
+            if (count == -1) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    Logger::Warn("Failed to receive LDN packets: {}", strerror(errno));
+                return;
+            }
+
+            TRACE_EVENT("service", "UdpTransport::Drain", "Count", count);
+            for (size_t i{}; i < static_cast<size_t>(count); i++) {
+                Endpoint source{ntohl(addresses[i].sin_addr.s_addr), ntohs(addresses[i].sin_port)};
+                if (source.address == localAddress && source.port == localPort)
+                    continue; // Our own broadcasts are looped back to us
+
+                span<u8> datagram{buffers[i].data(), messages[i].msg_len};
+                if (datagram.size() < sizeof(PacketHeader))
+                    continue;
+
+                auto &header{datagram.as<PacketHeader>()};
+                if (header.magic != PacketMagic || header.size != datagram.size() - sizeof(PacketHeader))
+                    continue;
+
+                callback(source, header.type, datagram.subspan(sizeof(PacketHeader)));
+            }
+
+            if (static_cast<size_t>(count) != ReceiveBatchSize)
+                return;
+        }
+    }
+
+    void UdpTransport::Run() {
+        if (int result{pthread_setname_np(pthread_self(), "Sky-LdnUdp")})
+            Logger::Warn("Failed to set the thread name: {}", strerror(result));
+
+        try {
+            std::array<pollfd, 3> fds{
+                pollfd{.fd = discoverySocket, .events = POLLIN},
+                pollfd{.fd = unicastSocket, .events = POLLIN},
+                pollfd{.fd = wakeFd, .events = POLLIN},
+            };
+
+            while (!exiting) {
+                if (poll(fds.data(), fds.size(), -1) == -1) {
+                    if (errno == EINTR)
+                        continue;
+                    throw exception("poll failed: {}", strerror(errno));
+                }
+
+                if (fds[0].revents)
+                    Drain(discoverySocket);
+                if (fds[1].revents)
+                    Drain(unicastSocket);
+            }
+        } catch (const std::exception &e) {
+            Logger::Error("{}", e.what());
+        }
+    }
+
+    void UdpTransport::Broadcast(PacketType type, span<const u8> payload) {
+        Endpoint destination{broadcastAddress, DiscoveryPort};
+        Send(span<const Endpoint>{destination}, type, payload);
+    }
+
+    void UdpTransport::Send(span<const Endpoint> destinations, PacketType type, span<const u8> payload) {
+        if (destinations.empty())
+            return;
+        if (sizeof(PacketHeader) + payload.size() > DatagramSizeMax)
+            throw exception("LDN packet payload is too large: 0x{:X}", payload.size());
+
+        PacketHeader header{
+            .magic = PacketMagic,
+            .type = type,
+            .size = static_cast<u16>(payload.size()),
+        };
+        std::array<iovec, 2> iovecs{
+            iovec{&header, sizeof(header)},
+            iovec{const_cast<u8 *>(payload.data()), payload.size()},
+        };
+
+        // All destinations share the same header and payload, only the address differs between messages
+        std::array<sockaddr_in, SendBatchSize> addresses;
+        std::array<mmsghdr, SendBatchSize> messages;
+        while (!destinations.empty()) {
+            auto batch{destinations.first(std::min(destinations.size(), addresses.size()))};
+            for (size_t i{}; i < batch.size(); i++) {
+                addresses[i] = ToSockAddr(batch[i]);
+                messages[i] = mmsghdr{.msg_hdr = {
+                    .msg_name = &addresses[i],
+                    .msg_namelen = sizeof(sockaddr_in),
+                    .msg_iov = iovecs.data(),
+                    .msg_iovlen = iovecs.size(),
+                }};
+            }
+
+            TRACE_EVENT("service", "UdpTransport::Send", "Count", batch.size());
+            if (sendmmsg(unicastSocket, messages.data(), static_cast<unsigned int>(batch.size()), 0) == -1)
+                Logger::Warn("Failed to send LDN packets: {}", strerror(errno));
+
+            destinations = destinations.subspan(batch.size());
+        }
+    }
+
+    InProcessTransport::InProcessTransport(std::shared_ptr<InProcessNetwork> pNetwork, ReceiveCallback callback) : network{std::move(pNetwork)}, callback{std::move(callback)} {
+        {
+            std::scoped_lock lock{network->mutex};
+            if (network->nextHost == 0xFF)
+                throw exception("Too many transports on the in-process LDN network");
+
+            localEndpoint = {(127U << 24) | network->nextHost++, 0};
+            network->transports.push_back(this);
+        }
+
+        thread = std::thread(&InProcessTransport::Run, this);
+    }
+
+    InProcessTransport::~InProcessTransport() {
+        {
+            std::scoped_lock lock{network->mutex};
+            std::erase(network->transports, this);
+        }
+
+        {
+            std::scoped_lock lock{queueMutex};
+            exiting = true;
+        }
+        queueCondition.notify_all();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void InProcessTransport::Enqueue(const Endpoint &source, PacketType type, span<const u8> payload) {
+        {
+            std::scoped_lock lock{queueMutex};
+            queue.push(QueuedPacket{source, type, std::vector<u8>(payload.begin(), payload.end())});
+        }
+        queueCondition.notify_one();
+    }
+
+    void InProcessTransport::Run() {
+        if (int result{pthread_setname_np(pthread_self(), "Sky-LdnLoopback")})
+            Logger::Warn("Failed to set the thread name: {}", strerror(result));
+
+        try {
+            std::unique_lock lock{queueMutex};
+            while (true) {
+                queueCondition.wait(lock, [this] { return exiting || !queue.empty(); });
+                if (exiting)
+                    return;
+
+                auto packet{std::move(queue.front())};
+                queue.pop();
+
+                // The callback must be called without the queue locked as it may send packets to this transport
+                lock.unlock();
+                callback(packet.source, packet.type, packet.payload);
+                lock.lock();
+            }
+        } catch (const std::exception &e) {
+            Logger::Error("{}", e.what());
+        }
+    }
+
+    void InProcessTransport::Broadcast(PacketType type, span<const u8> payload) {
+        std::scoped_lock lock{network->mutex};
+        for (auto transport : network->transports)
+            if (transport != this)
+                transport->Enqueue(localEndpoint, type, payload);
+    }
+
+    void InProcessTransport::Send(span<const Endpoint> destinations, PacketType type, span<const u8> payload) {
+        std::scoped_lock lock{network->mutex};
+        for (const auto &destination : destinations)
+            for (auto transport : network->transports)
+                if (transport->localEndpoint == destination)
+                    transport->Enqueue(localEndpoint, type, payload);
+    }
+}
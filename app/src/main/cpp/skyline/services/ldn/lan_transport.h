@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <thread>
+#include <queue>
+#include <common/file_descriptor.h>
+#include <common/utils.h>
+
+namespace skyline::service::ldn {
+    enum class PacketType : u8 {
+        Scan = 0, //!< A station looking for networks, it has no payload
+        ScanResponse = 1, //!< An access point advertising its network in response to a scan, the payload is a NetworkInfo
+        Connect = 2, //!< A station requesting to join a network, the payload is the NodeInfo of the station
+        SyncNetwork = 3, //!< An access point updating the network state of its stations, the payload is a NetworkInfo
+        Disconnect = 4, //!< A node leaving a network or an access point rejecting/removing a station, it has no payload
+    };
+
+    /**
+     * @brief The header which prefixes every LDN packet
+     */
+    struct PacketHeader {
+        u32 magic;
+        PacketType type;
+        u8 _pad0_;
+        u16 size; //!< The size of the payload following the header
+    };
+    static_assert(sizeof(PacketHeader) == 0x8);
+
+    constexpr u32 PacketMagic{util::MakeMagic<u32>("LDNE")};
+
+    /**
+     * @brief A transport is used to exchange LDN packets between emulator instances, it abstracts the discovery protocol from the medium used to reach other instances
+     */
+    class Transport {
+      public:
+        /**
+         * @brief An address which packets can be sent to, it's in host byte order
+         */
+        struct Endpoint {
+            u32 address;
+            u16 port;
+
+            bool operator==(const Endpoint &) const = default;
+        };
+
+        /**
+         * @brief A callback which is called on the transport's thread for every packet received from another instance
+         */
+        using ReceiveCallback = std::function<void(const Endpoint &source, PacketType type, span<u8> payload)>;
+
+        virtual ~Transport() = default;
+
+        /**
+         * @return The IPv4 address of this instance which other instances and guest sockets can reach it at, in host byte order
+         */
+        virtual u32 GetLocalAddress() = 0;
+
+        /**
+         * @return The subnet mask of the network the local address is on, in host byte order
+         */
+        virtual u32 GetSubnetMask() = 0;
+
+        /**
+         * @brief Sends a packet to every instance which can be discovered by this transport
+         */
+        virtual void Broadcast(PacketType type, span<const u8> payload) = 0;
+
+        /**
+         * @brief Sends the same packet to all supplied endpoints, this should be done with as few host calls as possible
+         */
+        virtual void Send(span<const Endpoint> destinations, PacketType type, span<const u8> payload) = 0;
+    };
+
+    /**
+     * @brief A transport which uses UDP broadcasts on the host's primary IPv4 network for discovery and unicast datagrams for all other packets
+     * @note All instances share the discovery port while every instance has its own unicast port, this allows multiple instances on the same host
+     * @note Received datagrams are drained in batches to keep up with frequent state synchronization
+     */
+    class UdpTransport : public Transport {
+      private:
+        static constexpr u16 DiscoveryPort{11452};
+        static constexpr size_t ReceiveBatchSize{16}; //!< The maximum amount of datagrams received by a single host call
+        static constexpr size_t SendBatchSize{8}; //!< The maximum amount of datagrams sent by a single host call, this covers every station in a network
+        static constexpr size_t DatagramSizeMax{0x800}; //!< The maximum size of a datagram including the header, this must be able to fit any packet
+
+        ReceiveCallback callback;
+        u32 localAddress{};
+        u32 subnetMask{};
+        u32 broadcastAddress{};
+        u16 localPort{}; //!< The port of the unicast socket, other instances respond to this port
+        FileDescriptor discoverySocket; //!< A socket bound to the shared discovery port which receives broadcasts
+        FileDescriptor unicastSocket; //!< A socket bound to an ephemeral port which is used to send all packets and receive unicast packets
+        FileDescriptor wakeFd; //!< An eventfd that is used to wake the receive thread for it to exit
+        std::atomic<bool> exiting{};
+        std::thread thread;
+
+        /**
+         * @brief Finds the first non-loopback IPv4 interface that is up, the loopback interface is used if there are none
+         */
+        void FindInterface();
+
+        /**
+         * @brief Receives and dispatches all pending datagrams on the supplied socket
+         */
+        void Drain(int socket);
+
+        void Run();
+
+      public:
+        UdpTransport(ReceiveCallback callback);
+
+        ~UdpTransport();
+
+        u32 GetLocalAddress() override {
+            return localAddress;
+        }
+
+        u32 GetSubnetMask() override {
+            return subnetMask;
+        }
+
+        void Broadcast(PacketType type, span<const u8> payload) override;
+
+        void Send(span<const Endpoint> destinations, PacketType type, span<const u8> payload) override;
+    };
+
+    class InProcessTransport;
+
+    /**
+     * @brief A network which connects all InProcessTransport instances attached to it, it takes the place of the host network
+     */
+    class InProcessNetwork {
+      private:
+        friend InProcessTransport;
+
+        std::mutex mutex; //!< Synchronizes the attached transports, it's held while packets are queued to prevent transports from being destroyed during delivery
+        std::vector<InProcessTransport *> transports;
+        u8 nextHost{1}; //!< The host part of the address assigned to the next attached transport
+    };
+
+    /**
+     * @brief A transport which exchanges packets with other transports attached to the same InProcessNetwork, this allows multiple LanDiscovery instances within a single process to be wired together without the host network
+     * @note Every transport is assigned a unique loopback address, packets are delivered on the transport's own thread in the same manner as UdpTransport
+     */
+    class InProcessTransport : public Transport {
+      private:
+        /**
+         * @brief A packet waiting to be dispatched to the callback
+         */
+        struct QueuedPacket {
+            Endpoint source;
+            PacketType type;
+            std::vector<u8> payload;
+        };
+
+        std::shared_ptr<InProcessNetwork> network;
+        ReceiveCallback callback;
+        Endpoint localEndpoint;
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::queue<QueuedPacket> queue;
+        bool exiting{};
+        std::thread thread;
+
+        /**
+         * @brief Queues a packet for delivery on this transport's thread
+         */
+        void Enqueue(const Endpoint &source, PacketType type, span<const u8> payload);
+
+        void Run();
+
+      public:
+        InProcessTransport(std::shared_ptr<InProcessNetwork> network, ReceiveCallback callback);
+
+        ~InProcessTransport();
+
+        u32 GetLocalAddress() override {
+            return localEndpoint.address;
+        }
+
+        u32 GetSubnetMask() override {
+            return 0xFF000000;
+        }
+
+        void Broadcast(PacketType type, span<const u8> payload) override;
+
+        void Send(span<const Endpoint> destinations, PacketType type, span<const u8> payload) override;
+    };
+}
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::service::ldn {
+    namespace result {
+        static constexpr Result AdvertiseDataTooLarge{203, 10};
+        static constexpr Result DeviceDisabled{203, 22};
+        static constexpr Result InvalidNodeCount{203, 30};
+        static constexpr Result ConnectionFailed{203, 31};
+        static constexpr Result InvalidState{203, 32};
+        static constexpr Result NoIpAddress{203, 33};
+        static constexpr Result MaximumNodeCount{203, 67};
+        static constexpr Result InvalidArgument{203, 96};
+    }
+
+    constexpr size_t NodeCountMax{8}; //!< The maximum amount of nodes in a single network, this includes the access point
+    constexpr size_t ScanResultCountMax{24}; //!< The maximum amount of networks returned by a single scan
+    constexpr size_t AdvertiseDataSizeMax{0x180};
+    constexpr size_t UserNameBytesMax{0x20};
+
+    /**
+     * @url https://switchbrew.org/wiki/LDN_services#State
+     */
+    enum class State : u32 {
+        None = 0,
+        Initialized = 1,
+        AccessPointOpened = 2,
+        AccessPointCreated = 3,
+        StationOpened = 4,
+        StationConnected = 5,
+        Error = 6,
+    };
+
+    enum class DisconnectReason : u16 {
+        None = 0,
+        DisconnectedByUser = 1,
+        DisconnectedBySystem = 2,
+        DestroyedByUser = 3,
+        DestroyedBySystem = 4,
+        Rejected = 5,
+        SignalLost = 6,
+    };
+
+    enum class NodeStateChange : u8 {
+        None = 0,
+        Connect = 1,
+        Disconnect = 2,
+        DisconnectAndConnect = 3,
+    };
+
+    enum class AcceptPolicy : u8 {
+        AcceptAll = 0,
+        RejectAll = 1,
+        BlackList = 2,
+        WhiteList = 3,
+    };
+
+    /**
+     * @brief The fields of a ScanFilter which should be matched against
+     */
+    enum class ScanFilterFlag : u32 {
+        LocalCommunicationId = 1 << 0,
+        SessionId = 1 << 1,
+        NetworkType = 1 << 2,
+        Ssid = 1 << 4,
+        SceneId = 1 << 5,
+    };
+
+    using MacAddress = std::array<u8, 6>;
+
+    struct IntentId {
+        u64 localCommunicationId;
+        u8 _pad0_[2];
+        u16 sceneId;
+        u8 _pad1_[4];
+    };
+    static_assert(sizeof(IntentId) == 0x10);
+
+    struct SessionId {
+        u64 high;
+        u64 low;
+
+        bool operator==(const SessionId &) const = default;
+    };
+    static_assert(sizeof(SessionId) == 0x10);
+
+    struct NetworkId {
+        IntentId intentId;
+        SessionId sessionId;
+    };
+    static_assert(sizeof(NetworkId) == 0x20);
+
+    struct Ssid {
+        u8 length;
+        std::array<char, 0x21> raw; //!< A null-terminated SSID
+
+        std::string_view View() const {
+            return std::string_view(raw.data(), std::min<size_t>(length, raw.size() - 1));
+        }
+    };
+    static_assert(sizeof(Ssid) == 0x22);
+
+    struct CommonNetworkInfo {
+        MacAddress bssid;
+        Ssid ssid;
+        i16 channel;
+        i8 linkLevel;
+        u8 networkType;
+        u8 _pad0_[4];
+    };
+    static_assert(sizeof(CommonNetworkInfo) == 0x30);
+
+    /**
+     * @url https://switchbrew.org/wiki/LDN_services#NodeInfo
+     */
+    struct NodeInfo {
+        u32 ipv4Address; //!< The IPv4 address of the node in host byte order
+        MacAddress macAddress;
+        i8 nodeId;
+        u8 isConnected;
+        std::array<u8, UserNameBytesMax + 1> userName;
+        u8 _pad0_;
+        i16 localCommunicationVersion;
+        u8 _pad1_[0x10];
+    };
+    static_assert(sizeof(NodeInfo) == 0x40);
+
+    struct LdnNetworkInfo {
+        std::array<u8, 0x10> securityParameter;
+        u16 securityMode;
+        AcceptPolicy stationAcceptPolicy;
+        u8 hasActionFrame;
+        u8 _pad0_[2];
+        u8 nodeCountMax;
+        u8 nodeCount;
+        std::array<NodeInfo, NodeCountMax> nodes;
+        u8 _pad1_[2];
+        u16 advertiseDataSize;
+        std::array<u8, AdvertiseDataSizeMax> advertiseData;
+        u8 _pad2_[0x8C];
+        u64 randomAuthenticationId;
+    };
+    static_assert(sizeof(LdnNetworkInfo) == 0x430);
+
+    /**
+     * @url https://switchbrew.org/wiki/LDN_services#NetworkInfo
+     */
+    struct NetworkInfo {
+        NetworkId networkId;
+        CommonNetworkInfo common;
+        LdnNetworkInfo ldn;
+    };
+    static_assert(sizeof(NetworkInfo) == 0x480);
+
+    struct SecurityConfig {
+        u16 securityMode;
+        u16 passphraseSize;
+        std::array<u8, 0x40> passphrase;
+    };
+    static_assert(sizeof(SecurityConfig) == 0x44);
+
+    struct UserConfig {
+        std::array<u8, UserNameBytesMax + 1> userName;
+        u8 _pad0_[0xF];
+    };
+    static_assert(sizeof(UserConfig) == 0x30);
+
+    struct NetworkConfig {
+        IntentId intentId;
+        u16 channel;
+        u8 nodeCountMax;
+        u8 _pad0_;
+        i16 localCommunicationVersion;
+        u8 _pad1_[0xA];
+    };
+    static_assert(sizeof(NetworkConfig) == 0x20);
+
+    struct CreateNetworkConfig {
+        SecurityConfig securityConfig;
+        UserConfig userConfig;
+        u8 _pad0_[4];
+        NetworkConfig networkConfig;
+    };
+    static_assert(sizeof(CreateNetworkConfig) == 0x98);
+
+    struct ConnectNetworkData {
+        SecurityConfig securityConfig;
+        UserConfig userConfig;
+        i32 localCommunicationVersion;
+        u32 option;
+    };
+    static_assert(sizeof(ConnectNetworkData) == 0x7C);
+
+    struct ScanFilter {
+        NetworkId networkId;
+        u32 networkType;
+        MacAddress bssid;
+        Ssid ssid;
+        u8 _pad0_[0x10];
+        u32 flag; //!< A bitmask of ScanFilterFlag
+    };
+    static_assert(sizeof(ScanFilter) == 0x60);
+
+    struct NodeLatestUpdate {
+        NodeStateChange stateChange;
+        u8 _pad0_[7];
+    };
+    static_assert(sizeof(NodeLatestUpdate) == 0x8);
+
+    struct SecurityParameter {
+        std::array<u8, 0x10> data;
+        SessionId sessionId;
+    };
+    static_assert(sizeof(SecurityParameter) == 0x20);
+}
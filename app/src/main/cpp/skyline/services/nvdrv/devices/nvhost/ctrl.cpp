@@ -9,21 +9,20 @@
 namespace skyline::service::nvdrv::device::nvhost {
     Ctrl::SyncpointEvent::SyncpointEvent(const DeviceState &state) : event(std::make_shared<type::KEvent>(state, false)) {}
 
-    void Ctrl::SyncpointEvent::Signal() {
+    void Ctrl::SyncpointEvent::OnThresholdReached() {
         // We should only signal the KEvent if the event is actively being waited on
         if (state.exchange(State::Signalled) == State::Waiting)
             event->Signal();
     }
 
     void Ctrl::SyncpointEvent::Cancel(soc::host1x::Host1x &host1x) {
-        host1x.syncpoints.at(fence.id).host.DeregisterWaiter(waiterHandle);
-        waiterHandle = {};
+        host1x.syncpoints.at(fence.id).host.DeregisterWaiter(*this);
     }
 
     void Ctrl::SyncpointEvent::RegisterWaiter(soc::host1x::Host1x &host1x, const Fence &pFence) {
         fence = pFence;
         state = State::Waiting;
-        waiterHandle = host1x.syncpoints.at(fence.id).host.RegisterWaiter(fence.threshold, [this] { Signal(); });
+        host1x.syncpoints.at(fence.id).host.RegisterWaiter(*this, fence.threshold);
     }
 
     bool Ctrl::SyncpointEvent::IsInUse() {
@@ -34,6 +33,14 @@ namespace skyline::service::nvdrv::device::nvhost {
 
     Ctrl::Ctrl(const DeviceState &state, Driver &driver, Core &core, const SessionContext &ctx) : NvDevice(state, driver, core, ctx) {}
 
+    Ctrl::~Ctrl() {
+        // Events are linked into the waiters of their syncpoint so any that are still waiting need to be removed prior to being destroyed
+        std::scoped_lock lock{syncpointEventMutex};
+        for (auto &event : syncpointEvents)
+            if (event && event->state == SyncpointEvent::State::Waiting)
+                event->Cancel(state.soc->host1x);
+    }
+
     u32 Ctrl::FindFreeSyncpointEvent(u32 syncpointId) {
         u32 eventSlot{SyncpointEventCount}; //!< Holds the slot of the last populated event in the event array
         u32 freeSlot{SyncpointEventCount}; //!< Holds the slot of the first unused event id
@@ -37,11 +37,9 @@ namespace skyline::service::nvdrv::device::nvhost {
         /**
          * @brief Syncpoint Events are used to expose fences to the userspace, they can be waited on using an IOCTL or be converted into a native HOS KEvent object that can be waited on just like any other KEvent on the guest
          */
-        class SyncpointEvent {
+        class SyncpointEvent : public soc::host1x::Syncpoint::Waiter {
           private:
-            soc::host1x::Syncpoint::WaiterHandle waiterHandle{};
-
-            void Signal();
+            void OnThresholdReached() override;
 
           public:
             enum class State {
@@ -98,6 +96,8 @@ namespace skyline::service::nvdrv::device::nvhost {
       public:
         Ctrl(const DeviceState &state, Driver &driver, Core &core, const SessionContext &ctx);
 
+        ~Ctrl();
+
         /**
          * @brief Clears a syncpoint event
          * @url https://switchbrew.org/wiki/NV_services#NVHOST_IOCTL_CTRL_SYNCPT_CLEAR_EVENT_WAIT
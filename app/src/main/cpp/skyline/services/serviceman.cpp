@@ -3,6 +3,7 @@
 
 #include <kernel/types/KProcess.h>
 #include <common/trace.h>
+#include <common/perf_counters.h>
 #include "sm/IUserInterface.h"
 #include "settings/ISettingsServer.h"
 #include "settings/ISystemSettingsServer.h"
@@ -200,6 +201,7 @@ namespace skyline::service {
 
     void ServiceManager::SyncRequestHandler(KHandle handle) {
         TRACE_EVENT("kernel", "ServiceManager::SyncRequestHandler");
+        perf::Add(perf::Counter::IpcCalls);
         auto session{state.process->GetHandle<type::KSession>(handle)};
         Logger::Verbose("----IPC Start----");
         Logger::Verbose("Handle is 0x{:X}", handle);
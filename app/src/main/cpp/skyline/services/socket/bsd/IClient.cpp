@@ -1,12 +1,161 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <kernel/types/KThread.h>
 #include "IClient.h"
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <poll.h>
 
 namespace skyline::service::socket {
-    IClient::IClient(const DeviceState &state, ServiceManager &manager) : BaseService(state, manager) {}
+    /**
+     * @brief The layout of sockaddr_in on HOS which is inherited from FreeBSD, it has a length field that Linux lacks
+     */
+    struct GuestSockAddrIn {
+        u8 length;
+        u8 family;
+        u16 port; //!< The port in network byte order
+        u32 address; //!< The IPv4 address in network byte order
+        std::array<u8, 8> _pad_;
+    };
+    static_assert(sizeof(GuestSockAddrIn) == sizeof(sockaddr_in));
+
+    static sockaddr_in GuestToHostAddress(span<u8> buffer) {
+        auto &guest{buffer.as<GuestSockAddrIn>()};
+        return sockaddr_in{
+            .sin_family = guest.family,
+            .sin_port = guest.port,
+            .sin_addr = {.s_addr = guest.address},
+        };
+    }
+
+    /**
+     * @return The size of the guest address that was written into the buffer
+     */
+    static u32 HostToGuestAddress(const sockaddr_in &host, span<u8> buffer) {
+        if (buffer.size() < sizeof(GuestSockAddrIn))
+            return 0;
+
+        buffer.as<GuestSockAddrIn>() = GuestSockAddrIn{
+            .length = sizeof(GuestSockAddrIn),
+            .family = static_cast<u8>(host.sin_family),
+            .port = host.sin_port,
+            .address = host.sin_addr.s_addr,
+        };
+        return sizeof(GuestSockAddrIn);
+    }
+
+    /**
+     * @return The FreeBSD errno equivalent to the supplied Linux errno
+     */
+    static i32 TranslateErrno(int error) {
+        switch (error) {
+            case EAGAIN:
+                return 35;
+            case EINPROGRESS:
+                return 36;
+            case EALREADY:
+                return 37;
+            case ENOTSOCK:
+                return 38;
+            case EDESTADDRREQ:
+                return 39;
+            case EMSGSIZE:
+                return 40;
+            case EPROTOTYPE:
+                return 41;
+            case ENOPROTOOPT:
+                return 42;
+            case EPROTONOSUPPORT:
+                return 43;
+            case EOPNOTSUPP:
+                return 45;
+            case EAFNOSUPPORT:
+                return 47;
+            case EADDRINUSE:
+                return 48;
+            case EADDRNOTAVAIL:
+                return 49;
+            case ENETDOWN:
+                return 50;
+            case ENETUNREACH:
+                return 51;
+            case ECONNABORTED:
+                return 53;
+            case ECONNRESET:
+                return 54;
+            case ENOBUFS:
+                return 55;
+            case EISCONN:
+                return 56;
+            case ENOTCONN:
+                return 57;
+            case ETIMEDOUT:
+                return 60;
+            case ECONNREFUSED:
+                return 61;
+            case EHOSTUNREACH:
+                return 65;
+            default:
+                return error; // Errors below 35 share the same values
+        }
+    }
+
+    /**
+     * @brief Translates FreeBSD message flags into their Linux equivalents
+     * @param dontWait If MSG_DONTWAIT was supplied, it's handled by IClient rather than being passed to the host
+     */
+    static int TranslateMessageFlags(i32 flags, bool &dontWait) {
+        constexpr i32 GuestMsgWaitAll{0x40}, GuestMsgDontWait{0x80};
+
+        dontWait = flags & GuestMsgDontWait;
+        int hostFlags{flags & (MSG_OOB | MSG_PEEK | MSG_DONTROUTE)};
+        if (flags & GuestMsgWaitAll)
+            hostFlags |= MSG_WAITALL;
+        return hostFlags;
+    }
+
+    /**
+     * @brief Writes the result of a BSD call into the response, the errno is only written for failed calls
+     */
+    static Result PushBsdResult(ipc::IpcResponse &response, i64 result, int error) {
+        response.Push<i32>(static_cast<i32>(result));
+        response.Push<i32>(result < 0 ? TranslateErrno(error) : 0);
+        return {};
+    }
+
+    IClient::IClient(const DeviceState &state, ServiceManager &manager) : BaseService(state, manager), reactor(state) {}
+
+    bool IClient::IsNonBlocking(int fd) {
+        std::scoped_lock lock{mutex};
+        return nonBlockingSockets.contains(fd);
+    }
+
+    bool IClient::WaitSocket(int fd, short events) {
+        if (reactor.Wait(fd, events) || !state.thread->cancelSync)
+            return true;
+
+        errno = EINTR;
+        return false;
+    }
+
+    int IClient::PollSockets(span<pollfd> fds, i64 timeout) {
+        int result{::poll(fds.data(), fds.size(), 0)};
+        if (result != 0 || timeout == 0)
+            return result;
+
+        i64 deadline{timeout > 0 ? util::GetTimeNs() + timeout : 0};
+        while (true) {
+            if (!reactor.Wait(fds, timeout > 0 ? std::max(deadline - util::GetTimeNs(), i64{1}) : -1) && state.thread->cancelSync) {
+                errno = EINTR;
+                return -1;
+            }
+
+            result = ::poll(fds.data(), fds.size(), 0);
+            if (result != 0 || (timeout > 0 && util::GetTimeNs() >= deadline))
+                return result;
+        }
+    }
 
     Result IClient::RegisterClient(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
         response.Push<u32>(0);
@@ -21,205 +170,282 @@ namespace skyline::service::socket {
     }
 
     Result IClient::Socket(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        auto domain{request.Pop<u32>()};
-        auto type{request.Pop<u32>()};
-        auto protocol{request.Pop<u32>()};
-
-        //https://jameshfisher.com/2017/02/27/socket-types/
-        //https://students.mimuw.edu.pl/SO/Linux/Kod/include/linux/socket.h.html
-        //Socket: Domain 2, Type 1, Protocol 6
-        //        AF_INET SOCK_STREAM
-
-        //int BSD_Socket = ::socket(domain, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
-        if (protocol == 17) type = 2;
-        int BSD_Socket = ::socket(domain, type, protocol);
-        Logger::Warn("SocketFd {} Domain {}, Type {}, Protocol {} Errno {}", BSD_Socket, domain, type, protocol, errno);
-
-        response.Push<int>(BSD_Socket); // Socket descriptor
-        response.Push<u32>(0);  // Error code
-
-        return {};
+        auto domain{request.Pop<i32>()};
+        auto type{request.Pop<i32>()};
+        auto protocol{request.Pop<i32>()};
+
+        constexpr i32 GuestSockNonBlock{0x20000000}, GuestSockCloexec{0x10000000}; // FreeBSD's values for SOCK_NONBLOCK and SOCK_CLOEXEC
+        bool nonBlocking{(type & GuestSockNonBlock) != 0};
+        type &= ~(GuestSockNonBlock | GuestSockCloexec);
+        if (protocol == IPPROTO_UDP)
+            type = SOCK_DGRAM;
+
+        // Host sockets are always non-blocking, blocking calls are emulated with the reactor so that they don't block the guest thread's core
+        int fd{::socket(domain, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol)};
+        int error{errno};
+        Logger::Debug("Socket {} (Domain: {}, Type: {}, Protocol: {}, Non-Blocking: {})", fd, domain, type, protocol, nonBlocking);
+        if (fd != -1 && nonBlocking) {
+            std::scoped_lock lock{mutex};
+            nonBlockingSockets.insert(fd);
+        }
+
+        return PushBsdResult(response, fd, error);
     }
 
     Result IClient::Select(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        return {};
+        auto nfds{request.Pop<i32>()};
+        request.Skip<u32>();
+        auto timeoutSeconds{request.Pop<i64>()};
+        auto timeoutMicroseconds{request.Pop<i64>()};
+        auto nullTimeout{request.Pop<u8>()};
+        i64 timeout{nullTimeout ? -1 : (timeoutSeconds * constant::NsInSecond) + (timeoutMicroseconds * constant::NsInMicrosecond)};
+
+        constexpr size_t SetCount{3}; //!< The read, write and exception sets
+        constexpr std::array<short, SetCount> SetEvents{POLLIN, POLLOUT, POLLPRI};
+        auto isSet{[](span<u8> set, int fd) { return static_cast<size_t>(fd / 8) < set.size() && (set[static_cast<size_t>(fd / 8)] & (1 << (fd % 8))); }};
+
+        // Any of the sets may be null, so they're looked up by their descriptor position rather than from the compacted buffer lists
+        std::array<span<u8>, SetCount> inputSets, outputSets;
+        for (size_t index{}; index < SetCount; index++) {
+            inputSets[index] = request.GetAutoSelectInputBuffer(index);
+            outputSets[index] = request.GetAutoSelectOutputBuffer(index);
+        }
+
+        std::vector<pollfd> fds;
+        for (int fd{}; fd < nfds; fd++) {
+            short events{};
+            for (size_t index{}; index < SetCount; index++)
+                if (isSet(inputSets[index], fd))
+                    events |= SetEvents[index];
+            if (events)
+                fds.push_back(pollfd{.fd = fd, .events = events});
+        }
+
+        int result{PollSockets(fds, timeout)};
+        if (result < 0)
+            return PushBsdResult(response, result, errno);
+
+        for (auto &set : outputSets)
+            std::fill(set.begin(), set.end(), 0);
+
+        // Unlike poll, select returns the total amount of bits that are set across all sets
+        result = 0;
+        for (const auto &fd : fds) {
+            std::array<bool, SetCount> ready{(fd.revents & (POLLIN | POLLHUP | POLLERR)) != 0, (fd.revents & (POLLOUT | POLLERR)) != 0, (fd.revents & POLLPRI) != 0};
+            for (size_t index{}; index < SetCount; index++) {
+                if ((fd.events & SetEvents[index]) && ready[index] && static_cast<size_t>(fd.fd / 8) < outputSets[index].size()) {
+                    outputSets[index][static_cast<size_t>(fd.fd / 8)] |= static_cast<u8>(1 << (fd.fd % 8));
+                    result++;
+                }
+            }
+        }
+
+        return PushBsdResult(response, result, 0);
     }
 
     Result IClient::Poll(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        //int result = ::poll(struct pollfd listptr[], nfds_t nmsgsfds, int timeout);
-        return {};
+        auto nfds{request.Pop<u32>()};
+        auto timeout{request.Pop<i32>()};
+
+        // HOS uses the FreeBSD layout of pollfd which is identical to that of Linux, the commonly used events also share the same values
+        // The guest may pass null buffers alongside an nfds of zero, these are looked up positionally and treated as empty
+        auto input{request.GetAutoSelectInputBuffer(0).cast<pollfd>()};
+        auto output{request.GetAutoSelectOutputBuffer(0).cast<pollfd>()};
+        span<pollfd> fds{output.data(), std::min({input.size(), output.size(), static_cast<size_t>(nfds)})};
+        fds.copy_from(input, fds.size());
+
+        int result{PollSockets(fds, timeout < 0 ? -1 : static_cast<i64>(timeout) * constant::NsInMillisecond)};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::Recv(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        //https://www.ibm.com/docs/en/zos/2.2.0?topic=functions-recv-receive-data-socket
-        int socketFd{request.Pop<int>()};
-        int socketFlags{request.Pop<int>()};
-
-        long result = ::recv(socketFd, request.outputBuf.at(0).data(), request.outputBuf.at(0).size(), socketFlags);
+        auto fd{request.Pop<i32>()};
+        bool dontWait;
+        auto flags{TranslateMessageFlags(request.Pop<i32>(), dontWait)};
 
-        Logger::Warn("SocketFd {} SocketFlags {} Result {} errno {}", socketFd, socketFlags, result, errno);
-        response.Push<u32>(0); //result
-        response.Push<u32>(errno);  // Error code
-        return {};
+        auto buffer{request.outputBuf.at(0)};
+        auto result{BlockingCall(fd, POLLIN, dontWait, [&] { return ::recv(fd, buffer.data(), buffer.size(), flags); })};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::RecvFrom(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
+        auto fd{request.Pop<i32>()};
+        bool dontWait;
+        auto flags{TranslateMessageFlags(request.Pop<i32>(), dontWait)};
+
+        auto buffer{request.outputBuf.at(0)};
+        sockaddr_in address{};
+        socklen_t addressLength{sizeof(address)};
+        auto result{BlockingCall(fd, POLLIN, dontWait, [&] { return ::recvfrom(fd, buffer.data(), buffer.size(), flags, reinterpret_cast<sockaddr *>(&address), &addressLength); })};
+        int error{errno};
+
+        u32 guestAddressLength{};
+        if (result >= 0 && request.outputBuf.size() > 1)
+            guestAddressLength = HostToGuestAddress(address, request.outputBuf[1]);
+
+        PushBsdResult(response, result, error);
+        response.Push<u32>(guestAddressLength);
         return {};
     }
 
     Result IClient::Send(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        return {};
+        auto fd{request.Pop<i32>()};
+        bool dontWait;
+        auto flags{TranslateMessageFlags(request.Pop<i32>(), dontWait) | MSG_NOSIGNAL}; // A broken pipe should be reported to the guest rather than raising SIGPIPE
+
+        auto buffer{request.inputBuf.at(0)};
+        auto result{BlockingCall(fd, POLLOUT, dontWait, [&] { return ::send(fd, buffer.data(), buffer.size(), flags); })};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::SendTo(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        // https://linux.die.net/man/2/sendto
-        int socketFd{request.Pop<int>()};
-        int socketFlags{request.Pop<int>()};
-
-        span message = request.inputBuf.at(0);
-        long result = ::sendto(socketFd, request.inputBuf.at(0).data(), request.inputBuf.at(0).size(), socketFlags, (struct sockaddr*)&sockaddrs[socketFd], sizeof(sockaddrs[socketFd]));
-
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} SocketFlags {} Result {} errno {}", socketFd, socketFlags, result, errno);
-        response.Push<u32>(errno);  // Error code
-        return {};
+        auto fd{request.Pop<i32>()};
+        bool dontWait;
+        auto flags{TranslateMessageFlags(request.Pop<i32>(), dontWait) | MSG_NOSIGNAL};
+
+        auto buffer{request.inputBuf.at(0)};
+        std::optional<sockaddr_in> address;
+        if (request.inputBuf.size() > 1)
+            address = GuestToHostAddress(request.inputBuf[1]);
+
+        auto result{BlockingCall(fd, POLLOUT, dontWait, [&] {
+            return ::sendto(fd, buffer.data(), buffer.size(), flags, address ? reinterpret_cast<const sockaddr *>(&*address) : nullptr, address ? sizeof(sockaddr_in) : 0);
+        })};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::Accept(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        // TODO : Check if it is correct by debugging
-        int socketFd{request.Pop<int>()};
-
-        struct sockaddr_in copy;
-        bzero(&copy, sizeof(copy));
-        socklen_t len = sizeof(copy);
-        int newSocketFd = ::accept(socketFd, (struct sockaddr*)&copy, &len);
-
-        sockaddrs[newSocketFd] = copy;
-
-        Logger::Warn("Copy sin_family {} sin_port {}  sin_addr {}", copy.sin_family, copy.sin_port, copy.sin_addr.s_addr);
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} NewSocketFd {} errno {}", socketFd, newSocketFd, errno); // If result is 0, do not care about errno
-        response.Push<u32>(errno);  // Error code
-        response.Push<sockaddr_in>(copy);
+        auto fd{request.Pop<i32>()};
+
+        sockaddr_in address{};
+        socklen_t addressLength{sizeof(address)};
+        auto result{BlockingCall(fd, POLLIN, false, [&] { return ::accept4(fd, reinterpret_cast<sockaddr *>(&address), &addressLength, SOCK_NONBLOCK | SOCK_CLOEXEC); })};
+        int error{errno};
+
+        u32 guestAddressLength{};
+        if (result >= 0) {
+            std::scoped_lock lock{mutex};
+            nonBlockingSockets.erase(result); // Accepted sockets are always blocking initially, any stale state from a prior socket with the same descriptor is dropped
+            if (!request.outputBuf.empty())
+                guestAddressLength = HostToGuestAddress(address, request.outputBuf[0]);
+        }
+
+        PushBsdResult(response, result, error);
+        response.Push<u32>(guestAddressLength);
         return {};
     }
 
     Result IClient::Bind(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        int socketFd{request.Pop<int>()};
-
-        Logger::Warn("errno before {}", errno);
-        // https://docs.freebsd.org/en/books/developers-handbook/sockets/  (sockaddr_in structure)
-        sockaddrs[socketFd] = request.inputBuf.at(0).as<sockaddr_in>();
-        Logger::Warn("sin_family {} sin_port {}  sin_addr {}", sockaddrs[socketFd].sin_family, sockaddrs[socketFd].sin_port, sockaddrs[socketFd].sin_addr.s_addr);
+        auto fd{request.Pop<i32>()};
+        auto address{GuestToHostAddress(request.inputBuf.at(0))};
 
-        sockaddrs[socketFd].sin_family >>= 8;
-        u16 sin_port = (sockaddrs[socketFd].sin_port>>8) | (sockaddrs[socketFd].sin_port<<8);
-        char ip[16];
-        ::inet_ntop(AF_INET,&sockaddrs[socketFd].sin_addr.s_addr,ip,sizeof(ip));
-
-        Logger::Warn("sin_family {} sin_port {}  sin_addr {}", sockaddrs[socketFd].sin_family, sin_port, ip);
-
-        int result = ::bind(socketFd, (struct sockaddr*)&sockaddrs[socketFd], sizeof(sockaddrs[socketFd]));
-
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} Result {} errno {}", socketFd, result, errno); // If result is 0, do not care about errno
-        response.Push<u32>(errno);  // Error code
-        return {};//
+        int result{::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address))};
+        int error{errno};
+        Logger::Debug("Bind {} to {}:{}", fd, inet_ntoa(address.sin_addr), ntohs(address.sin_port));
+        return PushBsdResult(response, result, error);
     }
 
     Result IClient::Connect(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        int socketFd{request.Pop<int>()};
-        Logger::Warn("errno before {}", errno);
-        // https://docs.freebsd.org/en/books/developers-handbook/sockets/  (sockaddr_in structure)
-        sockaddrs[socketFd] = request.inputBuf.at(0).as<sockaddr_in>();
-        Logger::Warn("sin_family {} sin_port {}  sin_addr {}", sockaddrs[socketFd].sin_family, sockaddrs[socketFd].sin_port, sockaddrs[socketFd].sin_addr.s_addr);
-
-        sockaddrs[socketFd].sin_family >>= 8;
-        u16 sin_port = (sockaddrs[socketFd].sin_port>>8) | (sockaddrs[socketFd].sin_port<<8);
-        char ip[16];
-        ::inet_ntop(AF_INET,&sockaddrs[socketFd].sin_addr.s_addr,ip,sizeof(ip));
-        //sockaddr.sin_addr.s_addr = htonl(sockaddr.sin_addr.s_addr); Not necessary
-
-        Logger::Warn("sin_family {} sin_port {}  sin_addr {}", sockaddrs[socketFd].sin_family, sin_port, ip);
-
-        int result = ::connect(socketFd, (struct sockaddr*)&sockaddrs[socketFd], sizeof(sockaddrs[socketFd]));
-
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} Result {} errno {}", socketFd, result, errno); // If result is 0, do not care about errno
-        response.Push<u32>(errno);  // Error code
-        return {};
+        auto fd{request.Pop<i32>()};
+        auto address{GuestToHostAddress(request.inputBuf.at(0))};
+        Logger::Debug("Connect {} to {}:{}", fd, inet_ntoa(address.sin_addr), ntohs(address.sin_port));
+
+        int result{::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address))};
+        if (result == -1 && errno == EINPROGRESS && !IsNonBlocking(fd)) {
+            // A blocking connect is emulated by waiting for the socket to be writable, the result of the connection is then retrieved from SO_ERROR
+            int error{};
+            socklen_t errorLength{sizeof(error)};
+            if (!WaitSocket(fd, POLLOUT)) {
+                result = -1;
+            } else if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorLength) == 0 && error) {
+                errno = error;
+                result = -1;
+            } else {
+                result = 0;
+            }
+        }
+
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::GetSockName(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        // TODO : FIX //Fixed I thing
-        int socketFd{request.Pop<int>()};
+        auto fd{request.Pop<i32>()};
 
-        struct sockaddr_in copy;
-        bzero(&copy, sizeof(copy));
-        socklen_t len = sizeof(copy);
-        int result = ::getsockname(socketFd, (struct sockaddr*)&copy, &len);
+        sockaddr_in address{};
+        socklen_t addressLength{sizeof(address)};
+        int result{::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &addressLength)};
+        int error{errno};
 
-        request.outputBuf.at(0).copy_from(span<sockaddr_in>(&copy, 1));
+        u32 guestAddressLength{};
+        if (result == 0 && !request.outputBuf.empty())
+            guestAddressLength = HostToGuestAddress(address, request.outputBuf[0]);
 
-        sockaddrs[socketFd] = copy;
-
-        Logger::Warn("Copy sin_family {} sin_port {}  sin_addr {}", copy.sin_family, copy.sin_port, copy.sin_addr.s_addr);
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} Result {} errno {}", socketFd, result, errno); // If result is 0, do not care about errno
-        response.Push<u32>(errno);  // Error code
-        response.Push<sockaddr_in>(copy);
+        PushBsdResult(response, result, error);
+        response.Push<u32>(guestAddressLength);
         return {};
     }
 
     Result IClient::Listen(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        int socketFd{request.Pop<int>()};
-        int backlog{request.Pop<int>()};
-
-        int result = ::listen(socketFd, backlog);
+        auto fd{request.Pop<i32>()};
+        auto backlog{request.Pop<i32>()};
 
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} Backlog {} Result {} errno {}", socketFd, backlog, result, errno); // If result is 0, do not care about errno
-        response.Push<u32>(errno);
-        return {};
+        int result{::listen(fd, backlog)};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::Fcntl(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        // https://www.ibm.com/docs/en/zvse/6.2?topic=SSB27H_6.2.0/fa2ti_call_fcntl.htm
-        int socketFd{request.Pop<int>()};
-        int cmd{request.Pop<int>()};
-        int arg{request.Pop<int>()};
-
-        int result = ::fcntl(socketFd, cmd, arg);
-
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} Cmd {} Arg {}", socketFd, cmd, arg); // If result is 0, do not care about errno
-        response.Push<u32>(errno);
-        return {};
+        auto fd{request.Pop<i32>()};
+        auto command{request.Pop<i32>()};
+        auto argument{request.Pop<i32>()};
+
+        // Host sockets are always non-blocking, so O_NONBLOCK is tracked separately for the guest
+        constexpr i32 GuestONonBlock{0x4}; // FreeBSD's value for O_NONBLOCK
+        switch (command) {
+            case F_GETFL: {
+                int result{::fcntl(fd, F_GETFL)};
+                if (result == -1)
+                    return PushBsdResult(response, result, errno);
+                return PushBsdResult(response, (result & O_ACCMODE) | (IsNonBlocking(fd) ? GuestONonBlock : 0), 0);
+            }
+
+            case F_SETFL: {
+                std::scoped_lock lock{mutex};
+                if (argument & GuestONonBlock)
+                    nonBlockingSockets.insert(fd);
+                else
+                    nonBlockingSockets.erase(fd);
+                return PushBsdResult(response, 0, 0);
+            }
+
+            default:
+                Logger::Warn("Unsupported fcntl command on {}: {} ({})", fd, command, argument);
+                return PushBsdResult(response, -1, EINVAL);
+        }
     }
 
     Result IClient::SetSockOpt(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        //https://www.ibm.com/docs/en/zos/2.3.0?topic=functions-setsockopt-set-options-associated-socket
-        int socketFd{request.Pop<int>()};
-        u32 level{request.Pop<u32>()};  // https://learn.microsoft.com/en-us/dotnet/api/system.net.sockets.socketoptionlevel?view=net-6.0   //Minecraft -> 65535 (SOL_SOCKET)  but for some reason returns errno 92
-        u32 option_name{request.Pop<u32>()};
+        auto fd{request.Pop<i32>()};
+        auto level{request.Pop<u32>()};
+        auto optionName{request.Pop<u32>()};
 
-        if (level == 0xffff)
+        if (level == 0xFFFF)
             level = SOL_SOCKET;
-        if (option_name == 0x4)
-            option_name = SO_REUSEADDR;
-
-        Logger::Warn("socketFd {} level {} option_name 0x{:x} option_len {}", socketFd, level, option_name, request.inputBuf.at(0).size());
-
-        int result = ::setsockopt(socketFd, SOL_SOCKET, option_name, request.inputBuf.at(0).data(), request.inputBuf.at(0).size());
-
-        response.Push<u32>(0); //result
-        Logger::Warn("SocketFd {} Result {} errno {}", socketFd, result, errno); // If result is 0, do not care about errno
-        response.Push<u32>(errno);  // Error code
-        return {};//
+        if (optionName == 0x4)
+            optionName = SO_REUSEADDR;
+
+        auto option{request.inputBuf.at(0)};
+        int result{::setsockopt(fd, static_cast<int>(level), static_cast<int>(optionName), option.data(), static_cast<socklen_t>(option.size()))};
+        int error{errno};
+        Logger::Debug("SetSockOpt on {} (Level: {}, Option: 0x{:X}) = {}", fd, level, optionName, result);
+        return PushBsdResult(response, result, error);
     }
 
     Result IClient::Shutdown(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        return {};
+        auto fd{request.Pop<i32>()};
+        auto how{request.Pop<i32>()};
+
+        int result{::shutdown(fd, how)};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::ShutdownAllSockets(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
@@ -227,19 +453,31 @@ namespace skyline::service::socket {
     }
 
     Result IClient::Write(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        return {};
+        auto fd{request.Pop<i32>()};
+
+        auto buffer{request.inputBuf.at(0)};
+        auto result{BlockingCall(fd, POLLOUT, false, [&] { return ::send(fd, buffer.data(), buffer.size(), MSG_NOSIGNAL); })};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::Read(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        response.Push<u32>(0);
-        response.Push<u32>(0);
-        return {};
+        auto fd{request.Pop<i32>()};
+
+        auto buffer{request.outputBuf.at(0)};
+        auto result{BlockingCall(fd, POLLIN, false, [&] { return ::read(fd, buffer.data(), buffer.size()); })};
+        return PushBsdResult(response, result, errno);
     }
 
     Result IClient::Close(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        int socketFd{request.Pop<int>()};
-        int result = ::close(socketFd);
-        Logger::Warn("Closed SocketFd {} Result {} errno {}", socketFd, result, errno);
-        return {};
+        auto fd{request.Pop<i32>()};
+
+        reactor.Cancel(fd);
+        {
+            std::scoped_lock lock{mutex};
+            nonBlockingSockets.erase(fd);
+        }
+
+        int result{::close(fd)};
+        return PushBsdResult(response, result, errno);
     }
 }
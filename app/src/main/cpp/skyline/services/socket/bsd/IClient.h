@@ -6,6 +6,7 @@
 #include <services/serviceman.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include "socket_reactor.h"
 
 namespace skyline::service::socket {
     /**
@@ -14,7 +15,40 @@ namespace skyline::service::socket {
      */
     class IClient : public BaseService {
       private:
-        std::map<int, sockaddr_in> sockaddrs;
+        SocketReactor reactor;
+        std::mutex mutex; //!< Synchronizes access to nonBlockingSockets
+        std::unordered_set<int> nonBlockingSockets; //!< The sockets which the guest has made non-blocking, all host sockets are non-blocking regardless
+
+        bool IsNonBlocking(int fd);
+
+        /**
+         * @brief Performs a socket call, if it would block on a socket which is blocking for the guest then the guest thread is parked on the reactor till the socket is ready and the call is retried
+         * @param events The poll events that the call waits on
+         * @param dontWait If the guest requested this call to not block regardless of the socket's blocking state
+         */
+        template<typename Function>
+        auto BlockingCall(int fd, short events, bool dontWait, Function function) {
+            while (true) {
+                auto result{function()};
+                if (result != -1 || (errno != EAGAIN && errno != EWOULDBLOCK) || dontWait || IsNonBlocking(fd))
+                    return result;
+                if (!WaitSocket(fd, events))
+                    return decltype(result){-1};
+            }
+        }
+
+        /**
+         * @brief Parks the guest thread until the supplied socket has any of the requested poll events pending
+         * @return If the socket may be ready, false if the wait was cancelled with svcCancelSynchronization in which case errno is set to EINTR
+         */
+        bool WaitSocket(int fd, short events);
+
+        /**
+         * @brief Polls the supplied sockets, the guest thread is parked on the reactor if none are ready
+         * @param timeout The timeout in nanoseconds, a negative timeout waits indefinitely
+         * @return The result of poll(2), a cancellation with svcCancelSynchronization fails with EINTR
+         */
+        int PollSockets(span<pollfd> fds, i64 timeout);
 
       public:
         IClient(const DeviceState &state, ServiceManager &manager);
@@ -36,12 +70,15 @@ namespace skyline::service::socket {
         Result Socket(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
         /**
-         * @brief Selects the socket
+         * @brief Waits for any sockets in the supplied sets to be ready
+         * @note The read, write and exception sets are looked up by their position in the auto-select buffer lists, a null set is treated as empty
+         * @url https://switchbrew.org/wiki/Sockets_services#Select
          */
         Result Select(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
         /**
-         * @brief Polls the socket for events
+         * @brief Waits for any of the supplied sockets to have any of the requested events pending
+         * @url https://switchbrew.org/wiki/Sockets_services#Poll
          */
         Result Poll(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
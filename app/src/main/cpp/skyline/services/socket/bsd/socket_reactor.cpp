@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <common/trace.h>
+#include <kernel/types/KProcess.h>
+#include "socket_reactor.h"
+
+namespace skyline::service::socket {
+    /**
+     * @return The epoll events equivalent to the supplied poll events
+     */
+    static u32 PollToEpollEvents(short events) {
+        u32 epollEvents{};
+        if (events & (POLLIN | POLLRDNORM))
+            epollEvents |= EPOLLIN;
+        if (events & POLLPRI)
+            epollEvents |= EPOLLPRI;
+        if (events & (POLLOUT | POLLWRNORM))
+            epollEvents |= EPOLLOUT;
+        return epollEvents;
+    }
+
+    SocketReactor::SocketReactor(const DeviceState &state) : state{state}, epollFd{epoll_create1(EPOLL_CLOEXEC)}, wakeFd{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)} {
+        if (epollFd == -1 || wakeFd == -1)
+            throw exception("Failed to create the socket reactor: {}", strerror(errno));
+
+        epoll_event event{.events = EPOLLIN, .data = {.fd = wakeFd}};
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == -1)
+            throw exception("Failed to register the socket reactor wake eventfd: {}", strerror(errno));
+
+        thread = std::thread(&SocketReactor::Run, this);
+    }
+
+    SocketReactor::~SocketReactor() {
+        exiting = true;
+        eventfd_write(wakeFd, 1);
+        if (thread.joinable())
+            thread.join();
+    }
+
+    bool SocketReactor::UpdateInterest(int fd) {
+        auto it{interests.find(fd)};
+        if (it == interests.end() || it->second.empty()) {
+            if (it != interests.end())
+                interests.erase(it);
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr); // This may fail if the socket was closed in the meantime, the kernel removes closed sockets on its own
+            return true;
+        }
+
+        epoll_event event{.data = {.fd = fd}};
+        for (const auto &interest : it->second)
+            event.events |= interest.events;
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == -1 && (errno != ENOENT || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1))
+            return false;
+        return true;
+    }
+
+    void SocketReactor::Run() {
+        if (int result{pthread_setname_np(pthread_self(), "Sky-BsdReactor")})
+            Logger::Warn("Failed to set the thread name: {}", strerror(result));
+
+        try {
+            std::array<epoll_event, 32> events;
+            while (!exiting) {
+                int count{epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1)};
+                if (count == -1) {
+                    if (errno == EINTR)
+                        continue;
+                    throw exception("epoll_wait failed: {}", strerror(errno));
+                }
+
+                TRACE_EVENT("service", "SocketReactor::Run", "Count", count);
+                std::scoped_lock lock{mutex};
+                for (const auto &event : span(events).first(static_cast<size_t>(count))) {
+                    int fd{event.data.fd};
+                    if (fd == wakeFd)
+                        continue;
+
+                    auto it{interests.find(fd)};
+                    if (it == interests.end())
+                        continue;
+
+                    // Errors and hangups are reported to all waiters as the subsequent socket call will return them
+                    std::erase_if(it->second, [&](const Interest &interest) {
+                        if (event.events & (interest.events | EPOLLERR | EPOLLHUP)) {
+                            interest.waiter->event->Signal();
+                            return true;
+                        }
+                        return false;
+                    });
+                    UpdateInterest(fd);
+                }
+            }
+        } catch (const std::exception &e) {
+            Logger::Error("{}", e.what());
+        }
+    }
+
+    void SocketReactor::Cancel(int fd) {
+        std::scoped_lock lock{mutex};
+        auto it{interests.find(fd)};
+        if (it == interests.end())
+            return;
+
+        for (const auto &interest : it->second)
+            interest.waiter->event->Signal();
+        interests.erase(it);
+        UpdateInterest(fd);
+    }
+
+    bool SocketReactor::Wait(span<const pollfd> fds, i64 timeout) {
+        auto waiter{std::make_shared<Waiter>(Waiter{std::make_shared<kernel::type::KEvent>(state, false)})};
+        auto &event{*waiter->event};
+
+        {
+            std::scoped_lock lock{mutex};
+            for (const auto &pollFd : fds) {
+                if (pollFd.fd < 0)
+                    continue;
+
+                interests[pollFd.fd].push_back(Interest{PollToEpollEvents(pollFd.events), waiter});
+                if (!UpdateInterest(pollFd.fd))
+                    event.Signal(); // An invalid socket is always ready as the subsequent poll will report it as such
+            }
+        }
+
+        // Any interests that weren't consumed by the reactor thread are removed once the wait is over, regardless of how it ends
+        struct InterestGuard {
+            SocketReactor &reactor;
+            span<const pollfd> fds;
+            const std::shared_ptr<Waiter> &waiter;
+
+            ~InterestGuard() {
+                std::scoped_lock lock{reactor.mutex};
+                for (const auto &pollFd : fds) {
+                    auto it{reactor.interests.find(pollFd.fd)};
+                    if (it == reactor.interests.end())
+                        continue;
+
+                    std::erase_if(it->second, [&](const Interest &interest) { return interest.waiter == waiter; });
+                    reactor.UpdateInterest(pollFd.fd);
+                }
+            }
+        } guard{*this, fds, waiter};
+
+        TRACE_EVENT("service", "SocketReactor::Wait", "Count", fds.size(), "Timeout", timeout);
+
+        // The guest thread waits on the event in the same manner as svcWaitSynchronization, it's descheduled till the event is signalled or the timeout expires
+        std::unique_lock lock{kernel::type::KSyncObject::syncObjectMutex};
+        if (event.signalled)
+            return true;
+        else if (timeout == 0)
+            return false;
+
+        event.syncObjectWaiters.push_back(state.thread);
+        state.thread->isCancellable = true;
+        state.thread->wakeObject = nullptr;
+        state.scheduler->RemoveThread();
+
+        lock.unlock();
+        if (timeout > 0)
+            state.scheduler->TimedWaitSchedule(std::chrono::nanoseconds(timeout));
+        else
+            state.scheduler->WaitSchedule(false);
+        lock.lock();
+
+        state.thread->isCancellable = false;
+        event.syncObjectWaiters.remove(state.thread);
+
+        if (state.thread->wakeObject == &event)
+            return true;
+
+        // A cancellation reinserts the thread on its own, it's left pending so that it applies to the guest's next svcWaitSynchronization
+        if (!state.thread->cancelSync) {
+            lock.unlock();
+            state.scheduler->InsertThread(state.thread);
+            state.scheduler->WaitSchedule();
+        }
+        return false;
+    }
+}
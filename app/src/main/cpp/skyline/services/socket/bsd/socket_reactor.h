@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <poll.h>
+#include <thread>
+#include <common/file_descriptor.h>
+#include <kernel/types/KEvent.h>
+
+namespace skyline::service::socket {
+    /**
+     * @brief An epoll-based reactor which allows guest threads to wait on host sockets becoming ready without occupying their core
+     * @note All host sockets are non-blocking, blocking guest socket calls are emulated by waiting on the reactor and retrying the call
+     */
+    class SocketReactor {
+      private:
+        /**
+         * @brief A single guest thread waiting on one or more sockets
+         */
+        struct Waiter {
+            std::shared_ptr<kernel::type::KEvent> event; //!< The event the guest thread is waiting on, it's signalled when any socket becomes ready
+        };
+
+        /**
+         * @brief The interest of a single waiter in a socket
+         */
+        struct Interest {
+            u32 events; //!< The epoll events the waiter is interested in
+            std::shared_ptr<Waiter> waiter;
+        };
+
+        const DeviceState &state;
+        FileDescriptor epollFd;
+        FileDescriptor wakeFd; //!< An eventfd that is used to wake the reactor thread for it to exit
+        std::atomic<bool> exiting{};
+        std::mutex mutex; //!< Synchronizes access to the interests and the epoll interest list
+        std::unordered_map<int, std::vector<Interest>> interests; //!< A map from host sockets to the waiters interested in them
+        std::thread thread; //!< The reactor thread which waits on epoll and signals waiters
+
+        /**
+         * @brief Updates the epoll interest list for the supplied socket to match the union of its waiters' interests
+         * @return If the socket could be registered, this fails for invalid file descriptors
+         * @note The mutex must be locked when calling this
+         */
+        bool UpdateInterest(int fd);
+
+        void Run();
+
+      public:
+        SocketReactor(const DeviceState &state);
+
+        ~SocketReactor();
+
+        /**
+         * @brief Parks the calling guest thread until any of the supplied sockets have any of their requested events pending or the timeout expires
+         * @param fds The sockets to wait on alongside their requested poll events, revents is not modified
+         * @param timeout The timeout in nanoseconds, a negative timeout waits indefinitely
+         * @return If any socket became ready prior to the timeout, the guest thread may also be woken by a cancellation in which case this returns false
+         * @note The calling thread is removed from the scheduler while waiting, other guest threads can run on its core in the meantime
+         */
+        bool Wait(span<const pollfd> fds, i64 timeout);
+
+        /**
+         * @brief Wakes all guest threads waiting on the supplied socket, this should be used prior to closing it as epoll silently drops closed sockets
+         */
+        void Cancel(int fd);
+
+        /**
+         * @brief Parks the calling guest thread until the supplied socket has any of the requested poll events pending
+         */
+        bool Wait(int fd, short events, i64 timeout = -1) {
+            pollfd pollFd{.fd = fd, .events = events};
+            return Wait(span<const pollfd>{pollFd}, timeout);
+        }
+    };
+}
@@ -80,7 +80,7 @@ namespace skyline::soc::gm20b::engine {
 
         struct {
             u32 index{std::numeric_limits<u32>::max()};
-            std::vector<u32> arguments;
+            std::vector<MacroArgument> arguments;
 
             bool Valid() {
                 return index != std::numeric_limits<u32>::max();
@@ -114,10 +114,26 @@ namespace skyline::soc::gm20b::engine {
             throw exception("DrawIndexedInstanced is not implemented for this engine");
         }
 
+        /**
+         * @brief Performs a draw with parameters that are read from GPU memory by the host GPU rather than the CPU
+         * @param indirectAddress The GPU address of an array of `drawCount` VkDrawIndirectCommand or VkDrawIndexedIndirectCommand structures
+         * @param stride The stride between consecutive draw structures, zero if they're tightly packed
+         * @param countAddress The GPU address of a 32-bit draw count that's clamped to `drawCount`, zero if `drawCount` should be used as-is
+         * @return If the draw could be performed, if false the caller must read the parameters on the CPU and draw using them directly
+         */
+        virtual bool DrawIndirect(u32 drawTopology, bool indexed, u64 indirectAddress, u32 drawCount, u32 stride, u64 countAddress) {
+            throw exception("DrawIndirect is not implemented for this engine");
+        }
+
+        /**
+         * @brief Submits all pending GPU work and waits for it to complete, this is required prior to reading any dirty macro arguments
+         */
+        virtual void FlushGpuWork() = 0;
+
         /**
          * @brief Handles a call to a method in the MME space
          * @param macroMethodOffset The target offset from EngineMethodsEnd
          */
-        void HandleMacroCall(u32 macroMethodOffset, u32 value, bool lastCall);
+        void HandleMacroCall(u32 macroMethodOffset, MacroArgument argument, bool lastCall);
     };
 }
@@ -75,6 +75,10 @@ namespace skyline::soc::gm20b::engine::fermi2d {
         return registers.raw[method];
     }
 
+    void Fermi2D::FlushGpuWork() {
+        channelCtx.executor.Submit({}, true);
+    }
+
     __attribute__((always_inline)) void Fermi2D::CallMethod(u32 method, u32 argument) {
         Logger::Verbose("Called method in Fermi 2D: 0x{:X} args: 0x{:X}", method, argument);
 
@@ -92,6 +92,8 @@ namespace skyline::soc::gm20b::engine::fermi2d {
 
         u32 ReadMethodFromMacro(u32 method) override;
 
+        void FlushGpuWork() override;
+
         void CallMethod(u32 method, u32 argument);
     };
 }
@@ -19,9 +19,7 @@ namespace skyline::soc::gm20b::engine {
             ENGINE_STRUCT_CASE(syncpoint, action, {
                 if (action.operation == Registers::Syncpoint::Operation::Incr) {
                     Logger::Debug("Increment syncpoint: {}", +action.index);
-                    channelCtx.executor.Submit([=, syncpoints = &this->syncpoints, index = action.index]() {
-                        syncpoints->at(index).host.Increment();
-                    });
+                    channelCtx.executor.SubmitWithSyncpointIncrement(syncpoints.at(action.index).host);
                     syncpoints.at(action.index).guest.Increment();
                 } else if (action.operation == Registers::Syncpoint::Operation::Wait) {
                     Logger::Debug("Wait syncpoint: {}, thresh: {}", +action.index, registers.syncpoint->payload);
@@ -838,6 +838,44 @@ namespace skyline::soc::gm20b::engine::maxwell3d::type {
     };
     static_assert(sizeof(SemaphoreInfo) == sizeof(u32));
 
+    /**
+     * @brief The counters which can be reset to zero using the counter reset method
+     */
+    enum class CounterReset : u32 {
+        SamplesPassed = 0x01,
+        ZcullStats = 0x02,
+        TransformFeedbackPrimitivesWritten = 0x10,
+        InputVertices = 0x12,
+        InputPrimitives = 0x13,
+        VertexShaderInvocations = 0x15,
+        TessControlShaderInvocations = 0x16,
+        TessEvaluationShaderInvocations = 0x17,
+        TessEvaluationShaderPrimitives = 0x18,
+        GeometryShaderInvocations = 0x1A,
+        GeometryShaderPrimitives = 0x1B,
+        ClipperInputPrimitives = 0x1C,
+        ClipperOutputPrimitives = 0x1D,
+        FragmentShaderInvocations = 0x1E,
+        PrimitivesGenerated = 0x1F,
+    };
+
+    /**
+     * @brief Controls if rendering commands are executed, this can be conditional on the values of counters previously reported to memory
+     */
+    struct RenderEnable {
+        enum class Mode : u32 {
+            False = 0, //!< All rendering is disabled
+            True = 1, //!< All rendering is enabled
+            Conditional = 2, //!< Rendering is enabled if the report at the address is non-zero
+            IfEqual = 3, //!< Rendering is enabled if the two consecutive reports at the address are equal
+            IfNotEqual = 4, //!< Rendering is enabled if the two consecutive reports at the address are not equal
+        };
+
+        Address address;
+        Mode mode;
+    };
+    static_assert(sizeof(RenderEnable) == (sizeof(u32) * 3));
+
     constexpr static size_t ShaderStageCount{5}; //!< Amount of pipeline stages on Maxwell 3D
 
     /**
@@ -52,7 +52,8 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
             .constantBufferSelectorRegisters = {*registers.constantBufferSelector},
             .samplerPoolRegisters = {*registers.texSamplerPool, *registers.texHeaderPool},
             .samplerBinding = *registers.samplerBinding,
-            .texturePoolRegisters = {*registers.texHeaderPool}
+            .texturePoolRegisters = {*registers.texHeaderPool},
+            .queriesRegisters = {*registers.sampleCounterEnable, *registers.renderEnable}
         };
     }
     #undef REGTYPE
@@ -218,9 +219,7 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
 
             ENGINE_CASE(syncpointAction, {
                 Logger::Debug("Increment syncpoint: {}", static_cast<u16>(syncpointAction.id));
-                channelCtx.executor.Submit([=, syncpoints = &this->syncpoints, index = syncpointAction.id]() {
-                    syncpoints->at(index).host.Increment();
-                });
+                channelCtx.executor.SubmitWithSyncpointIncrement(syncpoints.at(syncpointAction.id).host);
                 syncpoints.at(syncpointAction.id).guest.Increment();
             })
 
@@ -352,19 +351,20 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
 
                 switch (info.op) {
                     case type::SemaphoreInfo::Op::Release:
-                        channelCtx.executor.Submit([=, this, semaphore = *registers.semaphore]() {
-                            WriteSemaphoreResult(semaphore, semaphore.payload);
+                        channelCtx.executor.Submit([&channelCtx = channelCtx, semaphore = *registers.semaphore]() {
+                            WriteSemaphoreResult(channelCtx, semaphore, semaphore.payload);
                         });
                         break;
 
                     case type::SemaphoreInfo::Op::Counter: {
                         switch (info.counterType) {
                             case type::SemaphoreInfo::CounterType::Zero:
-                                WriteSemaphoreResult(*registers.semaphore, registers.semaphore->payload);
+                                WriteSemaphoreResult(channelCtx, *registers.semaphore, registers.semaphore->payload);
                                 break;
                             case type::SemaphoreInfo::CounterType::SamplesPassed:
-                                // Return a fake result for now
-                                WriteSemaphoreResult(*registers.semaphore, 0xffffff);
+                                interconnect.ReportSamplesPassedCounter(registers.semaphore->address, [&channelCtx = channelCtx, semaphore = *registers.semaphore](u64 result) {
+                                    WriteSemaphoreResult(channelCtx, semaphore, result);
+                                });
                                 break;
 
                             default:
@@ -380,6 +380,18 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
                 }
             })
 
+            ENGINE_CASE(counterReset, {
+                switch (counterReset) {
+                    case type::CounterReset::SamplesPassed:
+                        interconnect.ResetSamplesPassedCounter();
+                        break;
+
+                    default:
+                        Logger::Debug("Unsupported counter reset: 0x{:X}", static_cast<u32>(counterReset));
+                        break;
+                }
+            })
+
             ENGINE_ARRAY_CASE(firmwareCall, 4, {
                 registers.raw[0xD00] = 1;
             })
@@ -417,7 +429,7 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
         }
     }
 
-    void Maxwell3D::WriteSemaphoreResult(const Registers::Semaphore &semaphore, u64 result) {
+    void Maxwell3D::WriteSemaphoreResult(ChannelContext &channelCtx, const Registers::Semaphore &semaphore, u64 result) {
         switch (semaphore.info.structureSize) {
             case type::SemaphoreInfo::StructureSize::OneWord:
                 channelCtx.asCtx->gmmu.Write(semaphore.address, static_cast<u32>(result));
@@ -499,4 +511,15 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
 
         interconnect.Draw(topology, *registers.streamOutputEnable, true, indexBufferCount, indexBufferFirst, instanceCount, globalBaseVertexIndex, globalBaseInstanceIndex);
     }
+
+    bool Maxwell3D::DrawIndirect(u32 drawTopology, bool indexed, u64 indirectAddress, u32 drawCount, u32 stride, u64 countAddress) {
+        auto topology{static_cast<type::DrawTopology>(drawTopology)};
+        registers.begin->op = topology;
+
+        return interconnect.DrawIndirect(topology, *registers.streamOutputEnable, indexed, indirectAddress, drawCount, stride, countAddress);
+    }
+
+    void Maxwell3D::FlushGpuWork() {
+        channelCtx.executor.Submit({}, true);
+    }
 }
@@ -260,11 +260,14 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
             Register<0x547, u32> zCullStatCountersEnable;
             Register<0x548, u32> pointSpriteEnable;
             Register<0x54A, u32> shaderExceptions;
+            Register<0x54C, type::CounterReset> counterReset;
             Register<0x54D, u32> multisampleEnable;
             Register<0x54E, type::ZtSelect> ztSelect;
 
             Register<0x54F, type::MultisampleControl> multisampleControl;
 
+            Register<0x554, type::RenderEnable> renderEnable;
+
             Register<0x557, TexSamplerPool> texSamplerPool;
 
             Register<0x55B, float> slopeScaleDepthBias;
@@ -424,8 +427,9 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
         /**
          * @brief Writes back a semaphore result to the guest with an auto-generated timestamp (if required)
          * @note If the semaphore is OneWord then the result will be downcasted to a 32-bit unsigned integer
+         * @note This is static as it's called from GPU completion callbacks which only hold onto the channel context
          */
-        void WriteSemaphoreResult(const Registers::Semaphore &semaphore, u64 result);
+        static void WriteSemaphoreResult(ChannelContext &channelCtx, const Registers::Semaphore &semaphore, u64 result);
 
       public:
         Registers registers{};
@@ -456,5 +460,9 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
         void DrawInstanced(bool setRegs, u32 drawTopology, u32 vertexArrayCount, u32 instanceCount, u32 vertexArrayStart, u32 globalBaseInstanceIndex) override;
 
         void DrawIndexedInstanced(bool setRegs, u32 drawTopology, u32 indexBufferCount, u32 instanceCount, u32 globalBaseVertexIndex, u32 indexBufferFirst, u32 globalBaseInstanceIndex) override;
+
+        bool DrawIndirect(u32 drawTopology, bool indexed, u64 indirectAddress, u32 drawCount, u32 stride, u64 countAddress) override;
+
+        void FlushGpuWork() override;
     };
 }
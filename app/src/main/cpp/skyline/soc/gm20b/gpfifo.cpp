@@ -86,13 +86,20 @@ namespace skyline::soc::gm20b {
         gpfifoEngine(state.soc->host1x.syncpoints, channelCtx),
         channelCtx(channelCtx),
         gpEntries(numEntries),
+        capture([&state]() -> std::optional<GpfifoCapture> {
+            if (!*state.settings->gpfifoCapture)
+                return std::nullopt;
+
+            static std::atomic<u32> channelIndex{}; // Every channel is captured into a separate trace
+            return std::make_optional<GpfifoCapture>(fmt::format("{}gpfifo_captures/{}/{}_{}.gpct", state.os->publicAppFilesPath, state.loader->nacp->GetSaveDataOwnerId(), util::GetTimeNs(), channelIndex++));
+        }()),
         thread(std::thread(&ChannelGpfifo::Run, this)) {}
 
-    void ChannelGpfifo::SendFull(u32 method, u32 argument, SubchannelId subChannel, bool lastCall) {
+    void ChannelGpfifo::SendFull(u32 method, MacroArgument argument, SubchannelId subChannel, bool lastCall) {
         if (method < engine::GPFIFO::RegisterCount) {
-            gpfifoEngine.CallMethod(method, argument);
+            gpfifoEngine.CallMethod(method, *argument);
         } else if (method < engine::EngineMethodsEnd) { [[likely]]
-            SendPure(method, argument, subChannel);
+            SendPure(method, *argument, subChannel);
         } else {
             switch (subChannel) {
                 case SubchannelId::ThreeD:
@@ -102,7 +109,7 @@ namespace skyline::soc::gm20b {
                     channelCtx.fermi2D.HandleMacroCall(method - engine::EngineMethodsEnd, argument, lastCall);
                     break;
                 default:
-                    Logger::Warn("Called method 0x{:X} out of bounds for engine 0x{:X}, args: 0x{:X}", method, subChannel, argument);
+                    Logger::Warn("Called method 0x{:X} out of bounds for engine 0x{:X}, args: 0x{:X}", method, subChannel, *argument);
                     break;
             }
         }
@@ -155,9 +162,24 @@ namespace skyline::soc::gm20b {
         }
     }
 
+    bool ChannelGpfifo::IsPushBufferGpuDirty(GpEntry gpEntry) {
+        // Split pushbuffers are copied prior to being processed, which requires synchronizing them with the GPU regardless
+        auto pushBufferMappedRanges{channelCtx.asCtx->gmmu.TranslateRange(gpEntry.Address(), gpEntry.size * sizeof(u32))};
+        if (pushBufferMappedRanges.size() != 1)
+            return false;
+
+        std::scoped_lock lock{state.gpu->buffer};
+        return state.gpu->buffer.IsGpuDirty(pushBufferMappedRanges.front(), channelCtx.executor.tag);
+    }
+
     void ChannelGpfifo::Process(GpEntry gpEntry) {
+        // GpEntries that solely contain arguments for a pending macro call are commonly used to pass GPU-generated parameters (e.g. from compute-based culling) to draw macros
+        // If the memory has pending GPU writes the arguments are passed on without being read, this allows the single-draw instanced macro HLE functions to consume them as an indirect draw on the GPU rather than waiting on it to finish
+        // Any other macro (including multi-draw indirect macros, which have no HLE implementation) flushes GPU work prior to reading dirty arguments on the CPU
+        bool pushBufferGpuDirty{gpEntry.size && resumeState.remaining >= gpEntry.size && resumeState.address >= engine::EngineMethodsEnd && IsPushBufferGpuDirty(gpEntry)};
+
         // Submit if required by the GpEntry, this is needed as some games dynamically generate pushbuffer contents
-        if (gpEntry.sync == GpEntry::Sync::Wait)
+        if (gpEntry.sync == GpEntry::Sync::Wait && !pushBufferGpuDirty)
             channelCtx.executor.Submit({}, *state.settings->useDirectMemoryImport);
 
         if (!gpEntry.size) {
@@ -183,26 +205,41 @@ namespace skyline::soc::gm20b {
             }
         }()};
 
+        if (capture) [[unlikely]]
+            capture->CapturePushBuffer(gpEntry, pushBuffer, channelCtx.asCtx->gmmu);
+
         // There will be at least one entry here
         auto entry{pushBuffer.begin()};
 
+        /**
+         * @return The argument at the supplied pushbuffer entry alongside its GPU address
+         */
+        auto argumentAt{[&](span<u32>::iterator argumentEntry) -> MacroArgument {
+            u64 address{gpEntry.Address() + static_cast<u64>(std::distance(pushBuffer.begin(), argumentEntry)) * sizeof(u32)};
+            if (pushBufferGpuDirty)
+                return {.dirty = true, .argumentPtr = &*argumentEntry, .address = address};
+            else
+                return {.raw = *argumentEntry, .address = address};
+        }};
+
         // Executes the current split method, returning once execution is finished or the current GpEntry has reached its end
         auto resumeSplitMethod{[&](){
             switch (resumeState.state) {
                 case MethodResumeState::State::Inc:
-                    while (entry != pushBuffer.end() && resumeState.remaining)
-                        SendFull(resumeState.address++, *(entry++), resumeState.subChannel, --resumeState.remaining == 0);
+                    for (; entry != pushBuffer.end() && resumeState.remaining; entry++)
+                        SendFull(resumeState.address++, argumentAt(entry), resumeState.subChannel, --resumeState.remaining == 0);
 
                     break;
                 case MethodResumeState::State::OneInc:
-                    SendFull(resumeState.address++, *(entry++), resumeState.subChannel, --resumeState.remaining == 0);
+                    SendFull(resumeState.address++, argumentAt(entry), resumeState.subChannel, --resumeState.remaining == 0);
+                    entry++;
 
                     // After the first increment OneInc methods work the same as a NonInc method, this is needed so they can resume correctly if they are broken up by multiple GpEntries
                     resumeState.state = MethodResumeState::State::NonInc;
                     [[fallthrough]];
                 case MethodResumeState::State::NonInc:
-                    while (entry != pushBuffer.end() && resumeState.remaining)
-                        SendFull(resumeState.address, *(entry++), resumeState.subChannel, --resumeState.remaining == 0);
+                    for (; entry != pushBuffer.end() && resumeState.remaining; entry++)
+                        SendFull(resumeState.address, argumentAt(entry), resumeState.subChannel, --resumeState.remaining == 0);
 
                     break;
             }
@@ -288,7 +325,7 @@ namespace skyline::soc::gm20b {
                     } else {
                         // Slow path for methods that touch GPFIFO or macros
                         for (u32 i{}; i < methodHeader.methodCount; i++)
-                            SendFull(methodHeader.methodAddress + methodOffset(i), *++entry, methodHeader.methodSubChannel, i == methodHeader.methodCount - 1);
+                            SendFull(methodHeader.methodAddress + methodOffset(i), argumentAt(++entry), methodHeader.methodSubChannel, i == methodHeader.methodCount - 1);
                     }
                 } else {
                     startSplitMethod(State);
@@ -311,7 +348,7 @@ namespace skyline::soc::gm20b {
                     if (methodHeader.Pure())
                         SendPure(methodHeader.methodAddress, methodHeader.immdData, methodHeader.methodSubChannel);
                     else
-                        SendFull(methodHeader.methodAddress, methodHeader.immdData, methodHeader.methodSubChannel, true);
+                        SendFull(methodHeader.methodAddress, MacroArgument{.raw = methodHeader.immdData}, methodHeader.methodSubChannel, true);
 
                     return false;
                 } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::NonIncMethod) [[unlikely]] {
@@ -357,6 +394,9 @@ namespace skyline::soc::gm20b {
                     channelLocked = true;
                 }
 
+                if (capture) [[unlikely]]
+                    capture->BeginGpEntry(channelCtx.asCtx->gmmu);
+
                 Process(gpEntry);
             }, [this, &channelLocked]() {
                 // If we run out of GpEntries to process ensure we submit any remaining GPU work before waiting for more to arrive
@@ -388,10 +428,16 @@ namespace skyline::soc::gm20b {
     }
 
     void ChannelGpfifo::Push(span<GpEntry> entries) {
+        if (capture && !entries.empty()) [[unlikely]]
+            capture->Submit(entries.size(), true);
+
         gpEntries.Append(entries);
     }
 
     void ChannelGpfifo::Push(GpEntry entry) {
+        if (capture) [[unlikely]]
+            capture->Submit(1, false); // Single entries are only pushed internally for syncpoint operations, they don't consume any guest memory
+
         gpEntries.Push(entry);
     }
 
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <common/circular_queue.h>
+#include "macro/macro_state.h"
 #include "engines/gpfifo.h"
+#include "gpfifo_capture.h"
 
 namespace skyline::soc::gm20b {
     struct ChannelContext;
@@ -127,12 +129,15 @@ namespace skyline::soc::gm20b {
             } state; //!< The type of method to resume
         } resumeState{};
 
+        std::optional<GpfifoCapture> capture; //!< The trace that all processed pushbuffers are written to, this is only created when the 'gpfifoCapture' setting is enabled
+
         std::thread thread; //!< The thread that manages processing of pushbuffers
 
         /**
          * @brief Sends a method call to the appropriate subchannel and handles macro and GPFIFO methods
+         * @note Dirty arguments are only supported for macro methods, see MacroArgument
          */
-        void SendFull(u32 method, u32 argument, SubchannelId subchannel, bool lastCall);
+        void SendFull(u32 method, MacroArgument argument, SubchannelId subchannel, bool lastCall);
 
         /**
          * @brief Sends a method call to the appropriate subchannel, macro and GPFIFO methods are not handled
@@ -144,6 +149,11 @@ namespace skyline::soc::gm20b {
          */
         void SendPureBatchNonInc(u32 method, span<u32> arguments, SubchannelId subChannel);
 
+        /**
+         * @return If the pushbuffer contained within the given GpEntry is backed by memory with pending GPU writes
+         */
+        bool IsPushBufferGpuDirty(GpEntry gpEntry);
+
         /**
          * @brief Processes the pushbuffer contained within the given GpEntry, calling methods as needed
          */
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <filesystem>
+#include <soc.h>
+#include "gpfifo.h"
+#include "gpfifo_capture.h"
+
+namespace skyline::soc::gm20b {
+    GpfifoCapture::GpfifoCapture(const std::string &path) : startTime{util::GetTimeNs()} {
+        std::filesystem::create_directories(std::filesystem::path{path}.parent_path());
+        stream.open(path, std::ios::binary | std::ios::trunc);
+        if (!stream)
+            throw exception("Failed to open GPFIFO trace file: {}", path);
+
+        if (auto result{LZ4F_createCompressionContext(&context, LZ4F_VERSION)}; LZ4F_isError(result))
+            throw exception("Failed to create LZ4 compression context: {}", LZ4F_getErrorName(result));
+
+        compressedBuffer.resize(LZ4F_HEADER_SIZE_MAX);
+        auto headerSize{LZ4F_compressBegin(context, compressedBuffer.data(), compressedBuffer.size(), nullptr)};
+        if (LZ4F_isError(headerSize))
+            throw exception("Failed to begin LZ4 frame: {}", LZ4F_getErrorName(headerSize));
+        stream.write(reinterpret_cast<const char *>(compressedBuffer.data()), static_cast<std::streamsize>(headerSize));
+
+        Header header{};
+        Write(span<Header>{header}.cast<u8>());
+
+        Logger::Info("Capturing GPFIFO trace to: {}", path);
+    }
+
+    GpfifoCapture::~GpfifoCapture() {
+        compressedBuffer.resize(LZ4F_compressBound(0, nullptr));
+        auto size{LZ4F_compressEnd(context, compressedBuffer.data(), compressedBuffer.size(), nullptr)};
+        if (!LZ4F_isError(size))
+            stream.write(reinterpret_cast<const char *>(compressedBuffer.data()), static_cast<std::streamsize>(size));
+        else
+            Logger::Warn("Failed to end LZ4 frame of GPFIFO trace: {}", LZ4F_getErrorName(size));
+
+        LZ4F_freeCompressionContext(context);
+    }
+
+    void GpfifoCapture::Write(span<const u8> data) {
+        compressedBuffer.resize(LZ4F_compressBound(data.size(), nullptr));
+        auto size{LZ4F_compressUpdate(context, compressedBuffer.data(), compressedBuffer.size(), data.data(), data.size(), nullptr)};
+        if (LZ4F_isError(size))
+            throw exception("Failed to compress GPFIFO trace data: {}", LZ4F_getErrorName(size));
+
+        // LZ4 buffers input internally so there might be no output until a block has been filled
+        if (size)
+            stream.write(reinterpret_cast<const char *>(compressedBuffer.data()), static_cast<std::streamsize>(size));
+    }
+
+    void GpfifoCapture::WriteRecordHeader(RecordType type, size_t size) {
+        RecordHeader header{
+            .type = type,
+            .size = static_cast<u32>(size),
+            .timestamp = static_cast<u64>(util::GetTimeNs() - startTime),
+        };
+        Write(span<RecordHeader>{header}.cast<u8>());
+    }
+
+    void GpfifoCapture::CaptureGmmuMappings(GMMU &gmmu) {
+        if (mappingGeneration && *mappingGeneration == gmmu.GetMappingGeneration())
+            return;
+
+        mappings.clear();
+        mappingGeneration = gmmu.ForEachMapping([this](u64 virt, u64 size, bool sparse) {
+            mappings.push_back(GmmuMapping{
+                .gpuAddress = virt,
+                .size = size,
+                .sparse = sparse,
+            });
+        });
+
+        GmmuMappingsRecord record{.count = mappings.size()};
+        WriteRecordHeader(RecordType::GmmuMappings, sizeof(record) + mappings.size() * sizeof(GmmuMapping));
+        Write(span<GmmuMappingsRecord>{record}.cast<u8>());
+        Write(span(mappings).cast<u8>());
+    }
+
+    void GpfifoCapture::WriteMemory(u64 gpuAddress, span<u8> memory) {
+        while (!memory.empty()) {
+            auto chunk{memory.first(std::min(memory.size(), MaxMemoryRecordSize))};
+
+            MemoryRecord record{
+                .gpuAddress = gpuAddress,
+                .size = chunk.size(),
+            };
+            WriteRecordHeader(RecordType::Memory, sizeof(record) + chunk.size());
+            Write(span<MemoryRecord>{record}.cast<u8>());
+            Write(chunk);
+
+            gpuAddress += chunk.size();
+            memory = memory.subspan(chunk.size());
+        }
+    }
+
+    void GpfifoCapture::CaptureMemory(GMMU &gmmu) {
+        CaptureGmmuMappings(gmmu);
+
+        bool mappingsChanged{pageStatesGeneration != mappingGeneration};
+        if (mappingsChanged) {
+            pageStatesGeneration = mappingGeneration;
+
+            // Only the states of pages that are still mapped are carried over, the rest are discarded
+            std::swap(pageStates, stalePageStates);
+            pageStates.clear();
+        }
+
+        for (const auto &mapping : mappings) {
+            if (mapping.sparse)
+                continue;
+
+            u64 gpuAddress{mapping.gpuAddress};
+            for (auto range : gmmu.TranslateRange(mapping.gpuAddress, mapping.size)) {
+                if (!range.valid()) {
+                    gpuAddress += range.size();
+                    continue;
+                }
+
+                // Runs of consecutive changed pages are coalesced into a single record
+                u64 runAddress{gpuAddress};
+                u8 *runStart{range.data()};
+                size_t runSize{};
+
+                for (size_t offset{}; offset < range.size(); offset += PageSize) {
+                    auto page{range.subspan(offset, std::min(PageSize, range.size() - offset))};
+                    u64 pageAddress{gpuAddress + offset};
+                    u64 hash{XXH64(page.data(), page.size(), 0)};
+
+                    auto &pageState{[&]() -> PageState & {
+                        if (mappingsChanged) {
+                            auto &state{pageStates[pageAddress]};
+                            if (auto stale{stalePageStates.find(pageAddress)}; stale != stalePageStates.end())
+                                state = stale->second;
+                            return state;
+                        }
+                        return pageStates[pageAddress];
+                    }()};
+
+                    if (pageState.backing != page.data() || pageState.hash != hash) {
+                        pageState = {page.data(), hash};
+
+                        if (!runSize) {
+                            runAddress = pageAddress;
+                            runStart = page.data();
+                        }
+                        runSize += page.size();
+                    } else if (runSize) {
+                        WriteMemory(runAddress, span<u8>{runStart, runSize});
+                        runSize = 0;
+                    }
+                }
+
+                if (runSize)
+                    WriteMemory(runAddress, span<u8>{runStart, runSize});
+
+                gpuAddress += range.size();
+            }
+        }
+
+        stalePageStates.clear();
+    }
+
+    void GpfifoCapture::Submit(size_t entryCount, bool captureMemory) {
+        std::scoped_lock lock{submissionMutex};
+        submissions.push(Submission{entryCount, captureMemory});
+    }
+
+    void GpfifoCapture::BeginGpEntry(GMMU &gmmu) {
+        if (!submissionRemaining) {
+            Submission submission{};
+            {
+                std::scoped_lock lock{submissionMutex};
+                if (submissions.empty())
+                    throw exception("GpEntry was processed without a recorded submission");
+                submission = submissions.front();
+                submissions.pop();
+            }
+
+            submissionRemaining = submission.entryCount;
+            if (submission.captureMemory)
+                CaptureMemory(gmmu);
+        }
+
+        submissionRemaining--;
+    }
+
+    void GpfifoCapture::CapturePushBuffer(GpEntry entry, span<const u32> pushBuffer, GMMU &gmmu) {
+        CaptureGmmuMappings(gmmu);
+
+        PushBufferRecord record{
+            .gpuAddress = entry.Address(),
+            .size = static_cast<u32>(pushBuffer.size()),
+        };
+
+        WriteRecordHeader(RecordType::PushBuffer, sizeof(record) + pushBuffer.size_bytes());
+        Write(span<PushBufferRecord>{record}.cast<u8>());
+        Write(pushBuffer.cast<const u8>());
+    }
+}
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <fstream>
+#include <queue>
+#include <unordered_map>
+#include <lz4frame.h>
+#include <common.h>
+#include "gmmu.h"
+
+namespace skyline::soc::gm20b {
+    struct GpEntry;
+
+    /**
+     * @brief Writes a trace of all pushbuffers processed by a channel and the guest memory they can reference into an LZ4 frame compressed file, so the GPU command stream of a title can be inspected with scripts/decode_gpfifo_capture.py or replayed with the gpfifo_replay host tool
+     * @note The trace consists of a header followed by a sequence of records, each of which is a RecordHeader followed by its payload
+     * @note The capture starts alongside the channel so every macro upload and all inline data is contained in the captured command stream
+     * @note The contents of all mapped memory are captured prior to the first submission from the guest and only pages that have changed since are captured prior to subsequent ones, detecting changes requires hashing all mapped memory on every submission which is very slow
+     */
+    class GpfifoCapture {
+      public:
+        static constexpr u32 Magic{util::MakeMagic<u32>("GPCT")}; //!< The magic value used to identify a GPFIFO trace
+        static constexpr u32 Version{3}; //!< The version of the trace format, this MUST be incremented for any format changes
+        static constexpr size_t PageSize{GmmuSmallPageSize}; //!< The granularity at which changes to memory are detected and captured
+        static constexpr size_t MaxMemoryRecordSize{0x1000000}; //!< The maximum size of the memory captured in a single MemoryRecord, larger runs of changed pages are split into multiple records
+
+        struct Header {
+            u32 magic{Magic};
+            u32 version{Version};
+        };
+
+        enum class RecordType : u32 {
+            PushBuffer = 0, //!< A PushBufferRecord followed by the pushbuffer words
+            GmmuMappings = 1, //!< A GmmuMappingsRecord followed by a GmmuMapping for every mapped region of the channel's address space
+            Memory = 2, //!< A MemoryRecord followed by the contents of the memory
+        };
+
+        struct RecordHeader {
+            RecordType type;
+            u32 size; //!< The size of the payload following this header in bytes
+            u64 timestamp; //!< The time the record was written at in nanoseconds, relative to the start of the capture
+        };
+
+        struct PushBufferRecord {
+            u64 gpuAddress; //!< The GPU address of the pushbuffer
+            u32 size; //!< The size of the pushbuffer in words
+            u32 _pad_;
+        };
+
+        /**
+         * @note This replaces all mappings from any prior GmmuMappingsRecord
+         */
+        struct GmmuMappingsRecord {
+            u64 count; //!< The amount of GmmuMapping structures following this
+        };
+
+        struct GmmuMapping {
+            u64 gpuAddress;
+            u64 size;
+            u32 sparse; //!< If the region is sparsely mapped, these read as zero and ignore writes
+            u32 _pad_;
+        };
+
+        /**
+         * @note The memory is always contained within a single non-sparse mapping from the latest GmmuMappingsRecord
+         */
+        struct MemoryRecord {
+            u64 gpuAddress; //!< The page-aligned GPU address of the memory
+            u64 size; //!< The size of the memory in bytes, this is a multiple of the page size
+        };
+
+      private:
+        std::ofstream stream;
+        LZ4F_cctx *context{};
+        std::vector<u8> compressedBuffer; //!< A scratch buffer for compressed data prior to it being written to the file
+        i64 startTime; //!< The time at which the capture was started
+        std::optional<u64> mappingGeneration; //!< The generation of the GMMU mappings that were last recorded
+        std::vector<GmmuMapping> mappings; //!< The mappings of the GMMU that were last recorded
+
+        /**
+         * @brief The state of a page of GPU memory at the time it was last captured
+         */
+        struct PageState {
+            u8 *backing; //!< The CPU memory backing the page, a page is recaptured if this changes due to it being remapped
+            u64 hash; //!< The XXH64 hash of the page contents
+        };
+        std::unordered_map<u64, PageState> pageStates; //!< A map from the GPU address of every captured page to its state
+        std::unordered_map<u64, PageState> stalePageStates; //!< A scratch map used to discard the states of pages which are no longer mapped
+        std::optional<u64> pageStatesGeneration; //!< The generation of the GMMU mappings that the page states were last pruned against
+
+        struct Submission {
+            size_t entryCount;
+            bool captureMemory; //!< If guest memory should be captured prior to the submission being processed
+        };
+        std::mutex submissionMutex; //!< Synchronizes access to the submission queue as submissions are recorded on guest threads
+        std::queue<Submission> submissions; //!< Submissions which haven't started being processed yet, in the order they were pushed
+        size_t submissionRemaining{}; //!< The amount of GpEntries from the current submission that haven't been processed yet
+
+        /**
+         * @brief Writes the header of a record with the supplied payload size
+         */
+        void WriteRecordHeader(RecordType type, size_t size);
+
+        /**
+         * @brief Records the mappings of the GMMU if they've changed since they were last recorded
+         */
+        void CaptureGmmuMappings(GMMU &gmmu);
+
+        /**
+         * @brief Writes a MemoryRecord for the supplied page-aligned memory, splitting it into multiple records if required
+         */
+        void WriteMemory(u64 gpuAddress, span<u8> memory);
+
+        /**
+         * @brief Compresses the supplied data and writes it to the file
+         */
+        void Write(span<const u8> data);
+
+        /**
+         * @brief Appends the contents of all mapped pages which have changed since they were last captured to the trace, it's preceded by the GMMU mappings if they've changed
+         */
+        void CaptureMemory(GMMU &gmmu);
+
+      public:
+        /**
+         * @param path The path of the trace file, any missing parent directories will be created
+         */
+        GpfifoCapture(const std::string &path);
+
+        ~GpfifoCapture();
+
+        /**
+         * @brief Records a submission of GpEntries to the channel, this must be called prior to the entries being pushed and in the same order as them
+         * @param captureMemory If guest memory should be captured prior to the submission being processed
+         */
+        void Submit(size_t entryCount, bool captureMemory);
+
+        /**
+         * @brief Captures guest memory if the GpEntry that's about to be processed starts a submission that requires it, this must be called for every GpEntry with the channel locked
+         */
+        void BeginGpEntry(GMMU &gmmu);
+
+        /**
+         * @brief Appends the pushbuffer contained within the given GpEntry to the trace, it's preceded by the GMMU mappings if they've changed
+         */
+        void CapturePushBuffer(GpEntry entry, span<const u32> pushBuffer, GMMU &gmmu);
+    };
+}
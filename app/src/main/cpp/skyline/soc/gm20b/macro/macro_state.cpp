@@ -7,30 +7,78 @@
 
 namespace skyline::soc::gm20b {
     namespace macro_hle {
-        void DrawInstanced(size_t offset, span<u32> args, engine::MacroEngineBase *targetEngine) {
-            u32 instanceCount{targetEngine->ReadMethodFromMacro(0xD1B) & args[2]};
+        /**
+         * @return If any of the supplied arguments may have pending GPU writes
+         */
+        static bool AnyDirty(span<MacroArgument> args) {
+            return std::any_of(args.begin(), args.end(), [](const MacroArgument &arg) { return arg.dirty; });
+        }
+
+        /**
+         * @return If the supplied arguments are laid out sequentially in GPU memory, allowing them to be consumed in-place as an indirect draw structure
+         */
+        static bool IsContiguous(span<MacroArgument> args) {
+            for (size_t i{}; i < args.size(); i++)
+                if (!args[i].address || args[i].address != args.front().address + i * sizeof(u32))
+                    return false;
 
-            targetEngine->DrawInstanced(true, args[0], args[1], instanceCount, args[3], args[4]);
+            return true;
         }
 
-        void DrawIndexedInstanced(size_t offset, span<u32> args, engine::MacroEngineBase *targetEngine) {
-            u32 instanceCount{targetEngine->ReadMethodFromMacro(0xD1B) & args[2]};
+        bool DrawInstanced(size_t offset, span<MacroArgument> args, engine::MacroEngineBase *targetEngine) {
+            u32 instanceMask{targetEngine->ReadMethodFromMacro(0xD1B)};
+
+            if (AnyDirty(args)) {
+                // The draw parameters were written by the GPU and are laid out identically to VkDrawIndirectCommand, so they can be consumed in-place without waiting on the GPU
+                auto drawArgs{args.subspan(1, 4)};
+                if (args[0].dirty || instanceMask != std::numeric_limits<u32>::max() || !IsContiguous(drawArgs))
+                    return false;
+
+                return targetEngine->DrawIndirect(*args[0], false, drawArgs.front().address, 1, 0, 0);
+            }
 
-            targetEngine->DrawIndexedInstanced(true, args[0], args[1], instanceCount, args[3], args[4], args[5]);
+            targetEngine->DrawInstanced(true, *args[0], *args[1], *args[2] & instanceMask, *args[3], *args[4]);
+            return true;
         }
 
-        void DrawInstancedIndexedWithConstantBuffer(size_t offset, span<u32> args, engine::MacroEngineBase *targetEngine) {
+        bool DrawIndexedInstanced(size_t offset, span<MacroArgument> args, engine::MacroEngineBase *targetEngine) {
+            u32 instanceMask{targetEngine->ReadMethodFromMacro(0xD1B)};
+
+            if (AnyDirty(args)) {
+                // See DrawInstanced, the parameters are laid out identically to VkDrawIndexedIndirectCommand
+                auto drawArgs{args.subspan(1, 5)};
+                if (args[0].dirty || instanceMask != std::numeric_limits<u32>::max() || !IsContiguous(drawArgs))
+                    return false;
+
+                return targetEngine->DrawIndirect(*args[0], true, drawArgs.front().address, 1, 0, 0);
+            }
+
+            // The first index precedes the base vertex in the parameters, matching the layout of indirect draw structures
+            targetEngine->DrawIndexedInstanced(true, *args[0], *args[1], *args[2] & instanceMask, *args[4], *args[3], *args[5]);
+            return true;
+        }
+
+        bool DrawInstancedIndexedWithConstantBuffer(size_t offset, span<MacroArgument> args, engine::MacroEngineBase *targetEngine) {
+            // The base vertex and instance need to be written into a constant buffer which can't be done with GPU-resident parameters
+            if (AnyDirty(args))
+                return false;
+
             // Writes globalBaseVertexIndex and globalBaseInstanceIndex to the bound constant buffer before performing a standard instanced indexed draw
-            u32 instanceCount{targetEngine->ReadMethodFromMacro(0xD1B) & args[2]};
+            u32 instanceCount{targetEngine->ReadMethodFromMacro(0xD1B) & *args[2]};
             targetEngine->CallMethodFromMacro(0x8e3, 0x640);
-            targetEngine->CallMethodFromMacro(0x8e4, args[4]);
-            targetEngine->CallMethodFromMacro(0x8e5, args[5]);
-            targetEngine->DrawIndexedInstanced(false, args[0], args[1], instanceCount, args[4], args[3], args[5]);
+            targetEngine->CallMethodFromMacro(0x8e4, *args[4]);
+            targetEngine->CallMethodFromMacro(0x8e5, *args[5]);
+            targetEngine->DrawIndexedInstanced(false, *args[0], *args[1], instanceCount, *args[4], *args[3], *args[5]);
             targetEngine->CallMethodFromMacro(0x8e3, 0x640);
             targetEngine->CallMethodFromMacro(0x8e4, 0x0);
             targetEngine->CallMethodFromMacro(0x8e5, 0x0);
+            return true;
         }
 
+        /**
+         * @brief An entry in the HLE registry, a macro is matched by the hash of its first `size` words of code
+         * @note Adding support for a new macro only requires adding an entry with its size and XXH32 hash here
+         */
         struct HleFunctionInfo {
             Function function;
             u64 size;
@@ -50,7 +98,7 @@ namespace skyline::soc::gm20b {
 
                 auto macro{code.subspan(0, function.size)};
 
-                if (XXH32(code.data(), code.size_bytes(), 0) == function.hash)
+                if (XXH32(macro.data(), macro.size_bytes(), 0) == function.hash)
                     return function.function;
             }
 
@@ -62,7 +110,7 @@ namespace skyline::soc::gm20b {
         invalidatePending = true;
     }
 
-    void MacroState::Execute(u32 position, span<u32> args, engine::MacroEngineBase *targetEngine) {
+    void MacroState::Execute(u32 position, span<MacroArgument> args, engine::MacroEngineBase *targetEngine) {
         size_t offset{macroPositions[position]};
 
         if (invalidatePending) {
@@ -77,9 +125,17 @@ namespace skyline::soc::gm20b {
             hleEntry.valid = true;
         }
 
-        if (macroHleFunctions[position].function)
-            macroHleFunctions[position].function(offset, args, targetEngine);
-        else
-            macroInterpreter.Execute(offset, args, targetEngine);
+        if (hleEntry.function && hleEntry.function(offset, args, targetEngine))
+            return;
+
+        // The interpreter reads arguments on the CPU, so any GPU writes to them must be complete beforehand
+        if (macro_hle::AnyDirty(args))
+            targetEngine->FlushGpuWork();
+
+        interpreterArguments.clear();
+        for (const auto &arg : args)
+            interpreterArguments.push_back(*arg);
+
+        macroInterpreter.Execute(offset, interpreterArguments, targetEngine);
     }
 }
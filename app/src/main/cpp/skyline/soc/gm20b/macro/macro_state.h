@@ -7,8 +7,29 @@
 #include "macro_interpreter.h"
 
 namespace skyline::soc::gm20b {
+    /**
+     * @brief A single argument passed to a macro alongside where it was sourced from
+     * @note Arguments that lie in memory with pending GPU writes aren't read on the CPU until they're required as that would require waiting on the GPU, HLE functions can instead consume them directly on the GPU through their address
+     */
+    struct MacroArgument {
+        u32 raw{}; //!< The value of the argument, this is only valid if `dirty` is false
+        bool dirty{}; //!< If the argument lies in memory that may have pending GPU writes
+        u32 *argumentPtr{}; //!< A pointer to the argument in guest memory, this is only valid if `dirty` is true
+        u64 address{}; //!< The GPU virtual address of the argument, this is zero if the argument wasn't sourced from the pushbuffer (e.g. immediate data)
+
+        /**
+         * @note Dirty arguments **must** only be read after all pending GPU work has been flushed with MacroEngineBase::FlushGpuWork
+         */
+        u32 operator*() const {
+            return dirty ? *argumentPtr : raw;
+        }
+    };
+
     namespace macro_hle {
-        using Function = void (*)(size_t offset, span<u32> args, engine::MacroEngineBase *targetEngine);
+        /**
+         * @return If the macro was handled, if false is returned the macro will be executed by the interpreter instead
+         */
+        using Function = bool (*)(size_t offset, span<MacroArgument> args, engine::MacroEngineBase *targetEngine);
     }
 
     /**
@@ -24,12 +45,17 @@ namespace skyline::soc::gm20b {
         std::array<u32, 0x2000> macroCode{}; //!< Stores GPU macros, writes to it will wraparound on overflow
         std::array<size_t, 0x80> macroPositions{}; //!< The positions of each individual macro in macro code memory, there can be a maximum of 0x80 macros at any one time
         std::array<MacroHleEntry, 0x80> macroHleFunctions{}; //!< The HLE functions for each macro position, used to optionally override the interpreter
+        std::vector<u32> interpreterArguments; //!< Persistent vector storing resolved arguments for the interpreter to avoid constant reallocations
         bool invalidatePending{};
 
         MacroState() : macroInterpreter(macroCode) {}
 
         void Invalidate();
 
-        void Execute(u32 position, span<u32> args, engine::MacroEngineBase *targetEngine);
+        /**
+         * @brief Executes the macro at the supplied position with either a matching HLE function or the interpreter
+         * @note Any dirty arguments will be resolved by flushing GPU work prior to using the interpreter
+         */
+        void Execute(u32 position, span<MacroArgument> args, engine::MacroEngineBase *targetEngine);
     };
 }
@@ -16,8 +16,9 @@ namespace skyline::soc::host1x {
     class Host1x {
       public:
         SyncpointSet syncpoints;
+        FrameStore frameStore; //!< Frames decoded by NVDEC for compositing by the VIC, these are on separate channels
         std::array<ChannelCommandFifo, ChannelCount> channels;
 
-        Host1x(const DeviceState &state) : channels{util::MakeFilledArray<ChannelCommandFifo, ChannelCount>(state, syncpoints)} {}
+        Host1x(const DeviceState &state) : channels{util::MakeFilledArray<ChannelCommandFifo, ChannelCount>(state, syncpoints, frameStore)} {}
     };
 }
@@ -0,0 +1,546 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <media/NdkMediaFormat.h>
+#include <common/trace.h>
+#include "nvdec_picture_info.h"
+#include "media_codec_decoder.h"
+
+namespace skyline::soc::host1x {
+    constexpr i64 InputTimeoutUs{100000}; //!< The maximum duration to wait for an input buffer to become available
+    constexpr i64 OutputTimeoutUs{20000}; //!< The maximum duration to wait for a submitted frame to be decoded, decoders which delay output for reordering only hit this for the first few frames
+    constexpr u64 FrameDurationUs{33333}; //!< The duration used to generate presentation timestamps, decoders only use these to associate input and output frames
+
+    /**
+     * @url https://developer.android.com/reference/android/media/MediaCodecInfo.CodecCapabilities
+     */
+    enum class ColorFormat : i32 {
+        Yuv420Planar = 19,
+        Yuv420SemiPlanar = 21,
+        Yuv420Flexible = 0x7F420888,
+        QcomYuv420PackedSemiPlanar32m = 0x7FA30C04, //!< NV12 with the stride aligned to 128 and the slice height aligned to 32, it's output by Qualcomm decoders
+    };
+
+    /**
+     * @brief Writes a single H.264 NAL unit with emulation prevention into a byte stream in the Annex B format
+     */
+    class H264NalWriter {
+      private:
+        std::vector<u8> &output;
+        u8 bits{}; //!< The bits of the byte currently being written, they're filled from the MSB
+        u8 bitCount{};
+        u8 zeroCount{}; //!< The amount of consecutive zero bytes that were written
+
+        void WriteByte(u8 byte) {
+            // Two consecutive zero bytes followed by a byte below 4 could be mistaken for a start code, an emulation prevention byte is inserted to break the sequence
+            if (zeroCount >= 2 && byte <= 3) {
+                output.push_back(3);
+                zeroCount = 0;
+            }
+
+            output.push_back(byte);
+            zeroCount = byte ? 0 : static_cast<u8>(zeroCount + 1);
+        }
+
+      public:
+        H264NalWriter(std::vector<u8> &output, u8 nalUnitType) : output{output} {
+            output.insert(output.end(), {0, 0, 0, 1});
+            output.push_back(static_cast<u8>((3 << 5) | nalUnitType)); // nal_ref_idc is always 3 as parameter sets are always referenced
+        }
+
+        void WriteBits(u32 value, u8 count) {
+            for (u8 index{count}; index-- > 0;) {
+                bits = static_cast<u8>((bits << 1) | ((value >> index) & 1));
+                if (++bitCount == 8) {
+                    WriteByte(bits);
+                    bits = 0;
+                    bitCount = 0;
+                }
+            }
+        }
+
+        void WriteBit(bool value) {
+            WriteBits(value ? 1 : 0, 1);
+        }
+
+        /**
+         * @brief Writes an unsigned Exp-Golomb code
+         */
+        void WriteUe(u32 value) {
+            auto codeNum{static_cast<u64>(value) + 1};
+            auto length{static_cast<u8>(std::bit_width(codeNum))};
+            WriteBits(0, static_cast<u8>(length - 1));
+            for (u8 index{length}; index-- > 0;)
+                WriteBit((codeNum >> index) & 1);
+        }
+
+        /**
+         * @brief Writes a signed Exp-Golomb code
+         */
+        void WriteSe(i32 value) {
+            WriteUe(value > 0 ? (static_cast<u32>(value) * 2) - 1 : static_cast<u32>(-static_cast<i64>(value)) * 2);
+        }
+
+        /**
+         * @brief Writes a scaling list as deltas between consecutive entries in zig-zag order
+         * @param list The scaling list in raster order
+         * @param scan The zig-zag scan order of the list
+         */
+        void WriteScalingList(span<const u8> list, span<const u8> scan) {
+            i32 lastScale{8};
+            for (auto position : scan) {
+                i32 scale{list[position]};
+                i32 deltaScale{scale - lastScale};
+                // delta_scale is restricted to [-128, 127] but it's applied modulo 256 so any delta can be wrapped into the range
+                WriteSe(deltaScale > 127 ? deltaScale - 256 : (deltaScale < -128 ? deltaScale + 256 : deltaScale));
+                lastScale = scale;
+            }
+        }
+
+        /**
+         * @brief Writes the RBSP trailing bits which terminate the NAL unit
+         */
+        void Finish() {
+            WriteBit(true);
+            if (bitCount)
+                WriteBits(0, static_cast<u8>(8 - bitCount));
+        }
+    };
+
+    MediaCodecDecoder::~MediaCodecDecoder() {
+        Release();
+    }
+
+    bool MediaCodecDecoder::Configure(VideoCodec type, u32 frameWidth, u32 frameHeight) {
+        Release();
+        if (std::find(unavailableCodecs.begin(), unavailableCodecs.end(), type) != unavailableCodecs.end())
+            return false;
+
+        const char *mimeType{type == VideoCodec::H264 ? "video/avc" : (type == VideoCodec::Vp8 ? "video/x-vnd.on2.vp8" : "video/x-vnd.on2.vp9")};
+        codec = AMediaCodec_createDecoderByType(mimeType);
+        if (!codec) {
+            Logger::Warn("No MediaCodec decoder is available for '{}'", mimeType);
+            unavailableCodecs.push_back(type);
+            return false;
+        }
+
+        auto format{AMediaFormat_new()};
+        AMediaFormat_setString(format, AMEDIAFORMAT_KEY_MIME, mimeType);
+        AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_WIDTH, static_cast<i32>(frameWidth));
+        AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_HEIGHT, static_cast<i32>(frameHeight));
+        AMediaFormat_setInt32(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, static_cast<i32>(ColorFormat::Yuv420Flexible));
+        AMediaFormat_setInt32(format, "low-latency", 1); // Decoders don't hold onto frames for longer than the codec requires in this mode, AMEDIAFORMAT_KEY_LOW_LATENCY is only declared from API 30 and older decoders ignore the key
+        auto status{AMediaCodec_configure(codec, format, nullptr, nullptr, 0)};
+        AMediaFormat_delete(format);
+        if (status == AMEDIA_OK)
+            status = AMediaCodec_start(codec);
+
+        if (status != AMEDIA_OK) {
+            Logger::Warn("Failed to start MediaCodec decoder for '{}' at {}x{}: {}", mimeType, frameWidth, frameHeight, static_cast<i32>(status));
+            AMediaCodec_delete(codec);
+            codec = nullptr;
+            unavailableCodecs.push_back(type);
+            return false;
+        }
+
+        Logger::Info("Started MediaCodec decoder for '{}' at {}x{}", mimeType, frameWidth, frameHeight);
+        codecType = type;
+        width = frameWidth;
+        height = frameHeight;
+        inputCount = 0;
+        parameterSets.clear();
+        vp9Composer.Reset();
+        hiddenVp9Frames.clear();
+        // Decoders are only required to report the output format prior to the first frame when it differs from the configured one
+        outputFormat = {
+            .colorFormat = static_cast<i32>(ColorFormat::Yuv420SemiPlanar),
+            .width = frameWidth,
+            .height = frameHeight,
+            .stride = frameWidth,
+            .sliceHeight = frameHeight,
+        };
+        return true;
+    }
+
+    void MediaCodecDecoder::Release() {
+        if (codec) {
+            // The held frame is the last one of the stream, it's assumed to be shown as there's no following frame
+            if (heldVp9Frame)
+                SubmitHeldVp9Frame(true);
+
+            // The end of the stream is signalled so the decoder outputs any frames it's holding back, they'd be lost otherwise
+            auto inputIndex{AMediaCodec_dequeueInputBuffer(codec, InputTimeoutUs)};
+            if (inputIndex >= 0 && AMediaCodec_queueInputBuffer(codec, static_cast<size_t>(inputIndex), 0, 0, inputCount * FrameDurationUs, AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM) == AMEDIA_OK)
+                DrainOutput(OutputTimeoutUs, true);
+
+            AMediaCodec_stop(codec);
+            AMediaCodec_delete(codec);
+            codec = nullptr;
+            codecType = VideoCodec::None;
+        }
+
+        while (!pendingFrames.empty())
+            CompletePendingFrame(pendingFrames.begin(), nullptr);
+    }
+
+    void MediaCodecDecoder::ComposeH264Frame(const DecodeRequest &request) {
+        constexpr std::array<u8, 16> ZigZagScan4x4{0, 1, 4, 8, 5, 2, 3, 6, 9, 12, 13, 10, 7, 11, 14, 15};
+        constexpr std::array<u8, 64> ZigZagScan8x8{
+            0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+            12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+            35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+            58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+        };
+        constexpr u8 SpsNalUnitType{7}, PpsNalUnitType{8};
+        constexpr u8 HighProfile{100};
+        constexpr u8 Level51{51}; //!< The highest level that's commonly supported, the parameters of the stream aren't known so it must be high enough to not constrain them
+        constexpr u32 Level51MaxDpbMbs{184320}; //!< The maximum size of the decoded picture buffer in macroblocks at level 5.1 (Table A-1)
+        constexpr u32 MaxDpbFrames{16};
+
+        if (request.pictureInfo.size() < sizeof(H264PictureInfo))
+            throw exception("H.264 picture setup is too small: 0x{:X}", request.pictureInfo.size());
+        H264PictureInfo info;
+        std::memcpy(&info, request.pictureInfo.data(), sizeof(H264PictureInfo));
+
+        // The amount of reference frames isn't supplied to NVDEC, the maximum that the level allows for the frame size is used instead
+        u32 frameHeightInMbs{static_cast<u32>(info.frameHeightInMapUnits * (info.frameMbsOnlyFlag ? 1 : 2))};
+        u32 maxNumRefFrames{std::clamp(Level51MaxDpbMbs / std::max(info.picWidthInMbs * frameHeightInMbs, 1U), 1U, MaxDpbFrames)};
+
+        std::vector<u8> sets;
+        {
+            H264NalWriter sps{sets, SpsNalUnitType};
+            sps.WriteBits(HighProfile, 8);
+            sps.WriteBits(0, 8); // Constraint flags
+            sps.WriteBits(Level51, 8);
+            sps.WriteUe(0); // seq_parameter_set_id
+            sps.WriteUe(static_cast<u32>(info.chromaFormatIdc));
+            if (info.chromaFormatIdc == 3)
+                sps.WriteBit(false); // separate_colour_plane_flag
+            sps.WriteUe(0); // bit_depth_luma_minus8
+            sps.WriteUe(0); // bit_depth_chroma_minus8
+            sps.WriteBit(false); // qpprime_y_zero_transform_bypass_flag
+            sps.WriteBit(false); // seq_scaling_matrix_present_flag, the scaling lists are supplied in the PPS instead
+            sps.WriteUe(static_cast<u32>(info.log2MaxFrameNumMinus4));
+            sps.WriteUe(static_cast<u32>(info.picOrderCntType));
+            if (info.picOrderCntType == 0) {
+                sps.WriteUe(static_cast<u32>(info.log2MaxPicOrderCntLsbMinus4));
+            } else if (info.picOrderCntType == 1) {
+                // The picture order count cycle isn't supplied to NVDEC as it only requires the resulting picture order counts, an empty cycle is the closest approximation
+                sps.WriteBit(info.deltaPicOrderAlwaysZeroFlag != 0);
+                sps.WriteSe(0); // offset_for_non_ref_pic
+                sps.WriteSe(0); // offset_for_top_to_bottom_field
+                sps.WriteUe(0); // num_ref_frames_in_pic_order_cnt_cycle
+            }
+            sps.WriteUe(maxNumRefFrames);
+            sps.WriteBit(false); // gaps_in_frame_num_value_allowed_flag
+            sps.WriteUe(info.picWidthInMbs - 1);
+            sps.WriteUe(info.frameHeightInMapUnits - 1);
+            sps.WriteBit(info.frameMbsOnlyFlag != 0);
+            if (!info.frameMbsOnlyFlag)
+                sps.WriteBit(info.mbaffFrame);
+            sps.WriteBit(info.direct8x8Inference);
+            sps.WriteBit(false); // frame_cropping_flag
+            sps.WriteBit(false); // vui_parameters_present_flag
+            sps.Finish();
+        }
+        {
+            H264NalWriter pps{sets, PpsNalUnitType};
+            pps.WriteUe(0); // pic_parameter_set_id
+            pps.WriteUe(0); // seq_parameter_set_id
+            pps.WriteBit(info.entropyCodingModeFlag != 0);
+            pps.WriteBit(info.picOrderPresentFlag != 0);
+            pps.WriteUe(0); // num_slice_groups_minus1
+            pps.WriteUe(static_cast<u32>(info.numRefIdxL0ActiveMinus1));
+            pps.WriteUe(static_cast<u32>(info.numRefIdxL1ActiveMinus1));
+            pps.WriteBit(info.weightedPred);
+            pps.WriteBits(static_cast<u32>(info.weightedBipredIdc), 2);
+            pps.WriteSe(static_cast<i32>(info.picInitQpMinus26));
+            pps.WriteSe(0); // pic_init_qs_minus26
+            pps.WriteSe(static_cast<i32>(info.chromaQpIndexOffset));
+            pps.WriteBit(info.deblockingFilterControlPresentFlag != 0);
+            pps.WriteBit(info.constrainedIntraPred);
+            pps.WriteBit(info.redundantPicCntPresentFlag != 0);
+            pps.WriteBit(info.transform8x8ModeFlag != 0);
+            pps.WriteBit(true); // pic_scaling_matrix_present_flag
+            for (size_t index{}; index < 6; index++) {
+                pps.WriteBit(true); // pic_scaling_list_present_flag
+                pps.WriteScalingList(span(info.weightScale4x4).subspan(index * ZigZagScan4x4.size(), ZigZagScan4x4.size()), ZigZagScan4x4);
+            }
+            if (info.transform8x8ModeFlag) {
+                for (size_t index{}; index < 2; index++) {
+                    pps.WriteBit(true); // pic_scaling_list_present_flag
+                    pps.WriteScalingList(span(info.weightScale8x8).subspan(index * ZigZagScan8x8.size(), ZigZagScan8x8.size()), ZigZagScan8x8);
+                }
+            }
+            pps.WriteSe(static_cast<i32>(info.secondChromaQpIndexOffset));
+            pps.Finish();
+        }
+
+        // The parameter sets are retained by the decoder, they only need to be resubmitted when they change
+        frameData.clear();
+        if (sets != parameterSets) {
+            parameterSets = std::move(sets);
+            frameData.insert(frameData.end(), parameterSets.begin(), parameterSets.end());
+        }
+        frameData.insert(frameData.end(), request.bitstream.begin(), request.bitstream.end());
+    }
+
+    void MediaCodecDecoder::ComposeVp8Frame(const DecodeRequest &request) {
+        if (request.pictureInfo.size() < sizeof(Vp8PictureInfo))
+            throw exception("VP8 picture setup is too small: 0x{:X}", request.pictureInfo.size());
+        Vp8PictureInfo info;
+        std::memcpy(&info, request.pictureInfo.data(), sizeof(Vp8PictureInfo));
+
+        // The frame tag is 3 bytes long: a bit for the frame type (0 = key frame), 3 bits for the version, a bit for show_frame and 19 bits for the size of the first partition
+        // Key frames are additionally followed by a start code and the frame dimensions (RFC 6386 Section 9.1)
+        bool keyFrame{info.keyFrame != 0};
+        u32 frameTag{(keyFrame ? 0U : 1U) | ((info.version & 0x7U) << 1) | (1U << 4) | ((info.firstPartSize & 0x7FFFFU) << 5)};
+        frameData.clear();
+        frameData.insert(frameData.end(), {static_cast<u8>(frameTag), static_cast<u8>(frameTag >> 8), static_cast<u8>(frameTag >> 16)});
+        if (keyFrame)
+            frameData.insert(frameData.end(), {
+                0x9D, 0x01, 0x2A,
+                static_cast<u8>(info.frameWidth), static_cast<u8>((info.frameWidth >> 8) & 0x3F), // The upper 2 bits are the horizontal scale which NVDEC doesn't supply
+                static_cast<u8>(info.frameHeight), static_cast<u8>((info.frameHeight >> 8) & 0x3F),
+            });
+        frameData.insert(frameData.end(), request.bitstream.begin(), request.bitstream.end());
+    }
+
+    void MediaCodecDecoder::ComposeVp9Frame(const DecodeRequest &request, bool showFrame) {
+        if (request.pictureInfo.size() < sizeof(Vp9PictureInfo) || request.entropyProbs.size() < sizeof(Vp9EntropyProbs))
+            throw exception("VP9 picture setup is too small: 0x{:X}", request.pictureInfo.size());
+        Vp9PictureInfo info;
+        std::memcpy(&info, request.pictureInfo.data(), sizeof(Vp9PictureInfo));
+        Vp9EntropyProbs probs;
+        std::memcpy(&probs, request.entropyProbs.data(), sizeof(Vp9EntropyProbs));
+
+        vp9Composer.Compose(info, probs, request.surfaceAddress, request.referenceSurfaceAddresses, request.bitstream, showFrame, frameData);
+    }
+
+    void MediaCodecDecoder::UpdateOutputFormat() {
+        auto format{AMediaCodec_getOutputFormat(codec)};
+        if (!format)
+            return;
+
+        auto getInt32{[&](const char *key, u32 fallback) -> u32 {
+            i32 value{};
+            return (AMediaFormat_getInt32(format, key, &value) && value > 0) ? static_cast<u32>(value) : fallback;
+        }};
+
+        i32 colorFormat{};
+        if (AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, &colorFormat))
+            outputFormat.colorFormat = colorFormat;
+        outputFormat.width = getInt32(AMEDIAFORMAT_KEY_WIDTH, outputFormat.width);
+        outputFormat.height = getInt32(AMEDIAFORMAT_KEY_HEIGHT, outputFormat.height);
+
+        bool qcomFormat{outputFormat.colorFormat == static_cast<i32>(ColorFormat::QcomYuv420PackedSemiPlanar32m)};
+        outputFormat.stride = getInt32(AMEDIAFORMAT_KEY_STRIDE, qcomFormat ? util::AlignUp(outputFormat.width, 128) : outputFormat.width);
+        outputFormat.sliceHeight = getInt32(AMEDIAFORMAT_KEY_SLICE_HEIGHT, qcomFormat ? util::AlignUp(outputFormat.height, 32) : outputFormat.height);
+
+        // The crop rectangle is inclusive on all edges
+        i32 left{}, top{}, right{}, bottom{};
+        if (AMediaFormat_getRect(format, AMEDIAFORMAT_KEY_DISPLAY_CROP, &left, &top, &right, &bottom) && left >= 0 && top >= 0 && right >= left && bottom >= top) {
+            outputFormat.cropLeft = static_cast<u32>(left);
+            outputFormat.cropTop = static_cast<u32>(top);
+            outputFormat.width = static_cast<u32>(right - left + 1);
+            outputFormat.height = static_cast<u32>(bottom - top + 1);
+        } else {
+            outputFormat.cropLeft = 0;
+            outputFormat.cropTop = 0;
+        }
+
+        AMediaFormat_delete(format);
+        Logger::Debug("MediaCodec output format: {} {}x{} (Stride: {}, Slice Height: {}, Crop: {}x{})", outputFormat.colorFormat, outputFormat.width, outputFormat.height, outputFormat.stride, outputFormat.sliceHeight, outputFormat.cropLeft, outputFormat.cropTop);
+    }
+
+    std::shared_ptr<VideoFrame> MediaCodecDecoder::CopyOutput(span<u8> buffer, u32 frameWidth, u32 frameHeight) {
+        auto frame{std::make_shared<VideoFrame>(frameWidth, frameHeight)};
+
+        // Any part of the frame that isn't covered by the decoded image is left black, this is generally just the macroblock padding that's been cropped out
+        std::fill(frame->luma.begin(), frame->luma.end(), 16);
+        std::fill(frame->chroma.begin(), frame->chroma.end(), 128);
+
+        size_t copyWidth{std::min(frameWidth, outputFormat.width)}, copyHeight{std::min(frameHeight, outputFormat.height)};
+        if (!copyWidth || !copyHeight)
+            return frame;
+
+        size_t stride{outputFormat.stride}, cropLeft{outputFormat.cropLeft}, cropTop{outputFormat.cropTop};
+        size_t lumaSize{stride * outputFormat.sliceHeight};
+        size_t chromaWidth{util::DivideCeil<size_t>(copyWidth, 2)}, chromaHeight{util::DivideCeil<size_t>(copyHeight, 2)};
+        bool planar{outputFormat.colorFormat == static_cast<i32>(ColorFormat::Yuv420Planar)};
+
+        // Formats other than planar I420 are all treated as NV12 as that's the layout of every vendor-specific format that decoders commonly output
+        size_t chromaStride{planar ? stride / 2 : stride};
+        size_t chromaOffset{lumaSize + ((cropTop / 2) * chromaStride) + (planar ? cropLeft / 2 : cropLeft & ~static_cast<size_t>(1))};
+        size_t chromaPlaneSize{chromaStride * (outputFormat.sliceHeight / 2)};
+        size_t lumaEnd{(cropTop + copyHeight - 1) * stride + cropLeft + copyWidth};
+        size_t chromaEnd{chromaOffset + ((chromaHeight - 1) * chromaStride) + (planar ? chromaPlaneSize + chromaWidth : chromaWidth * 2)};
+        if (lumaEnd > buffer.size() || chromaEnd > buffer.size()) {
+            Logger::Warn("MediaCodec output buffer is too small for its format: 0x{:X} < 0x{:X}", buffer.size(), std::max(lumaEnd, chromaEnd));
+            return nullptr;
+        }
+
+        for (size_t row{}; row < copyHeight; row++)
+            std::memcpy(frame->luma.data() + (row * frameWidth), buffer.data() + ((cropTop + row) * stride) + cropLeft, copyWidth);
+
+        size_t framePitch{frame->ChromaPitch()};
+        for (size_t row{}; row < chromaHeight; row++) {
+            auto source{buffer.data() + chromaOffset + (row * chromaStride)};
+            auto destination{frame->chroma.data() + (row * framePitch)};
+            if (planar) {
+                for (size_t column{}; column < chromaWidth; column++) {
+                    destination[column * 2] = source[column];
+                    destination[(column * 2) + 1] = source[chromaPlaneSize + column];
+                }
+            } else {
+                std::memcpy(destination, source, chromaWidth * 2);
+            }
+        }
+
+        return frame;
+    }
+
+    void MediaCodecDecoder::DrainOutput(i64 timeoutUs, bool endOfStream) {
+        while (true) {
+            AMediaCodecBufferInfo info{};
+            auto outputIndex{AMediaCodec_dequeueOutputBuffer(codec, &info, timeoutUs)};
+            if (!endOfStream)
+                timeoutUs = 0;
+
+            if (outputIndex == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED) {
+                UpdateOutputFormat();
+                continue;
+            } else if (outputIndex == AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED) {
+                continue;
+            } else if (outputIndex < 0) {
+                break;
+            }
+
+            // The frame is written into the surface of the submission it belongs to, this may not be the latest one when the decoder reorders frames
+            if (auto pending{pendingFrames.find(info.presentationTimeUs)}; pending != pendingFrames.end()) {
+                TRACE_EVENT("gpu", "MediaCodecDecoder::CopyOutput");
+                std::shared_ptr<VideoFrame> frame;
+                size_t outputSize{};
+                auto output{AMediaCodec_getOutputBuffer(codec, static_cast<size_t>(outputIndex), &outputSize)};
+                if (output && info.size > 0 && info.offset >= 0 && static_cast<size_t>(info.offset) + static_cast<size_t>(info.size) <= outputSize)
+                    frame = CopyOutput(span(output + info.offset, static_cast<size_t>(info.size)), pending->second.width, pending->second.height);
+                CompletePendingFrame(pending, std::move(frame));
+            } else if (info.size > 0) {
+                Logger::Warn("MediaCodec output a frame with an unknown timestamp: {}", info.presentationTimeUs);
+            }
+            AMediaCodec_releaseOutputBuffer(codec, static_cast<size_t>(outputIndex), false);
+
+            if (info.flags & AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM)
+                break;
+        }
+    }
+
+    void MediaCodecDecoder::CompletePendingFrame(std::map<i64, PendingFrame>::iterator it, std::shared_ptr<VideoFrame> frame) {
+        frameStore.Complete(it->second.surfaceAddress, it->second.surfaceSequence, std::move(frame));
+        pendingFrames.erase(it);
+    }
+
+    bool MediaCodecDecoder::SubmitFrame(const DecodeRequest &request, bool showFrame) {
+        if (request.codec == VideoCodec::H264) {
+            ComposeH264Frame(request);
+        } else if (request.codec == VideoCodec::Vp8) {
+            ComposeVp8Frame(request);
+        } else {
+            ComposeVp9Frame(request, showFrame);
+            if (!showFrame) {
+                // Hidden frames don't produce any output so their surfaces retain their prior contents, they're generally only used as references
+                if (hiddenVp9Frames.size() == MaxSuperframeFrames - 1) {
+                    Logger::Warn("Too many consecutive hidden VP9 frames, dropping frame {}", request.frameNumber);
+                    hiddenVp9Frames.erase(hiddenVp9Frames.begin());
+                }
+                hiddenVp9Frames.push_back(frameData);
+                frameStore.Complete(request.surfaceAddress, request.surfaceSequence, nullptr);
+                return true;
+            }
+
+            if (!hiddenVp9Frames.empty()) {
+                // The superframe index lists the size of every frame and is delimited by a marker byte on both ends (Annex B)
+                hiddenVp9Frames.push_back(std::move(frameData));
+                frameData.clear();
+                for (const auto &frame : hiddenVp9Frames)
+                    frameData.insert(frameData.end(), frame.begin(), frame.end());
+
+                constexpr u8 SuperframeSizeBytes{4};
+                u8 marker{static_cast<u8>(0b11000000 | ((SuperframeSizeBytes - 1) << 3) | (hiddenVp9Frames.size() - 1))};
+                frameData.push_back(marker);
+                for (const auto &frame : hiddenVp9Frames)
+                    for (u8 index{}; index < SuperframeSizeBytes; index++)
+                        frameData.push_back(static_cast<u8>(frame.size() >> (index * 8)));
+                frameData.push_back(marker);
+                hiddenVp9Frames.clear();
+            }
+        }
+
+        auto inputIndex{AMediaCodec_dequeueInputBuffer(codec, InputTimeoutUs)};
+        if (inputIndex < 0) {
+            Logger::Warn("No MediaCodec input buffer became available, dropping frame {}", request.frameNumber);
+            return false;
+        }
+
+        size_t inputSize{};
+        auto input{AMediaCodec_getInputBuffer(codec, static_cast<size_t>(inputIndex), &inputSize)};
+        if (!input || inputSize < frameData.size())
+            throw exception("MediaCodec input buffer is too small: 0x{:X} < 0x{:X}", inputSize, frameData.size());
+        std::memcpy(input, frameData.data(), frameData.size());
+        auto presentationTimeUs{inputCount++ * FrameDurationUs};
+        if (auto status{AMediaCodec_queueInputBuffer(codec, static_cast<size_t>(inputIndex), 0, frameData.size(), presentationTimeUs, 0)}; status != AMEDIA_OK)
+            throw exception("Failed to queue MediaCodec input buffer: {}", static_cast<i32>(status));
+
+        pendingFrames.emplace(static_cast<i64>(presentationTimeUs), PendingFrame{request.surfaceAddress, request.surfaceSequence, request.width, request.height});
+        if (pendingFrames.size() > MaxPendingFrames) {
+            // The oldest frame is the one with the lowest timestamp, it's been pending for long enough that the decoder must have dropped it
+            Logger::Debug("MediaCodec didn't output frame with timestamp {}", pendingFrames.begin()->first);
+            CompletePendingFrame(pendingFrames.begin(), nullptr);
+        }
+
+        // Only the first dequeue waits for the submitted frame to be decoded, any further frames that are ready are drained as well since decoders which reorder frames can output several at once
+        DrainOutput(OutputTimeoutUs);
+        return true;
+    }
+
+    void MediaCodecDecoder::SubmitHeldVp9Frame(bool showFrame) {
+        auto request{std::move(*heldVp9Frame)};
+        heldVp9Frame.reset();
+
+        bool submitted{};
+        try {
+            submitted = SubmitFrame(request, showFrame);
+        } catch (const std::exception &e) {
+            Logger::Warn("Failed to submit VP9 frame {}: {}", request.frameNumber, e.what());
+        }
+
+        if (!submitted)
+            frameStore.Complete(request.surfaceAddress, request.surfaceSequence, nullptr);
+    }
+
+    bool MediaCodecDecoder::Decode(const DecodeRequest &request) {
+        if (heldVp9Frame) {
+            // The picture setup of a VP9 frame specifies if the prior frame was shown, a frame of any other codec ends the VP9 stream so the held frame is assumed to be shown
+            bool showFrame{true};
+            if (request.codec == VideoCodec::Vp9 && request.pictureInfo.size() >= sizeof(Vp9PictureInfo)) {
+                Vp9PictureInfo info;
+                std::memcpy(&info, request.pictureInfo.data(), sizeof(Vp9PictureInfo));
+                showFrame = info.lastShowFrame;
+            }
+            SubmitHeldVp9Frame(showFrame);
+        }
+
+        if ((request.codec != VideoCodec::H264 && request.codec != VideoCodec::Vp8 && request.codec != VideoCodec::Vp9) || request.bitstream.empty())
+            return false;
+
+        if (!codec || codecType != request.codec || width != request.width || height != request.height)
+            if (!Configure(request.codec, request.width, request.height))
+                return false;
+
+        if (request.codec == VideoCodec::Vp9) {
+            heldVp9Frame = request;
+            return true;
+        }
+        return SubmitFrame(request, true);
+    }
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <map>
+#include <media/NdkMediaCodec.h>
+#include "nvdec.h"
+#include "vp9_frame_composer.h"
+
+namespace skyline::soc::host1x {
+    /**
+     * @brief A decoder backend for H.264, VP8 and VP9 which uses the platform's MediaCodec decoders, these are generally hardware accelerated
+     * @note NVDEC is only supplied with slice data and a picture setup structure, the parameter sets and frame headers which MediaCodec requires are reconstructed from the latter
+     * @note VP9 frames are held back until the following frame is submitted as only its picture setup specifies if they're shown, this delays their output by a frame
+     * @note MediaCodec decodes asynchronously and may output frames in display order rather than the order they were submitted in, frames are associated with the submission they belong to by their presentation timestamp
+     */
+    class MediaCodecDecoder : public VideoDecoder {
+      private:
+        /**
+         * @brief The layout of the frames output by the current MediaCodec instance
+         */
+        struct OutputFormat {
+            i32 colorFormat;
+            u32 width; //!< The width of the visible region of the frame
+            u32 height; //!< The height of the visible region of the frame
+            u32 stride; //!< The pitch of the luma plane in bytes
+            u32 sliceHeight; //!< The amount of rows in the luma plane, including any padding prior to the chroma plane
+            u32 cropLeft;
+            u32 cropTop;
+        };
+
+        /**
+         * @brief A frame which was submitted to the current MediaCodec instance and hasn't been output yet
+         */
+        struct PendingFrame {
+            u32 surfaceAddress;
+            u64 surfaceSequence;
+            u32 width;
+            u32 height;
+        };
+
+        static constexpr size_t MaxPendingFrames{32}; //!< The maximum amount of frames that can be pending output, this is far more than decoders buffer so frames beyond it are assumed to have been dropped
+        static constexpr size_t MaxSuperframeFrames{8}; //!< The maximum amount of frames in a VP9 superframe
+
+        AMediaCodec *codec{};
+        VideoCodec codecType{VideoCodec::None}; //!< The codec that the current MediaCodec instance decodes
+        u32 width{}; //!< The width that the current MediaCodec instance was configured with
+        u32 height{}; //!< The height that the current MediaCodec instance was configured with
+        OutputFormat outputFormat{};
+        u64 inputCount{}; //!< The amount of frames submitted to the current MediaCodec instance, it's used to generate presentation timestamps
+        std::map<i64, PendingFrame> pendingFrames; //!< Frames which were submitted to the current MediaCodec instance keyed by their presentation timestamp
+        std::vector<VideoCodec> unavailableCodecs; //!< Codecs which couldn't be decoded with MediaCodec, they aren't retried to avoid recreating a decoder for every frame
+        std::vector<u8> parameterSets; //!< The H.264 SPS and PPS NAL units that were last submitted to the current MediaCodec instance
+        std::vector<u8> frameData; //!< A scratch buffer for the bitstream of a frame alongside any reconstructed headers
+        Vp9FrameComposer vp9Composer;
+        std::optional<DecodeRequest> heldVp9Frame; //!< The last VP9 frame that was decoded, it's submitted once the next frame determines if it's shown
+        std::vector<std::vector<u8>> hiddenVp9Frames; //!< Composed VP9 frames which aren't shown, they're submitted in a superframe with the next shown frame as decoders expect them to be
+
+        /**
+         * @brief Creates and starts a MediaCodec instance for the supplied codec and dimensions, replacing the current one
+         * @return If the MediaCodec instance was successfully created
+         */
+        bool Configure(VideoCodec type, u32 frameWidth, u32 frameHeight);
+
+        /**
+         * @brief Outputs any frames which were decoded before stopping and destroying the current MediaCodec instance, if any
+         */
+        void Release();
+
+        /**
+         * @brief Writes the bitstream of a H.264 frame into frameData, it's preceded by an SPS and PPS reconstructed from the picture setup when they differ from the last submitted ones
+         */
+        void ComposeH264Frame(const DecodeRequest &request);
+
+        /**
+         * @brief Writes the bitstream of a VP8 frame into frameData, it's preceded by the uncompressed frame header reconstructed from the picture setup
+         */
+        void ComposeVp8Frame(const DecodeRequest &request);
+
+        /**
+         * @brief Writes the bitstream of a VP9 frame into frameData, it's preceded by the uncompressed and compressed frame headers reconstructed from the picture setup and probability tables
+         */
+        void ComposeVp9Frame(const DecodeRequest &request, bool showFrame);
+
+        /**
+         * @brief Composes a frame and submits it to the current MediaCodec instance
+         * @param showFrame If the frame is shown, this is only used for VP9
+         * @return If the frame was submitted, its decode is completed when the decoder outputs it
+         */
+        bool SubmitFrame(const DecodeRequest &request, bool showFrame);
+
+        /**
+         * @brief Submits the held VP9 frame to the current MediaCodec instance, its decode is completed without a frame if it can't be submitted
+         */
+        void SubmitHeldVp9Frame(bool showFrame);
+
+        /**
+         * @brief Updates outputFormat with the current output format of the MediaCodec instance
+         */
+        void UpdateOutputFormat();
+
+        /**
+         * @brief Converts a decoded frame from a MediaCodec output buffer into a frame of the supplied dimensions
+         * @return The converted frame or nullptr if the output buffer doesn't match the output format
+         */
+        std::shared_ptr<VideoFrame> CopyOutput(span<u8> buffer, u32 frameWidth, u32 frameHeight);
+
+        /**
+         * @brief Dequeues all decoded frames from the current MediaCodec instance and completes the decodes they belong to
+         * @param timeoutUs The maximum duration to wait for the first frame, any further frames are only dequeued if they're immediately available
+         * @param endOfStream If frames should be dequeued until the end of stream is reached, every dequeue waits for the timeout in that case
+         */
+        void DrainOutput(i64 timeoutUs, bool endOfStream = false);
+
+        /**
+         * @brief Completes the decode of a pending frame in the frame store
+         * @param frame The decoded frame or nullptr if the decoder didn't output it
+         */
+        void CompletePendingFrame(std::map<i64, PendingFrame>::iterator it, std::shared_ptr<VideoFrame> frame);
+
+      public:
+        using VideoDecoder::VideoDecoder;
+
+        ~MediaCodecDecoder() override;
+
+        bool Decode(const DecodeRequest &request) override;
+    };
+}
@@ -1,13 +1,194 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2021 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <common/trace.h>
+#include <soc.h>
+#include "nvdec_picture_info.h"
+#include "media_codec_decoder.h"
 #include "nvdec.h"
 
 namespace skyline::soc::host1x {
-    NvDecClass::NvDecClass(std::function<void()> opDoneCallback)
-        : opDoneCallback(std::move(opDoneCallback)) {}
+    /**
+     * @brief A fallback decoder which outputs black frames of the correct size, this keeps guests progressing through videos when a frame can't be decoded
+     */
+    class BlankVideoDecoder : public VideoDecoder {
+      private:
+        std::vector<VideoCodec> warnedCodecs; //!< Codecs for which a blank frame has already been output
 
-    void NvDecClass::CallMethod(u32 method, u32 argument) {
-        Logger::Warn("Unknown NVDEC class method called: 0x{:X} argument: 0x{:X}", method, argument);
+      public:
+        using VideoDecoder::VideoDecoder;
+
+        bool Decode(const DecodeRequest &request) override {
+            if (std::find(warnedCodecs.begin(), warnedCodecs.end(), request.codec) == warnedCodecs.end()) {
+                Logger::Warn("Outputting blank frames for NVDEC codec {} as it couldn't be decoded", static_cast<u32>(request.codec));
+                warnedCodecs.push_back(request.codec);
+            }
+
+            auto frame{std::make_shared<VideoFrame>(request.width, request.height)};
+            std::fill(frame->luma.begin(), frame->luma.end(), 16); // Black in limited range YCbCr
+            std::fill(frame->chroma.begin(), frame->chroma.end(), 128);
+            frameStore.Complete(request.surfaceAddress, request.surfaceSequence, std::move(frame));
+            return true;
+        }
+    };
+
+    NvDecClass::NvDecClass(std::function<void()> opDoneCallback, const DeviceState &state, FrameStore &frameStore)
+        : state{state},
+          opDoneCallback{std::move(opDoneCallback)},
+          frameStore{frameStore},
+          decoder{std::make_unique<MediaCodecDecoder>(frameStore)},
+          fallbackDecoder{std::make_unique<BlankVideoDecoder>(frameStore)} {}
+
+    NvDecClass::~NvDecClass() {
+        {
+            std::scoped_lock lock{decodeMutex};
+            exiting = true;
+        }
+        decodeCondition.notify_all();
+
+        if (thread.joinable())
+            thread.join();
+    }
+
+    template<typename PictureInfo>
+    static PictureInfo ReadPictureInfo(const DeviceState &state, u32 address, DecodeRequest &request) {
+        auto pictureInfo{state.soc->smmu.Read<PictureInfo>(address)};
+        request.pictureInfo.resize(sizeof(PictureInfo));
+        std::memcpy(request.pictureInfo.data(), &pictureInfo, sizeof(PictureInfo));
+        return pictureInfo;
+    }
+
+    void NvDecClass::Execute() {
+        TRACE_EVENT("gpu", "NvDecClass::Execute");
+
+        constexpr size_t MaxBitstreamSize{0x1000000}; //!< A sanity limit on the size of a single frame's bitstream, it's far larger than what any frame could need
+        constexpr size_t Vp8Vp9CurrentSurfaceIndex{3}; //!< The index of the output surface for VP8 and VP9, the prior indices are the last, golden and alternate reference surfaces
+
+        DecodeRequest request{
+            .codec = *registers.codec,
+            .frameNumber = *registers.frameNumber,
+        };
+        auto pictureInfoAddress{static_cast<u32>(*registers.pictureInfoOffset << 8)};
+        size_t bitstreamSize{};
+        size_t surfaceIndex{Vp8Vp9CurrentSurfaceIndex};
+
+        switch (request.codec) {
+            case VideoCodec::H264: {
+                auto info{ReadPictureInfo<H264PictureInfo>(state, pictureInfoAddress, request)};
+                request.width = info.picWidthInMbs * 16;
+                request.height = info.frameHeightInMapUnits * 16 * (info.frameMbsOnlyFlag ? 1 : 2);
+                bitstreamSize = info.bitstreamSize;
+                surfaceIndex = info.currPicIdx;
+                break;
+            }
+
+            case VideoCodec::Vp8: {
+                auto info{ReadPictureInfo<Vp8PictureInfo>(state, pictureInfoAddress, request)};
+                request.width = info.frameWidth;
+                request.height = info.frameHeight;
+                bitstreamSize = info.vldBufferSize;
+                break;
+            }
+
+            case VideoCodec::Vp9: {
+                auto info{ReadPictureInfo<Vp9PictureInfo>(state, pictureInfoAddress, request)};
+                request.width = info.currentFrameSize.width;
+                request.height = info.currentFrameSize.height;
+                bitstreamSize = info.bitstreamSize;
+
+                // VP9 frame headers are reconstructed from the probability tables and the reference surfaces as NVDEC is only supplied with the tile data
+                request.entropyProbs.resize(sizeof(Vp9EntropyProbs));
+                state.soc->smmu.Read(span(request.entropyProbs), static_cast<u32>(*registers.vp9EntropyProbsOffset << 8));
+                std::copy_n(registers.surfaceLumaOffsets->begin(), request.referenceSurfaceAddresses.size(), request.referenceSurfaceAddresses.begin());
+                break;
+            }
+
+            default:
+                Logger::Warn("Unsupported NVDEC codec: {}", static_cast<u32>(request.codec));
+                break;
+        }
+
+        if (surfaceIndex >= registers.surfaceLumaOffsets->size()) {
+            Logger::Warn("NVDEC output surface index is out of range: {}", surfaceIndex);
+            request.width = request.height = 0;
+        }
+
+        if (bitstreamSize > MaxBitstreamSize) {
+            Logger::Warn("NVDEC bitstream is too large: 0x{:X}", bitstreamSize);
+            bitstreamSize = 0;
+        }
+
+        // The bitstream is copied on the channel thread as the guest is free to reuse the buffer once the channel has moved on
+        request.bitstream.resize(bitstreamSize);
+        if (bitstreamSize)
+            state.soc->smmu.Read(span(request.bitstream), static_cast<u32>(*registers.bitstreamOffset << 8));
+
+        // The surface is marked as pending on the channel thread so the VIC waits for the frame even when it executes before the decode thread has started decoding it
+        if (request.width && request.height) {
+            request.surfaceAddress = registers.surfaceLumaOffsets[surfaceIndex];
+            request.surfaceSequence = frameStore.Begin(request.surfaceAddress);
+        }
+
+        {
+            std::unique_lock lock{decodeMutex};
+            consumeCondition.wait(lock, [this] { return decodeQueue.size() < DecodeQueueSize; });
+            decodeQueue.push(std::move(request));
+        }
+        decodeCondition.notify_one();
+
+        if (!thread.joinable())
+            thread = std::thread(&NvDecClass::Run, this);
+    }
+
+    void NvDecClass::Run() {
+        if (int result{pthread_setname_np(pthread_self(), "Sky-NvDec")})
+            Logger::Warn("Failed to set the thread name: {}", strerror(result));
+
+        while (true) {
+            DecodeRequest request;
+            {
+                std::unique_lock lock{decodeMutex};
+                decodeCondition.wait(lock, [this] { return exiting || !decodeQueue.empty(); });
+                if (exiting)
+                    return;
+
+                request = std::move(decodeQueue.front());
+                decodeQueue.pop();
+            }
+            consumeCondition.notify_one();
+
+            if (request.width && request.height) {
+                TRACE_EVENT("gpu", "NvDecClass::Decode", "Codec", static_cast<u32>(request.codec), "Width", request.width, "Height", request.height);
+                bool submitted{};
+                try {
+                    submitted = decoder->Decode(request);
+                } catch (const std::exception &e) {
+                    Logger::Error("Failed to decode NVDEC frame: {}", e.what());
+                }
+
+                // A blank frame is output when the decoder couldn't decode the frame, the guest expects a frame in the surface for every submission
+                if (!submitted)
+                    fallbackDecoder->Decode(request);
+            }
+
+            // The operation is complete even if decoding failed as the guest would otherwise wait on it forever
+            opDoneCallback();
+        }
+    }
+
+    bool NvDecClass::CallMethod(u32 method, u32 argument) {
+        constexpr u32 ExecuteMethodId{0xC0}; //!< Starts decoding a frame with the current register state
+
+        if (method >= registers.raw.size()) {
+            Logger::Warn("Unknown NVDEC class method called: 0x{:X} argument: 0x{:X}", method, argument);
+            return false;
+        }
+
+        registers.raw[method] = argument;
+        if (method == ExecuteMethodId) {
+            Execute();
+            return true;
+        }
+        return false;
     }
 }
@@ -3,19 +3,126 @@
 
 #pragma once
 
+#include <queue>
 #include <common.h>
+#include <soc/host1x/frame_store.h>
 
 namespace skyline::soc::host1x {
+    enum class VideoCodec : u32 {
+        None = 0,
+        H264 = 3,
+        Vp8 = 5,
+        H265 = 7,
+        Vp9 = 9,
+    };
+
+    /**
+     * @brief All state required to decode a single frame, it's captured from the NVDEC registers and guest memory at the time of execution so decoding can happen asynchronously
+     */
+    struct DecodeRequest {
+        VideoCodec codec;
+        u32 width;
+        u32 height;
+        u64 frameNumber;
+        u32 surfaceAddress; //!< The SMMU address of the luma plane of the surface that the frame is decoded into in units of 256 bytes
+        u64 surfaceSequence; //!< The sequence number of the decode in the frame store
+        std::array<u32, 3> referenceSurfaceAddresses; //!< The SMMU addresses of the luma planes of the last, golden and alternate reference surfaces in units of 256 bytes, these are only captured for VP9
+        std::vector<u8> pictureInfo; //!< The codec-specific picture setup structure supplied by the guest driver
+        std::vector<u8> bitstream; //!< The compressed data for the frame
+        std::vector<u8> entropyProbs; //!< The VP9 probability tables for the frame
+    };
+
+    /**
+     * @brief A decoder backend for NVDEC, it's only ever called on the decode thread of a single NVDEC instance
+     */
+    class VideoDecoder {
+      protected:
+        FrameStore &frameStore; //!< The frame store that decoded frames are output into
+
+      public:
+        VideoDecoder(FrameStore &frameStore) : frameStore{frameStore} {}
+
+        virtual ~VideoDecoder() = default;
+
+        /**
+         * @brief Submits a frame for decoding, the decoded frame is output into the frame store which may only happen during a later submission for decoders that buffer frames
+         * @return If the frame was submitted, the decoder is responsible for completing its decode in the frame store in that case
+         */
+        virtual bool Decode(const DecodeRequest &request) = 0;
+    };
+
     /**
      * @brief The NVDEC Host1x class implements hardware accelerated video decoding for the VP9/VP8/H264/VC1 codecs
+     * @note Frames are decoded on a dedicated thread, the channel is only blocked for the duration of capturing the decode state
      */
     class NvDecClass {
       private:
+        /**
+         * @note All offsets are in units of 256 bytes in the SMMU address space
+         * @note Only the registers which are required for capturing the decode state are named
+         */
+        #pragma pack(push, 1)
+        union Registers {
+            std::array<u32, 0x160> raw;
+
+            template<size_t Offset, typename Type>
+            using Register = util::OffsetMember<Offset, Type, u32>;
+
+            Register<0x80, VideoCodec> codec;
+            Register<0x100, u32> controlParams;
+            Register<0x101, u32> pictureInfoOffset;
+            Register<0x102, u32> bitstreamOffset;
+            Register<0x103, u32> frameNumber;
+            Register<0x104, u32> h264SliceDataOffsets;
+            Register<0x105, u32> h264MvDumpOffset;
+            Register<0x109, u32> frameStatsOffset;
+            Register<0x10A, u32> h264LastSurfaceLumaOffset;
+            Register<0x10B, u32> h264LastSurfaceChromaOffset;
+            Register<0x10C, std::array<u32, 17>> surfaceLumaOffsets;
+            Register<0x11D, std::array<u32, 17>> surfaceChromaOffsets;
+            Register<0x150, u32> vp9EntropyProbsOffset;
+            Register<0x151, u32> vp9BackwardUpdatesOffset;
+            Register<0x152, u32> vp9LastFrameSegmapOffset;
+            Register<0x153, u32> vp9CurrFrameSegmapOffset;
+            Register<0x155, u32> vp9LastFrameMvsOffset;
+            Register<0x156, u32> vp9CurrFrameMvsOffset;
+            Register<0x158, u32> vp8ProbDataOffset;
+        } registers{};
+        static_assert(sizeof(Registers) == (0x160 * sizeof(u32)));
+        #pragma pack(pop)
+
+        const DeviceState &state;
         std::function<void()> opDoneCallback;
+        FrameStore &frameStore;
+        std::unique_ptr<VideoDecoder> decoder;
+        std::unique_ptr<VideoDecoder> fallbackDecoder; //!< A decoder which is used when the primary decoder can't decode a frame, it must always complete the decode
+
+        static constexpr size_t DecodeQueueSize{0x10}; //!< The maximum amount of frames that can be queued for decoding before the channel is blocked
+        std::queue<DecodeRequest> decodeQueue;
+        std::mutex decodeMutex; //!< Synchronizes access to the decode queue and the exit flag
+        std::condition_variable decodeCondition; //!< Signalled when a request is queued or the decode thread should exit
+        std::condition_variable consumeCondition; //!< Signalled when a request has been decoded
+        bool exiting{};
+        std::thread thread; //!< The thread that decodes frames, it's started on the first execution
+
+        /**
+         * @brief Captures the decode state of the current frame and queues it for decoding
+         */
+        void Execute();
+
+        /**
+         * @brief Decodes all queued frames and waits for more
+         */
+        void Run();
 
       public:
-        NvDecClass(std::function<void()> opDoneCallback);
+        NvDecClass(std::function<void()> opDoneCallback, const DeviceState &state, FrameStore &frameStore);
+
+        ~NvDecClass();
 
-        void CallMethod(u32 method, u32 argument);
+        /**
+         * @return If the method started an operation, opDoneCallback will be called once it's complete
+         */
+        bool CallMethod(u32 method, u32 argument);
     };
 }
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::soc::host1x {
+    /**
+     * @brief The H.264 picture setup structure, it contains the SPS/PPS fields that aren't part of the bitstream supplied to NVDEC
+     */
+    struct H264PictureInfo {
+        u32 _pad0_[18];
+        u32 bitstreamSize;
+        u32 _pad1_[3];
+        i32 log2MaxPicOrderCntLsbMinus4;
+        i32 deltaPicOrderAlwaysZeroFlag;
+        i32 frameMbsOnlyFlag;
+        u32 picWidthInMbs;
+        u32 frameHeightInMapUnits;
+        u32 blockLayout; //!< The tile format and GOB height of the output surface
+        u32 entropyCodingModeFlag;
+        i32 picOrderPresentFlag;
+        i32 numRefIdxL0ActiveMinus1;
+        i32 numRefIdxL1ActiveMinus1;
+        i32 deblockingFilterControlPresentFlag;
+        i32 redundantPicCntPresentFlag;
+        u32 transform8x8ModeFlag;
+        u32 lumaPitch;
+        u32 chromaPitch;
+        u32 lumaTopOffset;
+        u32 lumaBottomOffset;
+        u32 lumaFrameOffset;
+        u32 chromaTopOffset;
+        u32 chromaBottomOffset;
+        u32 chromaFrameOffset;
+        u32 histBufferSize;
+        u64 mbaffFrame : 1;
+        u64 direct8x8Inference : 1;
+        u64 weightedPred : 1;
+        u64 constrainedIntraPred : 1;
+        u64 refPic : 1;
+        u64 fieldPic : 1;
+        u64 bottomField : 1;
+        u64 secondField : 1;
+        u64 log2MaxFrameNumMinus4 : 4;
+        u64 chromaFormatIdc : 2;
+        u64 picOrderCntType : 2;
+        i64 picInitQpMinus26 : 6;
+        i64 chromaQpIndexOffset : 5;
+        i64 secondChromaQpIndexOffset : 5;
+        u64 weightedBipredIdc : 2;
+        u64 currPicIdx : 7;
+        u64 currColIdx : 5;
+        u64 frameNumber : 16;
+        u64 frameSurfaces : 1;
+        u64 outputMemoryLayout : 1;
+        u32 _pad2_[66];
+        std::array<u8, 0x60> weightScale4x4; //!< The six 4x4 scaling lists in raster order
+        std::array<u8, 0x80> weightScale8x8; //!< The two 8x8 scaling lists in raster order
+    };
+    static_assert(sizeof(H264PictureInfo) == 0x2A0);
+
+    /**
+     * @brief The leading part of the VP8 picture setup structure which contains the frame dimensions and the fields of the uncompressed frame header
+     */
+    struct Vp8PictureInfo {
+        u32 _pad0_[14];
+        u16 frameWidth;
+        u16 frameHeight;
+        u8 keyFrame;
+        u8 version;
+        u8 surfaceFormat;
+        u8 errorConcealOn;
+        u32 firstPartSize;
+        u32 histBufferSize;
+        u32 vldBufferSize; //!< The size of the bitstream in bytes
+    };
+    static_assert(sizeof(Vp8PictureInfo) == 0x4C);
+
+    /**
+     * @brief The VP9 picture setup structure, it contains the fields of the uncompressed frame header as NVDEC is only supplied with the tile data of a frame
+     */
+    struct Vp9PictureInfo {
+        struct FrameSize {
+            u16 width;
+            u16 height;
+            u16 lumaPitch;
+            u16 chromaPitch;
+        };
+
+        u32 _pad0_[12];
+        u32 bitstreamSize;
+        u32 _pad1_[5];
+        FrameSize lastFrameSize;
+        FrameSize goldenFrameSize;
+        FrameSize altFrameSize;
+        FrameSize currentFrameSize;
+        u32 keyFrame : 1;
+        u32 lastFrameIsKeyFrame : 1;
+        u32 frameSizeChanged : 1;
+        u32 errorResilientMode : 1;
+        u32 lastShowFrame : 1; //!< If the previously decoded frame was shown, show_frame of the current frame isn't supplied to NVDEC
+        u32 intraOnly : 1;
+        u32 _pad2_ : 26;
+        std::array<i8, 4> refFrameSignBias; //!< The sign bias of each reference frame indexed by its type (None, Last, Golden, AltRef)
+        u8 filterLevel;
+        u8 sharpnessLevel;
+        u8 baseQIndex;
+        i8 yDcDeltaQ;
+        i8 uvAcDeltaQ;
+        i8 uvDcDeltaQ;
+        u8 lossless;
+        u8 txMode;
+        u8 allowHighPrecisionMv;
+        u8 interpFilter; //!< The interpolation filter type as numbered by libvpx (EightTap, EightTapSmooth, EightTapSharp, Bilinear, Switchable)
+        u8 referenceMode;
+        i8 compFixedRef;
+        std::array<i8, 2> compVarRef;
+        u8 log2TileCols;
+        u8 log2TileRows;
+
+        struct {
+            u8 enabled;
+            u8 updateMap;
+            u8 temporalUpdate;
+            u8 absDelta;
+            std::array<u32, 8> featureMask; //!< A bitmask of the features that are enabled for each segment
+            std::array<std::array<i16, 4>, 8> featureData;
+        } segmentation;
+
+        struct {
+            u8 modeRefDeltaEnabled;
+            std::array<i8, 4> refDeltas;
+            std::array<i8, 2> modeDeltas;
+        } loopFilter;
+
+        u8 _pad3_[21];
+    };
+    static_assert(sizeof(Vp9PictureInfo) == 0x100);
+
+    /**
+     * @brief The VP9 probability tables for a frame, these are the probabilities after the forward updates in the compressed header were applied by the guest
+     * @note Mode probability trees with 9 nodes are split into the first 8 nodes and the last one, other tables are padded to a multiple of 2 or 4 nodes
+     */
+    struct Vp9EntropyProbs {
+        using CoefProbs = std::array<std::array<std::array<u8, 4>, 6>, 6>; //!< The coefficient probabilities of a single transform size, plane type and reference type indexed by band and context
+
+        std::array<std::array<std::array<u8, 8>, 10>, 10> kfYModeProbs;
+        std::array<std::array<u8, 10>, 10> kfYModeProbsE8;
+        u8 _pad0_[3];
+        std::array<u8, 7> segTreeProbs;
+        std::array<u8, 3> segPredProbs;
+        u8 _pad1_[15];
+        std::array<std::array<u8, 8>, 10> kfUvModeProbs;
+        std::array<u8, 10> kfUvModeProbsE8;
+        u8 _pad2_[6];
+        std::array<std::array<u8, 4>, 7> interModeProbs;
+        std::array<u8, 4> intraInterProbs;
+        std::array<std::array<u8, 8>, 10> uvModeProbs;
+        std::array<std::array<u8, 1>, 2> tx8x8Probs;
+        std::array<std::array<u8, 2>, 2> tx16x16Probs;
+        std::array<std::array<u8, 3>, 2> tx32x32Probs;
+        std::array<u8, 4> yModeProbsE8;
+        std::array<std::array<u8, 8>, 4> yModeProbs;
+        std::array<std::array<u8, 4>, 16> kfPartitionProbs;
+        std::array<std::array<u8, 4>, 16> partitionProbs;
+        std::array<u8, 10> uvModeProbsE8;
+        std::array<std::array<u8, 2>, 4> switchableInterpProbs;
+        std::array<u8, 5> compInterProbs;
+        std::array<u8, 4> skipProbs;
+        std::array<u8, 3> mvJointProbs;
+        std::array<u8, 2> mvSignProbs;
+        std::array<std::array<u8, 1>, 2> mvClass0Probs;
+        std::array<std::array<u8, 3>, 2> mvFpProbs;
+        std::array<u8, 2> mvClass0HpProbs;
+        std::array<u8, 2> mvHpProbs;
+        std::array<std::array<u8, 10>, 2> mvClassesProbs;
+        std::array<std::array<std::array<u8, 3>, 2>, 2> mvClass0FpProbs;
+        std::array<std::array<u8, 10>, 2> mvBitsProbs;
+        std::array<std::array<u8, 2>, 5> singleRefProbs;
+        std::array<u8, 5> compRefProbs;
+        u8 _pad3_[17];
+        std::array<std::array<std::array<CoefProbs, 2>, 2>, 4> coefProbs; //!< Indexed by transform size, plane type and reference type
+    };
+    static_assert(sizeof(Vp9EntropyProbs) == 0xEA0);
+    static_assert(offsetof(Vp9EntropyProbs, interModeProbs) == 0x400);
+    static_assert(offsetof(Vp9EntropyProbs, partitionProbs) == 0x4E0);
+    static_assert(offsetof(Vp9EntropyProbs, coefProbs) == 0x5A0);
+}
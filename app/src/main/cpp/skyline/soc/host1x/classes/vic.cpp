@@ -1,13 +1,179 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2021 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+#include <common/trace.h>
+#include <gpu/texture/layout.h>
+#include <soc.h>
 #include "vic.h"
 
 namespace skyline::soc::host1x {
-    VicClass::VicClass(std::function<void()> opDoneCallback)
-        : opDoneCallback(std::move(opDoneCallback)) {}
+    /**
+     * @brief BT.601 limited range YCbCr to RGB coefficients in 10.6 fixed point, these are small enough for all intermediate values to fit into 16 bits
+     */
+    namespace coefficient {
+        constexpr i16 Luma{75}; //!< 1.164
+        constexpr i16 CrToRed{102}; //!< 1.596
+        constexpr i16 CbToGreen{25}; //!< 0.392
+        constexpr i16 CrToGreen{52}; //!< 0.813
+        constexpr i16 CbToBlue{129}; //!< 2.017
+        constexpr int Shift{6};
+    }
+
+    /**
+     * @brief Converts a single row of an NV12 frame into 32-bit RGBA
+     * @param swapRedBlue If the output should be in BGRA order rather than RGBA
+     */
+    static void ConvertRowToRgba(const u8 *luma, const u8 *chroma, u8 *output, u32 width, bool swapRedBlue) {
+        u32 x{};
+
+        #ifdef __ARM_NEON
+        // 16 pixels are converted at a time, each CbCr pair is shared by two horizontally adjacent pixels
+        int16x8_t lumaBias{vdupq_n_s16(16)}, chromaBias{vdupq_n_s16(128)};
+        uint8x16_t alpha{vdupq_n_u8(0xFF)};
+        for (; x + 16 <= width; x += 16) {
+            uint8x16_t y{vld1q_u8(luma + x)};
+            uint8x8x2_t cbcr{vld2_u8(chroma + x)};
+            uint8x8x2_t cbPair{vzip_u8(cbcr.val[0], cbcr.val[0])}, crPair{vzip_u8(cbcr.val[1], cbcr.val[1])};
+
+            auto convert{[&](uint8x8_t y8, uint8x8_t cb8, uint8x8_t cr8, uint8x8_t &r, uint8x8_t &g, uint8x8_t &b) {
+                int16x8_t yScaled{vmulq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y8)), lumaBias), coefficient::Luma)};
+                int16x8_t cb{vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb8)), chromaBias)};
+                int16x8_t cr{vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr8)), chromaBias)};
+
+                r = vqshrun_n_s16(vqaddq_s16(yScaled, vmulq_n_s16(cr, coefficient::CrToRed)), coefficient::Shift);
+                g = vqshrun_n_s16(vqsubq_s16(vqsubq_s16(yScaled, vmulq_n_s16(cb, coefficient::CbToGreen)), vmulq_n_s16(cr, coefficient::CrToGreen)), coefficient::Shift);
+                b = vqshrun_n_s16(vqaddq_s16(yScaled, vmulq_n_s16(cb, coefficient::CbToBlue)), coefficient::Shift);
+            }};
+
+            uint8x8_t rLow, gLow, bLow, rHigh, gHigh, bHigh;
+            convert(vget_low_u8(y), cbPair.val[0], crPair.val[0], rLow, gLow, bLow);
+            convert(vget_high_u8(y), cbPair.val[1], crPair.val[1], rHigh, gHigh, bHigh);
+
+            uint8x16_t r{vcombine_u8(rLow, rHigh)}, g{vcombine_u8(gLow, gHigh)}, b{vcombine_u8(bLow, bHigh)};
+            vst4q_u8(output + x * 4, (uint8x16x4_t{swapRedBlue ? b : r, g, swapRedBlue ? r : b, alpha}));
+        }
+        #endif
+
+        for (; x < width; x++) {
+            i32 y{(luma[x] - 16) * coefficient::Luma};
+            i32 cb{chroma[x & ~1U] - 128}, cr{chroma[(x & ~1U) + 1] - 128};
+
+            u8 r{static_cast<u8>(std::clamp((y + coefficient::CrToRed * cr) >> coefficient::Shift, 0, 0xFF))};
+            u8 g{static_cast<u8>(std::clamp((y - coefficient::CbToGreen * cb - coefficient::CrToGreen * cr) >> coefficient::Shift, 0, 0xFF))};
+            u8 b{static_cast<u8>(std::clamp((y + coefficient::CbToBlue * cb) >> coefficient::Shift, 0, 0xFF))};
+
+            u8 *pixel{output + x * 4};
+            pixel[0] = swapRedBlue ? b : r;
+            pixel[1] = g;
+            pixel[2] = swapRedBlue ? r : b;
+            pixel[3] = 0xFF;
+        }
+    }
+
+    VicClass::VicClass(std::function<void()> opDoneCallback, const DeviceState &state, FrameStore &frameStore)
+        : state{state},
+          opDoneCallback{std::move(opDoneCallback)},
+          frameStore{frameStore} {}
+
+    void VicClass::WriteSurface(const OutputSurfaceConfig &config, u32 address, u32 width, u32 height, u32 bpp, span<u8> linear) {
+        if (!config.blockLinearKind) {
+            state.soc->smmu.Write(address, linear);
+            return;
+        }
+
+        gpu::texture::Dimensions dimensions{width, height};
+        size_t gobBlockHeight{1U << config.blockLinearHeightLog2};
+        blockLinearBuffer.resize(gpu::texture::GetBlockLinearLayerSize(dimensions, 1, 1, bpp, gobBlockHeight, 1));
+        gpu::texture::CopyLinearToBlockLinear(dimensions, 1, 1, bpp, gobBlockHeight, 1, linear.data(), blockLinearBuffer.data());
+        state.soc->smmu.Write(address, span(blockLinearBuffer));
+    }
+
+    void VicClass::Execute() {
+        TRACE_EVENT("gpu", "VicClass::Execute");
+
+        constexpr u32 OutputSurfaceConfigOffset{0x20}; //!< The offset of the output surface configuration in the configuration structure
+        auto config{state.soc->smmu.Read<OutputSurfaceConfig>(static_cast<u32>((configStructOffset << 8) + OutputSurfaceConfigOffset))};
+
+        constexpr auto FrameTimeout{std::chrono::milliseconds(50)}; //!< The maximum duration to wait for NVDEC to finish decoding the input surface, the surface's prior frame is composited if it's exceeded
+
+        auto inputFrame{frameStore.Get(inputLumaOffset, FrameTimeout)};
+        if (!inputFrame) {
+            Logger::Warn("VIC execution without a decoded frame");
+            return;
+        }
+
+        const auto &frame{*inputFrame};
+        u32 surfaceWidth{static_cast<u32>(config.surfaceWidthMinus1 + 1)}, surfaceHeight{static_cast<u32>(config.surfaceHeightMinus1 + 1)};
+        u32 width{std::min(frame.width, surfaceWidth)}, height{std::min(frame.height, surfaceHeight)}; // The frame is cropped to the surface, any remaining area is left black
+
+        auto lumaAddress{static_cast<u32>(outputLumaOffset << 8)};
+        switch (config.pixelFormat) {
+            case PixelFormat::R8G8B8A8:
+            case PixelFormat::R8G8B8X8:
+            case PixelFormat::B8G8R8A8: {
+                constexpr u32 Bpp{4};
+                linearBuffer.assign(static_cast<size_t>(surfaceWidth) * surfaceHeight * Bpp, 0);
+
+                bool swapRedBlue{config.pixelFormat == PixelFormat::B8G8R8A8};
+                for (u32 y{}; y < height; y++)
+                    ConvertRowToRgba(frame.luma.data() + static_cast<size_t>(y) * frame.width, frame.chroma.data() + static_cast<size_t>(y / 2) * frame.ChromaPitch(), linearBuffer.data() + static_cast<size_t>(y) * surfaceWidth * Bpp, width, swapRedBlue);
+
+                WriteSurface(config, lumaAddress, surfaceWidth, surfaceHeight, Bpp, linearBuffer);
+                break;
+            }
+
+            case PixelFormat::Y8___V8U8_N420: {
+                // The frame is already in the same layout as the surface, the planes only need to be cropped to it
+                linearBuffer.assign(static_cast<size_t>(surfaceWidth) * surfaceHeight, 16);
+                for (u32 y{}; y < height; y++)
+                    std::memcpy(linearBuffer.data() + static_cast<size_t>(y) * surfaceWidth, frame.luma.data() + static_cast<size_t>(y) * frame.width, width);
+                WriteSurface(config, lumaAddress, surfaceWidth, surfaceHeight, 1, linearBuffer);
+
+                u32 chromaWidth{util::DivideCeil(surfaceWidth, 2U)}, chromaHeight{util::DivideCeil(surfaceHeight, 2U)};
+                linearBuffer.assign(static_cast<size_t>(chromaWidth) * chromaHeight * 2, 128);
+                for (u32 y{}; y < util::DivideCeil(height, 2U); y++)
+                    std::memcpy(linearBuffer.data() + static_cast<size_t>(y) * chromaWidth * 2, frame.chroma.data() + static_cast<size_t>(y) * frame.ChromaPitch(), util::AlignUp(width, 2));
+                WriteSurface(config, static_cast<u32>(outputChromaOffset << 8), chromaWidth, chromaHeight, 2, linearBuffer);
+                break;
+            }
+
+            default:
+                Logger::Warn("Unsupported VIC output pixel format: 0x{:X}", static_cast<u64>(config.pixelFormat));
+                break;
+        }
+    }
+
+    bool VicClass::CallMethod(u32 method, u32 argument) {
+        constexpr u32 ExecuteMethodId{0xC0};
+        constexpr u32 SetInputSurfaceLumaOffsetMethodId{0x100}; //!< The luma plane of the current surface in the first slot, only a single slot is composited
+        constexpr u32 SetConfigStructOffsetMethodId{0x1C2};
+        constexpr u32 SetOutputSurfaceLumaOffsetMethodId{0x1C8};
+        constexpr u32 SetOutputSurfaceChromaOffsetMethodId{0x1C9};
 
-    void VicClass::CallMethod(u32 method, u32 argument) {
-        Logger::Warn("Unknown VIC class method called: 0x{:X} argument: 0x{:X}", method, argument);
+        switch (method) {
+            case ExecuteMethodId:
+                Execute();
+                opDoneCallback();
+                return true;
+            case SetInputSurfaceLumaOffsetMethodId:
+                inputLumaOffset = argument;
+                break;
+            case SetConfigStructOffsetMethodId:
+                configStructOffset = argument;
+                break;
+            case SetOutputSurfaceLumaOffsetMethodId:
+                outputLumaOffset = argument;
+                break;
+            case SetOutputSurfaceChromaOffsetMethodId:
+                outputChromaOffset = argument;
+                break;
+            default:
+                Logger::Debug("Unknown VIC class method called: 0x{:X} argument: 0x{:X}", method, argument);
+                break;
+        }
+        return false;
     }
 }
@@ -4,18 +4,68 @@
 #pragma once
 
 #include <common.h>
+#include <soc/host1x/frame_store.h>
 
 namespace skyline::soc::host1x {
     /**
      * @brief The VIC Host1x class implements hardware accelerated image operations
+     * @note Only composition of a single decoded video frame into an output surface is implemented, this is all that's used for video playback
      */
     class VicClass {
       private:
+        enum class PixelFormat : u64 {
+            R8G8B8A8 = 0x1F,
+            B8G8R8A8 = 0x20,
+            R8G8B8X8 = 0x23,
+            Y8___V8U8_N420 = 0x44, //!< NV12
+        };
+
+        /**
+         * @brief The configuration of the output surface, it's located at an offset into the guest's configuration structure
+         */
+        union OutputSurfaceConfig {
+            u64 raw;
+            struct {
+                PixelFormat pixelFormat : 7;
+                u64 chromaLocationHorizontal : 2;
+                u64 chromaLocationVertical : 2;
+                u64 blockLinearKind : 4; //!< If this is non-zero then the surface is block-linear, otherwise it's pitch-linear
+                u64 blockLinearHeightLog2 : 4;
+                u64 _pad0_ : 13;
+                u64 surfaceWidthMinus1 : 14;
+                u64 surfaceHeightMinus1 : 14;
+                u64 _pad1_ : 4;
+            };
+        };
+        static_assert(sizeof(OutputSurfaceConfig) == sizeof(u64));
+
+        const DeviceState &state;
         std::function<void()> opDoneCallback;
+        FrameStore &frameStore;
+        std::vector<u8> linearBuffer; //!< A scratch buffer for the converted surface prior to it being written to guest memory
+        std::vector<u8> blockLinearBuffer; //!< A scratch buffer for swizzling the converted surface into the block-linear layout
+
+        u32 configStructOffset{}; //!< The SMMU address of the configuration structure in units of 256 bytes
+        u32 inputLumaOffset{}; //!< The SMMU address of the luma plane of the input surface in units of 256 bytes, this is the surface that NVDEC decoded the frame into
+        u32 outputLumaOffset{}; //!< The SMMU address of the output surface or its luma plane in units of 256 bytes
+        u32 outputChromaOffset{}; //!< The SMMU address of the output surface's chroma plane in units of 256 bytes, this is only used for YUV surfaces
+
+        /**
+         * @brief Writes a linear surface to guest memory in the layout specified by the configuration
+         */
+        void WriteSurface(const OutputSurfaceConfig &config, u32 address, u32 width, u32 height, u32 bpp, span<u8> linear);
+
+        /**
+         * @brief Composites the frame in the input surface into the output surface
+         */
+        void Execute();
 
       public:
-        VicClass(std::function<void()> opDoneCallback);
+        VicClass(std::function<void()> opDoneCallback, const DeviceState &state, FrameStore &frameStore);
 
-        void CallMethod(u32 method, u32 argument);
+        /**
+         * @return If the method started an operation, opDoneCallback will be called once it's complete
+         */
+        bool CallMethod(u32 method, u32 argument);
     };
 }
@@ -0,0 +1,864 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "vp9_frame_composer.h"
+
+namespace skyline::soc::host1x {
+    /**
+     * @brief Writes the fixed-width fields of the uncompressed frame header, these are packed from the MSB of each byte
+     */
+    class Vp9BitWriter {
+      private:
+        std::vector<u8> &output;
+        u8 bits{}; //!< The bits of the byte currently being written, they're filled from the MSB
+        u8 bitCount{};
+
+      public:
+        Vp9BitWriter(std::vector<u8> &output) : output{output} {}
+
+        void WriteBits(u32 value, u8 count) {
+            for (u8 index{count}; index-- > 0;) {
+                bits = static_cast<u8>((bits << 1) | ((value >> index) & 1));
+                if (++bitCount == 8) {
+                    output.push_back(bits);
+                    bits = 0;
+                    bitCount = 0;
+                }
+            }
+        }
+
+        void WriteBit(bool value) {
+            WriteBits(value ? 1 : 0, 1);
+        }
+
+        /**
+         * @brief Writes a signed field as its magnitude followed by a sign bit
+         */
+        void WriteSigned(i32 value, u8 count) {
+            WriteBits(static_cast<u32>(std::abs(value)), count);
+            WriteBit(value < 0);
+        }
+
+        /**
+         * @brief Pads the header with zero bits up to the next byte boundary
+         */
+        void Align() {
+            if (bitCount)
+                WriteBits(0, static_cast<u8>(8 - bitCount));
+        }
+    };
+
+    /**
+     * @brief Writes the boolean-coded compressed frame header, this is the encoder counterpart of the VP9 boolean decoder (Section 9.2)
+     */
+    class Vp9BoolEncoder {
+      private:
+        std::vector<u8> &output;
+        u32 low{};
+        u32 range{255};
+        i32 count{-24}; //!< The amount of bits in low that are ready to be output, offset by the 24 bits it holds back for carries
+
+      public:
+        Vp9BoolEncoder(std::vector<u8> &output) : output{output} {
+            Write(false, 128); // The marker bit which must be zero
+        }
+
+        void Write(bool bit, u8 probability) {
+            u32 split{1 + (((range - 1) * probability) >> 8)};
+            if (bit) {
+                low += split;
+                range -= split;
+            } else {
+                range = split;
+            }
+
+            i32 shift{std::countl_zero(static_cast<u8>(range))};
+            range <<= shift;
+            count += shift;
+            if (count >= 0) {
+                i32 offset{shift - count};
+                if ((low << (offset - 1)) & 0x80000000) {
+                    // The carry is propagated into the bytes which were already output
+                    auto byte{output.end() - 1};
+                    for (; *byte == 0xFF; byte--)
+                        *byte = 0;
+                    (*byte)++;
+                }
+                output.push_back(static_cast<u8>(low >> (24 - offset)));
+                low = (low << offset) & 0xFFFFFF;
+                shift = count;
+                count -= 8;
+            }
+            low <<= shift;
+        }
+
+        void WriteLiteral(u32 value, u8 bitCount) {
+            for (u8 index{bitCount}; index-- > 0;)
+                Write((value >> index) & 1, 128);
+        }
+
+        /**
+         * @brief Flushes all pending bits, the padding ensures the decoder doesn't read beyond the header
+         */
+        void Finish() {
+            for (size_t index{}; index < 32; index++)
+                Write(false, 128);
+
+            // A trailing byte that looks like a superframe marker could be misinterpreted by decoders (libvpx vpx_stop_encode)
+            if ((output.back() & 0xE0) == 0xC0)
+                output.push_back(0);
+        }
+    };
+
+    constexpr u8 UpdateProbability{252}; //!< The probability of a probability being updated in the compressed header
+    constexpr u8 TxModeSelect{4};
+    constexpr u8 SwitchableInterpFilter{4};
+
+    /**
+     * @brief The table mapping the coded deltas of probability updates to their distance from the current probability (Section 10.5)
+     */
+    constexpr std::array<u8, 254> InvMapTable{
+        7, 20, 33, 46, 59, 72, 85, 98, 111, 124, 137, 150, 163, 176, 189, 202,
+        215, 228, 241, 254, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13,
+        14, 15, 16, 17, 18, 19, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+        31, 32, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 47, 48,
+        49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 60, 61, 62, 63, 64, 65,
+        66, 67, 68, 69, 70, 71, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82,
+        83, 84, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 99, 100,
+        101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 112, 113, 114, 115, 116, 117,
+        118, 119, 120, 121, 122, 123, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134,
+        135, 136, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 151, 152,
+        153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 164, 165, 166, 167, 168, 169,
+        170, 171, 172, 173, 174, 175, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186,
+        187, 188, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 203, 204,
+        205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 216, 217, 218, 219, 220, 221,
+        222, 223, 224, 225, 226, 227, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238,
+        239, 240, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253
+    };
+
+    /**
+     * @brief The default probabilities of a single motion vector component
+     */
+    struct Vp9MvComponentProbs {
+        u8 sign;
+        std::array<u8, 10> classes;
+        u8 class0;
+        std::array<u8, 10> bits;
+        std::array<std::array<u8, 3>, 2> class0Fp;
+        std::array<u8, 3> fp;
+        u8 class0Hp;
+        u8 hp;
+    };
+
+    /**
+     * @brief The default probabilities that are loaded by key frames and frames in error resilient mode (Section 10.5)
+     * @note Only the probabilities that can be forward updated are filled in, the intra-only probabilities are fixed and aren't tracked
+     */
+    constexpr Vp9EntropyProbs DefaultProbabilities{[] {
+        constexpr u8 DefaultYModeProbs[4][9]{
+            {65, 32, 18, 144, 162, 194, 41, 51, 98},
+            {132, 68, 18, 165, 217, 196, 45, 40, 78},
+            {173, 80, 19, 176, 240, 193, 64, 35, 46},
+            {221, 135, 38, 194, 248, 121, 96, 85, 29},
+        };
+        constexpr u8 DefaultUvModeProbs[10][9]{
+            {48, 12, 154, 155, 139, 90, 34, 117, 119},
+            {67, 6, 25, 204, 243, 158, 13, 21, 96},
+            {120, 7, 76, 176, 208, 126, 28, 54, 103},
+            {97, 5, 44, 131, 176, 139, 48, 68, 97},
+            {83, 5, 42, 156, 111, 152, 26, 49, 152},
+            {80, 5, 58, 178, 74, 83, 33, 62, 145},
+            {86, 5, 32, 154, 192, 168, 14, 22, 163},
+            {77, 7, 64, 116, 132, 122, 37, 126, 120},
+            {85, 5, 32, 156, 216, 148, 19, 29, 73},
+            {101, 21, 107, 181, 192, 103, 19, 67, 125},
+        };
+        constexpr u8 DefaultPartitionProbs[16][3]{
+            {199, 122, 141},
+            {147, 63, 159},
+            {148, 133, 118},
+            {121, 104, 114},
+            {174, 73, 87},
+            {92, 41, 83},
+            {82, 99, 50},
+            {53, 39, 39},
+            {177, 58, 59},
+            {68, 26, 63},
+            {52, 79, 25},
+            {17, 14, 12},
+            {222, 34, 30},
+            {72, 16, 44},
+            {58, 32, 12},
+            {10, 7, 6},
+        };
+        constexpr u8 DefaultSwitchableInterpProbs[4][2]{{235, 162}, {36, 255}, {34, 3}, {149, 144}};
+        constexpr u8 DefaultInterModeProbs[7][3]{{2, 173, 34}, {7, 145, 85}, {7, 166, 63}, {7, 94, 66}, {8, 64, 46}, {17, 81, 31}, {25, 29, 30}};
+        constexpr u8 DefaultIntraInterProbs[4]{9, 102, 187, 225};
+        constexpr u8 DefaultCompInterProbs[5]{239, 183, 119, 96, 41};
+        constexpr u8 DefaultSingleRefProbs[5][2]{{33, 16}, {77, 74}, {142, 142}, {172, 170}, {238, 247}};
+        constexpr u8 DefaultCompRefProbs[5]{50, 126, 123, 221, 226};
+        constexpr u8 DefaultTx8x8Probs[2][1]{{100}, {66}};
+        constexpr u8 DefaultTx16x16Probs[2][2]{{20, 152}, {15, 101}};
+        constexpr u8 DefaultTx32x32Probs[2][3]{{3, 136, 37}, {5, 52, 13}};
+        constexpr u8 DefaultSkipProbs[3]{192, 128, 64};
+        constexpr u8 DefaultMvJointProbs[3]{32, 64, 96};
+        constexpr std::array<Vp9MvComponentProbs, 2> DefaultMvComponentProbs{{
+            {128, {224, 144, 192, 168, 192, 176, 192, 198, 198, 245}, 216, {136, 140, 148, 160, 176, 192, 224, 234, 234, 240}, {{{128, 128, 64}, {96, 112, 64}}}, {64, 96, 64}, 160, 128},
+            {128, {216, 128, 176, 160, 176, 176, 192, 198, 198, 208}, 208, {136, 140, 148, 160, 176, 192, 224, 234, 234, 240}, {{{128, 128, 64}, {96, 112, 64}}}, {64, 96, 64}, 160, 128},
+        }};
+        constexpr u8 DefaultCoefProbs[4][2][2][6][6][3]{
+            { // 4x4
+                {
+                    {
+                        {{195, 29, 183}, {84, 49, 136}, {8, 42, 71}},
+                        {{31, 107, 169}, {35, 99, 159}, {17, 82, 140}, {8, 66, 114}, {2, 44, 76}, {1, 19, 32}},
+                        {{40, 132, 201}, {29, 114, 187}, {13, 91, 157}, {7, 75, 127}, {3, 58, 95}, {1, 28, 47}},
+                        {{69, 142, 221}, {42, 122, 201}, {15, 91, 159}, {6, 67, 121}, {1, 42, 77}, {1, 17, 31}},
+                        {{102, 148, 228}, {67, 117, 204}, {17, 82, 154}, {6, 59, 114}, {2, 39, 75}, {1, 15, 29}},
+                        {{156, 57, 233}, {119, 57, 212}, {58, 48, 163}, {29, 40, 124}, {12, 30, 81}, {3, 12, 31}},
+                    },
+                    {
+                        {{191, 107, 226}, {124, 117, 204}, {25, 99, 155}},
+                        {{29, 148, 210}, {37, 126, 194}, {8, 93, 157}, {2, 68, 118}, {1, 39, 69}, {1, 17, 33}},
+                        {{41, 151, 213}, {27, 123, 193}, {3, 82, 144}, {1, 58, 105}, {1, 32, 60}, {1, 13, 26}},
+                        {{59, 159, 220}, {23, 126, 198}, {4, 88, 151}, {1, 66, 114}, {1, 38, 71}, {1, 18, 34}},
+                        {{114, 136, 232}, {51, 114, 207}, {11, 83, 155}, {3, 56, 105}, {1, 33, 65}, {1, 17, 34}},
+                        {{149, 65, 234}, {121, 57, 215}, {61, 49, 166}, {28, 36, 114}, {12, 25, 76}, {3, 16, 42}},
+                    },
+                },
+                {
+                    {
+                        {{214, 49, 220}, {132, 63, 188}, {42, 65, 137}},
+                        {{85, 137, 221}, {104, 131, 216}, {49, 111, 192}, {21, 87, 155}, {2, 49, 87}, {1, 16, 28}},
+                        {{89, 163, 230}, {90, 137, 220}, {29, 100, 183}, {10, 70, 135}, {2, 42, 81}, {1, 17, 33}},
+                        {{108, 167, 237}, {55, 133, 222}, {15, 97, 179}, {4, 72, 135}, {1, 45, 85}, {1, 19, 38}},
+                        {{124, 146, 240}, {66, 124, 224}, {17, 88, 175}, {4, 58, 122}, {1, 36, 75}, {1, 18, 37}},
+                        {{141, 79, 241}, {126, 70, 227}, {66, 58, 182}, {30, 44, 136}, {12, 34, 96}, {2, 20, 47}},
+                    },
+                    {
+                        {{229, 99, 249}, {143, 111, 235}, {46, 109, 192}},
+                        {{82, 158, 236}, {94, 146, 224}, {25, 117, 191}, {9, 87, 149}, {3, 56, 99}, {1, 33, 57}},
+                        {{83, 167, 237}, {68, 145, 222}, {10, 103, 177}, {2, 72, 131}, {1, 41, 79}, {1, 20, 39}},
+                        {{99, 167, 239}, {47, 141, 224}, {10, 104, 178}, {2, 73, 133}, {1, 44, 85}, {1, 22, 47}},
+                        {{127, 145, 243}, {71, 129, 228}, {17, 93, 177}, {3, 61, 124}, {1, 41, 84}, {1, 21, 52}},
+                        {{157, 78, 244}, {140, 72, 231}, {69, 58, 184}, {31, 44, 137}, {14, 38, 105}, {8, 23, 61}},
+                    },
+                },
+            },
+            { // 8x8
+                {
+                    {
+                        {{125, 34, 187}, {52, 41, 133}, {6, 31, 56}},
+                        {{37, 109, 153}, {51, 102, 147}, {23, 87, 128}, {8, 67, 101}, {1, 41, 63}, {1, 19, 29}},
+                        {{31, 154, 185}, {17, 127, 175}, {6, 96, 145}, {2, 73, 114}, {1, 51, 82}, {1, 28, 45}},
+                        {{23, 163, 200}, {10, 131, 185}, {2, 93, 148}, {1, 67, 111}, {1, 41, 69}, {1, 14, 24}},
+                        {{29, 176, 217}, {12, 145, 201}, {3, 101, 156}, {1, 69, 111}, {1, 39, 63}, {1, 14, 23}},
+                        {{57, 192, 233}, {25, 154, 215}, {6, 109, 167}, {3, 78, 118}, {1, 48, 69}, {1, 21, 29}},
+                    },
+                    {
+                        {{202, 105, 245}, {108, 106, 216}, {18, 90, 144}},
+                        {{33, 172, 219}, {64, 149, 206}, {14, 117, 177}, {5, 90, 141}, {2, 61, 95}, {1, 37, 57}},
+                        {{33, 179, 220}, {11, 140, 198}, {1, 89, 148}, {1, 60, 104}, {1, 33, 57}, {1, 12, 21}},
+                        {{30, 181, 221}, {8, 141, 198}, {1, 87, 145}, {1, 58, 100}, {1, 31, 55}, {1, 12, 20}},
+                        {{32, 186, 224}, {7, 142, 198}, {1, 86, 143}, {1, 58, 100}, {1, 31, 55}, {1, 12, 22}},
+                        {{57, 192, 227}, {20, 143, 204}, {3, 96, 154}, {1, 68, 112}, {1, 42, 69}, {1, 19, 32}},
+                    },
+                },
+                {
+                    {
+                        {{212, 35, 215}, {113, 47, 169}, {29, 48, 105}},
+                        {{74, 129, 203}, {106, 120, 203}, {49, 107, 178}, {19, 84, 144}, {4, 50, 84}, {1, 15, 25}},
+                        {{71, 172, 217}, {44, 141, 209}, {15, 102, 173}, {6, 76, 133}, {2, 51, 89}, {1, 24, 42}},
+                        {{64, 185, 231}, {31, 148, 216}, {8, 103, 175}, {3, 74, 131}, {1, 46, 81}, {1, 18, 30}},
+                        {{65, 196, 235}, {25, 157, 221}, {5, 105, 174}, {1, 67, 120}, {1, 38, 69}, {1, 15, 30}},
+                        {{65, 204, 238}, {30, 156, 224}, {7, 107, 177}, {2, 70, 124}, {1, 42, 73}, {1, 18, 34}},
+                    },
+                    {
+                        {{225, 86, 251}, {144, 104, 235}, {42, 99, 181}},
+                        {{85, 175, 239}, {112, 165, 229}, {29, 136, 200}, {12, 103, 162}, {6, 77, 123}, {2, 53, 84}},
+                        {{75, 183, 239}, {30, 155, 221}, {3, 106, 171}, {1, 74, 128}, {1, 44, 76}, {1, 17, 28}},
+                        {{73, 185, 240}, {27, 159, 222}, {2, 107, 172}, {1, 75, 127}, {1, 42, 73}, {1, 17, 29}},
+                        {{62, 190, 238}, {21, 159, 222}, {2, 107, 172}, {1, 72, 122}, {1, 40, 71}, {1, 18, 32}},
+                        {{61, 199, 240}, {27, 161, 226}, {4, 113, 180}, {1, 76, 129}, {1, 46, 80}, {1, 23, 41}},
+                    },
+                },
+            },
+            { // 16x16
+                {
+                    {
+                        {{7, 27, 153}, {5, 30, 95}, {1, 16, 30}},
+                        {{50, 75, 127}, {57, 75, 124}, {27, 67, 108}, {10, 54, 86}, {1, 33, 52}, {1, 12, 18}},
+                        {{43, 125, 151}, {26, 108, 148}, {7, 83, 122}, {2, 59, 89}, {1, 38, 60}, {1, 17, 27}},
+                        {{23, 144, 163}, {13, 112, 154}, {2, 75, 117}, {1, 50, 81}, {1, 31, 51}, {1, 14, 23}},
+                        {{18, 162, 185}, {6, 123, 171}, {1, 78, 125}, {1, 51, 86}, {1, 31, 54}, {1, 14, 23}},
+                        {{15, 199, 227}, {3, 150, 204}, {1, 91, 146}, {1, 55, 95}, {1, 30, 53}, {1, 11, 20}},
+                    },
+                    {
+                        {{19, 55, 240}, {19, 59, 196}, {3, 52, 105}},
+                        {{41, 166, 207}, {104, 153, 199}, {31, 123, 181}, {14, 101, 152}, {5, 72, 106}, {1, 36, 52}},
+                        {{35, 176, 211}, {12, 131, 190}, {2, 88, 144}, {1, 60, 101}, {1, 36, 60}, {1, 16, 28}},
+                        {{28, 183, 213}, {8, 134, 191}, {1, 86, 142}, {1, 56, 96}, {1, 30, 53}, {1, 12, 20}},
+                        {{20, 190, 215}, {4, 135, 192}, {1, 84, 139}, {1, 53, 91}, {1, 28, 49}, {1, 11, 20}},
+                        {{13, 196, 216}, {2, 137, 192}, {1, 86, 143}, {1, 57, 99}, {1, 32, 56}, {1, 13, 24}},
+                    },
+                },
+                {
+                    {
+                        {{211, 29, 217}, {96, 47, 156}, {22, 43, 87}},
+                        {{78, 120, 193}, {111, 116, 186}, {46, 102, 164}, {15, 80, 128}, {2, 49, 76}, {1, 18, 28}},
+                        {{71, 161, 203}, {42, 132, 192}, {10, 98, 150}, {3, 69, 109}, {1, 44, 70}, {1, 18, 29}},
+                        {{57, 186, 211}, {30, 140, 196}, {4, 93, 146}, {1, 62, 102}, {1, 38, 65}, {1, 16, 27}},
+                        {{47, 199, 217}, {14, 145, 196}, {1, 88, 142}, {1, 57, 98}, {1, 36, 62}, {1, 15, 26}},
+                        {{26, 219, 229}, {5, 155, 207}, {1, 94, 151}, {1, 60, 104}, {1, 36, 62}, {1, 16, 28}},
+                    },
+                    {
+                        {{233, 29, 248}, {146, 47, 220}, {43, 52, 140}},
+                        {{100, 163, 232}, {179, 161, 222}, {63, 142, 204}, {37, 113, 174}, {26, 89, 137}, {18, 68, 97}},
+                        {{85, 181, 230}, {32, 146, 209}, {7, 100, 164}, {3, 71, 121}, {1, 45, 77}, {1, 18, 30}},
+                        {{65, 187, 230}, {20, 148, 207}, {2, 97, 159}, {1, 68, 116}, {1, 40, 70}, {1, 14, 29}},
+                        {{40, 194, 227}, {8, 147, 204}, {1, 94, 155}, {1, 65, 112}, {1, 39, 66}, {1, 14, 26}},
+                        {{16, 208, 228}, {3, 151, 207}, {1, 98, 160}, {1, 67, 117}, {1, 41, 74}, {1, 17, 31}},
+                    },
+                },
+            },
+            { // 32x32
+                {
+                    {
+                        {{17, 38, 140}, {7, 34, 80}, {1, 17, 29}},
+                        {{37, 75, 128}, {41, 76, 128}, {26, 66, 116}, {12, 52, 94}, {2, 32, 55}, {1, 10, 16}},
+                        {{50, 127, 154}, {37, 109, 152}, {16, 82, 121}, {5, 59, 85}, {1, 35, 54}, {1, 13, 20}},
+                        {{40, 142, 167}, {17, 110, 157}, {2, 71, 112}, {1, 44, 72}, {1, 27, 45}, {1, 11, 17}},
+                        {{30, 175, 188}, {9, 124, 169}, {1, 74, 116}, {1, 48, 78}, {1, 30, 49}, {1, 11, 18}},
+                        {{10, 222, 223}, {2, 150, 194}, {1, 83, 128}, {1, 48, 79}, {1, 27, 45}, {1, 11, 17}},
+                    },
+                    {
+                        {{36, 41, 235}, {29, 36, 193}, {10, 27, 111}},
+                        {{85, 165, 222}, {177, 162, 215}, {110, 135, 195}, {57, 113, 168}, {23, 83, 120}, {10, 49, 61}},
+                        {{85, 190, 223}, {36, 139, 200}, {5, 90, 146}, {1, 60, 103}, {1, 38, 65}, {1, 18, 30}},
+                        {{72, 202, 223}, {23, 141, 199}, {2, 86, 140}, {1, 56, 97}, {1, 36, 61}, {1, 16, 27}},
+                        {{55, 218, 225}, {13, 145, 200}, {1, 86, 141}, {1, 57, 99}, {1, 35, 61}, {1, 13, 22}},
+                        {{15, 235, 212}, {1, 132, 184}, {1, 84, 139}, {1, 57, 97}, {1, 34, 56}, {1, 14, 23}},
+                    },
+                },
+                {
+                    {
+                        {{181, 21, 201}, {61, 37, 123}, {10, 38, 71}},
+                        {{47, 106, 172}, {95, 104, 173}, {42, 93, 159}, {18, 77, 131}, {4, 50, 81}, {1, 17, 23}},
+                        {{62, 147, 199}, {44, 130, 189}, {28, 102, 154}, {18, 75, 115}, {2, 44, 65}, {1, 12, 19}},
+                        {{55, 153, 210}, {24, 130, 194}, {3, 93, 146}, {1, 61, 97}, {1, 31, 50}, {1, 10, 16}},
+                        {{49, 186, 223}, {17, 148, 204}, {1, 96, 142}, {1, 53, 83}, {1, 26, 44}, {1, 11, 17}},
+                        {{13, 217, 212}, {2, 136, 180}, {1, 78, 124}, {1, 50, 83}, {1, 29, 49}, {1, 14, 23}},
+                    },
+                    {
+                        {{197, 13, 247}, {82, 17, 222}, {25, 17, 162}},
+                        {{126, 186, 247}, {234, 191, 243}, {176, 177, 234}, {104, 158, 220}, {66, 128, 186}, {55, 90, 137}},
+                        {{111, 197, 242}, {46, 158, 219}, {9, 104, 171}, {2, 65, 125}, {1, 44, 80}, {1, 17, 91}},
+                        {{104, 208, 245}, {39, 168, 224}, {3, 109, 162}, {1, 79, 124}, {1, 50, 102}, {1, 43, 102}},
+                        {{84, 220, 246}, {31, 177, 231}, {2, 115, 180}, {1, 79, 134}, {1, 55, 77}, {1, 60, 79}},
+                        {{43, 243, 240}, {8, 180, 217}, {1, 115, 166}, {1, 84, 121}, {1, 51, 67}, {1, 16, 6}},
+                    },
+                },
+            },
+        };
+
+        Vp9EntropyProbs probs{};
+        for (size_t i{}; i < 4; i++) {
+            for (size_t j{}; j < 8; j++)
+                probs.yModeProbs[i][j] = DefaultYModeProbs[i][j];
+            probs.yModeProbsE8[i] = DefaultYModeProbs[i][8];
+        }
+        for (size_t i{}; i < 10; i++) {
+            for (size_t j{}; j < 8; j++)
+                probs.uvModeProbs[i][j] = DefaultUvModeProbs[i][j];
+            probs.uvModeProbsE8[i] = DefaultUvModeProbs[i][8];
+        }
+        for (size_t i{}; i < 16; i++)
+            for (size_t j{}; j < 3; j++)
+                probs.partitionProbs[i][j] = DefaultPartitionProbs[i][j];
+        for (size_t i{}; i < 4; i++)
+            for (size_t j{}; j < 2; j++)
+                probs.switchableInterpProbs[i][j] = DefaultSwitchableInterpProbs[i][j];
+        for (size_t i{}; i < 7; i++)
+            for (size_t j{}; j < 3; j++)
+                probs.interModeProbs[i][j] = DefaultInterModeProbs[i][j];
+        for (size_t i{}; i < 4; i++)
+            probs.intraInterProbs[i] = DefaultIntraInterProbs[i];
+        for (size_t i{}; i < 5; i++) {
+            probs.compInterProbs[i] = DefaultCompInterProbs[i];
+            probs.singleRefProbs[i] = {DefaultSingleRefProbs[i][0], DefaultSingleRefProbs[i][1]};
+            probs.compRefProbs[i] = DefaultCompRefProbs[i];
+        }
+        for (size_t i{}; i < 2; i++) {
+            probs.tx8x8Probs[i][0] = DefaultTx8x8Probs[i][0];
+            for (size_t j{}; j < 2; j++)
+                probs.tx16x16Probs[i][j] = DefaultTx16x16Probs[i][j];
+            for (size_t j{}; j < 3; j++)
+                probs.tx32x32Probs[i][j] = DefaultTx32x32Probs[i][j];
+        }
+        for (size_t i{}; i < 3; i++) {
+            probs.skipProbs[i] = DefaultSkipProbs[i];
+            probs.mvJointProbs[i] = DefaultMvJointProbs[i];
+        }
+        for (size_t i{}; i < 2; i++) {
+            const auto &component{DefaultMvComponentProbs[i]};
+            probs.mvSignProbs[i] = component.sign;
+            probs.mvClassesProbs[i] = component.classes;
+            probs.mvClass0Probs[i][0] = component.class0;
+            probs.mvBitsProbs[i] = component.bits;
+            probs.mvClass0FpProbs[i] = component.class0Fp;
+            probs.mvFpProbs[i] = component.fp;
+            probs.mvClass0HpProbs[i] = component.class0Hp;
+            probs.mvHpProbs[i] = component.hp;
+        }
+        for (size_t txSize{}; txSize < 4; txSize++)
+            for (size_t plane{}; plane < 2; plane++)
+                for (size_t reference{}; reference < 2; reference++)
+                    for (size_t band{}; band < 6; band++)
+                        for (size_t context{}; context < 6; context++)
+                            for (size_t node{}; node < 3; node++)
+                                probs.coefProbs[txSize][plane][reference][band][context][node] = DefaultCoefProbs[txSize][plane][reference][band][context][node];
+        return probs;
+    }()};
+
+    /**
+     * @brief The probability that a delta of a probability update decodes to, this is the inverse of the remapping done by encoders (Section 8.4.2)
+     */
+    static u8 InvRemapProbability(u8 delta, u8 probability) {
+        auto invRecenterNonneg{[](i32 v, i32 m) {
+            if (v > 2 * m)
+                return v;
+            return (v & 1) ? m - ((v + 1) >> 1) : m + (v >> 1);
+        }};
+
+        i32 v{InvMapTable[delta]}, m{probability - 1};
+        if ((m << 1) <= 255)
+            return static_cast<u8>(1 + invRecenterNonneg(v, m));
+        return static_cast<u8>(255 - invRecenterNonneg(v, 255 - 1 - m));
+    }
+
+    /**
+     * @brief Writes a delta with the terminated subexponential code used by probability updates (Section 9.2.2, decode_term_subexp)
+     */
+    static void WriteTermSubexp(Vp9BoolEncoder &encoder, u32 value) {
+        if (value < 16) {
+            encoder.WriteLiteral(0b0, 1);
+            encoder.WriteLiteral(value, 4);
+        } else if (value < 32) {
+            encoder.WriteLiteral(0b10, 2);
+            encoder.WriteLiteral(value - 16, 4);
+        } else if (value < 64) {
+            encoder.WriteLiteral(0b110, 3);
+            encoder.WriteLiteral(value - 32, 5);
+        } else if (value < 129) {
+            encoder.WriteLiteral(0b111, 3);
+            encoder.WriteLiteral(value - 64, 7);
+        } else {
+            // Values beyond 128 are coded as 7 bits which are at least 65 and an extra bit
+            encoder.WriteLiteral(0b111, 3);
+            encoder.WriteLiteral((value + 1) >> 1, 7);
+            encoder.WriteLiteral((value + 1) & 1, 1);
+        }
+    }
+
+    /**
+     * @brief Writes a forward update of a probability to the target value (diff_update_prob), the probability is updated to reflect what the decoder will use
+     */
+    static void WriteProbabilityUpdate(Vp9BoolEncoder &encoder, u8 &probability, u8 target) {
+        if (target != probability && target != 0) {
+            for (u8 delta{}; delta < InvMapTable.size(); delta++) {
+                if (InvRemapProbability(delta, probability) == target) {
+                    encoder.Write(true, UpdateProbability);
+                    WriteTermSubexp(encoder, delta);
+                    probability = target;
+                    return;
+                }
+            }
+        }
+        encoder.Write(false, UpdateProbability);
+    }
+
+    /**
+     * @brief Writes a forward update of a motion vector probability (update_mv_prob), these are coded with 7 bits so only odd probabilities can be represented
+     */
+    static void WriteMvProbabilityUpdate(Vp9BoolEncoder &encoder, u8 &probability, u8 target) {
+        if (target != probability && (target | 1) != probability) {
+            encoder.Write(true, UpdateProbability);
+            encoder.WriteLiteral(target >> 1, 7);
+            probability = static_cast<u8>(target | 1);
+        } else {
+            encoder.Write(false, UpdateProbability);
+        }
+    }
+
+    Vp9FrameComposer::Vp9FrameComposer() {
+        Reset();
+    }
+
+    void Vp9FrameComposer::Reset() {
+        slots = {};
+        frameIndex = 0;
+        contexts.fill(DefaultProbabilities);
+    }
+
+    u8 Vp9FrameComposer::FindSlot(u32 surfaceAddress) {
+        for (u8 index{}; index < slots.size(); index++) {
+            if (slots[index].surfaceAddress == surfaceAddress) {
+                slots[index].lastUse = frameIndex;
+                return index;
+            }
+        }
+        return 0;
+    }
+
+    u8 Vp9FrameComposer::AllocateSlots(u32 surfaceAddress, const std::array<u32, 3> &referenceSurfaces) {
+        // Any slots holding the surface that's being decoded into have stale contents and need to be refreshed with the new frame
+        u8 refreshMask{};
+        for (u8 index{}; index < slots.size(); index++)
+            if (slots[index].surfaceAddress == surfaceAddress)
+                refreshMask |= static_cast<u8>(1 << index);
+
+        if (!refreshMask) {
+            // Otherwise a slot which duplicates another one is preferred, then the least recently used one, slots which the frame references can't be replaced
+            auto isDuplicate{[&](size_t index) {
+                for (size_t other{}; other < slots.size(); other++)
+                    if (other != index && slots[other].surfaceAddress == slots[index].surfaceAddress)
+                        return true;
+                return false;
+            }};
+
+            std::optional<size_t> victim;
+            for (size_t index{}; index < slots.size(); index++) {
+                bool duplicate{isDuplicate(index)};
+                if (!duplicate && std::find(referenceSurfaces.begin(), referenceSurfaces.end(), slots[index].surfaceAddress) != referenceSurfaces.end())
+                    continue;
+
+                if (!victim || (duplicate && !isDuplicate(*victim)) || (duplicate == isDuplicate(*victim) && slots[index].lastUse < slots[*victim].lastUse))
+                    victim = index;
+            }
+            refreshMask = static_cast<u8>(1 << victim.value_or(0));
+        }
+
+        for (u8 index{}; index < slots.size(); index++) {
+            if (refreshMask & (1 << index))
+                slots[index] = {surfaceAddress, frameIndex};
+        }
+        return refreshMask;
+    }
+
+    u8 Vp9FrameComposer::SelectContext(const Vp9EntropyProbs &probs) {
+        // Motion vector probabilities which can't be coded from a context are far costlier than any other difference as they change the decoded frame
+        constexpr size_t MvMismatchCost{0x10000};
+        constexpr size_t MvProbsOffset{offsetof(Vp9EntropyProbs, mvJointProbs)}, MvProbsEnd{offsetof(Vp9EntropyProbs, singleRefProbs)};
+
+        u8 selected{};
+        size_t selectedCost{std::numeric_limits<size_t>::max()};
+        for (u8 index{}; index < contexts.size(); index++) {
+            auto current{reinterpret_cast<const u8 *>(&contexts[index])}, target{reinterpret_cast<const u8 *>(&probs)};
+            size_t cost{};
+            for (size_t offset{}; offset < sizeof(Vp9EntropyProbs); offset++) {
+                if (current[offset] != target[offset]) {
+                    bool mvMismatch{offset >= MvProbsOffset && offset < MvProbsEnd && !(target[offset] & 1)};
+                    cost += mvMismatch ? MvMismatchCost : 1;
+                }
+            }
+
+            if (cost < selectedCost) {
+                selected = index;
+                selectedCost = cost;
+            }
+        }
+        return selected;
+    }
+
+    void Vp9FrameComposer::WriteCompressedHeader(const Vp9PictureInfo &info, const Vp9EntropyProbs &probs, bool intraFrame, bool lossless, Vp9EntropyProbs &context, std::vector<u8> &output) {
+        Vp9BoolEncoder encoder{output};
+        auto update{[&](u8 &probability, u8 target) { WriteProbabilityUpdate(encoder, probability, target); }};
+        auto updateMv{[&](u8 &probability, u8 target) { WriteMvProbabilityUpdate(encoder, probability, target); }};
+
+        u8 txMode{lossless ? u8{} : std::min<u8>(info.txMode, TxModeSelect)};
+        if (!lossless) {
+            encoder.WriteLiteral(std::min<u8>(txMode, 3), 2);
+            if (txMode >= 3)
+                encoder.WriteLiteral(txMode == TxModeSelect, 1);
+        }
+
+        if (txMode == TxModeSelect) {
+            for (size_t i{}; i < 2; i++)
+                update(context.tx8x8Probs[i][0], probs.tx8x8Probs[i][0]);
+            for (size_t i{}; i < 2; i++)
+                for (size_t j{}; j < 2; j++)
+                    update(context.tx16x16Probs[i][j], probs.tx16x16Probs[i][j]);
+            for (size_t i{}; i < 2; i++)
+                for (size_t j{}; j < 3; j++)
+                    update(context.tx32x32Probs[i][j], probs.tx32x32Probs[i][j]);
+        }
+
+        // Coefficient probabilities are only coded up to the largest transform size that the transform mode allows, the first band only has 3 contexts
+        u8 maxTxSize{std::min<u8>(txMode, 3)};
+        for (u8 txSize{}; txSize <= maxTxSize; txSize++) {
+            auto forEachCoefProb{[&](auto function) {
+                for (size_t plane{}; plane < 2; plane++)
+                    for (size_t reference{}; reference < 2; reference++)
+                        for (size_t band{}; band < 6; band++)
+                            for (size_t ctx{}; ctx < (band == 0 ? 3U : 6U); ctx++)
+                                for (size_t node{}; node < 3; node++)
+                                    function(context.coefProbs[txSize][plane][reference][band][ctx][node], probs.coefProbs[txSize][plane][reference][band][ctx][node]);
+            }};
+
+            bool changed{};
+            forEachCoefProb([&](u8 probability, u8 target) { changed |= probability != target; });
+            encoder.WriteLiteral(changed, 1);
+            if (changed)
+                forEachCoefProb(update);
+        }
+
+        for (size_t i{}; i < 3; i++)
+            update(context.skipProbs[i], probs.skipProbs[i]);
+
+        if (!intraFrame) {
+            for (size_t i{}; i < 7; i++)
+                for (size_t j{}; j < 3; j++)
+                    update(context.interModeProbs[i][j], probs.interModeProbs[i][j]);
+
+            if (info.interpFilter == SwitchableInterpFilter)
+                for (size_t i{}; i < 4; i++)
+                    for (size_t j{}; j < 2; j++)
+                        update(context.switchableInterpProbs[i][j], probs.switchableInterpProbs[i][j]);
+
+            for (size_t i{}; i < 4; i++)
+                update(context.intraInterProbs[i], probs.intraInterProbs[i]);
+
+            // Compound prediction is only possible when the reference frames have differing sign biases
+            constexpr u8 SingleReference{0}, CompoundReference{1}, ReferenceModeSelect{2};
+            u8 referenceMode{SingleReference};
+            if (info.refFrameSignBias[2] != info.refFrameSignBias[1] || info.refFrameSignBias[3] != info.refFrameSignBias[1]) {
+                referenceMode = std::min(info.referenceMode, ReferenceModeSelect);
+                encoder.WriteLiteral(referenceMode != SingleReference, 1);
+                if (referenceMode != SingleReference)
+                    encoder.WriteLiteral(referenceMode == ReferenceModeSelect, 1);
+            }
+
+            if (referenceMode == ReferenceModeSelect)
+                for (size_t i{}; i < 5; i++)
+                    update(context.compInterProbs[i], probs.compInterProbs[i]);
+            if (referenceMode != CompoundReference)
+                for (size_t i{}; i < 5; i++)
+                    for (size_t j{}; j < 2; j++)
+                        update(context.singleRefProbs[i][j], probs.singleRefProbs[i][j]);
+            if (referenceMode != SingleReference)
+                for (size_t i{}; i < 5; i++)
+                    update(context.compRefProbs[i], probs.compRefProbs[i]);
+
+            for (size_t i{}; i < 4; i++) {
+                for (size_t j{}; j < 8; j++)
+                    update(context.yModeProbs[i][j], probs.yModeProbs[i][j]);
+                update(context.yModeProbsE8[i], probs.yModeProbsE8[i]);
+            }
+
+            for (size_t i{}; i < 16; i++)
+                for (size_t j{}; j < 3; j++)
+                    update(context.partitionProbs[i][j], probs.partitionProbs[i][j]);
+
+            for (size_t i{}; i < 3; i++)
+                updateMv(context.mvJointProbs[i], probs.mvJointProbs[i]);
+            for (size_t i{}; i < 2; i++) {
+                updateMv(context.mvSignProbs[i], probs.mvSignProbs[i]);
+                for (size_t j{}; j < 10; j++)
+                    updateMv(context.mvClassesProbs[i][j], probs.mvClassesProbs[i][j]);
+                updateMv(context.mvClass0Probs[i][0], probs.mvClass0Probs[i][0]);
+                for (size_t j{}; j < 10; j++)
+                    updateMv(context.mvBitsProbs[i][j], probs.mvBitsProbs[i][j]);
+            }
+            for (size_t i{}; i < 2; i++) {
+                for (size_t j{}; j < 2; j++)
+                    for (size_t k{}; k < 3; k++)
+                        updateMv(context.mvClass0FpProbs[i][j][k], probs.mvClass0FpProbs[i][j][k]);
+                for (size_t k{}; k < 3; k++)
+                    updateMv(context.mvFpProbs[i][k], probs.mvFpProbs[i][k]);
+            }
+            if (info.allowHighPrecisionMv) {
+                for (size_t i{}; i < 2; i++) {
+                    updateMv(context.mvClass0HpProbs[i], probs.mvClass0HpProbs[i]);
+                    updateMv(context.mvHpProbs[i], probs.mvHpProbs[i]);
+                }
+            }
+        }
+
+        encoder.Finish();
+    }
+
+    void Vp9FrameComposer::Compose(const Vp9PictureInfo &info, const Vp9EntropyProbs &probs, u32 surfaceAddress, const std::array<u32, 3> &referenceSurfaces, span<const u8> tileData, bool showFrame, std::vector<u8> &output) {
+        constexpr u32 SyncCode{0x498342};
+        constexpr u8 ColorSpaceBt601{1};
+        constexpr std::array<u8, 4> InterpFilterLiterals{1, 0, 2, 3}; //!< The literal coding each interpolation filter type, the literals of the regular and smooth filters are swapped relative to their types
+        constexpr std::array<u8, 4> SegmentationFeatureBits{8, 6, 2, 0};
+        constexpr std::array<bool, 4> SegmentationFeatureSigned{true, true, false, false};
+
+        bool keyFrame{info.keyFrame != 0};
+        bool intraOnly{!keyFrame && info.intraOnly}; // intra_only is only coded for hidden frames, such frames can only be displayed through a later reference
+        bool errorResilient{info.errorResilientMode != 0};
+        bool lossless{info.baseQIndex == 0 && info.yDcDeltaQ == 0 && info.uvDcDeltaQ == 0 && info.uvAcDeltaQ == 0};
+        showFrame &= !intraOnly;
+        u32 width{info.currentFrameSize.width}, height{info.currentFrameSize.height};
+
+        frameIndex++;
+        std::array<u8, 3> referenceSlots{};
+        if (!keyFrame && !intraOnly)
+            for (size_t index{}; index < referenceSlots.size(); index++)
+                referenceSlots[index] = FindSlot(referenceSurfaces[index]);
+
+        u8 refreshMask;
+        if (keyFrame) {
+            slots.fill({surfaceAddress, frameIndex});
+            refreshMask = 0xFF;
+        } else {
+            refreshMask = AllocateSlots(surfaceAddress, referenceSurfaces);
+        }
+
+        // Key frames and frames in error resilient mode reset all frame contexts to the defaults, intra-only frames always use the first context
+        if (keyFrame || errorResilient)
+            contexts.fill(DefaultProbabilities);
+        u8 contextIndex{(keyFrame || intraOnly || errorResilient) ? u8{} : SelectContext(probs)};
+
+        std::vector<u8> compressedHeader;
+        WriteCompressedHeader(info, probs, keyFrame || intraOnly, lossless, contexts[contextIndex], compressedHeader);
+        if (errorResilient)
+            contexts[contextIndex] = DefaultProbabilities; // Frames in error resilient mode don't refresh their frame context
+
+        output.clear();
+        Vp9BitWriter writer{output};
+        writer.WriteBits(0b10, 2); // frame_marker
+        writer.WriteBits(0, 2); // profile_low_bit and profile_high_bit, only 8-bit 4:2:0 content (Profile 0) is supported
+        writer.WriteBit(false); // show_existing_frame
+        writer.WriteBit(!keyFrame); // frame_type
+        writer.WriteBit(showFrame);
+        writer.WriteBit(errorResilient);
+
+        auto writeFrameSize{[&] {
+            writer.WriteBits(width - 1, 16);
+            writer.WriteBits(height - 1, 16);
+            writer.WriteBit(false); // render_and_frame_size_different
+        }};
+
+        if (keyFrame) {
+            writer.WriteBits(SyncCode, 24);
+            writer.WriteBits(ColorSpaceBt601, 3);
+            writer.WriteBit(false); // color_range, NVDEC doesn't supply the color configuration so studio swing is assumed
+            writeFrameSize();
+        } else {
+            if (!showFrame)
+                writer.WriteBit(intraOnly);
+            if (!errorResilient)
+                writer.WriteBits(0, 2); // reset_frame_context
+
+            if (intraOnly)
+                writer.WriteBits(SyncCode, 24); // Intra-only frames use the default color configuration in Profile 0
+            writer.WriteBits(refreshMask, 8);
+            if (!intraOnly) {
+                for (size_t index{}; index < referenceSlots.size(); index++) {
+                    writer.WriteBits(referenceSlots[index], 3);
+                    writer.WriteBit(info.refFrameSignBias[index + 1] != 0);
+                }
+                writer.WriteBits(0, 3); // found_ref for every reference, the frame size is always written explicitly
+            }
+            writeFrameSize();
+
+            if (!intraOnly) {
+                writer.WriteBit(info.allowHighPrecisionMv != 0);
+                bool switchable{info.interpFilter >= SwitchableInterpFilter};
+                writer.WriteBit(switchable);
+                if (!switchable)
+                    writer.WriteBits(InterpFilterLiterals[info.interpFilter], 2);
+            }
+        }
+
+        if (!errorResilient) {
+            writer.WriteBit(true); // refresh_frame_context
+            writer.WriteBit(true); // frame_parallel_decoding_mode, backward adaptation is disabled as the guest's probabilities are supplied for every frame
+        }
+        writer.WriteBits(contextIndex, 2); // frame_context_idx
+
+        writer.WriteBits(info.filterLevel, 6);
+        writer.WriteBits(info.sharpnessLevel, 3);
+        writer.WriteBit(info.loopFilter.modeRefDeltaEnabled != 0);
+        if (info.loopFilter.modeRefDeltaEnabled) {
+            writer.WriteBit(true); // mode_ref_delta_update
+            for (auto delta : info.loopFilter.refDeltas) {
+                writer.WriteBit(true);
+                writer.WriteSigned(delta, 6);
+            }
+            for (auto delta : info.loopFilter.modeDeltas) {
+                writer.WriteBit(true);
+                writer.WriteSigned(delta, 6);
+            }
+        }
+
+        writer.WriteBits(info.baseQIndex, 8);
+        for (auto delta : {info.yDcDeltaQ, info.uvDcDeltaQ, info.uvAcDeltaQ}) {
+            writer.WriteBit(delta != 0);
+            if (delta)
+                writer.WriteSigned(delta, 4);
+        }
+
+        const auto &segmentation{info.segmentation};
+        writer.WriteBit(segmentation.enabled != 0);
+        if (segmentation.enabled) {
+            // Probabilities of 255 are implied when they aren't coded
+            auto writeProbability{[&](u8 probability) {
+                writer.WriteBit(probability != 255);
+                if (probability != 255)
+                    writer.WriteBits(probability, 8);
+            }};
+
+            writer.WriteBit(segmentation.updateMap != 0);
+            if (segmentation.updateMap) {
+                for (auto probability : probs.segTreeProbs)
+                    writeProbability(probability);
+                writer.WriteBit(segmentation.temporalUpdate != 0);
+                if (segmentation.temporalUpdate)
+                    for (auto probability : probs.segPredProbs)
+                        writeProbability(probability);
+            }
+
+            writer.WriteBit(true); // segmentation_update_data
+            writer.WriteBit(segmentation.absDelta != 0);
+            for (size_t segment{}; segment < segmentation.featureMask.size(); segment++) {
+                for (size_t feature{}; feature < SegmentationFeatureBits.size(); feature++) {
+                    bool enabled{((segmentation.featureMask[segment] >> feature) & 1) != 0};
+                    writer.WriteBit(enabled);
+                    if (enabled) {
+                        i32 value{segmentation.featureData[segment][feature]};
+                        writer.WriteBits(static_cast<u32>(std::abs(value)), SegmentationFeatureBits[feature]);
+                        if (SegmentationFeatureSigned[feature])
+                            writer.WriteBit(value < 0);
+                    }
+                }
+            }
+        }
+
+        // The range of tile column counts depends on the width of the frame in 64x64 superblocks, increments from the minimum are coded in unary
+        u32 superblockColumns{(((width + 7) >> 3) + 7) >> 3};
+        u32 minLog2TileCols{}, maxLog2TileCols{1};
+        while ((64U << minLog2TileCols) < superblockColumns)
+            minLog2TileCols++;
+        while ((superblockColumns >> maxLog2TileCols) >= 4)
+            maxLog2TileCols++;
+        maxLog2TileCols = std::max(maxLog2TileCols - 1, minLog2TileCols);
+
+        u32 log2TileCols{std::clamp<u32>(info.log2TileCols, minLog2TileCols, maxLog2TileCols)};
+        for (u32 log2{minLog2TileCols}; log2 < maxLog2TileCols; log2++) {
+            writer.WriteBit(log2 < log2TileCols);
+            if (log2 >= log2TileCols)
+                break;
+        }
+        writer.WriteBit(info.log2TileRows != 0);
+        if (info.log2TileRows)
+            writer.WriteBit(info.log2TileRows > 1);
+
+        writer.WriteBits(static_cast<u32>(compressedHeader.size()), 16); // header_size_in_bytes
+        writer.Align();
+
+        output.insert(output.end(), compressedHeader.begin(), compressedHeader.end());
+        output.insert(output.end(), tileData.begin(), tileData.end());
+    }
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <common.h>
+#include "nvdec_picture_info.h"
+
+namespace skyline::soc::host1x {
+    /**
+     * @brief Reconstructs complete VP9 frames from the state supplied to NVDEC, which is only the tile data of a frame alongside its picture setup and probability tables
+     * @note The compressed header is written as forward updates from the probabilities that the decoder holds to the ones supplied by the guest, this requires tracking the decoder's frame context across frames
+     * @note The frame context indices of the original stream aren't supplied to NVDEC, every frame uses and refreshes the context which is closest to its probabilities instead and backward adaptation is disabled
+     * @note Probabilities which can't be forward updated (the UV mode probabilities) or only to odd values (the motion vector probabilities) may differ from the guest's after it adapts them
+     */
+    class Vp9FrameComposer {
+      private:
+        static constexpr size_t ReferenceSlotCount{8}; //!< The amount of reference frame slots in a VP9 decoder
+        static constexpr size_t FrameContextCount{4}; //!< The amount of probability contexts that a VP9 decoder retains across frames
+
+        /**
+         * @brief The surface that a decoder reference frame slot holds
+         */
+        struct ReferenceSlot {
+            u32 surfaceAddress;
+            u64 lastUse; //!< The index of the last frame that referenced or refreshed the slot
+        };
+
+        std::array<ReferenceSlot, ReferenceSlotCount> slots{};
+        u64 frameIndex{};
+        std::array<Vp9EntropyProbs, FrameContextCount> contexts; //!< The probabilities in each of the decoder's frame contexts, these are the base for the forward updates of a frame
+
+        /**
+         * @return The index of the slot holding the supplied surface or the first slot if no slot holds it
+         */
+        u8 FindSlot(u32 surfaceAddress);
+
+        /**
+         * @return A bitmask of the slots that are refreshed with the current frame
+         */
+        u8 AllocateSlots(u32 surfaceAddress, const std::array<u32, 3> &referenceSurfaces);
+
+        /**
+         * @return The index of the frame context that the probabilities of a frame can be most accurately and compactly coded from
+         */
+        u8 SelectContext(const Vp9EntropyProbs &probs);
+
+        /**
+         * @brief Writes the compressed header of a frame and updates the frame context with the probabilities written into it
+         */
+        void WriteCompressedHeader(const Vp9PictureInfo &info, const Vp9EntropyProbs &probs, bool intraFrame, bool lossless, Vp9EntropyProbs &context, std::vector<u8> &output);
+
+      public:
+        Vp9FrameComposer();
+
+        /**
+         * @brief Resets the tracked decoder state, this must be called when the decoder is recreated
+         */
+        void Reset();
+
+        /**
+         * @brief Writes the uncompressed and compressed headers of a frame followed by its tile data
+         * @param surfaceAddress The address of the surface the frame is decoded into, reference frames are tracked by their surface
+         * @param referenceSurfaces The addresses of the last, golden and alternate reference surfaces
+         * @param showFrame If the frame is displayed, this isn't supplied to NVDEC and needs to be determined from the following frame
+         */
+        void Compose(const Vp9PictureInfo &info, const Vp9EntropyProbs &probs, u32 surfaceAddress, const std::array<u32, 3> &referenceSurfaces, span<const u8> tileData, bool showFrame, std::vector<u8> &output);
+    };
+}
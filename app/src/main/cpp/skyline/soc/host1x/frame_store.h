@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <condition_variable>
+#include <common.h>
+
+namespace skyline::soc::host1x {
+    /**
+     * @brief A decoded video frame in the semi-planar 4:2:0 layout that NVDEC outputs (NV12)
+     */
+    struct VideoFrame {
+        u32 width;
+        u32 height;
+        std::vector<u8> luma; //!< The Y plane with a pitch of the frame width
+        std::vector<u8> chroma; //!< The interleaved CbCr plane with a pitch of the frame width rounded up to an even number and half the height
+
+        VideoFrame(u32 width, u32 height) : width{width}, height{height}, luma(static_cast<size_t>(width) * height), chroma(static_cast<size_t>(util::AlignUp(width, 2)) * util::DivideCeil(height, 2U)) {}
+
+        u32 ChromaPitch() const {
+            return util::AlignUp(width, 2);
+        }
+    };
+
+    /**
+     * @brief The frames decoded by NVDEC keyed by the surface they were decoded into, the VIC looks up the frame of the surface that it composites
+     * @note NVDEC decodes frames in decoding order while the VIC composites them in display order, these differ for streams with reordered frames so frames can't be consumed in the order they were decoded in
+     * @note Decoding is asynchronous, a surface is marked as pending when a decode into it is submitted so the VIC can wait for the frame rather than using the prior contents of the surface
+     */
+    class FrameStore {
+      private:
+        static constexpr size_t MaxSurfaces{32}; //!< The maximum amount of surfaces to track, this is far more than the 17 surfaces that NVDEC can reference at once
+
+        /**
+         * @brief The state of a single NVDEC output surface
+         */
+        struct Surface {
+            u32 address; //!< The SMMU address of the surface's luma plane in units of 256 bytes
+            std::shared_ptr<VideoFrame> frame; //!< The latest frame that was decoded into the surface, this may be from a prior decode while one is pending
+            u64 frameSequence; //!< The sequence number of the decode that was last completed for this surface
+            u64 pendingSequence; //!< The sequence number of the latest decode that was submitted for this surface
+
+            bool Pending() const {
+                return frameSequence < pendingSequence;
+            }
+        };
+
+        std::mutex mutex;
+        std::condition_variable completeCondition; //!< Signalled when a decode is completed
+        std::vector<Surface> surfaces;
+        u64 sequence{}; //!< The sequence number of the last submitted decode
+        std::shared_ptr<VideoFrame> latestFrame; //!< The frame from the most recently completed decode, it's used when a surface isn't known
+
+        Surface *FindSurface(u32 address) {
+            auto it{std::find_if(surfaces.begin(), surfaces.end(), [address](const Surface &surface) { return surface.address == address; })};
+            return it != surfaces.end() ? &*it : nullptr;
+        }
+
+      public:
+        /**
+         * @brief Marks a surface as being decoded into, lookups of the surface will wait for the decode to be completed
+         * @return The sequence number of the decode which needs to be supplied to Complete
+         */
+        u64 Begin(u32 address) {
+            std::scoped_lock lock{mutex};
+            auto surface{FindSurface(address)};
+            if (!surface) {
+                if (surfaces.size() == MaxSurfaces) {
+                    // The surface which was least recently decoded into is replaced, it's unlikely that it's still in use by the guest
+                    auto oldest{std::min_element(surfaces.begin(), surfaces.end(), [](const Surface &a, const Surface &b) { return a.pendingSequence < b.pendingSequence; })};
+                    surfaces.erase(oldest);
+                }
+                surface = &surfaces.emplace_back(Surface{.address = address});
+            }
+
+            surface->pendingSequence = ++sequence;
+            return sequence;
+        }
+
+        /**
+         * @brief Supplies the frame for a decode which was submitted with Begin, decodes may be completed in any order
+         * @param frame The decoded frame or nullptr if the decode didn't output a frame, the surface retains its prior frame in that case
+         */
+        void Complete(u32 address, u64 decodeSequence, std::shared_ptr<VideoFrame> frame) {
+            {
+                std::scoped_lock lock{mutex};
+                auto surface{FindSurface(address)};
+                if (!surface || decodeSequence <= surface->frameSequence)
+                    return; // The surface was replaced or a more recent decode into it was already completed
+
+                surface->frameSequence = decodeSequence;
+                if (frame) {
+                    surface->frame = frame;
+                    latestFrame = std::move(frame);
+                }
+            }
+            completeCondition.notify_all();
+        }
+
+        /**
+         * @brief Looks up the frame in a surface, waiting for any pending decode into it to be completed
+         * @param timeout The maximum duration to wait for a pending decode, the prior frame of the surface is returned if it's exceeded
+         * @return The frame in the surface, the most recently decoded frame if the surface isn't known or nullptr if no frames have been decoded
+         */
+        std::shared_ptr<VideoFrame> Get(u32 address, std::chrono::nanoseconds timeout) {
+            std::unique_lock lock{mutex};
+            auto surface{FindSurface(address)};
+            if (!surface)
+                return latestFrame;
+
+            if (surface->Pending() && !completeCondition.wait_for(lock, timeout, [&] {
+                // The surface may be replaced while waiting, this invalidates the pointer to it
+                surface = FindSurface(address);
+                return !surface || !surface->Pending();
+            }))
+                Logger::Debug("Timed out waiting for a frame to be decoded into surface 0x{:X}", static_cast<u64>(address) << 8);
+
+            return (surface && surface->frame) ? surface->frame : latestFrame;
+        }
+    };
+}
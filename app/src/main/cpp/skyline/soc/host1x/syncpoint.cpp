@@ -2,81 +2,152 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 // Copyright © 2020 Ryujinx Team and Contributors (https://github.com/Ryujinx/)
 
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <common/trace.h>
 #include "syncpoint.h"
 
 namespace skyline::soc::host1x {
-    Syncpoint::WaiterHandle Syncpoint::RegisterWaiter(u32 threshold, const std::function<void()> &callback) {
-        if (value.load(std::memory_order_acquire) >= threshold) {
-            // (Fast path) We don't need to wait on the mutex and can just get away with atomics
-            callback();
-            return {};
+    void Syncpoint::SiftUp(size_t index) {
+        Waiter *waiter{waiters[index]};
+        while (index > 0) {
+            size_t parent{(index - 1) / 2};
+            if (waiters[parent]->threshold <= waiter->threshold)
+                break;
+
+            waiters[index] = waiters[parent];
+            waiters[index]->heapIndex = index;
+            index = parent;
         }
 
-        std::scoped_lock lock(mutex);
-        if (value.load(std::memory_order_acquire) >= threshold) {
-            callback();
-            return {};
+        waiters[index] = waiter;
+        waiter->heapIndex = index;
+    }
+
+    void Syncpoint::SiftDown(size_t index) {
+        Waiter *waiter{waiters[index]};
+        while (true) {
+            size_t child{index * 2 + 1};
+            if (child >= waiters.size())
+                break;
+            if (child + 1 < waiters.size() && waiters[child + 1]->threshold < waiters[child]->threshold)
+                child++;
+            if (waiter->threshold <= waiters[child]->threshold)
+                break;
+
+            waiters[index] = waiters[child];
+            waiters[index]->heapIndex = index;
+            index = child;
         }
 
-        auto it{waiters.begin()};
-        while (it != waiters.end() && threshold >= it->threshold)
-            it++;
-        return waiters.emplace(it, threshold, callback);
+        waiters[index] = waiter;
+        waiter->heapIndex = index;
     }
 
-    void Syncpoint::DeregisterWaiter(WaiterHandle waiter) {
-        std::scoped_lock lock(mutex);
-        // We want to ensure the iterator still exists prior to erasing it
-        // Otherwise, if an invalid iterator was passed in then it could lead to UB
-        // It is important to avoid UB in that case since the deregister isn't called from a locked context
-        for (auto it{waiters.begin()}; it != waiters.end(); it++) {
-            if (it == waiter) {
-                waiters.erase(it);
-                return;
-            }
+    void Syncpoint::RemoveWaiter(size_t index) {
+        waiters[index]->heapIndex = Waiter::NotQueued;
+
+        Waiter *last{waiters.back()};
+        waiters.pop_back();
+        if (index < waiters.size()) {
+            waiters[index] = last;
+            SiftDown(index);
+            SiftUp(last->heapIndex);
         }
+
+        if (waiters.empty())
+            hasWaiters.store(false, std::memory_order_relaxed);
     }
 
-    u32 Syncpoint::Increment() {
-        auto readValue{value.fetch_add(1, std::memory_order_acq_rel) + 1}; // We don't want to constantly do redundant atomic loads
-
-        std::scoped_lock lock(mutex);
-        bool signalCondition{};
-        auto it{waiters.begin()};
-        while (it != waiters.end() && readValue >= it->threshold) {
-            auto &waiter{*it};
-            if (waiter.callback)
-                waiter.callback();
-            else
-                signalCondition = true;
-            it++;
+    bool Syncpoint::RegisterWaiter(Waiter &waiter, u32 threshold) {
+        if (value.load(std::memory_order_acquire) >= threshold) {
+            // (Fast path) We don't need to wait on the mutex and can just get away with atomics
+            waiter.OnThresholdReached();
+            return false;
+        }
+
+        std::scoped_lock lock{mutex};
+        waiter.threshold = threshold;
+        waiters.push_back(&waiter);
+        SiftUp(waiters.size() - 1);
+
+        // The flag must be visible before the value is checked again, an increment will then either observe the flag and take the lock or we'll observe its value here
+        hasWaiters.store(true, std::memory_order_seq_cst);
+        if (value.load(std::memory_order_seq_cst) >= threshold) {
+            RemoveWaiter(waiter.heapIndex);
+            waiter.OnThresholdReached();
+            return false;
         }
 
-        waiters.erase(waiters.begin(), it);
+        return true;
+    }
+
+    void Syncpoint::DeregisterWaiter(Waiter &waiter) {
+        std::scoped_lock lock{mutex};
+        // The index is only valid while the waiter is in this syncpoint's heap, it's reset when the waiter is notified
+        if (waiter.heapIndex < waiters.size() && waiters[waiter.heapIndex] == &waiter)
+            RemoveWaiter(waiter.heapIndex);
+    }
+
+    u32 Syncpoint::Increment(u32 amount) {
+        auto readValue{value.fetch_add(amount, std::memory_order_seq_cst) + amount}; // We don't want to constantly do redundant atomic loads
+
+        // Blocking waiters sleep on the value itself so they only need a wake when there are any
+        if (sleeperCount.load(std::memory_order_seq_cst))
+            syscall(SYS_futex, reinterpret_cast<u32 *>(&value), FUTEX_WAKE_PRIVATE, std::numeric_limits<i32>::max(), nullptr, nullptr, 0);
 
-        if (signalCondition)
-            incrementCondition.notify_all();
+        // (Fast path) There are no waiters to notify so the mutex can be skipped entirely
+        if (!hasWaiters.load(std::memory_order_seq_cst))
+            return readValue;
+
+        std::scoped_lock lock{mutex};
+        while (!waiters.empty() && readValue >= waiters.front()->threshold) {
+            Waiter *waiter{waiters.front()};
+            RemoveWaiter(0);
+            waiter->OnThresholdReached();
+        }
 
         return readValue;
     }
 
     bool Syncpoint::Wait(u32 threshold, std::chrono::steady_clock::duration timeout) {
         if (value.load(std::memory_order_acquire) >= threshold)
-            // (Fast Path) We don't need to wait on the mutex and can just get away with atomics
-            return {};
+            // (Fast Path) We don't need to wait on the futex and can just get away with atomics
+            return true;
 
-        std::unique_lock lock(mutex);
-        auto it{waiters.begin()};
-        while (it != waiters.end() && threshold >= it->threshold)
-            it++;
-        waiters.emplace(it, threshold, nullptr);
+        TRACE_EVENT("gpu", "Syncpoint::Wait", "Threshold", threshold);
 
-        if (timeout == std::chrono::steady_clock::duration::max()) {
-            incrementCondition.wait(lock, [&] { return value.load(std::memory_order_relaxed) >= threshold; });
-            return true;
-        } else {
-            return incrementCondition.wait_for(lock, timeout, [&] { return value.load(std::memory_order_relaxed) >= threshold; });
+        bool infinite{timeout == std::chrono::steady_clock::duration::max()};
+        auto deadline{infinite ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + timeout};
+
+        sleeperCount.fetch_add(1, std::memory_order_seq_cst);
+        bool reached{};
+        while (true) {
+            // The value is loaded after registering as a sleeper, an increment will then either observe us and wake the futex or we'll observe its value
+            u32 currentValue{value.load(std::memory_order_seq_cst)};
+            if (currentValue >= threshold) {
+                reached = true;
+                break;
+            }
+
+            timespec remainingSpec{};
+            if (!infinite) {
+                auto remaining{deadline - std::chrono::steady_clock::now()};
+                if (remaining <= std::chrono::steady_clock::duration::zero())
+                    break;
+
+                auto remainingNs{std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count()};
+                remainingSpec = {
+                    .tv_sec = static_cast<time_t>(remainingNs / constant::NsInSecond),
+                    .tv_nsec = static_cast<long>(remainingNs % constant::NsInSecond),
+                };
+            }
+
+            // Spurious wakeups, interruptions by signals and a changed value are all handled by rechecking the value
+            syscall(SYS_futex, reinterpret_cast<u32 *>(&value), FUTEX_WAIT_PRIVATE, currentValue, infinite ? nullptr : &remainingSpec, nullptr, 0);
         }
+        sleeperCount.fetch_sub(1, std::memory_order_relaxed);
+
+        return reached;
     }
 }
-
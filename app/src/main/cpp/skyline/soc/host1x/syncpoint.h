@@ -13,19 +13,52 @@ namespace skyline::soc::host1x {
      * @brief The Syncpoint class represents a single syncpoint in the GPU which is used for GPU -> CPU synchronisation
      */
     class Syncpoint {
-      private:
-        std::atomic<u32> value{}; //!< An atomically-incrementing counter at the core of a syncpoint
+      public:
+        /**
+         * @brief An intrusive waiter which is notified when the syncpoint reaches a threshold, it's embedded into the object that waits so registering it doesn't allocate
+         * @note A waiter can only be registered on a single syncpoint at a time and must be deregistered prior to being destroyed
+         */
+        class Waiter {
+          private:
+            friend Syncpoint;
+
+            static constexpr size_t NotQueued{std::numeric_limits<size_t>::max()};
 
-        std::mutex mutex; //!< Synchronizes insertions and deletions of waiters alongside locking the increment condition
-        std::condition_variable incrementCondition; //!< Signalled on thresholds for waiters which are tied to Wait(...)
+            u32 threshold{}; //!< The syncpoint value to wait on to be reached
+            size_t heapIndex{NotQueued}; //!< The index of the waiter in the syncpoint's waiter heap
 
-        struct Waiter {
-            u32 threshold; //!< The syncpoint value to wait on to be reached
-            std::function<void()> callback; //!< The callback to do after the wait has ended, refers to cvar signal when nullptr
+          public:
+            virtual ~Waiter() = default;
 
-            Waiter(u32 threshold, std::function<void()> callback) : threshold(threshold), callback(std::move(callback)) {}
+            /**
+             * @brief Called once the syncpoint has reached the threshold, this is called with the syncpoint's lock held so it must not register or deregister waiters on the same syncpoint
+             */
+            virtual void OnThresholdReached() = 0;
         };
-        std::list<Waiter> waiters; //!< A linked list of all waiters, it's sorted in ascending order by threshold
+
+      private:
+        std::atomic<u32> value{}; //!< An atomically-incrementing counter at the core of a syncpoint, it doubles as the futex word for blocking waits
+        std::atomic<u32> sleeperCount{}; //!< The amount of threads blocked on the futex in Wait(...), the futex is only woken when this is non-zero
+        std::atomic<bool> hasWaiters{}; //!< If there are any waiters in the heap, this allows increments to skip locking the mutex when there's nothing to notify
+
+        std::mutex mutex; //!< Synchronizes insertions and deletions of waiters
+        std::vector<Waiter *> waiters; //!< A binary min-heap of all registered waiters ordered by threshold, the storage is retained so registrations don't allocate in the steady state
+
+        /**
+         * @brief Moves the waiter at the supplied index towards the root of the heap until the heap property is restored
+         */
+        void SiftUp(size_t index);
+
+        /**
+         * @brief Moves the waiter at the supplied index towards the leaves of the heap until the heap property is restored
+         */
+        void SiftDown(size_t index);
+
+        /**
+         * @brief Removes the waiter at the supplied index from the heap
+         * @note The mutex must be locked when calling this
+         */
+        void RemoveWaiter(size_t index);
 
       public:
         /**
@@ -35,24 +68,23 @@ namespace skyline::soc::host1x {
             return value.load(std::memory_order_acquire);
         }
 
-        using WaiterHandle = decltype(waiters)::iterator; //!< Aliasing an iterator to a Waiter as an opaque handle
-
         /**
-         * @brief Registers a new waiter with a callback that will be called when the syncpoint reaches the target threshold
-         * @note The callback will be called immediately if the syncpoint has already reached the given threshold
-         * @return A handle that can be used to deregister the waiter, its boolean operator will evaluate to false if the threshold has already been reached
+         * @brief Registers a waiter that will be notified when the syncpoint reaches the target threshold
+         * @note The waiter will be notified immediately if the syncpoint has already reached the given threshold
+         * @return If the waiter was registered (true) or the threshold has already been reached (false)
          */
-        WaiterHandle RegisterWaiter(u32 threshold, const std::function<void()> &callback);
+        bool RegisterWaiter(Waiter &waiter, u32 threshold);
 
         /**
-         * @note If the supplied handle is invalid then the function will do nothing
+         * @note If the supplied waiter isn't registered then the function will do nothing
          */
-        void DeregisterWaiter(WaiterHandle waiter);
+        void DeregisterWaiter(Waiter &waiter);
 
         /**
+         * @param amount The amount to increment the syncpoint by, waiters are only notified once for the entire amount
          * @return The new value of the syncpoint after the increment
          */
-        u32 Increment();
+        u32 Increment(u32 amount = 1);
 
         /**
          * @brief Waits for the syncpoint to reach given threshold
@@ -16,23 +16,45 @@ namespace skyline::soc::host1x {
     class TegraHostInterface {
       private:
         SyncpointSet &syncpoints;
-        ClassType deviceClass; //!< The device class behind the THI, such as NVDEC or VIC
-
         u32 storedMethod{}; //!< Method that will be used for deviceClass.CallMethod, set using Method0
 
-        std::queue<u32> incrQueue; //!< Queue of syncpoint IDs to be incremented when a device operation is finished, the same syncpoint may be held multiple times within the queue
+        /**
+         * @brief A syncpoint increment which is deferred until all operations submitted prior to it have completed
+         */
+        struct PendingIncr {
+            u32 syncpointId;
+            u64 opThreshold; //!< The amount of operations that need to be completed for the increment to happen
+        };
+
+        std::queue<PendingIncr> incrQueue; //!< Queue of syncpoint increments waiting on operations, the same syncpoint may be held multiple times within the queue
         std::mutex incrMutex;
+        u64 submittedOps{}; //!< The amount of operations submitted to the device class, this is only accessed by the channel thread
+        u64 completedOps{}; //!< The amount of operations the device class has completed, this is protected by incrMutex
+
+        ClassType deviceClass; //!< The device class behind the THI, such as NVDEC or VIC, it's declared last as it may complete operations till it's destroyed
 
+        /**
+         * @brief Queues an increment to happen once all previously submitted operations have completed, it happens immediately if they already have
+         */
         void AddIncr(u32 syncpointId) {
             std::scoped_lock lock(incrMutex);
-            incrQueue.push(syncpointId);
+            if (completedOps >= submittedOps) {
+                Logger::Debug("Increment syncpoint: {}", syncpointId);
+                syncpoints.at(syncpointId).Increment();
+            } else {
+                incrQueue.push({syncpointId, submittedOps});
+            }
         }
 
-        void SubmitPendingIncrs() {
+        /**
+         * @brief Called by the device class when an operation completes, this may be on a thread other than the channel thread
+         */
+        void OnOpDone() {
             std::scoped_lock lock(incrMutex);
+            completedOps++;
 
-            while (!incrQueue.empty()) {
-                u32 syncpointId{incrQueue.front()};
+            while (!incrQueue.empty() && incrQueue.front().opThreshold <= completedOps) {
+                u32 syncpointId{incrQueue.front().syncpointId};
                 incrQueue.pop();
 
                 Logger::Debug("Increment syncpoint: {}", syncpointId);
@@ -41,9 +63,10 @@ namespace skyline::soc::host1x {
         }
 
       public:
-        TegraHostInterface(SyncpointSet &syncpoints)
-            : deviceClass([&] { SubmitPendingIncrs(); }),
-              syncpoints(syncpoints) {}
+        template<typename... Args>
+        TegraHostInterface(SyncpointSet &syncpoints, Args &&... args)
+            : syncpoints(syncpoints),
+              deviceClass([&] { OnOpDone(); }, std::forward<Args>(args)...) {}
 
         void CallMethod(u32 method, u32 argument)  {
             constexpr u32 Method0MethodId{0x10}; //!< Sets the method to be called on the device class upon a call to Method1, see TRM '15.5.6 NV_PVIC_THI_METHOD0'
@@ -61,7 +84,6 @@ namespace skyline::soc::host1x {
                         case IncrementSyncpointMethod::Condition::OpDone:
                             Logger::Debug("Queue syncpoint for OpDone: {}", incrSyncpoint.index);
                             AddIncr(incrSyncpoint.index);
-                            SubmitPendingIncrs(); // FIXME: immediately submit the incrs as classes are not yet implemented
                             break;
                         default:
                             Logger::Warn("Unimplemented syncpoint condition: {}", static_cast<u8>(incrSyncpoint.condition));
@@ -73,7 +95,8 @@ namespace skyline::soc::host1x {
                     storedMethod = argument;
                     break;
                 case Method1MethodId:
-                    deviceClass.CallMethod(storedMethod, argument);
+                    if (deviceClass.CallMethod(storedMethod, argument))
+                        submittedOps++;
                     break;
                 default:
                     Logger::Error("Unknown THI method called: 0x{:X}, argument: 0x{:X}", method, argument);
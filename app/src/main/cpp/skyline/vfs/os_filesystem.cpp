@@ -5,6 +5,7 @@
 #include <fcntl.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <filesystem>
 #include "os_backing.h"
 #include "os_filesystem.h"
 
@@ -7,73 +7,131 @@
 namespace skyline::vfs {
     RomFileSystem::RomFileSystem(std::shared_ptr<Backing> pBacking) : FileSystem(), backing(std::move(pBacking)) {
         header = backing->Read<RomFsHeader>();
-        TraverseDirectory(0, "");
+
+        // Only the hash tables are read upfront, all entries are looked up from the metadata tables lazily on access
+        dirHashTable.resize(header.dirHashTableSize / sizeof(u32));
+        backing->Read(span(dirHashTable), header.dirHashTableOffset);
+
+        fileHashTable.resize(header.fileHashTableSize / sizeof(u32));
+        backing->Read(span(fileHashTable), header.fileHashTableOffset);
     }
 
-    void RomFileSystem::TraverseFiles(u32 offset, const std::string &path) {
-        RomFsFileEntry entry;
-        do {
-            entry = backing->Read<RomFsFileEntry>(header.fileMetaTableOffset + offset);
+    u32 RomFileSystem::CalculatePathHash(u32 parentOffset, std::string_view name) {
+        u32 hash{parentOffset ^ 123456789};
+        for (char character : name) {
+            hash = (hash >> 5) | (hash << 27);
+            hash ^= static_cast<u8>(character);
+        }
+        return hash;
+    }
 
-            if (entry.nameSize) {
-                std::vector<char> name(entry.nameSize);
-                backing->Read(span(name), header.fileMetaTableOffset + offset + sizeof(RomFsFileEntry));
+    bool RomFileSystem::CompareEntryName(size_t nameOffset, u32 nameSize, std::string_view name) {
+        if (nameSize != name.size() || nameSize > constant::RomFsMaxNameSize)
+            return false;
 
-                std::string fullPath{path + (path.empty() ? "" : "/") + std::string(name.data(), entry.nameSize)};
-                fileMap.emplace(fullPath, entry);
-            }
+        std::array<char, constant::RomFsMaxNameSize> entryName;
+        backing->Read(span<char>(entryName.data(), nameSize), nameOffset);
+        return std::string_view(entryName.data(), nameSize) == name;
+    }
+
+    std::optional<u32> RomFileSystem::FindChildDirectory(u32 parentOffset, std::string_view name) {
+        if (dirHashTable.empty())
+            return std::nullopt;
 
-            offset = entry.siblingOffset;
-        } while (offset != constant::RomFsEmptyEntry);
+        u32 offset{dirHashTable[CalculatePathHash(parentOffset, name) % dirHashTable.size()]};
+        while (offset != constant::RomFsEmptyEntry) {
+            auto entry{backing->Read<RomFsDirectoryEntry>(header.dirMetaTableOffset + offset)};
+            if (entry.parentOffset == parentOffset && CompareEntryName(header.dirMetaTableOffset + offset + sizeof(RomFsDirectoryEntry), entry.nameSize, name))
+                return offset;
+
+            offset = entry.hashSiblingOffset;
+        }
+
+        return std::nullopt;
     }
 
-    void RomFileSystem::TraverseDirectory(u32 offset, const std::string &path) {
-        auto entry{backing->Read<RomFsDirectoryEntry>(header.dirMetaTableOffset + offset)};
+    std::optional<RomFileSystem::RomFsFileEntry> RomFileSystem::FindChildFile(u32 parentOffset, std::string_view name) {
+        if (fileHashTable.empty())
+            return std::nullopt;
 
-        std::string childPath(path);
-        if (entry.nameSize) {
-            std::vector<char> name(entry.nameSize);
-            backing->Read(span(name), header.dirMetaTableOffset + offset + sizeof(RomFsDirectoryEntry));
-            childPath = path + (path.empty() ? "" : "/") + std::string(name.data(), entry.nameSize);
+        u32 offset{fileHashTable[CalculatePathHash(parentOffset, name) % fileHashTable.size()]};
+        while (offset != constant::RomFsEmptyEntry) {
+            auto entry{backing->Read<RomFsFileEntry>(header.fileMetaTableOffset + offset)};
+            if (entry.parentOffset == parentOffset && CompareEntryName(header.fileMetaTableOffset + offset + sizeof(RomFsFileEntry), entry.nameSize, name))
+                return entry;
+
+            offset = entry.hashSiblingOffset;
         }
 
-        directoryMap.emplace(childPath, entry);
+        return std::nullopt;
+    }
 
-        if (entry.fileOffset != constant::RomFsEmptyEntry)
-            TraverseFiles(entry.fileOffset, childPath);
+    std::optional<u32> RomFileSystem::ResolveParentDirectory(std::string_view path, std::string_view &name) {
+        u32 directoryOffset{}; // The root directory is always the first entry in the directory metadata table
+        name = {};
+
+        // Empty components (leading, trailing or repeated separators) are skipped
+        size_t start{};
+        while (start < path.size()) {
+            size_t end{path.find('/', start)};
+            if (end == std::string_view::npos)
+                end = path.size();
+
+            if (end != start) {
+                if (!name.empty()) {
+                    auto childOffset{FindChildDirectory(directoryOffset, name)};
+                    if (!childOffset)
+                        return std::nullopt;
+                    directoryOffset = *childOffset;
+                }
+                name = path.substr(start, end - start);
+            }
 
-        if (entry.childOffset != constant::RomFsEmptyEntry)
-            TraverseDirectory(entry.childOffset, childPath);
+            start = end + 1;
+        }
 
-        if (entry.siblingOffset != constant::RomFsEmptyEntry)
-            TraverseDirectory(entry.siblingOffset, path);
+        return directoryOffset;
+    }
+
+    std::optional<u32> RomFileSystem::FindDirectory(std::string_view path) {
+        std::string_view name;
+        auto parentOffset{ResolveParentDirectory(path, name)};
+        if (!parentOffset || name.empty())
+            return parentOffset;
+
+        return FindChildDirectory(*parentOffset, name);
+    }
+
+    std::optional<RomFileSystem::RomFsFileEntry> RomFileSystem::FindFile(std::string_view path) {
+        std::string_view name;
+        auto parentOffset{ResolveParentDirectory(path, name)};
+        if (!parentOffset || name.empty())
+            return std::nullopt;
+
+        return FindChildFile(*parentOffset, name);
     }
 
     std::shared_ptr<Backing> RomFileSystem::OpenFileImpl(const std::string &path, Backing::Mode mode) {
-        try {
-            const auto &entry{fileMap.at(path)};
-            return std::make_shared<RegionBacking>(backing, header.dataOffset + entry.offset, entry.size, mode);
-        } catch (std::out_of_range &e) {
-            return nullptr;
-        }
+        if (auto entry{FindFile(path)})
+            return std::make_shared<RegionBacking>(backing, header.dataOffset + entry->offset, entry->size, mode);
+
+        return nullptr;
     }
 
     std::optional<Directory::EntryType> RomFileSystem::GetEntryTypeImpl(const std::string &path) {
-        if (fileMap.count(path))
+        if (FindFile(path))
             return Directory::EntryType::File;
-        else if (directoryMap.count(path))
+        else if (FindDirectory(path))
             return Directory::EntryType::Directory;
 
         return std::nullopt;
     }
 
     std::shared_ptr<Directory> RomFileSystem::OpenDirectoryImpl(const std::string &path, Directory::ListMode listMode) {
-        try {
-            auto &entry{directoryMap.at(path)};
-            return std::make_shared<RomFileSystemDirectory>(backing, header, entry, listMode);
-        } catch (std::out_of_range &e) {
-            return nullptr;
-        }
+        if (auto offset{FindDirectory(path)})
+            return std::make_shared<RomFileSystemDirectory>(backing, header, backing->Read<RomFsDirectoryEntry>(header.dirMetaTableOffset + *offset), listMode);
+
+        return nullptr;
     }
 
     RomFileSystemDirectory::RomFileSystemDirectory(std::shared_ptr<Backing> backing, const RomFileSystem::RomFsHeader &header, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode) : Directory(listMode), backing(std::move(backing)), header(header), ownEntry(ownEntry) {}
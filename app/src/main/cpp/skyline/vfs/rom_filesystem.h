@@ -8,6 +8,7 @@
 namespace skyline {
     namespace constant {
         constexpr u32 RomFsEmptyEntry{0xFFFFFFFF}; //!< The value a RomFS entry has its offset set to, if it's empty
+        constexpr size_t RomFsMaxNameSize{0x300}; //!< The maximum size of a RomFS entry name in bytes
     }
 
     namespace vfs {
@@ -15,30 +16,6 @@ namespace skyline {
          * @brief The RomFileSystem class abstracts access to a RomFS image using the vfs::FileSystem api
          */
         class RomFileSystem : public FileSystem {
-          private:
-            std::shared_ptr<Backing> backing;
-
-            /**
-             * @brief Traverses the sibling files of the given file and adds them to the file map
-             * @param offset The offset of the file entry to traverses the siblings of
-             * @param path The path to the parent directory of the supplied file entry
-             */
-            void TraverseFiles(u32 offset, const std::string &path);
-
-            /**
-             * @brief Traverses the directories within the given directory, adds them to the directory map and calls TraverseFiles on them
-             * @param offset The offset of the directory entry to traverses the directories in
-             * @param path The path to the supplied directory entry
-             */
-            void TraverseDirectory(u32 offset, const std::string &path);
-
-          protected:
-            std::shared_ptr<Backing> OpenFileImpl(const std::string &path, Backing::Mode mode) override;
-
-            std::optional<Directory::EntryType> GetEntryTypeImpl(const std::string &path) override;
-
-            std::shared_ptr<Directory> OpenDirectoryImpl(const std::string &path, Directory::ListMode listMode) override;
-
           public:
             struct RomFsHeader {
                 u64 headerSize; //!< The size of the header
@@ -59,7 +36,7 @@ namespace skyline {
                 u32 siblingOffset; //!< The offset from the directory metadata base of a sibling directory
                 u32 childOffset; //!< The offset from the directory metadata base of a child directory
                 u32 fileOffset; //!< The offset from the file metadata base of a child file
-                u32 hash; //!< The hash of the directory
+                u32 hashSiblingOffset; //!< The offset from the directory metadata base of the next directory in the same hash bucket
                 u32 nameSize; //!< The size of the directory's name in bytes
             };
 
@@ -68,13 +45,63 @@ namespace skyline {
                 u32 siblingOffset; //!< The offset from the file metadata base of a sibling file
                 u64 offset; //!< The offset from the file data base of the file contents
                 u64 size; //!< The size of the file in bytes
-                u32 hash; //!< The hash of the file
+                u32 hashSiblingOffset; //!< The offset from the file metadata base of the next file in the same hash bucket
                 u32 nameSize; //!< The size of the file's name in bytes
             };
 
-            std::unordered_map<std::string, RomFsFileEntry> fileMap; //!< A map that maps file names to their corresponding entry
-            std::unordered_map<std::string, RomFsDirectoryEntry> directoryMap; //!< A map that maps directory names to their corresponding entry
+          private:
+            std::shared_ptr<Backing> backing;
+            std::vector<u32> dirHashTable; //!< The on-disk directory hash table, each bucket holds the offset of the first directory entry with a matching hash
+            std::vector<u32> fileHashTable; //!< The on-disk file hash table, each bucket holds the offset of the first file entry with a matching hash
+
+            /**
+             * @return The RomFS hash of an entry with the supplied name inside the directory at the supplied offset
+             */
+            static u32 CalculatePathHash(u32 parentOffset, std::string_view name);
+
+            /**
+             * @brief Compares the name that trails an entry in a metadata table to the supplied name
+             * @param nameOffset The absolute offset of the name in the backing
+             */
+            bool CompareEntryName(size_t nameOffset, u32 nameSize, std::string_view name);
 
+            /**
+             * @brief Looks up a child directory by walking the hash chain in the directory hash table
+             * @return The offset of the child directory's entry in the directory metadata table, if found
+             */
+            std::optional<u32> FindChildDirectory(u32 parentOffset, std::string_view name);
+
+            /**
+             * @brief Looks up a child file by walking the hash chain in the file hash table
+             * @return The file's entry in the file metadata table, if found
+             */
+            std::optional<RomFsFileEntry> FindChildFile(u32 parentOffset, std::string_view name);
+
+            /**
+             * @brief Resolves all directory components of a path, the final component is returned in `name` rather than being resolved
+             * @param name The last component of the path, this will be empty if the path refers to the root directory
+             * @return The offset of the directory containing `name`, if all components could be resolved
+             */
+            std::optional<u32> ResolveParentDirectory(std::string_view path, std::string_view &name);
+
+            /**
+             * @return The offset of the directory entry the supplied path refers to, if it exists
+             */
+            std::optional<u32> FindDirectory(std::string_view path);
+
+            /**
+             * @return The file entry the supplied path refers to, if it exists
+             */
+            std::optional<RomFsFileEntry> FindFile(std::string_view path);
+
+          protected:
+            std::shared_ptr<Backing> OpenFileImpl(const std::string &path, Backing::Mode mode) override;
+
+            std::optional<Directory::EntryType> GetEntryTypeImpl(const std::string &path) override;
+
+            std::shared_ptr<Directory> OpenDirectoryImpl(const std::string &path, Directory::ListMode listMode) override;
+
+          public:
             RomFileSystem(std::shared_ptr<Backing> backing);
         };
 
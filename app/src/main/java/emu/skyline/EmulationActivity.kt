@@ -138,6 +138,21 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
      */
     private external fun updatePerformanceStatistics()
 
+    /**
+     * @return A snapshot of the cumulative performance counters followed by the buckets of each histogram, in the order defined by `perf::Counter` and `perf::Histogram`
+     */
+    private external fun getPerformanceCounters() : LongArray
+
+    /**
+     * @return The names of the performance counters in the same order as they're returned by [getPerformanceCounters]
+     */
+    private external fun getPerformanceCounterNames() : Array<String>
+
+    /**
+     * If the performance statistics overlay should show per-second rates from the performance counters
+     */
+    private var detailedPerfStats = false
+
     /**
      * @see [InputHandler.initializeControllers]
      */
@@ -282,9 +297,28 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
 
             binding.perfStats.apply {
                 postDelayed(object : Runnable {
+                    var lastCounters = getPerformanceCounters()
+                    val counterNames = getPerformanceCounterNames()
+
                     override fun run() {
                         updatePerformanceStatistics()
                         text = "$fps FPS\n${"%.1f".format(averageFrametime)}±${"%.2f".format(averageFrametimeDeviation)}ms"
+
+                        val counters = getPerformanceCounters()
+                        if (detailedPerfStats) {
+                            // The counters are cumulative, their delta over the 250ms interval is scaled to a per-second rate
+                            val rate = { name : String ->
+                                val index = counterNames.indexOf(name)
+                                if (index != -1) (counters[index] - lastCounters[index]) * 4 else 0L
+                            }
+                            text = "$text\n${rate("Draws")} draws/s" +
+                                    "\n${rate("Pipeline Compiles")} pipeline compiles/s (${rate("Pipeline Cache Hits")} hits, ${rate("Pipeline Cache Misses")} misses)" +
+                                    "\n${"%.1f".format(rate("Texture Upload Bytes") / (1024.0 * 1024.0))} MiB/s texture uploads" +
+                                    "\n${rate("SVCs")} SVCs/s, ${rate("IPC Calls")} IPC/s" +
+                                    "\n${rate("Fence Waits")} fence waits/s"
+                        }
+                        lastCounters = counters
+
                         postDelayed(this, 250)
                     }
                 }, 250)
@@ -293,6 +327,10 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
                     var color = if (preferenceSettings.disableFrameThrottling) getColor(R.color.colorPerfStatsSecondary) else getColor(R.color.colorPerfStatsPrimary)
                     binding.perfStats.setTextColor(color)
                 }
+                setOnLongClickListener {
+                    detailedPerfStats = !detailedPerfStats
+                    true
+                }
             }
         }
 
@@ -148,10 +148,12 @@ class GameSettingsActivity : AppCompatActivity() {
             findPreference<IntegerListPreference>("gamep_system_language")!!.value = gameData.systemLanguage
             findPreference<IntegerListPreference>("gamep_system_region")!!.value = gameData.systemRegion
             findPreference<CheckBoxPreference>("gamep_force_triple_buffering")!!.isChecked = gameData.forceTripleBuffering
+            findPreference<IntegerListPreference>("gamep_frame_latency")!!.value = gameData.frameLatency
             findPreference<CheckBoxPreference>("gamep_disable_frame_throttling")!!.isChecked = gameData.disableFrameThrottling
             findPreference<CheckBoxPreference>("gamep_max_refresh_rate")!!.isChecked = gameData.maxRefreshRate
             findPreference<IntegerListPreference>("gamep_aspect_ratio")!!.value = gameData.aspectRatio
             findPreference<IntegerListPreference>("gamep_orientation")!!.value = gameData.orientation
+            findPreference<IntegerListPreference>("gamep_resolution_scale")!!.value = gameData.resolutionScale
             findPreference<SeekBarPreference>("gamep_executor_slot_count_scale")!!.value = gameData.executorSlotCountScale
             findPreference<SeekBarPreference>("gamep_executor_flush_threshold")!!.value = gameData.executorFlushThreshold
             findPreference<CheckBoxPreference>("gamep_use_direct_memory_import")!!.isChecked = gameData.useDirectMemoryImport
@@ -192,10 +194,12 @@ class GameSettingsActivity : AppCompatActivity() {
             gameData.systemLanguage = context?.let { PreferenceSettings(it).gamepSystemLanguage }!!
             gameData.systemRegion = context?.let { PreferenceSettings(it).gamepSystemRegion }!!
             gameData.forceTripleBuffering = context?.let { PreferenceSettings(it).gamepForceTripleBuffering }!!
+            gameData.frameLatency = context?.let { PreferenceSettings(it).gamepFrameLatency }!!
             gameData.disableFrameThrottling = context?.let { PreferenceSettings(it).gamepDisableFrameThrottling }!!
             gameData.maxRefreshRate = context?.let { PreferenceSettings(it).gamepMaxRefreshRate }!!
             gameData.aspectRatio = context?.let { PreferenceSettings(it).gamepAspectRatio }!!
             gameData.orientation = context?.let { PreferenceSettings(it).gamepOrientation }!!
+            gameData.resolutionScale = context?.let { PreferenceSettings(it).gamepResolutionScale }!!
             gameData.executorSlotCountScale = context?.let { PreferenceSettings(it).gamepExecutorSlotCountScale }!!
             gameData.executorFlushThreshold = context?.let { PreferenceSettings(it).gamepExecutorFlushThreshold }!!
             gameData.useDirectMemoryImport = context?.let { PreferenceSettings(it).gamepUseDirectMemoryImport }!!
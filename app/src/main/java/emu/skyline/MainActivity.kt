@@ -106,10 +106,12 @@ class MainActivity : AppCompatActivity() {
         gameData.systemLanguage = preferenceSettings.systemLanguage
         gameData.systemRegion = preferenceSettings.systemRegion
         gameData.forceTripleBuffering = preferenceSettings.forceTripleBuffering
+        gameData.frameLatency = preferenceSettings.frameLatency
         gameData.disableFrameThrottling = preferenceSettings.disableFrameThrottling
         gameData.maxRefreshRate = preferenceSettings.maxRefreshRate
         gameData.aspectRatio = preferenceSettings.aspectRatio
         gameData.orientation = preferenceSettings.orientation
+        gameData.resolutionScale = preferenceSettings.resolutionScale
         gameData.executorSlotCountScale = preferenceSettings.executorSlotCountScale
         gameData.executorFlushThreshold = preferenceSettings.executorFlushThreshold
         gameData.useDirectMemoryImport = preferenceSettings.useDirectMemoryImport
@@ -119,11 +119,13 @@ class GameDataHandler() {
             settings?.putInt("gamep_system_language", gameData.systemLanguage)
             settings?.putInt("gamep_system_region", gameData.systemRegion)
             settings?.putBoolean("fgamep_force_triple_buffering", gameData.forceTripleBuffering)
+            settings?.putInt("gamep_frame_latency", gameData.frameLatency)
             settings?.putBoolean("gamep_disable_frame_throttling", gameData.disableFrameThrottling)
             settings?.putBoolean("gamep_max_refresh_rate", gameData.maxRefreshRate)
             settings?.putInt("gamep_aspect_ratio", gameData.aspectRatio)
             settings?.putInt("gamep_orientation", gameData.orientation)
             settings?.putString("gamep_gpu_driver", gameData.gpuDriver)
+            settings?.putInt("gamep_resolution_scale", gameData.resolutionScale)
             settings?.putInt("gamep_executor_slot_count_scale", gameData.executorSlotCountScale)
             settings?.putInt("gamep_executor_flush_threshold", gameData.executorFlushThreshold)
             settings?.putBoolean("gamep_use_direct_memory_import", gameData.useDirectMemoryImport)
@@ -154,6 +156,7 @@ class GameDataHandler() {
 	var internetEnabled : Boolean = false
         // Display
         var forceTripleBuffering : Boolean = true
+        var frameLatency : Int = 2
         var disableFrameThrottling : Boolean = false
         var maxRefreshRate : Boolean = false
         var aspectRatio : Int = 0
@@ -161,6 +164,7 @@ class GameDataHandler() {
 	var disableShaderCache : Boolean = false
         // GPU
         var gpuDriver : String = PreferenceSettings.SYSTEM_GPU_DRIVER
+        var resolutionScale : Int = 100
         var executorSlotCountScale : Int = 4
         var executorFlushThreshold : Int = 256
         var useDirectMemoryImport : Boolean = false
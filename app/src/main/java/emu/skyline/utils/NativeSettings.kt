@@ -19,16 +19,21 @@ class NativeSettings(context : Context, pref : PreferenceSettings) {
     var systemLanguage : Int = if (pref.gamepCustomSettings) pref.gamepSystemLanguage else pref.systemLanguage
     var systemRegion : Int = if (pref.gamepCustomSettings) pref.gamepSystemRegion else pref.systemRegion
     var internetEnabled : Boolean = if (pref.gamepCustomSettings) pref.gamepInternetEnabled else pref.internetEnabled
+    var enableHugePages : Boolean = pref.enableHugePages
+    var prefaultGuestMemory : Boolean = pref.prefaultGuestMemory
 
     // Display
     var forceTripleBuffering : Boolean = if (pref.gamepCustomSettings) pref.gamepForceTripleBuffering else pref.forceTripleBuffering
+    var frameLatency : Int = if (pref.gamepCustomSettings) pref.gamepFrameLatency else pref.frameLatency
     var disableFrameThrottling : Boolean = if (pref.gamepCustomSettings) pref.gamepDisableFrameThrottling else pref.disableFrameThrottling
+    var enableFramePacing : Boolean = pref.enableFramePacing
     var disableShaderCache : Boolean = if (pref.gamepCustomSettings) pref.gamepDisableShaderCache else pref.disableShaderCache
 
     // GPU
     var selectedGpuDriver : String = if (pref.gamepCustomSettings) pref.gamepGpuDriver else pref.gpuDriver
     var gpuDriver : String = if (selectedGpuDriver == PreferenceSettings.SYSTEM_GPU_DRIVER) "" else selectedGpuDriver
     var gpuDriverLibraryName : String = if (selectedGpuDriver == PreferenceSettings.SYSTEM_GPU_DRIVER) "" else GpuDriverHelper.getLibraryName(context, selectedGpuDriver)
+    var resolutionScale : Int = if (pref.gamepCustomSettings) pref.gamepResolutionScale else pref.resolutionScale
     var executorSlotCountScale : Int = if (pref.gamepCustomSettings) pref.gamepExecutorSlotCountScale else pref.executorSlotCountScale
     var executorFlushThreshold : Int = if (pref.gamepCustomSettings) pref.gamepExecutorFlushThreshold else pref.executorFlushThreshold
     var useDirectMemoryImport : Boolean = if (pref.gamepCustomSettings) pref.gamepUseDirectMemoryImport else pref.useDirectMemoryImport
@@ -45,6 +50,7 @@ class NativeSettings(context : Context, pref : PreferenceSettings) {
 
     // Debug
     var validationLayer : Boolean = BuildConfig.BUILD_TYPE != "release" && if (pref.gamepCustomSettings) pref.gamepValidationLayer else pref.validationLayer
+    var gpfifoCapture : Boolean = BuildConfig.BUILD_TYPE != "release" && pref.gpfifoCapture
 
     /**
      * Updates settings in libskyline during emulation
@@ -31,10 +31,14 @@ class PreferenceSettings @Inject constructor(@ApplicationContext private val con
     var systemLanguage by sharedPreferences(context, 1)
     var systemRegion by sharedPreferences(context, -1)
     var internetEnabled by sharedPreferences(context, false)
+    var enableHugePages by sharedPreferences(context, true)
+    var prefaultGuestMemory by sharedPreferences(context, true)
 
     // Display
     var forceTripleBuffering by sharedPreferences(context, true)
+    var frameLatency by sharedPreferences(context, 2)
     var disableFrameThrottling by sharedPreferences(context, false)
+    var enableFramePacing by sharedPreferences(context, false)
     var maxRefreshRate by sharedPreferences(context, false)
     var aspectRatio by sharedPreferences(context, 0)
     var orientation by sharedPreferences(context, ActivityInfo.SCREEN_ORIENTATION_SENSOR_LANDSCAPE)
@@ -43,6 +47,7 @@ class PreferenceSettings @Inject constructor(@ApplicationContext private val con
 
     // GPU
     var gpuDriver by sharedPreferences(context, SYSTEM_GPU_DRIVER)
+    var resolutionScale by sharedPreferences(context, 100)
     var executorSlotCountScale by sharedPreferences(context, 6)
     var executorFlushThreshold by sharedPreferences(context, 256)
     var useDirectMemoryImport by sharedPreferences(context, false)
@@ -59,6 +64,7 @@ class PreferenceSettings @Inject constructor(@ApplicationContext private val con
 
     // Debug
     var validationLayer by sharedPreferences(context, false)
+    var gpfifoCapture by sharedPreferences(context, false)
 
     // Input
     var onScreenControl by sharedPreferences(context, true)
@@ -83,6 +89,7 @@ class PreferenceSettings @Inject constructor(@ApplicationContext private val con
 
     // Display
     var gamepForceTripleBuffering by sharedPreferences(context, true)
+    var gamepFrameLatency by sharedPreferences(context, 2)
     var gamepDisableFrameThrottling by sharedPreferences(context, false)
     var gamepMaxRefreshRate by sharedPreferences(context, false)
     var gamepAspectRatio by sharedPreferences(context, 0)
@@ -91,6 +98,7 @@ class PreferenceSettings @Inject constructor(@ApplicationContext private val con
 
     // GPU
     var gamepGpuDriver by sharedPreferences(context, PreferenceSettings.SYSTEM_GPU_DRIVER)
+    var gamepResolutionScale by sharedPreferences(context, 100)
     var gamepExecutorSlotCountScale by sharedPreferences(context, 6)
     var gamepExecutorFlushThreshold by sharedPreferences(context, 256)
     var gamepUseDirectMemoryImport by sharedPreferences(context, false)
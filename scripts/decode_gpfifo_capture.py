@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MPL-2.0
+# Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+"""
+Decodes a GPFIFO trace captured with the "Capture GPU command traces" debug setting into a textual listing of the GMMU mappings, captured memory and the methods of every pushbuffer
+
+The trace is an LZ4 frame (this requires the 'lz4' package) of little-endian data starting with a u32 magic ('GPCT') and a u32 version, it's followed by a sequence of records:
+* Each record starts with a u32 type, a u32 payload size and a u64 timestamp (ns) relative to the start of the capture
+* PushBuffer (0): u64 GPU address, u32 size (words), u32 padding, pushbuffer words
+* GmmuMappings (1): u64 count, count * (u64 GPU address, u64 size, u32 sparse, u32 padding) -- Replaces all prior mappings
+* Memory (2): u64 GPU address, u64 size, memory contents -- Only pages which changed since the prior submission are captured
+
+The gpfifo_replay host tool (app/host) can replay traces through the macro interpreter and reconstruct guest memory from them
+"""
+
+import argparse
+import struct
+import sys
+
+import lz4.frame
+
+Magic = b"GPCT"
+Version = 3
+SubchannelNames = ["3D", "Compute", "I2M", "2D", "Copy", "SW0", "SW1", "SW2"]
+
+
+def decode_pushbuffer(words, output):
+    index = 0
+    while index < len(words):
+        header = words[index]
+        index += 1
+
+        method = header & 0xFFF
+        subchannel = SubchannelNames[(header >> 13) & 0x7]
+        count = (header >> 16) & 0x1FFF
+        sec_op = header >> 29
+
+        if sec_op == 1:  # IncMethod
+            for offset, argument in enumerate(words[index:index + count]):
+                output.write(f"    {subchannel:<7} 0x{(method + offset) * 4:04X} = 0x{argument:08X}\n")
+            index += count
+        elif sec_op == 3:  # NonIncMethod
+            for argument in words[index:index + count]:
+                output.write(f"    {subchannel:<7} 0x{method * 4:04X} = 0x{argument:08X}\n")
+            index += count
+        elif sec_op == 4:  # ImmdDataMethod
+            output.write(f"    {subchannel:<7} 0x{method * 4:04X} = 0x{count:08X} (Immediate)\n")
+        elif sec_op == 5:  # OneInc
+            for offset, argument in enumerate(words[index:index + count]):
+                output.write(f"    {subchannel:<7} 0x{(method + min(offset, 1)) * 4:04X} = 0x{argument:08X}\n")
+            index += count
+        elif sec_op == 7:  # EndPbSegment
+            output.write("    End of segment\n")
+            return
+        else:
+            output.write(f"    Unsupported method header: 0x{header:08X}\n")
+            return
+
+
+def decode(trace, output):
+    if trace.read(4) != Magic:
+        raise ValueError("Not a GPFIFO trace")
+    version = struct.unpack("<I", trace.read(4))[0]
+    if version != Version:
+        raise ValueError(f"Unsupported GPFIFO trace version: {version}")
+
+    while record_header := trace.read(16):
+        record_type, size, timestamp = struct.unpack("<IIQ", record_header)
+        payload = trace.read(size)
+        if record_type == 0:
+            address, word_count = struct.unpack_from("<QI", payload)
+            output.write(f"[{timestamp / 1000000:.3f}ms] Pushbuffer @ 0x{address:X} ({word_count} words)\n")
+            decode_pushbuffer(struct.unpack_from(f"<{word_count}I", payload, 16), output)
+        elif record_type == 1:
+            count = struct.unpack_from("<Q", payload)[0]
+            output.write(f"[{timestamp / 1000000:.3f}ms] GMMU Mappings ({count})\n")
+            for address, mapping_size, sparse, _ in struct.iter_unpack("<QQII", payload[8:8 + count * 24]):
+                output.write(f"    0x{address:010X} - 0x{address + mapping_size:010X}{' (Sparse)' if sparse else ''}\n")
+        elif record_type == 2:
+            address, memory_size = struct.unpack_from("<QQ", payload)
+            output.write(f"[{timestamp / 1000000:.3f}ms] Memory @ 0x{address:010X} - 0x{address + memory_size:010X}\n")
+        else:
+            raise ValueError(f"Unknown record type: {record_type}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes a Skyline GPFIFO trace into a textual listing of its methods")
+    parser.add_argument("trace", help="The GPFIFO trace (.gpct) to decode")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w", encoding="utf-8"), default=sys.stdout, help="The file to write the decoded trace to")
+    arguments = parser.parse_args()
+    with lz4.frame.open(arguments.trace, "rb") as trace:
+        decode(trace, arguments.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MPL-2.0
+# Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+"""
+Decodes a binary log written with LOGGER_BINARY_FORMAT into the textual log format, the output can be viewed like any other log
+
+The binary log is little-endian and starts with a u32 magic ('SKLB') and a u32 version, it's followed by a sequence of records:
+* String (0): u32 id, u32 size, characters -- Interns a string, they're referenced by their ID from messages
+* Message (1): u8 level, u8 argumentCount, u32 thread, u32 function, u32 format, i64 timestamp (ns), u32 argumentSize, arguments
+  A function or format ID of 0xFFFFFFFF denotes that there's none, a message without a format string has the message as its only argument
+  Each argument is a u8 type followed by its payload, as defined by skyline::log::ArgumentType
+"""
+
+import argparse
+import string
+import struct
+import sys
+
+Magic = b"SKLB"
+Version = 1
+NoString = 0xFFFFFFFF
+LevelCharacters = "EWIDV"
+
+
+class FmtFormatter(string.Formatter):
+    """A formatter that handles the differences between {fmt} and Python format specifications which are relevant to log messages"""
+
+    def format_field(self, value, format_spec):
+        if isinstance(value, bool) and not format_spec:
+            return "true" if value else "false"
+        return super().format_field(value, format_spec)
+
+
+def read_arguments(data, count):
+    arguments = []
+    offset = 0
+    for _ in range(count):
+        argument_type = data[offset]
+        offset += 1
+        if argument_type == 0:  # Signed
+            arguments.append(struct.unpack_from("<q", data, offset)[0])
+            offset += 8
+        elif argument_type == 1:  # Unsigned
+            arguments.append(struct.unpack_from("<Q", data, offset)[0])
+            offset += 8
+        elif argument_type == 2:  # Float
+            arguments.append(struct.unpack_from("<d", data, offset)[0])
+            offset += 8
+        elif argument_type == 3:  # Bool
+            arguments.append(data[offset] != 0)
+            offset += 1
+        elif argument_type == 4:  # Char
+            arguments.append(chr(data[offset]))
+            offset += 1
+        elif argument_type == 5:  # String
+            size = struct.unpack_from("<I", data, offset)[0]
+            offset += 4
+            arguments.append(data[offset:offset + size].decode("utf-8", "replace"))
+            offset += size
+        else:
+            raise ValueError(f"Unknown argument type: {argument_type}")
+    return arguments
+
+
+def decode(log, output):
+    if log.read(4) != Magic:
+        raise ValueError("Not a binary log")
+    version = struct.unpack("<I", log.read(4))[0]
+    if version != Version:
+        raise ValueError(f"Unsupported binary log version: {version}")
+
+    formatter = FmtFormatter()
+    strings = {}
+    while record_type := log.read(1):
+        if record_type[0] == 0:
+            string_id, size = struct.unpack("<II", log.read(8))
+            strings[string_id] = log.read(size).decode("utf-8", "replace")
+        elif record_type[0] == 1:
+            level, argument_count, thread, function, format_id, timestamp, argument_size = struct.unpack("<BBIIIqI", log.read(26))
+            arguments = read_arguments(log.read(argument_size), argument_count)
+
+            if format_id == NoString:
+                message = arguments[0]
+            else:
+                try:
+                    message = formatter.format(strings[format_id], *arguments)
+                except (ValueError, IndexError, KeyError) as e:
+                    message = f"{strings[format_id]} {arguments} (Format Error: {e})"
+
+            if function != NoString:
+                message = f"{strings[function]}: {message}"
+
+            # We use RS (\036) and GS (\035) as our delimiters, this matches the textual log format
+            output.write(f"\036{LevelCharacters[level]}\035{timestamp // 1000000}\035{strings[thread]}\035{message}\n")
+        else:
+            raise ValueError(f"Unknown record type: {record_type[0]}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes a binary Skyline log into the textual log format")
+    parser.add_argument("log", type=argparse.FileType("rb"), help="The binary log to decode")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w", encoding="utf-8"), default=sys.stdout, help="The file to write the decoded log to")
+    arguments = parser.parse_args()
+    decode(arguments.log, arguments.output)
+
+
+if __name__ == "__main__":
+    main()